@@ -0,0 +1,366 @@
+//
+// AudioAnalyzeZoomFFT_IQ_F32.cpp
+//
+// Zoom FFT spectrum analyzer.  See AudioAnalyzeZoomFFT_IQ_F32.h
+//
+#include "AudioAnalyzeZoomFFT_IQ_F32.h"
+
+//
+//  Build the decimation filter, then start with a 1024 FFT at zoom x1 centered on 0Hz
+//
+void AudioAnalyzeZoomFFT_IQ_F32::init(float fs)
+{
+    float sum;
+
+    // Blackman windowed sinc lowpass, cutoff at 1/4 of the stage input rate, unity gain at DC.
+    // Symmetric so the reversed order the CMSIS FIR functions expect is the same.
+    const int16_t mid = ZOOM_FIR_TAPS/2;
+    sum = 0.0f;
+    for (int16_t i = 0; i < ZOOM_FIR_TAPS; i++)
+    {
+        float x = (float) (i - mid);
+        float h = (i == mid) ? 0.5f : sinf(0.5f * PI * x) / (PI * x);
+        h *= 0.42f - 0.5f * cosf(2.0f * PI * i / (ZOOM_FIR_TAPS-1)) + 0.08f * cosf(4.0f * PI * i / (ZOOM_FIR_TAPS-1));
+        fir_coeffs[i] = h;
+        sum += h;
+    }
+    for (int16_t i = 0; i < ZOOM_FIR_TAPS; i++)
+        fir_coeffs[i] /= sum;
+
+    sample_rate_Hz  = fs;
+    center_Hz       = 0.0f;
+    zoom_factor     = 1;
+    n_stages        = 0;
+    overlap         = 0;
+    x_axis          = 3;
+    n_average       = 1;
+    avg_mode        = ZOOM_AVG_BLOCK;
+    avg_log         = false;
+    avg_tc_ms       = 0;
+    nco_c           = 1.0f;
+    nco_s           = 0.0f;
+    nco_dc          = 1.0f;
+    nco_ds          = 0.0f;
+    setFFTSize(1024);
+}
+
+//
+//  Select the FFT length and rebuild the window for it.  The buffers are already sized for ZOOM_FFT_MAX_SIZE.
+//
+void AudioAnalyzeZoomFFT_IQ_F32::setFFTSize(uint16_t size)
+{
+    const arm_cfft_instance_f32 *new_cfft;
+    uint16_t n;
+    float    sum = 0.0f;
+
+    if      (size >= 4096) { n = 4096; new_cfft = &arm_cfft_sR_f32_len4096; }
+    else if (size >= 2048) { n = 2048; new_cfft = &arm_cfft_sR_f32_len2048; }
+    else if (size >= 1024) { n = 1024; new_cfft = &arm_cfft_sR_f32_len1024; }
+    else if (size >=  512) { n =  512; new_cfft = &arm_cfft_sR_f32_len512;  }
+    else                   { n =  256; new_cfft = &arm_cfft_sR_f32_len256;  }
+
+    AudioNoInterrupts();
+    fft_size = n;
+    cfft     = new_cfft;
+    // Hann window, only the first half plus the middle point are stored.
+    // The coherent gain is removed in db_offset so a full scale tone reads 0dBFS.
+    for (uint16_t i = 0; i <= n/2; i++)
+    {
+        window[i] = 0.5f - 0.5f * cosf(2.0f * PI * i / n);
+        sum += (i == 0 || i == n/2) ? window[i] : 2.0f * window[i];
+    }
+    db_offset = -20.0f * log10f(sum);
+    set_hop();
+    reset();
+    AudioInterrupts();
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setOverlap(uint8_t ovl)
+{
+    overlap = (ovl > ZOOM_FFT_MAX) ? ZOOM_FFT_MAX : ovl;
+    AudioNoInterrupts();
+    set_hop();
+    AudioInterrupts();
+}
+
+//
+//  Decimated samples between FFTs.  The default (overlap 0) overlaps by the zoom factor so there is 1 FFT per
+//  fft_size input samples at every zoom level, the same CPU load and update rate as zoom x1.
+//
+void AudioAnalyzeZoomFFT_IQ_F32::set_hop(void)
+{
+    uint8_t ovl = (overlap == 0) ? zoom_factor : overlap;
+
+    hop = fft_size / ovl;
+    if (hop < 1)
+        hop = 1;
+    set_avg();
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setAverage(uint8_t mode, uint16_t tc_ms)
+{
+    if (mode >= ZOOM_AVG_NUM)
+        mode = ZOOM_AVG_BLOCK;
+    if (mode % 3 == avg_mode && (mode >= 3) == avg_log && tc_ms == avg_tc_ms)
+        return;     // keep the average going through display redraws
+    AudioNoInterrupts();
+    avg_mode  = mode % 3;
+    avg_log   = (mode >= 3);
+    avg_tc_ms = tc_ms;
+    set_avg();
+    memset(power_sum, 0, sizeof(power_sum));    // the old average may be in the other domain
+    avg_count  = 0;
+    avg_primed = false;
+    AudioInterrupts();
+}
+
+//
+//  Convert the time constant to FFTs at the current FFT rate.  Called when the rate changes.
+//
+void AudioAnalyzeZoomFFT_IQ_F32::set_avg(void)
+{
+    float ffts = avg_tc_ms * 0.001f * sample_rate_Hz / zoom_factor / hop;   // FFTs per time constant
+    if (ffts < 1.0f)
+        ffts = 1.0f;
+    float e = expf(-1.0f / ffts);
+
+    avg_block = (avg_tc_ms == 0) ? 0 : (uint16_t) (ffts + 0.5f);
+    if (avg_mode == ZOOM_AVG_EXP)
+        avg_k = 1.0f - e;
+    else if (avg_log)
+        avg_k = -10.0f * log10f(e);     // dB per FFT
+    else
+        avg_k = e;
+}
+
+//
+//  Clear the filters and sample history.  The first FFT after this has less than a full buffer of new samples.
+//
+void AudioAnalyzeZoomFFT_IQ_F32::reset(void)
+{
+    for (uint8_t st = 0; st < ZOOM_FFT_STAGES; st++)
+    {
+        // Stage st gets AUDIO_BLOCK_SAMPLES >> st samples per update
+        arm_fir_decimate_init_f32(&fir_i[st], ZOOM_FIR_TAPS, 2, fir_coeffs, fir_state_i[st], AUDIO_BLOCK_SAMPLES >> st);
+        arm_fir_decimate_init_f32(&fir_q[st], ZOOM_FIR_TAPS, 2, fir_coeffs, fir_state_q[st], AUDIO_BLOCK_SAMPLES >> st);
+    }
+    memset(ring_i, 0, sizeof(ring_i));
+    memset(ring_q, 0, sizeof(ring_q));
+    memset(power_sum, 0, sizeof(power_sum));
+    wr_idx          = 0;
+    new_samples     = 0;
+    avg_count       = 0;
+    avg_primed      = false;
+    output_ready    = false;
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setZoom(uint8_t zoom)
+{
+    uint8_t stages = 0;
+
+    if (zoom > ZOOM_FFT_MAX)
+        zoom = ZOOM_FFT_MAX;
+    while ((2 << stages) <= zoom)   // round down to a power of 2
+        stages++;
+    AudioNoInterrupts();
+    zoom_factor = 1 << stages;
+    n_stages    = stages;
+    set_hop();
+    reset();
+    AudioInterrupts();
+    setCenter(center_Hz);   // recheck the limit for the new span
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setCenter(float hz)
+{
+    float limit = (sample_rate_Hz - getSpan()) / 2;   // keep the whole span inside the input bandwidth
+    if (zoom_factor == 1)       // the span is the whole input, so any move wraps.  The wrapped bins are blanked.
+        limit = sample_rate_Hz / 2;
+
+    if (hz > limit)
+        hz = limit;
+    if (hz < -limit)
+        hz = -limit;
+    center_Hz = hz;
+    // The mixer multiplies by e^(-j*2*pi*center*t).  When the bin order is reversed (bit 0) the positive
+    // frequencies are in the lower bins so the mix direction is reversed to keep pan moving the same way.
+    float w = 2.0f * PI * hz / sample_rate_Hz;
+    if (!(x_axis & 0x01))
+        w = -w;
+    AudioNoInterrupts();
+    nco_dc = cosf(w);
+    nco_ds = sinf(w);
+    AudioInterrupts();
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setPan(float pan)
+{
+    if (pan != pan)     // NaN
+        pan = 0.0f;
+    // x1 takes the same range as x2, the other half of the screen is blanked at the ends
+    setCenter(pan * ((zoom_factor == 1) ? sample_rate_Hz / 2 : sample_rate_Hz - getSpan()));
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setXAxis(uint8_t axis)
+{
+    x_axis = axis & 0x03;
+    setCenter(center_Hz);   // mix direction follows the bin order
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::setSampleRate(float fs)
+{
+    sample_rate_Hz = fs;
+    setZoom(zoom_factor);
+}
+
+//
+//  Mix, decimate and save the new samples.  Run the FFT every hop decimated samples.
+//
+void AudioAnalyzeZoomFFT_IQ_F32::update(void)
+{
+    audio_block_f32_t *block_i = receiveReadOnly_f32(0);
+    audio_block_f32_t *block_q = receiveReadOnly_f32(1);
+
+    if (!block_i || !block_q)
+    {
+        if (block_i) release(block_i);
+        if (block_q) release(block_q);
+        return;
+    }
+
+    uint16_t n  = block_i->length;
+    float    *pi = work_i[0];
+    float    *pq = work_q[0];
+    float    c  = nco_c;
+    float    s  = nco_s;
+
+    if (n > AUDIO_BLOCK_SAMPLES)
+        n = AUDIO_BLOCK_SAMPLES;
+    for (uint16_t k = 0; k < n; k++)    // complex mix, (I + jQ) * (c + js)
+    {
+        float i = block_i->data[k];
+        float q = block_q->data[k];
+        pi[k]   = i * c - q * s;
+        pq[k]   = i * s + q * c;
+        float t = c * nco_dc - s * nco_ds;   // rotate the oscillator
+        s       = c * nco_ds + s * nco_dc;
+        c       = t;
+    }
+    float g = 1.5f - 0.5f * (c * c + s * s);   // keep the oscillator on the unit circle
+    nco_c = c * g;
+    nco_s = s * g;
+    release(block_i);
+    release(block_q);
+
+    for (uint8_t st = 0; st < n_stages; st++)   // decimate by 2 per stage, ping pong between the work buffers
+    {
+        float *oi = work_i[(st+1) & 1];
+        float *oq = work_q[(st+1) & 1];
+        arm_fir_decimate_f32(&fir_i[st], pi, oi, n);
+        arm_fir_decimate_f32(&fir_q[st], pq, oq, n);
+        pi = oi;
+        pq = oq;
+        n /= 2;
+    }
+
+    // Run each FFT at its hop boundary inside the block, so the FFT rate and the samples in each FFT do not depend on
+    // how hop and the block size divide.  A hop shorter than the block gives more than 1 FFT in this update.
+    for (uint16_t k = 0; k < n; )
+    {
+        uint16_t m = (new_samples < hop) ? hop - new_samples : 0;     // 0 after setOverlap() shortened hop
+        if (m > n - k)
+            m = n - k;
+        new_samples += m;
+        for ( ; m; m--, k++)
+        {
+            ring_i[wr_idx] = pi[k];
+            ring_q[wr_idx] = pq[k];
+            wr_idx = (wr_idx + 1) & (fft_size - 1);
+        }
+        if (new_samples >= hop)
+        {
+            new_samples = 0;
+            compute_fft();
+        }
+    }
+}
+
+void AudioAnalyzeZoomFFT_IQ_F32::compute_fft(void)
+{
+    uint16_t n    = fft_size;
+    uint16_t mask = n - 1;
+    uint16_t idx  = wr_idx;     // oldest sample
+
+    for (uint16_t k = 0; k < n; k++)
+    {
+        float w = window[(k <= n/2) ? k : n - k];
+        fft_buffer[2*k]   = ring_i[idx] * w;
+        fft_buffer[2*k+1] = ring_q[idx] * w;
+        idx = (idx + 1) & mask;
+    }
+    arm_cfft_f32(cfft, fft_buffer, 0, 1);
+    float *pwr = fft_buffer;
+    arm_cmplx_mag_squared_f32(fft_buffer, pwr, n);      // power into the first half of the buffer
+    if (avg_log)
+    {
+        for (uint16_t k = 0; k < n; k++)
+            pwr[k] = 10.0f * log10f(pwr[k] + 1.0e-20f);
+    }
+
+    if (avg_mode == ZOOM_AVG_BLOCK)
+        arm_add_f32(power_sum, pwr, power_sum, n);
+    else if (!avg_primed)       // start the running average from the first FFT instead of 0
+    {
+        memcpy(power_sum, pwr, n * sizeof(float));
+        avg_primed = true;
+    }
+    else if (avg_mode == ZOOM_AVG_EXP)  // avg += k * (new - avg)
+    {
+        arm_sub_f32(pwr, power_sum, pwr, n);
+        arm_scale_f32(pwr, avg_k, pwr, n);
+        arm_add_f32(power_sum, pwr, power_sum, n);
+    }
+    else    // ZOOM_AVG_PEAK.  Decay, then keep the larger
+    {
+        if (avg_log)
+            arm_offset_f32(power_sum, -avg_k, power_sum, n);
+        else
+            arm_scale_f32(power_sum, avg_k, power_sum, n);
+        for (uint16_t k = 0; k < n; k++)
+        {
+            if (pwr[k] > power_sum[k])
+                power_sum[k] = pwr[k];
+        }
+    }
+
+    uint16_t n_out = (avg_mode == ZOOM_AVG_BLOCK && avg_block) ? avg_block : n_average;
+    if (++avg_count < n_out)
+        return;
+
+    bool  block = (avg_mode == ZOOM_AVG_BLOCK);
+    float scale = block ? 1.0f / avg_count : 1.0f;
+    float bin   = getBinSize();
+    bool  wrap  = (fabsf(center_Hz) >= bin);    // only at x1, the limit keeps the span in the input band when zoomed
+    for (uint16_t i = 0; i < n; i++)
+    {
+        uint16_t k = i;
+        if (x_axis & 0x02)      // 0Hz in the middle
+            k = (k + n/2) & mask;
+        if (x_axis & 0x01)      // reversed
+            k = (n - k) & mask;
+        if (avg_log)
+            output[i] = power_sum[k] * scale + db_offset;
+        else
+            output[i] = 10.0f * log10f(power_sum[k] * scale + 1.0e-20f) + db_offset;
+        if (block)
+            power_sum[k] = 0.0f;
+        if (wrap)               // bin k holds the input at f + center (-f + center reversed), past fs/2 it wrapped in from the other edge
+        {
+            float f = ((k < n/2) ? (float) k : (float) k - n) * bin;
+            if (fabsf(((x_axis & 0x01) ? -f : f) + center_Hz) > sample_rate_Hz / 2)
+                output[i] = ZOOM_FFT_BLANK_DB;
+        }
+    }
+    avg_count = 0;
+    output_ready = true;
+}
@@ -0,0 +1,129 @@
+//
+// AudioAnalyzeZoomFFT_IQ_F32.h
+//
+// Spectrum analyzer for the display.  The I and Q input is mixed down so the pan point is at 0Hz, decimated by the
+// zoom factor (1, 2, 4, 8 or 16) with a cascade of decimate by 2 FIR stages, then analyzed with a complex FFT.
+// The FFT size (256 to 4096) and overlap can be changed at runtime.  All buffers are sized once for the largest FFT
+// so this 1 object replaces the separate 1024, 2048 and 4096 point FFT objects and their switch channels.
+// Each zoom step halves the Hz per bin and the span at the same FFT size and, with the default overlap, the same
+// number of FFTs per second.
+//
+// Output is dBFS per bin, ordered per setXAxis() the same as the OpenAudio IQ FFT objects, every setNAverage() FFTs.
+// setAverage() selects how the FFTs are averaged over time, per bin, in the power or the dB domain:
+//   block      - mean of each setNAverage() FFTs (or of time constant worth of FFTs), restarted each output.
+//   exponential - every FFT moves the average 1/e of the way to the new value per time constant.
+//   peak hold  - new values above the held one replace it, otherwise it decays 4.3dB (1/e in power) per time constant.
+// The averages are kept across outputs with CMSIS vector functions so only the output is converted to dB.
+//
+#ifndef _AUDIO_ANALYZE_ZOOM_FFT_IQ_F32_H_
+#define _AUDIO_ANALYZE_ZOOM_FFT_IQ_F32_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define ZOOM_FFT_MIN_SIZE       256     // Smallest complex FFT size
+#define ZOOM_FFT_MAX_SIZE       4096    // Largest complex FFT size, sets the buffer sizes
+#define ZOOM_FFT_MAX            16      // Largest zoom (decimation) factor
+#define ZOOM_FFT_STAGES         4       // Decimate by 2 stages needed for ZOOM_FFT_MAX
+#define ZOOM_AVG_BLOCK          0       // setAverage() modes.  Block mean of power (the original behavior)
+#define ZOOM_AVG_EXP            1       // Exponential average of power
+#define ZOOM_AVG_PEAK           2       // Peak hold with decay on power
+#define ZOOM_AVG_BLOCK_LOG      3       // The same 3 averaging the dB values instead.  Noise averages about 2.5dB lower
+#define ZOOM_AVG_EXP_LOG        4       //   and the trace is smoother for the same time constant.  Costs a log10 per bin per FFT.
+#define ZOOM_AVG_PEAK_LOG       5
+#define ZOOM_AVG_NUM            6
+#define ZOOM_FFT_BLANK_DB       -200.0f // Output of the bins a pan at x1 wraps around from the other band edge
+#define ZOOM_FIR_TAPS           63      // Each stage passes +/-0.2 and stops beyond +/-0.3 of its input rate.  Keeps 80% of the final span alias free.
+
+#if AUDIO_BLOCK_SAMPLES % ZOOM_FFT_MAX
+#error AUDIO_BLOCK_SAMPLES has to be a multiple of ZOOM_FFT_MAX, each zoom stage halves the block
+#endif
+
+class AudioAnalyzeZoomFFT_IQ_F32 : public AudioStream_F32
+{
+//GUI: inputs:2, outputs:0  //this line used for automatic generation of GUI node
+//GUI: shortName:ZoomFFT_IQ
+  public:
+    AudioAnalyzeZoomFFT_IQ_F32(void) : AudioStream_F32(2, inputQueueArray)
+    {
+        init(AUDIO_SAMPLE_RATE_EXACT);
+    }
+    AudioAnalyzeZoomFFT_IQ_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+    {
+        init(settings.sample_rate_Hz);
+    }
+
+    void     setFFTSize(uint16_t size);         // 256, 512, 1024, 2048 or 4096.  Other values round down to one of these.
+    uint16_t getFFTSize(void)   { return fft_size; }
+    void     setOverlap(uint8_t overlap);       // FFTs per FFT length of new samples, 1 to 16.  0 follows the zoom factor.
+    void     setZoom(uint8_t zoom);             // 1, 2, 4, 8 or 16.  Other values round down to one of these.
+    uint8_t  getZoom(void)      { return zoom_factor; }
+    void     setCenter(float hz);               // Offset from 0Hz moved to the center bin, positive toward the higher output bins
+    void     setPan(float pan);                 // -0.5 to +0.5 of the center range that keeps the span inside the input bandwidth.
+                                                // x1 has the x2 range, the bins past the band edge read ZOOM_FFT_BLANK_DB.
+    float    getCenter(void)    { return center_Hz; }
+    float    getBinSize(void)   { return sample_rate_Hz / zoom_factor / fft_size; }   // Hz per bin
+    float    getSpan(void)      { return sample_rate_Hz / zoom_factor; }              // Hz across all bins
+    void     setSampleRate(float fs);
+    void     setXAxis(uint8_t axis);            // bit 1 puts 0Hz in the middle, bit 0 reverses the order
+    void     setNAverage(uint16_t n) { n_average = (n < 1) ? 1 : n; }         // FFTs per output
+    void     setAverage(uint8_t mode, uint16_t tc_ms);  // ZOOM_AVG_xxx and time constant.  tc_ms 0 in block mode uses setNAverage()
+    bool     available(void)
+    {
+        if (output_ready)
+        {
+            output_ready = false;
+            return true;
+        }
+        return false;
+    }
+    float   *getData(void)      { return output; }
+    float    read(uint16_t bin) { return (bin < fft_size) ? output[bin] : 0.0f; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+    const arm_cfft_instance_f32 *cfft;
+    float       sample_rate_Hz;
+    float       center_Hz;
+    uint16_t    fft_size;
+    uint16_t    hop;                                // decimated samples between FFTs
+    uint8_t     overlap;                            // 0 = follow zoom_factor
+    uint8_t     zoom_factor;
+    uint8_t     n_stages;
+    uint8_t     x_axis;
+    uint16_t    n_average;
+    uint16_t    avg_count;
+    uint8_t     avg_mode;                           // ZOOM_AVG_xxx
+    bool        avg_log;                            // averaging dB values
+    bool        avg_primed;                         // power_sum holds an average to continue
+    uint16_t    avg_tc_ms;
+    uint16_t    avg_block;                          // FFTs per block from the time constant, 0 = n_average
+    float       avg_k;                              // exponential weight of the new FFT, or peak decay per FFT (factor or dB)
+    uint16_t    wr_idx;                             // next write position in the time ring
+    uint16_t    new_samples;                        // decimated samples received since the last FFT
+    volatile bool output_ready;
+    float       nco_c, nco_s;                       // mixer oscillator, cos and sin of the current phase
+    float       nco_dc, nco_ds;                     // rotation per input sample
+
+    arm_fir_decimate_instance_f32 fir_i[ZOOM_FFT_STAGES], fir_q[ZOOM_FFT_STAGES];
+    float       fir_coeffs[ZOOM_FIR_TAPS];
+    float       fir_state_i[ZOOM_FFT_STAGES][ZOOM_FIR_TAPS + AUDIO_BLOCK_SAMPLES - 1];
+    float       fir_state_q[ZOOM_FFT_STAGES][ZOOM_FIR_TAPS + AUDIO_BLOCK_SAMPLES - 1];
+    float       work_i[2][AUDIO_BLOCK_SAMPLES], work_q[2][AUDIO_BLOCK_SAMPLES];
+
+    float       ring_i[ZOOM_FFT_MAX_SIZE], ring_q[ZOOM_FFT_MAX_SIZE];     // last fft_size decimated samples
+    float       window[ZOOM_FFT_MAX_SIZE/2+1];      // Symmetric so *Half Size* plus the middle point
+    float       fft_buffer[ZOOM_FFT_MAX_SIZE*2];    // interleaved real, imaginary
+    float       power_sum[ZOOM_FFT_MAX_SIZE];          // block sum, or the running average
+    float       output[ZOOM_FFT_MAX_SIZE];
+    float       db_offset;                          // scales the window and FFT gain to dBFS
+
+    void        init(float fs);
+    void        reset(void);
+    void        set_hop(void);
+    void        set_avg(void);
+    void        compute_fft(void);
+};
+#endif  // _AUDIO_ANALYZE_ZOOM_FFT_IQ_F32_H_
@@ -0,0 +1,117 @@
+//
+// AudioEffectAGC_F32.cpp
+//
+// Look-ahead, hang AGC for the receive audio.  See AudioEffectAGC_F32.h
+//
+#include "AudioEffectAGC_F32.h"
+
+void AudioEffectAGC_F32::setParams(float _threshold, float _max_gain_dB, float _decay_dBps, uint16_t _hang_ms)
+{
+    AudioNoInterrupts();
+    threshold   = _threshold;
+    max_gain_dB = _max_gain_dB;
+    decay_dBps  = _decay_dBps;
+    hang_ms     = _hang_ms;
+    AudioInterrupts();
+}
+
+void AudioEffectAGC_F32::setLookahead_ms(float ms)
+{
+    uint16_t d = (uint16_t) (ms * sample_rate_Hz / 1000.0f);
+
+    if (d > AUDIO_BLOCK_SAMPLES)
+        d = AUDIO_BLOCK_SAMPLES;
+    AudioNoInterrupts();
+    delay = d;
+    memset(dl, 0, sizeof(dl));
+    AudioInterrupts();
+}
+
+void AudioEffectAGC_F32::enable(bool on)
+{
+    AudioNoInterrupts();
+    if (on && !enabled)
+    {
+        memset(dl, 0, sizeof(dl));
+        gain_dB    = 0.0f;
+        gain       = 1.0f;
+        hang_count = 0;
+    }
+    enabled = on;
+    AudioInterrupts();
+}
+
+void AudioEffectAGC_F32::update(void)
+{
+    audio_block_f32_t *in = receiveReadOnly_f32(0);
+    audio_block_f32_t *out;
+
+    if (!in)
+        return;
+    if (!enabled)
+    {
+        transmit(in);
+        release(in);
+        return;
+    }
+    out = allocate_f32();
+    if (!out)
+    {
+        release(in);
+        return;
+    }
+
+    uint16_t n = (in->length > AUDIO_BLOCK_SAMPLES) ? AUDIO_BLOCK_SAMPLES : in->length;
+    uint16_t d = (delay > n) ? n : delay;
+    float    peak = 0.0f;
+
+    // Envelope covers the delayed samples going out now and the look-ahead ones going out next block
+    for (uint16_t i = 0; i < d; i++)
+        if (fabsf(dl[i]) > peak) peak = fabsf(dl[i]);
+    for (uint16_t i = 0; i < n; i++)
+        if (fabsf(in->data[i]) > peak) peak = fabsf(in->data[i]);
+
+    memcpy(out->data, dl, d * sizeof(float));
+    memcpy(out->data + d, in->data, (n - d) * sizeof(float));
+    memcpy(dl, in->data + n - d, d * sizeof(float));
+    release(in);
+
+    float want = (peak > 1.0e-9f) ? threshold - 20.0f * log10f(peak) : max_gain_dB;
+    if (want > max_gain_dB)
+        want = max_gain_dB;
+
+    float    new_dB = gain_dB;
+    uint16_t ramp   = n;            // samples to reach the new gain over
+    if (want < gain_dB)             // attack, done before the peak comes out of the delay
+    {
+        new_dB     = want;
+        ramp       = d;
+        hang_count = (uint16_t) (hang_ms * sample_rate_Hz / 1000.0f / n);
+    }
+    else if (want < gain_dB + AGC_HANG_DB)  // still there, hold and hang from here
+        hang_count = (uint16_t) (hang_ms * sample_rate_Hz / 1000.0f / n);
+    else if (hang_count)
+        hang_count--;
+    else                            // decay
+    {
+        new_dB += decay_dBps * n / sample_rate_Hz;
+        if (new_dB > want)
+            new_dB = want;
+    }
+
+    float new_gain = powf(10.0f, new_dB / 20.0f);
+    float g        = gain;
+    float step     = (ramp) ? (new_gain - gain) / ramp : 0.0f;
+    for (uint16_t i = 0; i < ramp; i++)
+    {
+        g += step;
+        out->data[i] *= g;
+    }
+    arm_scale_f32(out->data + ramp, new_gain, out->data + ramp, n - ramp);
+    gain_dB = new_dB;
+    gain    = new_gain;
+
+    out->length = n;
+    transmit(out);
+    release(out);
+}
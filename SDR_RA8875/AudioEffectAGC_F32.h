@@ -0,0 +1,62 @@
+//
+// AudioEffectAGC_F32.h
+//
+// Receive audio AGC with look-ahead and hang.  The envelope is the peak of each block, gain is worked out once per
+// block in dB and applied as a straight line ramp across the block, so the per sample cost is 1 multiply-add.
+//
+// The audio is delayed by the look-ahead time so a peak is seen 1 block before it is output.  Gain going down (attack)
+// ramps over the delayed samples only and is at the new value before the peak arrives, so there is no overshoot.  Gain
+// going up (decay) waits out the hang time, then ramps over the whole block at decay dB/s up to max gain.  The hang
+// time runs from the last block whose peak was within AGC_HANG_DB of the level the gain is set for, so a steady signal
+// keeps it from running out and the gain holds for the whole hang time once the signal goes.  The gain does not follow
+// a block inside AGC_HANG_DB, so a slow fade still waits out the hang and comes up no faster than decay dB/s.
+//
+// Levels are in dBFS, the gain brings the block peak to the threshold.  Disabled it passes audio through undelayed.
+//
+#ifndef _AUDIO_EFFECT_AGC_F32_H_
+#define _AUDIO_EFFECT_AGC_F32_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define AGC_LOOKAHEAD_MS    3.0f    // default look-ahead, limited to 1 block
+#define AGC_HANG_DB         1.0f    // a block peak this close under the gain's level is the signal still there
+
+class AudioEffectAGC_F32 : public AudioStream_F32
+{
+//GUI: inputs:1, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:AGC
+  public:
+    AudioEffectAGC_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray)
+    {
+        sample_rate_Hz = settings.sample_rate_Hz;
+        enabled        = false;
+        gain_dB        = 0.0f;
+        gain           = 1.0f;
+        hang_count     = 0;
+        setParams(-10.0f, 40.0f, 20.0f, 500);
+        setLookahead_ms(AGC_LOOKAHEAD_MS);
+    }
+    // threshold dBFS, max_gain_dB, decay dB/s and hang ms.  Values come from the agc_set[] table.
+    void    setParams(float threshold, float max_gain_dB, float decay_dBps, uint16_t hang_ms);
+    void    setLookahead_ms(float ms);
+    void    enable(bool on);
+    float   getGain_dB(void) { return gain_dB; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[1];
+    float       sample_rate_Hz;
+    bool        enabled;
+    float       threshold;
+    float       max_gain_dB;
+    float       decay_dBps;
+    uint16_t    hang_ms;
+    uint16_t    delay;                          // look-ahead samples
+    float       gain_dB;                        // at the end of the last block
+    float       gain;                           // same, linear
+    uint16_t    hang_count;                     // blocks left to hold the gain
+    float       dl[AUDIO_BLOCK_SAMPLES];        // look-ahead delay line
+};
+#endif  // _AUDIO_EFFECT_AGC_F32_H_
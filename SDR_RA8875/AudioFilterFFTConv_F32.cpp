@@ -0,0 +1,161 @@
+//
+// AudioFilterFFTConv_F32.cpp
+//
+// Partitioned overlap-save FFT convolution with swappable kernels.  See AudioFilterFFTConv_F32.h
+//
+#include "AudioFilterFFTConv_F32.h"
+
+// Modified Bessel function of the first kind, order 0, for the Kaiser window
+static float _bessel_I0(float x)
+{
+    float sum  = 1.0f;
+    float term = 1.0f;
+
+    for (int k = 1; k < 50; k++)
+    {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum  += term;
+        if (term < 1.0e-9f * sum)
+            break;
+    }
+    return sum;
+}
+
+// Ideal lowpass with cutoff f (cycles per sample) at tap offset n from the center
+static float _sinc_lp(float f, float n)
+{
+    if (n == 0.0f)
+        return 2.0f * f;
+    return sinf(2.0f * PI * f * n) / (PI * n);
+}
+
+void AudioFilterFFTConv_F32::design(FFTConv_Kernel *k, float fc, float Astop, int type, float bw)
+{
+    const uint16_t n_taps = getTaps();
+    const float mid = (n_taps - 1) / 2.0f;
+    float taps[FFTCONV_LEN];
+    float buf[2 * AUDIO_BLOCK_SAMPLES];     // not work[], the audio update may be using it
+    float beta;
+    float f_lo, f_hi;
+
+    if (Astop > 50.0f)
+        beta = 0.1102f * (Astop - 8.7f);
+    else if (Astop > 21.0f)
+        beta = 0.5842f * powf(Astop - 21.0f, 0.4f) + 0.07886f * (Astop - 21.0f);
+    else
+        beta = 0.0f;
+    float i0_beta = _bessel_I0(beta);
+
+    if (type == FFTCONV_BANDPASS)
+    {
+        f_lo = (fc - bw / 2.0f) / sample_rate_Hz;
+        f_hi = (fc + bw / 2.0f) / sample_rate_Hz;
+    }
+    else
+    {
+        f_lo = 0.0f;
+        f_hi = fc / sample_rate_Hz;
+    }
+    if (f_lo < 0.0f) f_lo = 0.0f;
+    if (f_hi > 0.5f) f_hi = 0.5f;
+
+    for (int n = 0; n < n_taps; n++)
+    {
+        float t = (n - mid) / mid;
+        float h = _sinc_lp(f_hi, n - mid) - _sinc_lp(f_lo, n - mid);
+        if (type == FFTCONV_HIGHPASS)
+            h = ((n - mid) == 0.0f ? 1.0f : 0.0f) - h;
+        taps[n] = h * _bessel_I0(beta * sqrtf(1.0f - t * t)) / i0_beta;
+    }
+    taps[n_taps] = 0.0f;        // pad the last partition
+    for (int p = 0; p < parts; p++)
+    {
+        memcpy(buf, taps + p * part, part * sizeof(float));
+        memset(buf + part, 0, part * sizeof(float));
+        arm_rfft_fast_f32(&rfft, buf, k->H + p * nfft, 0);
+    }
+    k->parts = parts;
+    k->fc = fc;
+    k->bw = bw;
+    k->fs = sample_rate_Hz;
+}
+
+void AudioFilterFFTConv_F32::initFilter(float fc, float Astop, int type, float bw)
+{
+    FFTConv_Kernel *k = &own[inUse(&own[0]) ? 1 : 0];
+
+    design(k, fc, Astop, type, bw);
+    setKernel(k);
+}
+
+//
+//  Sum of the last 'parts' input spectra times the matching kernel partitions, partition 0 with the newest,
+//  inverse FFT into out.  Spectra are arm_rfft_fast_f32 packed, [0] is DC and [1] is Nyquist (both real) then complex pairs.
+//
+void AudioFilterFFTConv_F32::convolve(const FFTConv_Kernel *k, float *out)
+{
+    memset(Y, 0, nfft * sizeof(float));
+    for (uint16_t p = 0; p < parts; p++)
+    {
+        const float *X = fdl + ((fdl_i + parts - p) % parts) * nfft;
+        const float *H = k->H + p * nfft;
+
+        Y[0] += X[0] * H[0];
+        Y[1] += X[1] * H[1];
+        for (uint16_t n = 2; n < nfft; n += 2)
+        {
+            Y[n]   += X[n] * H[n]   - X[n+1] * H[n+1];
+            Y[n+1] += X[n] * H[n+1] + X[n+1] * H[n];
+        }
+    }
+    arm_rfft_fast_f32(&rfft, Y, out, 1);
+}
+
+//
+//  1 block in, the same block filtered out.  A kernel change is picked up here.  When it changes the block is filtered
+//  with both and fades from the old to the new result.  The delay line does not depend on the kernel so that is 1 more
+//  multiply-add pass and inverse FFT for the 1 block.
+//
+void AudioFilterFFTConv_F32::update(void)
+{
+    audio_block_f32_t *in = receiveReadOnly_f32(0);
+    audio_block_f32_t *out;
+    const FFTConv_Kernel *old = cur;
+
+    if (!in)
+        return;
+    out = allocate_f32();
+    if (!out)
+    {
+        release(in);
+        return;
+    }
+    memcpy(x + part, in->data, part * sizeof(float));
+    release(in);
+
+    fdl_i = (fdl_i + 1) % parts;
+    memcpy(work, x, nfft * sizeof(float));  // the rfft writes over its input
+    arm_rfft_fast_f32(&rfft, work, fdl + fdl_i * nfft, 0);
+
+    cur = next;
+    if (!cur)   // no kernel yet, pass through
+        memcpy(out->data, x + part, part * sizeof(float));
+    else
+    {
+        convolve(cur, y);
+        if (old && old != cur)
+        {
+            convolve(old, y_old);
+            for (uint16_t i = part; i < nfft; i++)
+            {
+                float g = (i - part + 0.5f) / part;
+                y[i] = y_old[i] + g * (y[i] - y_old[i]);
+            }
+        }
+        memcpy(out->data, y + part, part * sizeof(float));    // the first half is wrapped around, drop it
+    }
+    memcpy(x, x + part, part * sizeof(float));
+    out->length = part;
+    transmit(out);
+    release(out);
+}
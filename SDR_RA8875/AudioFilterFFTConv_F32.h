@@ -0,0 +1,105 @@
+//
+// AudioFilterFFTConv_F32.h
+//
+// Uniformly partitioned overlap-save FFT convolution for the receive bandwidth filter.  The Kaiser windowed FIR is cut
+// into partitions 1 input block long.  Each update does 1 forward FFT of the last 2 blocks, keeps its spectrum in a
+// delay line of 1 per partition, multiplies and adds those with the partition spectra of the kernel and does 1 inverse
+// FFT.  Output is the same block that came in, so the filter adds no block of latency (the library
+// AudioFilterConvolution_F32 gathers 512 samples first).  The work is the same every update, there is no 1 in 4 spike.
+//
+// The partition is the settings' audio_block_samples, so a decimator sending short blocks (AudioResample_F32.h) feeds
+// it directly.  The filter spans the same time at any rate:  511 taps at FFTCONV_FULL_RATE_HZ, 127 at 12 kHz.  The
+// delay is half of that, 5.3 ms.  A shorter partition gives more of them for the same taps:  the kernel takes the same
+// memory and the multiply-adds per sample go up with the partition count (1 at 128 samples and 12 kHz, 4 at 32).
+//
+// The kernel spectrum lives outside the object in an FFTConv_Kernel.  Kernels are designed ahead of time with design()
+// and handed over with setKernel(), which only stores a pointer.  The update picks it up on the next block and
+// crossfades that block from the old kernel's output to the new one so filter changes do not click.
+//
+// initFilter() is kept so the object drops in for AudioFilterConvolution_F32.  It designs into 1 of 2 kernels owned
+// by the object, so it still costs a design on every call.
+//
+#ifndef _AUDIO_FILTER_FFT_CONV_F32_H_
+#define _AUDIO_FILTER_FFT_CONV_F32_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define FFTCONV_LEN         512                 // longest FIR plus 1, the taps are 1 short so the delay is a whole sample
+#define FFTCONV_FULL_RATE_HZ 48000.0f           // rate the longest FIR is for, lower rates get fewer taps
+#define FFTCONV_MIN_PART    16                  // shortest partition, the rfft is 32 points or more
+
+#if AUDIO_BLOCK_SAMPLES < FFTCONV_MIN_PART || FFTCONV_LEN % AUDIO_BLOCK_SAMPLES
+#error AUDIO_BLOCK_SAMPLES has to be 16 to 512 and divide 512
+#endif
+
+// FIR types for design() and initFilter(), same numbering as AudioFilterConvolution_F32
+#define FFTCONV_LOWPASS     0
+#define FFTCONV_HIGHPASS    1
+#define FFTCONV_BANDPASS    2
+
+struct FFTConv_Kernel {
+    float       fc;                 // what it was designed for.  fs == 0 is an empty kernel
+    float       bw;
+    float       fs;
+    uint16_t    parts;              // partitions
+    float       H[2 * FFTCONV_LEN]; // arm_rfft_fast_f32 packed spectrum of each partition of the taps, 2 * part each
+};
+
+class AudioFilterFFTConv_F32 : public AudioStream_F32
+{
+//GUI: inputs:1, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:FFTConv
+  public:
+    AudioFilterFFTConv_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray)
+    {
+        sample_rate_Hz = settings.sample_rate_Hz;
+        part = settings.audio_block_samples;
+        if (part < FFTCONV_MIN_PART) part = FFTCONV_MIN_PART;
+        if (part > AUDIO_BLOCK_SAMPLES) part = AUDIO_BLOCK_SAMPLES;
+        nfft = 2 * part;
+        parts = (uint16_t) (FFTCONV_LEN * sample_rate_Hz / FFTCONV_FULL_RATE_HZ / part + 0.5f);
+        if (parts < 1) parts = 1;
+        if (parts > FFTCONV_LEN / part) parts = FFTCONV_LEN / part;
+        arm_rfft_fast_init_f32(&rfft, nfft);
+        cur   = NULL;
+        next  = NULL;
+        fdl_i = 0;
+        memset(x, 0, sizeof(x));
+        memset(fdl, 0, sizeof(fdl));
+    }
+    // Fill k for a filter at this object's sample rate.  type is FFTCONV_xxx, fc is the center (bandpass) or the edge,
+    // bw is the bandpass width.  Astop in dB sets the Kaiser window.  Takes a few ms, call from loop() not the audio ISR.
+    void    design(FFTConv_Kernel *k, float fc, float Astop, int type, float bw);
+    bool    matches(const FFTConv_Kernel *k, float fc, float bw) { return k->fs == sample_rate_Hz && k->fc == fc && k->bw == bw; }
+    void    setKernel(const FFTConv_Kernel *k) { next = k; }   // takes effect at the next block, k must stay valid until replaced
+    bool    inUse(const FFTConv_Kernel *k)     { return k == cur || k == next; }
+    void    initFilter(float fc, float Astop, int type, float bw);
+    float   getRate(void) { return sample_rate_Hz; }
+    uint16_t getTaps(void)  { return parts * part - 1; }
+    uint16_t getParts(void) { return parts; }
+    uint16_t getPart(void)  { return part; }   // samples per partition and per block
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[1];
+    arm_rfft_fast_instance_f32 rfft;
+    float       sample_rate_Hz;
+    uint16_t    part;                           // partition and block length
+    uint16_t    nfft;                           // 2 * part
+    uint16_t    parts;
+    const FFTConv_Kernel * volatile cur;        // in use
+    const FFTConv_Kernel * volatile next;       // requested
+    FFTConv_Kernel own[2];                      // for initFilter()
+    uint16_t    fdl_i;                          // newest spectrum in fdl
+    float       x[2 * AUDIO_BLOCK_SAMPLES];     // last block then the new one
+    float       fdl[2 * FFTCONV_LEN];           // spectra of the last 'parts' input blocks, nfft each
+    float       Y[2 * AUDIO_BLOCK_SAMPLES];     // sum of the partition products
+    float       y[2 * AUDIO_BLOCK_SAMPLES];
+    float       y_old[2 * AUDIO_BLOCK_SAMPLES]; // old kernel's output during a crossfade
+    float       work[2 * AUDIO_BLOCK_SAMPLES];
+
+    void        convolve(const FFTConv_Kernel *k, float *out);
+};
+#endif  // _AUDIO_FILTER_FFT_CONV_F32_H_
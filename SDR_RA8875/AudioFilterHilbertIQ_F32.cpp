@@ -0,0 +1,233 @@
+//
+// AudioFilterHilbertIQ_F32.cpp
+//
+// Fused +45/-45 degree phasing filter.  See AudioFilterHilbertIQ_F32.h
+//
+#include "AudioFilterHilbertIQ_F32.h"
+
+static float design_buf[HILBERT_IQ_MAX_TAPS];  // design() output before it is folded, shared by every object
+
+// Zero order modified Bessel function of the first kind for the Kaiser window
+static float bessel_i0(float x)
+{
+    float sum  = 1.0f;
+    float term = 1.0f;
+
+    for (uint8_t k = 1; k < 32 && term > 1.0e-8f * sum; k++)
+    {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum  += term;
+    }
+    return sum;
+}
+
+//
+//  A lowpass of half the passband width, windowed sinc, is shifted up to the middle of the passband by a cosine with the
+//  wanted phase:  h[k] = 2 * lp[k] * cos(w0 * (k - mid) + phase).  The positive frequency half of that is the lowpass
+//  moved to f_lo..f_hi with its phase turned by 'phase', the negative half by -phase.  The lowpass has unity DC gain so
+//  the passband gain is 1.  Kaiser beta for HILBERT_IQ_ATTEN_DB is from Kaiser's formula.
+//
+void Hilbert_Design(float *h, uint16_t n, float fs, float f_lo, float f_hi, float phase_deg)
+{
+    float a     = HILBERT_IQ_ATTEN_DB;
+    float beta  = (a > 50.0f) ? 0.1102f * (a - 8.7f) : 0.5842f * powf(a - 21.0f, 0.4f) + 0.07886f * (a - 21.0f);
+    float width = (f_hi - f_lo) / fs;                   // lowpass from -width/2 to width/2, cycles per sample
+    float w0    = PI * (f_hi + f_lo) / fs;              // 2 pi * center
+    float phase = phase_deg * PI / 180.0f;
+    float mid   = 0.5f * (n - 1);
+    float i0    = bessel_i0(beta);
+    float sum   = 0.0f;
+
+    for (uint16_t k = 0; k < n; k++)
+    {
+        float x = k - mid;
+        float r = x / mid;
+        float lp = (fabsf(x) < 1.0e-6f) ? width : sinf(PI * width * x) / (PI * x);
+        lp *= bessel_i0(beta * sqrtf(fmaxf(0.0f, 1.0f - r*r))) / i0;
+        h[k] = lp;
+        sum += lp;
+    }
+    for (uint16_t k = 0; k < n; k++)
+        h[k] *= 2.0f / sum * cosf(w0 * (k - mid) + phase);
+}
+
+void AudioFilterHilbertIQ_F32::design(float f_lo, float f_hi, uint16_t n)
+{
+    if (n == 0)
+    {
+        n = (uint16_t) ((HILBERT_IQ_DESIGN_TAPS - 1) * sample_rate_Hz / HILBERT_IQ_DESIGN_RATE + 0.5f) | 1;
+        if (n > HILBERT_IQ_MAX_TAPS)
+            n = HILBERT_IQ_MAX_TAPS;
+    }
+    if (n > HILBERT_IQ_MAX_TAPS || !(n & 1))
+    {
+        begin(NULL, 0);
+        return;
+    }
+    Hilbert_Design(design_buf, n, sample_rate_Hz, f_lo, f_hi, 45.0f);
+    begin(design_buf, n);
+}
+
+//
+//  Split the +45 table into its symmetric (e) and antisymmetric (o) halves and keep only the non zero taps of each.
+//  The center tap is in e only.  It is stored at half value since the folded loop adds its sample twice.
+//
+void AudioFilterHilbertIQ_F32::begin(const float *plus45, uint16_t n)
+{
+    uint16_t ne = 0;
+    uint16_t no = 0;
+
+    AudioNoInterrupts();
+    if (!plus45 || n > HILBERT_IQ_MAX_TAPS || !(n & 1))
+    {
+        n_taps = 0;     // pass through
+        AudioInterrupts();
+        return;
+    }
+    uint16_t mid = n/2;
+    for (uint16_t k = 0; k <= mid; k++)
+    {
+        float e = 0.5f * (plus45[k] + plus45[n-1-k]);
+        float o = 0.5f * (plus45[k] - plus45[n-1-k]);
+        if (e != 0.0f)
+        {
+            e_k[ne] = k;
+            e_c[ne] = (k == mid) ? 0.5f * e : e;
+            ne++;
+        }
+        if (o != 0.0f && k < mid)
+        {
+            o_k[no] = k;
+            o_c[no] = o;
+            no++;
+        }
+    }
+    if (n != n_taps)    // the history lines up with the new taps only if the length is the same
+    {
+        memset(hist0, 0, sizeof(hist0));
+        memset(hist1, 0, sizeof(hist1));
+    }
+    n_taps = n;
+    n_e    = ne;
+    n_o    = no;
+    AudioInterrupts();
+}
+
+//
+//  x holds n_taps-1 old samples followed by the n new ones.  y[i] is the symmetric half applied at new sample i.
+//
+void AudioFilterHilbertIQ_F32::fold_e(const float *x, uint16_t n, float *y)
+{
+    const int16_t far = n_taps - 1;
+
+    for (uint16_t i = 0; i < n; i++)
+    {
+        const float *p = x + far + i;      // newest sample for this output
+        float acc = 0.0f;
+        for (uint16_t j = 0; j < n_e; j++)
+        {
+            int16_t k = e_k[j];
+            acc += e_c[j] * (p[-k] + p[k - far]);
+        }
+        y[i] = acc;
+    }
+}
+
+void AudioFilterHilbertIQ_F32::fold_o(const float *x, uint16_t n, float *y)
+{
+    const int16_t far = n_taps - 1;
+
+    for (uint16_t i = 0; i < n; i++)
+    {
+        const float *p = x + far + i;
+        float acc = 0.0f;
+        for (uint16_t j = 0; j < n_o; j++)
+        {
+            int16_t k = o_k[j];
+            acc += o_c[j] * (p[-k] - p[k - far]);
+        }
+        y[i] = acc;
+    }
+}
+
+void AudioFilterHilbertIQ_F32::update(void)
+{
+    audio_block_f32_t *in0 = receiveReadOnly_f32(0);
+    audio_block_f32_t *in1 = receiveReadOnly_f32(1);
+    audio_block_f32_t *out0, *out1 = NULL;
+
+    if (!in0)
+    {
+        if (in1) release(in1);
+        return;
+    }
+    if (n_taps == 0)    // no table yet, pass through
+    {
+        transmit(in0, 0);
+        transmit(in1 ? in1 : in0, 1);
+        release(in0);
+        if (in1) release(in1);
+        return;
+    }
+
+    uint16_t n   = (in0->length > AUDIO_BLOCK_SAMPLES) ? AUDIO_BLOCK_SAMPLES : in0->length;
+    uint16_t old = n_taps - 1;
+    bool     sum = (in1 && sideband != 0);
+
+    memcpy(hist0 + old, in0->data, n * sizeof(float));
+    if (in1)
+        memcpy(hist1 + old, in1->data, n * sizeof(float));
+    release(in0);
+    if (in1) release(in1);
+
+    out0 = allocate_f32();
+    if (out0 && !sum)
+        out1 = allocate_f32();
+    if (out0 && (sum || out1))
+    {
+        if (sum)    // e*(in0 + sb*in1) + o*(in0 - sb*in1)
+        {
+            if (sideband > 0)
+            {
+                arm_add_f32(hist0, hist1, work_a, old + n);
+                arm_sub_f32(hist0, hist1, work_b, old + n);
+            }
+            else
+            {
+                arm_sub_f32(hist0, hist1, work_a, old + n);
+                arm_add_f32(hist0, hist1, work_b, old + n);
+            }
+            fold_e(work_a, n, sum_e);
+            fold_o(work_b, n, sum_o);
+            arm_add_f32(sum_e, sum_o, out0->data, n);
+        }
+        else if (in1)   // 2 separate filters
+        {
+            fold_e(hist0, n, sum_e);
+            fold_o(hist0, n, sum_o);
+            arm_add_f32(sum_e, sum_o, out0->data, n);
+            fold_e(hist1, n, sum_e);
+            fold_o(hist1, n, sum_o);
+            arm_sub_f32(sum_e, sum_o, out1->data, n);
+        }
+        else    // 1 input, both filters share the halves
+        {
+            fold_e(hist0, n, sum_e);
+            fold_o(hist0, n, sum_o);
+            arm_add_f32(sum_e, sum_o, out0->data, n);
+            arm_sub_f32(sum_e, sum_o, out1->data, n);
+        }
+        out0->length = n;
+        transmit(out0, 0);
+        if (out1)
+        {
+            out1->length = n;
+            transmit(out1, 1);
+        }
+    }
+    if (out0) release(out0);
+    if (out1) release(out1);
+
+    memmove(hist0, hist0 + n, old * sizeof(float));   // keep the last n_taps-1 samples for the next block
+    memmove(hist1, hist1 + n, old * sizeof(float));
+}
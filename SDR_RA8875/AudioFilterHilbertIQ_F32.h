@@ -0,0 +1,80 @@
+//
+// AudioFilterHilbertIQ_F32.h
+//
+// +45/-45 degree phasing filter pair in 1 object.  begin() takes the +45 table, the -45 filter is the same table reversed
+// (true for the Hilbert_Design() tables and the old Hilbert_PlusXX/Hilbert_MinusXX pairs).  The table is split into its symmetric and
+// antisymmetric halves, h = e + o, so +45 = e + o and -45 = e - o.  Each half is folded (1 multiply per pair of taps)
+// and its zero taps dropped, so the antisymmetric hilbertXXA designs cost 1 multiply per 4 taps.
+//
+// Channel use, picked per update from what is connected and setSideband():
+//   2 inputs, sideband 0  - out 0 = +45 of input 0, out 1 = -45 of input 1.  Drop in for the 2 separate FIR objects,
+//                           same multiplies, 1 pass.
+//   2 inputs, sideband +/-1 - out 0 = +45(in 0) +/- -45(in 1), the sum RX_Summer was doing.  Computed as
+//                           e*(in0 +/- in1) + o*(in0 -/+ in1), half the multiplies of the 2 filters.
+//   input 1 not connected - out 0 = +45 and out 1 = -45 of input 0.  e and o are shared, half the multiplies (TX).
+//
+// design() makes the +45 table for a passband at the object's sample rate with Hilbert_Design() and begins it, in place
+// of a fixed table.  The pair is a lowpass shifted up to the middle of the passband, so the phase difference is 90
+// degrees all across it.  A new design with the same number of taps keeps the sample history, so the audio does not stop.
+// The default length is HILBERT_IQ_DESIGN_TAPS scaled with the sample rate, so the transitions, and where the pair is
+// flat, stay the same in Hz at 48, 96 and 192KHz.
+//
+#ifndef _AUDIO_FILTER_HILBERT_IQ_F32_H_
+#define _AUDIO_FILTER_HILBERT_IQ_F32_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define HILBERT_IQ_MAX_TAPS     601     // Longest table, odd length.  design() at 192KHz.
+#define HILBERT_IQ_HIST         (HILBERT_IQ_MAX_TAPS - 1 + AUDIO_BLOCK_SAMPLES)
+#define HILBERT_IQ_DESIGN_TAPS  151     // design() default at HILBERT_IQ_DESIGN_RATE, the length of the tables it replaced
+#define HILBERT_IQ_DESIGN_RATE  48000.0f
+#define HILBERT_IQ_ATTEN_DB     70.0f   // Kaiser window for design(), about 1.4KHz transition with 151 taps at 48KHz
+
+// Windowed sinc (Kaiser) FIR at fs with a passband from f_lo to f_hi (the -6dB edges) and the phase in it shifted by
+// phase_deg.  45 is the +45 filter of a pair (its time reverse is the -45) and 0 is a plain bandpass.  n taps, odd.
+void Hilbert_Design(float *h, uint16_t n, float fs, float f_lo, float f_hi, float phase_deg);
+
+class AudioFilterHilbertIQ_F32 : public AudioStream_F32
+{
+//GUI: inputs:2, outputs:2  //this line used for automatic generation of GUI node
+//GUI: shortName:HilbertIQ
+  public:
+    AudioFilterHilbertIQ_F32(void) : AudioStream_F32(2, inputQueueArray)
+    {
+        n_taps = 0; sideband = 0; sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+    }
+    AudioFilterHilbertIQ_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+    {
+        n_taps = 0; sideband = 0; sample_rate_Hz = settings.sample_rate_Hz;
+    }
+
+    void     begin(const float *plus45, uint16_t n);   // n odd, up to HILBERT_IQ_MAX_TAPS.  Other lengths pass audio through.
+    void     design(float f_lo, float f_hi, uint16_t n = 0);  // passband -6dB edges in Hz.  0 taps for the default.
+    void     setSideband(int8_t sb) { sideband = (sb > 0) ? 1 : (sb < 0) ? -1 : 0; }   // +1 = USB sum, -1 = LSB sum, 0 = 2 outputs
+    uint16_t getMultiplies(void)    { return n_e + n_o; }  // per output sample of 1 filter, was n_taps
+    float    getRate(void)          { return sample_rate_Hz; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+    uint16_t    n_taps;                         // 0 = not set up, pass through
+    uint16_t    n_e, n_o;                       // non zero folded taps in each half
+    int8_t      sideband;
+    float       sample_rate_Hz;
+    uint16_t    e_k[HILBERT_IQ_MAX_TAPS/2+1];   // tap index from the newest sample, the pair is at n_taps-1-k
+    float       e_c[HILBERT_IQ_MAX_TAPS/2+1];
+    uint16_t    o_k[HILBERT_IQ_MAX_TAPS/2];
+    float       o_c[HILBERT_IQ_MAX_TAPS/2];
+    float       hist0[HILBERT_IQ_HIST];         // last n_taps-1 samples then the new block
+    float       hist1[HILBERT_IQ_HIST];
+    float       work_a[HILBERT_IQ_HIST];        // sideband sum and difference
+    float       work_b[HILBERT_IQ_HIST];
+    float       sum_e[AUDIO_BLOCK_SAMPLES];     // output of each half before they are combined
+    float       sum_o[AUDIO_BLOCK_SAMPLES];
+
+    void        fold_e(const float *x, uint16_t n, float *y);
+    void        fold_o(const float *x, uint16_t n, float *y);
+};
+#endif  // _AUDIO_FILTER_HILBERT_IQ_F32_H_
@@ -0,0 +1,368 @@
+//
+//    AudioGraph.cpp
+//
+//  Graph pruning by mode.  See AudioGraph.h
+//
+#include "SDR_RA8875.h"
+#include "RadioConfig.h"
+#include "AudioGraph.h"
+
+extern struct Audio_Group   audio_groups[GRAPH_STATES];
+
+static uint8_t  graph_state = GRAPH_RX;
+static float    graph_cpu[GRAPH_STATES];        // last reading in each state, for comparing builds with and without pruning
+static float    graph_cpu_max[GRAPH_STATES];
+
+//
+//  The audio library keeps the run flag and the input queues protected.  Pointers to members taken through a derived
+//  class reach them on any F32 object.  Never instantiated.
+//
+class AudioGraph_Access : public AudioStream_F32
+{
+  public:
+    static void set(AudioStream_F32 *node, bool on)
+    {
+        bool AudioStream::*active = &AudioGraph_Access::active;
+        unsigned char AudioStream_F32::*n_in = &AudioGraph_Access::num_inputs_f32;
+        audio_block_f32_t *(AudioStream_F32::*receive)(unsigned int) = &AudioGraph_Access::receiveReadOnly_f32;
+
+        node->*active = on;
+        // A stopped node still gets 1 block per input from running nodes upstream.  Drop it now so the pool gets it
+        // back on the way down, and so stale audio is not played on the way up.
+        for (unsigned int i = 0; i < node->*n_in; i++)
+        {
+            audio_block_f32_t *block = (node->*receive)(i);
+            if (block)
+                release(block);
+        }
+    }
+};
+
+void Audio_Set_Active(AudioStream_F32 *node, bool on)
+{
+    AudioNoInterrupts();
+    AudioGraph_Access::set(node, on);
+    AudioInterrupts();
+}
+
+//
+//  Stop every group but the one for state, then start that one.  A node in more than 1 group runs if any of them is
+//  selected.  Without USE_GRAPH_PRUNING everything keeps running, the state is only tracked for Audio_Graph_Print().
+//
+COLD void Audio_Graph_Select(uint8_t state)
+{
+    if (state >= GRAPH_STATES)
+        return;
+    graph_state = state;
+    #ifdef USE_GRAPH_PRUNING
+    for (uint8_t g = 0; g < GRAPH_STATES; g++)
+    {
+        if (g == state)
+            continue;
+        for (uint8_t i = 0; i < audio_groups[g].count; i++)
+            Audio_Set_Active(audio_groups[g].nodes[i], false);
+    }
+    for (uint8_t i = 0; i < audio_groups[state].count; i++)
+        Audio_Set_Active(audio_groups[state].nodes[i], true);
+    #endif
+    AudioProcessorUsageMaxReset();  // so the peak shown is for this state
+}
+
+uint8_t Audio_Graph_State(void)
+{
+    return graph_state;
+}
+
+// True if the node at audio_groups[g].nodes[i] is also listed in an earlier spot
+static bool _listed_before(uint8_t g, uint8_t i)
+{
+    AudioStream_F32 *node = audio_groups[g].nodes[i];
+
+    for (uint8_t h = 0; h <= g; h++)
+        for (uint8_t j = 0; j < ((h == g) ? i : audio_groups[h].count); j++)
+            if (audio_groups[h].nodes[j] == node)
+                return true;
+    return false;
+}
+
+COLD void Audio_Graph_Print(void)
+{
+    uint8_t stopped = 0;
+
+    for (uint8_t g = 0; g < GRAPH_STATES; g++)
+        for (uint8_t i = 0; i < audio_groups[g].count; i++)
+            if (!audio_groups[g].nodes[i]->isActive() && !_listed_before(g, i))
+                stopped++;
+    graph_cpu[graph_state] = AudioProcessorUsage();
+    if (AudioProcessorUsageMax() > graph_cpu_max[graph_state])
+        graph_cpu_max[graph_state] = AudioProcessorUsageMax();
+
+    #ifdef USE_GRAPH_PRUNING
+    DPRINT(F("Audio Graph: ")); DPRINT(audio_groups[graph_state].name); DPRINT(F("  Nodes stopped: ")); DPRINTLN(stopped);
+    #else
+    DPRINT(F("Audio Graph: ")); DPRINT(audio_groups[graph_state].name); DPRINTLN(F("  Pruning off"));
+    #endif
+    DPRINT(F(" CPU Cur/Peak by state:"));
+    for (uint8_t g = 0; g < GRAPH_STATES; g++)
+    {
+        DPRINT(F("  ")); DPRINT(audio_groups[g].name); DPRINT(F(" "));
+        DPRINT(graph_cpu[g]); DPRINT(F("%/")); DPRINT(graph_cpu_max[g]); DPRINT(F("%"));
+    }
+    DPRINTLN();
+}
+
+//----------------------------------------- Update order ---------------------------------------------------------------
+//
+//  The update list and the destination lists are private to the audio library.  An explicit template instantiation
+//  may name private members, so each _Graph_Rob below hands back a pointer to 1 of them through a friend function.
+//  The connections keep their destination protected, so _Cord and _Cord_F32 read it from a derived class.  It is a
+//  reference in the cores copy in Libraries/ and a pointer in newer Teensyduino, _cord_to() takes either.  Only used
+//  at setup time.
+//
+template <typename Tag, typename Tag::type M>
+struct _Graph_Rob { friend typename Tag::type _graph_get(Tag) { return M; } };
+
+struct _First_Update  { typedef AudioStream **type;                               friend type _graph_get(_First_Update); };
+struct _Next_Update   { typedef AudioStream *AudioStream::*type;                  friend type _graph_get(_Next_Update); };
+struct _Dest_List     { typedef AudioConnection *AudioStream::*type;              friend type _graph_get(_Dest_List); };
+struct _Dest_List_F32 { typedef AudioConnection_F32 *AudioStream_F32::*type;      friend type _graph_get(_Dest_List_F32); };
+
+template struct _Graph_Rob<_First_Update,  &AudioStream::first_update>;
+template struct _Graph_Rob<_Next_Update,   &AudioStream::next_update>;
+template struct _Graph_Rob<_Dest_List,     &AudioStream::destination_list>;
+template struct _Graph_Rob<_Dest_List_F32, &AudioStream_F32::destination_list_f32>;
+
+template <typename T> static inline T *_cord_to(T &dst) { return &dst; }
+template <typename T> static inline T *_cord_to(T *dst) { return dst; }
+
+class _Cord : public AudioConnection
+{
+  public:
+    AudioStream         *to(void)   { return _cord_to(dst); }
+    AudioConnection     *next(void) { return next_dest; }
+};
+
+class _Cord_F32 : public AudioConnection_F32
+{
+  public:
+    AudioStream_F32     *to(void)   { return _cord_to(dst); }
+    AudioConnection_F32 *next(void) { return next_dest; }
+};
+
+extern struct Audio_Node    audio_nodes[];
+extern uint8_t              audio_nodes_count;
+extern float                sample_rate_Hz;
+
+// Update list and its connections as indexes into it
+static AudioStream *g_node[GRAPH_MAX_NODES];
+static uint8_t      g_from[GRAPH_MAX_EDGES];
+static uint8_t      g_to[GRAPH_MAX_EDGES];
+static uint8_t      g_n, g_e;
+
+static int16_t _node_index(AudioStream *p)
+{
+    for (uint8_t i = 0; i < g_n; i++)
+        if (g_node[i] == p)
+            return i;
+    return -1;
+}
+
+static const Audio_Node *_node_info(AudioStream *p)
+{
+    for (uint8_t i = 0; i < audio_nodes_count; i++)
+        if (audio_nodes[i].node == p)
+            return &audio_nodes[i];
+    return NULL;
+}
+
+const char *Audio_Graph_Name(AudioStream *p)
+{
+    const Audio_Node *info = _node_info(p);
+    return (info) ? info->name : "(not in audio_nodes[])";
+}
+
+static void _add_edge(uint8_t from, AudioStream *to)
+{
+    int16_t j = _node_index(to);
+
+    if (j >= 0 && g_e < GRAPH_MAX_EDGES)
+    {
+        g_from[g_e] = from;
+        g_to[g_e]   = j;
+        g_e++;
+    }
+}
+
+// Read the update list and every connection out of it.  Objects not in audio_nodes[] only have their 16 bit outputs seen.
+static void _graph_load(void)
+{
+    g_n = 0;
+    g_e = 0;
+    for (AudioStream *p = *_graph_get(_First_Update()); p && g_n < GRAPH_MAX_NODES; p = p->*_graph_get(_Next_Update()))
+        g_node[g_n++] = p;
+    for (uint8_t i = 0; i < g_n; i++)
+    {
+        for (AudioConnection *c = g_node[i]->*_graph_get(_Dest_List()); c; c = ((_Cord *) c)->next())
+            _add_edge(i, ((_Cord *) c)->to());
+        const Audio_Node *info = _node_info(g_node[i]);
+        if (info && info->f32)
+        {
+            AudioStream_F32 *p = (AudioStream_F32 *) g_node[i];
+            for (AudioConnection_F32 *c = p->*_graph_get(_Dest_List_F32()); c; c = ((_Cord_F32 *) c)->next())
+                _add_edge(i, ((_Cord_F32 *) c)->to());
+        }
+    }
+}
+
+//
+//  Kahn's sort.  Of the nodes with all their inputs placed the earliest constructed goes next, so unrelated objects
+//  keep their order.  If none is ready the rest are on or after a cycle: the one with the most inputs already placed is
+//  where the cycle is entered, it is placed anyway and counted.
+//
+static uint8_t _graph_topo(uint8_t *order)
+{
+    uint8_t indeg[GRAPH_MAX_NODES] = {0};
+    uint8_t ready[GRAPH_MAX_NODES] = {0};     // inputs already placed
+    bool    placed[GRAPH_MAX_NODES] = {false};
+    uint8_t cycles = 0;
+
+    for (uint8_t e = 0; e < g_e; e++)
+        indeg[g_to[e]]++;
+    for (uint8_t k = 0; k < g_n; k++)
+    {
+        int16_t next = -1;
+        for (uint8_t i = 0; i < g_n && next < 0; i++)
+            if (!placed[i] && indeg[i] == 0)
+                next = i;
+        if (next < 0)
+        {
+            uint8_t most = 0;
+            for (uint8_t i = 0; i < g_n; i++)
+                if (!placed[i] && (next < 0 || ready[i] > most))
+                {
+                    next = i;
+                    most = ready[i];
+                }
+            DPRINT(F("Audio Graph: cycle through ")); DPRINTLN(Audio_Graph_Name(g_node[next]));
+            cycles++;
+        }
+        placed[next] = true;
+        order[k] = next;
+        for (uint8_t e = 0; e < g_e; e++)
+            if (g_from[e] == next && indeg[g_to[e]])
+            {
+                indeg[g_to[e]]--;
+                ready[g_to[e]]++;
+            }
+    }
+    return cycles;
+}
+
+COLD uint8_t Audio_Graph_Sort(void)
+{
+    uint8_t order[GRAPH_MAX_NODES];
+
+    _graph_load();
+    if (g_n == 0)
+        return 0;
+    uint8_t cycles = _graph_topo(order);
+
+    AudioNoInterrupts();
+    *_graph_get(_First_Update()) = g_node[order[0]];
+    for (uint8_t k = 0; k < g_n; k++)
+        g_node[order[k]]->*_graph_get(_Next_Update()) = (k+1 < g_n) ? g_node[order[k+1]] : NULL;
+    AudioInterrupts();
+
+    DPRINT(F("Audio Graph: ")); DPRINT(g_n); DPRINT(F(" objects, ")); DPRINT(g_e); DPRINT(F(" connections sorted"));
+    if (cycles)
+    {
+        DPRINT(F(", ")); DPRINT(cycles); DPRINT(F(" cycle(s) left 1 block late"));
+    }
+    DPRINTLN();
+    return cycles;
+}
+
+//
+//  Copy the update list, in the order the audio interrupt runs it, into list.  Returns how many.
+//
+uint8_t Audio_Graph_List(AudioStream **list, uint8_t max)
+{
+    uint8_t n = 0;
+
+    for (AudioStream *p = *_graph_get(_First_Update()); p && n < max; p = p->*_graph_get(_Next_Update()))
+        list[n++] = p;
+    return n;
+}
+
+//
+//  Move node to the end of the update list so it runs after every other object in the audio interrupt
+//
+COLD void Audio_Graph_Move_Last(AudioStream *node)
+{
+    AudioStream **p = _graph_get(_First_Update());
+
+    AudioNoInterrupts();
+    while (*p && *p != node)
+        p = &((*p)->*_graph_get(_Next_Update()));
+    if (*p)
+    {
+        *p = node->*_graph_get(_Next_Update());
+        while (*p)
+            p = &((*p)->*_graph_get(_Next_Update()));
+        *p = node;
+        node->*_graph_get(_Next_Update()) = NULL;
+    }
+    AudioInterrupts();
+}
+
+//
+//  Longest path from in to out counting 1 block for every connection that goes backwards in the update order, plus
+//  the 2 blocks the I2S input and output DMA always take.  Block delays inside objects (FFT frames, resamplers,
+//  look-ahead) are not counted.
+//
+COLD void Audio_Graph_Print_Order(AudioStream *in, AudioStream *out)
+{
+    uint8_t order[GRAPH_MAX_NODES];
+    int16_t dist[GRAPH_MAX_NODES];
+    uint8_t late = 0;
+
+    _graph_load();
+    _graph_topo(order);
+    DPRINTLN(F("Audio update order:"));
+    for (uint8_t i = 0; i < g_n; i++)
+    {
+        DPRINT(F("  ")); DPRINT(i); DPRINT(F(" ")); DPRINTLN(Audio_Graph_Name(g_node[i]));
+        dist[i] = -1;
+    }
+    for (uint8_t e = 0; e < g_e; e++)
+        if (g_from[e] >= g_to[e])
+            late++;
+
+    int16_t a = _node_index(in);
+    int16_t b = _node_index(out);
+    if (a < 0 || b < 0)
+        return;
+    dist[a] = 0;
+    for (uint8_t k = 0; k < g_n; k++)
+    {
+        uint8_t u = order[k];
+        if (dist[u] < 0)
+            continue;
+        for (uint8_t e = 0; e < g_e; e++)
+        {
+            if (g_from[e] != u)
+                continue;
+            int16_t d = dist[u] + ((g_to[e] > u) ? 0 : 1);
+            if (d > dist[g_to[e]])
+                dist[g_to[e]] = d;
+        }
+    }
+    DPRINT(F("Connections running 1 block late: ")); DPRINTLN(late);
+    if (dist[b] < 0)
+    {
+        DPRINTLN(F("No path from input to output"));
+        return;
+    }
+    DPRINT(F("I2S in to out: ")); DPRINT(dist[b] + 2); DPRINT(F(" blocks, "));
+    DPRINT((dist[b] + 2) * AUDIO_BLOCK_SAMPLES * 1000.0f / sample_rate_Hz); DPRINTLN(F("ms"));
+}
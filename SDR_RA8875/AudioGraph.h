@@ -0,0 +1,49 @@
+#ifndef _AUDIO_GRAPH_H_
+#define _AUDIO_GRAPH_H_
+//
+//    AudioGraph.h
+//
+//  Turns groups of audio objects on and off with the mode.  The audio library only calls update() on objects that are
+//  active, and an object that is not running sends nothing so mixers and switches downstream see a silent input.
+//  The node groups are set up in SDR_RA8875.ino next to the objects.
+//
+//  The library runs objects in the order they were constructed.  An object that runs before the one feeding it gets
+//  that block on the next update, 1 block late.  Audio_Graph_Sort() puts the update list in data flow order once all
+//  the objects and connections exist.  It needs the audio_nodes[] table in SDR_RA8875.ino to tell F32 objects from
+//  16 bit ones and to print names.
+//
+#include <Arduino.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+// Graph states, index to the node groups
+#define GRAPH_RX        0       // SSB, CW, AM and Data receive
+#define GRAPH_FM        1       // FM receive
+#define GRAPH_TX        2
+#define GRAPH_STATES    3
+
+#define GRAPH_MAX_NODES 128
+#define GRAPH_MAX_EDGES 255
+
+struct Audio_Node {
+    AudioStream             *node;
+    const char              *name;
+    bool                     f32;           // AudioStream_F32, has F32 outputs
+};
+
+struct Audio_Group {
+    const char              *name;
+    AudioStream_F32 * const *nodes;
+    uint8_t                  count;
+};
+
+void    Audio_Set_Active(AudioStream_F32 *node, bool on);   // Also drops any blocks waiting at its inputs
+void    Audio_Graph_Select(uint8_t state);                  // Runs the group for state, stops the others
+uint8_t Audio_Graph_State(void);
+void    Audio_Graph_Print(void);                            // State, nodes stopped and the CPU seen in each state
+uint8_t Audio_Graph_Sort(void);                             // Update list in data flow order.  Reports and returns cycles.
+void    Audio_Graph_Print_Order(AudioStream *in, AudioStream *out); // Update order and blocks of latency from in to out
+uint8_t Audio_Graph_List(AudioStream **list, uint8_t max);  // Update list in run order
+void    Audio_Graph_Move_Last(AudioStream *node);           // Run node after all the others
+const char *Audio_Graph_Name(AudioStream *node);            // Name in audio_nodes[]
+
+#endif  // _AUDIO_GRAPH_H_
@@ -0,0 +1,137 @@
+//
+// AudioIQCorrect_F32.cpp
+//
+// See AudioIQCorrect_F32.h
+//
+#include "AudioIQCorrect_F32.h"
+
+void AudioIQCorrect_F32::reset(void)
+{
+    AudioNoInterrupts();
+    c1     = 0.0f;
+    c2     = 1.0f;
+    teta1  = teta2 = teta3 = 0.0f;
+    out_ii = out_qq = out_iq = 0.0f;
+    primed = false;
+    AudioInterrupts();
+}
+
+float AudioIQCorrect_F32::getGain(void)
+{
+    return sqrtf(c1*c1 + c2*c2);
+}
+
+float AudioIQCorrect_F32::getPhase(void)
+{
+    return atan2f(-c1, c2) * 180.0f / PI;
+}
+
+// z = I + jQ = s (1 + g e^(j phi))/2 + conj(s) (1 - g e^(-j phi))/2, the image is the conj(s) part
+float AudioIQCorrect_F32::getInputIRR(void)
+{
+    float g2    = c1*c1 + c2*c2;
+    float image = 1.0f - 2.0f*c2 + g2;
+
+    if (image <= 0.0f)
+        return IQ_CORRECT_MAX_IRR_DB;
+    return fminf(IQ_CORRECT_MAX_IRR_DB, 10.0f * log10f((1.0f + 2.0f*c2 + g2) / image));
+}
+
+// With z = a s + b conj(s), |E[z*z]| / E[|z|^2] = 2r / (1 + r^2) for r = |b/a|, the image to wanted amplitude
+float AudioIQCorrect_F32::getOutputIRR(void)
+{
+    float power = out_ii + out_qq;
+    float rho;
+
+    if (power <= 0.0f)
+        return 0.0f;
+    rho = sqrtf((out_ii - out_qq)*(out_ii - out_qq) + 4.0f*out_iq*out_iq) / power;
+    if (rho < 1.0e-5f)
+        return IQ_CORRECT_MAX_IRR_DB;
+    if (rho > 1.0f)
+        rho = 1.0f;
+    return fminf(IQ_CORRECT_MAX_IRR_DB, -20.0f * log10f((1.0f - sqrtf(1.0f - rho*rho)) / rho));
+}
+
+void AudioIQCorrect_F32::update(void)
+{
+    audio_block_f32_t *in_i, *in_q, *out_i, *out_q;
+    float s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    float ii = 0.0f, qq = 0.0f, iq = 0.0f;
+    float k1 = enabled ? c1 : 0.0f;
+    float k2 = enabled ? c2 : 1.0f;
+
+    in_i = receiveReadOnly_f32(0);
+    in_q = receiveReadOnly_f32(1);
+    if (!in_i || !in_q)
+    {
+        if (in_i) release(in_i);
+        if (in_q) release(in_q);
+        return;
+    }
+    out_i = allocate_f32();
+    out_q = allocate_f32();
+    if (!out_i || !out_q)
+    {
+        if (out_i) release(out_i);
+        if (out_q) release(out_q);
+        release(in_i);
+        release(in_q);
+        return;
+    }
+    for (uint16_t n = 0; n < AUDIO_BLOCK_SAMPLES; n++)
+    {
+        float i = in_i->data[n];
+        float q = in_q->data[n];
+
+        s1 += (i < 0.0f) ? -q : q;      // sign(I)*Q
+        s2 += fabsf(i);                 // sign(I)*I
+        s3 += fabsf(q);                 // sign(Q)*Q
+        float oi = k2 * i;
+        float oq = q + k1 * i;
+        out_i->data[n] = oi;
+        out_q->data[n] = oq;
+        ii += oi * oi;
+        qq += oq * oq;
+        iq += oi * oq;
+    }
+    out_i->length = AUDIO_BLOCK_SAMPLES;
+    out_q->length = AUDIO_BLOCK_SAMPLES;
+    transmit(out_i, 0);
+    transmit(out_q, 1);
+    release(out_i);
+    release(out_q);
+    release(in_i);
+    release(in_q);
+
+    if (!adapt)
+        return;
+    s1 *= -1.0f / AUDIO_BLOCK_SAMPLES;
+    s2 *=  1.0f / AUDIO_BLOCK_SAMPLES;
+    s3 *=  1.0f / AUDIO_BLOCK_SAMPLES;
+    ii *=  1.0f / AUDIO_BLOCK_SAMPLES;
+    qq *=  1.0f / AUDIO_BLOCK_SAMPLES;
+    iq *=  1.0f / AUDIO_BLOCK_SAMPLES;
+    if (!primed)
+    {
+        teta1  = s1;  teta2  = s2;  teta3  = s3;
+        out_ii = ii;  out_qq = qq;  out_iq = iq;
+        primed = true;
+    }
+    else
+    {
+        teta1  += alpha * (s1 - teta1);
+        teta2  += alpha * (s2 - teta2);
+        teta3  += alpha * (s3 - teta3);
+        out_ii += alpha * (ii - out_ii);
+        out_qq += alpha * (qq - out_qq);
+        out_iq += alpha * (iq - out_iq);
+    }
+    // No signal, or Q much smaller than the phase term says it should be:  keep the last correction
+    float c2sq = teta3*teta3 - teta1*teta1;
+    if (teta2 > 1.0e-9f && c2sq > 0.0f)
+    {
+        c1 = teta1 / teta2;
+        c2 = sqrtf(c2sq) / teta2;
+    }
+}
@@ -0,0 +1,78 @@
+//
+// AudioIQCorrect_F32.h
+//
+// Blind adaptive I/Q gain and phase correction.  A gain or phase error between I and Q leaves an image of every signal
+// mirrored around the LO, on the spectrum and in the opposite sideband.  Nothing has to be injected to measure it: the
+// radio's input is circular on average (a signal is as likely at any phase), so any difference in the size of I and Q
+// or any correlation between them is the error.  This is the Moseley and Slump estimator.  With
+//      I = cos(t), Q = g sin(t + phi)
+// the block averages of sign(I)*Q, sign(I)*I and sign(Q)*Q give
+//      c1 = -g sin(phi)    c2 = g cos(phi)
+// and I' = c2 I, Q' = Q + c1 I puts I and Q back at the same size and 90 degrees apart.  The averages are smoothed over
+// the time constant, so it converges in the background and follows drift with temperature and band changes.  Cost is
+// 3 multiply-adds for the estimate and 2 for the correction per sample pair, plus 3 for the output image rejection.
+//
+// Image rejection ratio (IRR) is reported 2 ways for checking in the field:
+//      getInputIRR()   - what the hardware gives, from g and phi
+//      getOutputIRR()  - what is left after the correction, measured on the output.  Read from |E[z*z]| / E[|z|^2] of
+//                        z = I + jQ, which is 0 for a balanced pair.  Noise in the estimate limits it to about 50dB
+//                        with the default time constant.
+//
+// Only a gain and phase the same at every frequency is corrected.  An I2S slip between the channels (a whole sample
+// delay, the Twin Peaks problem) is a phase error that grows with frequency, that is for AudioAlignLR_F32 ahead of this.
+// A DC offset on the input biases the estimate, so it should be small next to the signals.
+//
+// Input 0 is I and input 1 is Q, output 0 and 1 the same.  setAdapt(false) holds the correction (TX, when the input is
+// the mic).  enable(false) passes the input through and keeps adapting, to compare with and without.
+//
+#ifndef _AUDIO_IQ_CORRECT_F32_H_
+#define _AUDIO_IQ_CORRECT_F32_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define IQ_CORRECT_TAU_S        1.0f    // default time constant of the averages in seconds
+#define IQ_CORRECT_MAX_IRR_DB   99.0f   // reported for a perfect pair
+
+class AudioIQCorrect_F32 : public AudioStream_F32
+{
+//GUI: inputs:2, outputs:2  //this line used for automatic generation of GUI node
+//GUI: shortName:IQCorrect
+  public:
+    AudioIQCorrect_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+    {
+        sample_rate_Hz = settings.sample_rate_Hz;
+        tau_s          = IQ_CORRECT_TAU_S;
+        enabled        = true;
+        adapt          = true;
+        setAlpha();
+        reset();
+    }
+    void    enable(bool on)                 { enabled = on; }
+    bool    isEnabled(void)                 { return enabled; }
+    void    setAdapt(bool on)               { adapt = on; }     // false holds c1 and c2 and the IRR averages
+    void    setTimeConstant(float seconds)  { tau_s = seconds; setAlpha(); }
+    void    setSampleRate(float fs)         { sample_rate_Hz = fs; setAlpha(); }
+    void    reset(void);                    // back to no correction and start the averages again
+    float   getGain(void);                  // g, Q over I
+    float   getPhase(void);                 // phi in degrees, Q less 90 degrees from I
+    float   getInputIRR(void);              // dB
+    float   getOutputIRR(void);             // dB
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+    float   sample_rate_Hz;
+    float   tau_s;
+    float   alpha;                          // per block weight of the new averages
+    bool    enabled;
+    bool    adapt;
+    float   c1, c2;                         // correction, 0 and 1 do nothing
+    float   teta1, teta2, teta3;            // smoothed -sign(I)*Q, sign(I)*I, sign(Q)*Q
+    float   out_ii, out_qq, out_iq;         // smoothed output I*I, Q*Q, I*Q
+    bool    primed;                         // the averages have a first block in them
+
+    void    setAlpha(void)  { alpha = fminf(1.0f, AUDIO_BLOCK_SAMPLES / (sample_rate_Hz * tau_s)); }
+};
+#endif  // _AUDIO_IQ_CORRECT_F32_H_
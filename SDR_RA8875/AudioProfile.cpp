@@ -0,0 +1,256 @@
+//
+//    AudioProfile.cpp
+//
+//  Per object CPU time for the audio graph.  See AudioProfile.h
+//
+#include "SDR_RA8875.h"
+#include "RadioConfig.h"
+#include "AudioGraph.h"
+#include "AudioProfile.h"
+
+struct Profile_Node {
+    AudioStream *node;                  // NULL for the whole interrupt
+    uint32_t     blocks;                // blocks it ran in
+    uint64_t     sum;                   // cpu_cycles units, 64 CPU clocks
+    uint64_t     ready_sum;
+    uint16_t     max;
+    uint32_t     ready_max;
+    uint32_t     hist[PROFILE_BINS];
+};
+
+// The whole audio interrupt, from AudioStream::cpu_cycles_total of the interrupt before.  Each time the library keeps is
+// rounded down to 64 cycles, so each one gets half a unit back and the rounding does not read as scheduler time.
+struct Profile_Interrupt {
+    uint32_t blocks;
+    uint64_t total;                     // cpu_cycles units
+    uint64_t objects;                   // half cpu_cycles units
+    uint64_t self;                      // this profiler, cpu_cycles units
+};
+
+extern float    sample_rate_Hz;
+
+DMAMEM static Profile_Node prof[GRAPH_MAX_NODES + 1];   // the update list then the total
+static Profile_Interrupt   prof_isr;
+static uint8_t  prof_n;
+static uint32_t prof_mhz;
+static uint32_t prof_last_ready;        // objects in the last interrupt, 0 before the first one
+static uint8_t  prof_last_active;
+
+static inline void _profile_add(Profile_Node *p, uint32_t c, uint32_t ready)
+{
+    uint32_t us = c * 64 / prof_mhz;
+    uint8_t  bin = (us) ? 32 - __builtin_clz(us) : 0;
+
+    p->blocks++;
+    p->sum       += c;
+    p->ready_sum += ready;
+    if (c > p->max)
+        p->max = c;
+    if (ready > p->ready_max)
+        p->ready_max = ready;
+    p->hist[(bin < PROFILE_BINS) ? bin : PROFILE_BINS - 1]++;
+}
+
+//
+//  Runs last in every audio interrupt while profiling.  cpu_cycles of each object is from this interrupt.
+//
+class AudioProfile_F32 : public AudioStream_F32
+{
+  public:
+    AudioProfile_F32(void) : AudioStream_F32(0, NULL) {}
+    virtual void update(void)
+    {
+        uint32_t ready = 0;
+        uint8_t  active = 0;
+
+        for (uint8_t i = 0; i < prof_n; i++)
+        {
+            if (!prof[i].node->isActive())
+                continue;
+            ready += prof[i].node->cpu_cycles;
+            active++;
+            _profile_add(&prof[i], prof[i].node->cpu_cycles, ready);
+        }
+        _profile_add(&prof[prof_n], ready, ready);
+        if (prof_last_active)   // the interrupt before had this profiler in it
+        {
+            prof_isr.blocks++;
+            prof_isr.total   += AudioStream::cpu_cycles_total;
+            prof_isr.objects += 2 * prof_last_ready + prof_last_active;
+            prof_isr.self    += cpu_cycles;
+        }
+        prof_last_ready  = ready;
+        prof_last_active = active;
+    }
+};
+
+static AudioProfile_F32 profiler;
+
+COLD void Audio_Profile_Start(void)
+{
+    AudioStream *list[GRAPH_MAX_NODES];
+
+    Audio_Set_Active(&profiler, false);
+    Audio_Graph_Move_Last(&profiler);
+    uint8_t n = Audio_Graph_List(list, GRAPH_MAX_NODES);
+    memset(prof, 0, sizeof(prof));
+    memset(&prof_isr, 0, sizeof(prof_isr));
+    prof_last_ready  = 0;
+    prof_last_active = 0;
+    prof_n = 0;
+    for (uint8_t i = 0; i < n; i++)
+        if (list[i] != &profiler)
+            prof[prof_n++].node = list[i];
+    prof_mhz = F_CPU_ACTUAL / 1000000;
+    Audio_Set_Active(&profiler, true);
+}
+
+COLD void Audio_Profile_Stop(void)
+{
+    Audio_Set_Active(&profiler, false);
+}
+
+bool Audio_Profile_Running(void)
+{
+    return profiler.isActive();
+}
+
+static const char *_profile_name(uint8_t i)
+{
+    return (prof[i].node) ? Audio_Graph_Name(prof[i].node) : "(audio interrupt)";
+}
+
+// Copy of node i taken between audio interrupts
+static void _profile_get(uint8_t i, Profile_Node *p)
+{
+    AudioNoInterrupts();
+    *p = prof[i];
+    AudioInterrupts();
+}
+
+// cpu_cycles units to 0.1us, held to 16 bits
+static uint16_t _profile_tenths(uint64_t c, uint32_t blocks)
+{
+    uint64_t t = (blocks) ? c * 640 / ((uint64_t) prof_mhz * blocks) : 0;
+    return (t > 0xFFFF) ? 0xFFFF : (uint16_t) t;
+}
+
+COLD void Audio_Profile_Interrupt(float *interrupt_us, float *objects_us, float *scheduler_us)
+{
+    Profile_Interrupt p;
+
+    AudioNoInterrupts();
+    p = prof_isr;
+    AudioInterrupts();
+    if (p.blocks == 0 || prof_mhz == 0)
+    {
+        *interrupt_us = *objects_us = *scheduler_us = 0.0f;
+        return;
+    }
+    float us = 64.0f / prof_mhz / p.blocks;     // cpu_cycles units to average us
+    *interrupt_us = (p.total + 0.5f * p.blocks) * us;
+    *objects_us   = p.objects * 0.5f * us;
+    *scheduler_us = *interrupt_us - *objects_us - (p.self + 0.5f * p.blocks) * us;
+}
+
+// Node indexes sorted by name, the total last
+static void _profile_sort(uint8_t *order)
+{
+    for (uint8_t i = 0; i < prof_n; i++)
+    {
+        uint8_t j = i;
+        for ( ; j > 0 && strcmp(_profile_name(order[j-1]), _profile_name(i)) > 0; j--)
+            order[j] = order[j-1];
+        order[j] = i;
+    }
+    order[prof_n] = prof_n;
+}
+
+COLD void Audio_Profile_Print(void)
+{
+    uint8_t      order[GRAPH_MAX_NODES + 1];
+    Profile_Node p;
+    char         line[64];
+
+    if (prof_mhz == 0)
+    {
+        DPRINTLN(F("Audio profile: not started"));
+        return;
+    }
+    _profile_get(prof_n, &p);
+    snprintf(line, sizeof(line), "%lu blocks at %lu MHz, %u us per block", (unsigned long) p.blocks,
+            (unsigned long) prof_mhz, (unsigned) (AUDIO_BLOCK_SAMPLES * 1000000.0f / sample_rate_Hz));
+    DPRINT(F("Audio profile: ")); DPRINTLN(line);
+    float isr_us, obj_us, sched_us;
+    Audio_Profile_Interrupt(&isr_us, &obj_us, &sched_us);
+    DPRINT(F("Per block: interrupt ")); DPRINT(isr_us, 1); DPRINT(F(" us, objects ")); DPRINT(obj_us, 1);
+    DPRINT(F(" us, scheduler ")); DPRINT(sched_us, 1); DPRINTLN(F(" us"));
+    // Histogram columns are % of blocks from each lower edge in us, for PROFILE_BINS 12
+    DPRINTLN(F("name                         avg us   max us  ready avg  ready max    <1   1   2   4   8  16  32  64 128 256 512 1k+"));
+    _profile_sort(order);
+    for (uint8_t k = 0; k <= prof_n; k++)
+    {
+        uint8_t i = order[k];
+        _profile_get(i, &p);
+        if (p.blocks == 0)      // never ran, stopped by the mode
+            continue;
+        uint16_t v[4] = {_profile_tenths(p.sum, p.blocks), _profile_tenths(p.max, 1),
+                         _profile_tenths(p.ready_sum, p.blocks), _profile_tenths(p.ready_max, 1)};
+        snprintf(line, sizeof(line), "%-26s", _profile_name(i));
+        DPRINT(line);
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            snprintf(line, sizeof(line), "%*u.%u", (j < 2) ? 7 : 9, v[j] / 10, v[j] % 10);
+            DPRINT(line);
+        }
+        DPRINT(F(" "));
+        for (uint8_t b = 0; b < PROFILE_BINS; b++)
+        {
+            snprintf(line, sizeof(line), "%4lu", (unsigned long) (p.hist[b] * 100ULL / p.blocks));
+            DPRINT(line);
+        }
+        DPRINTLN();
+    }
+}
+
+static void _profile_put(Print &port, uint32_t v, uint8_t bytes, uint8_t *sum)
+{
+    for (uint8_t i = 0; i < bytes; i++, v >>= 8)
+    {
+        port.write((uint8_t) v);
+        *sum += (uint8_t) v;
+    }
+}
+
+COLD void Audio_Profile_Write(Print &port)
+{
+    Profile_Node p;
+    uint8_t      sum = 0;
+
+    _profile_get(prof_n, &p);
+    _profile_put(port, 'A', 1, &sum);
+    _profile_put(port, 'P', 1, &sum);
+    _profile_put(port, PROFILE_VERSION, 1, &sum);
+    _profile_put(port, prof_n + 1, 1, &sum);
+    _profile_put(port, p.blocks, 4, &sum);
+    _profile_put(port, prof_mhz, 2, &sum);
+    _profile_put(port, (uint32_t) (AUDIO_BLOCK_SAMPLES * 1000000.0f / sample_rate_Hz), 2, &sum);
+    _profile_put(port, PROFILE_BINS, 1, &sum);
+    for (uint8_t i = 0; i <= prof_n; i++)
+    {
+        const char *name = _profile_name(i);
+        uint8_t     len  = strlen(name);
+
+        _profile_get(i, &p);
+        _profile_put(port, len, 1, &sum);
+        for (uint8_t j = 0; j < len; j++)
+            _profile_put(port, name[j], 1, &sum);
+        _profile_put(port, _profile_tenths(p.sum, p.blocks), 2, &sum);
+        _profile_put(port, _profile_tenths(p.max, 1), 2, &sum);
+        _profile_put(port, _profile_tenths(p.ready_sum, p.blocks), 2, &sum);
+        _profile_put(port, _profile_tenths(p.ready_max, 1), 2, &sum);
+        for (uint8_t b = 0; b < PROFILE_BINS; b++)
+            _profile_put(port, (p.blocks) ? p.hist[b] * 1000ULL / p.blocks : 0, 2, &sum);
+    }
+    port.write(sum);
+}
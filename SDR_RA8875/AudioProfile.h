@@ -0,0 +1,35 @@
+#ifndef _AUDIO_PROFILE_H_
+#define _AUDIO_PROFILE_H_
+//
+//    AudioProfile.h
+//
+//  Per object CPU time for the audio graph.  The audio library times every update() and keeps the last one in
+//  cpu_cycles.  While profiling, a small object with no connections runs last in each audio interrupt and adds that
+//  block's time for every running object to its average, maximum and a histogram.  It also adds up the times in update
+//  order, so each object gets the time after the start of the interrupt its output is ready (ready at).  That is the
+//  latency inside 1 block.  Block delays between objects are printed by Audio_Graph_Print_Order().
+//
+//  Names come from audio_nodes[] in SDR_RA8875.ino.  The text report is sorted by name with a fixed layout and no
+//  run length or time in the node lines, so 2 builds can be compared with diff.
+//
+//  Binary report, little endian:
+//      'A' 'P' version(1) nodes(1) blocks(4) cpu_MHz(2) block_us(2) bins(1)
+//      per node: name_len(1) name(name_len) avg max ready_avg ready_max(2 each, 0.1us) hist(2 per bin, 1/1000 of blocks)
+//      checksum(1), the 8 bit sum of every byte before it
+//
+#include <Arduino.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define PROFILE_VERSION     1
+#define PROFILE_BINS        12      // bin 0 is under 1us, bin n is 2^(n-1) to 2^n us, the last is everything above
+
+void    Audio_Profile_Start(void);          // Clear and start collecting
+void    Audio_Profile_Stop(void);
+bool    Audio_Profile_Running(void);
+void    Audio_Profile_Print(void);          // Text report on the debug port
+void    Audio_Profile_Write(Print &port);   // Binary report
+// Averages per block of the whole audio interrupt, the objects in it and the rest less the profiler:  walking the
+// update list and timing each object.  That rest is paid per block, so it goes up with smaller AUDIO_BLOCK_SAMPLES.
+void    Audio_Profile_Interrupt(float *interrupt_us, float *objects_us, float *scheduler_us);
+
+#endif  // _AUDIO_PROFILE_H_
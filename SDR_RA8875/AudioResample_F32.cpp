@@ -0,0 +1,216 @@
+//
+// AudioResample_F32.cpp
+//
+// Polyphase decimate and interpolate pair for the demodulated audio.  See AudioResample_F32.h
+//
+#include "AudioResample_F32.h"
+
+uint8_t Resample_Factor(float fs, float rate_Hz)
+{
+    uint8_t n = 1;
+
+    while (n < RESAMPLE_MAX_FACTOR && fs / (n*2) >= rate_Hz)
+        n *= 2;
+    return n;
+}
+
+uint16_t Resample_Block(uint8_t n)
+{
+    uint16_t len = AUDIO_BLOCK_SAMPLES / n;
+
+    while (len < RESAMPLE_MIN_BLOCK)
+        len *= 2;
+    return len;
+}
+
+//
+//  The alias (or image) of a signal at f lands at fs/n - f.  To keep 0 to passband_Hz clean the stopband has to start
+//  by fs/n - passband_Hz, so the cutoff sits at fs/n/2 and the transition is as wide as the passband allows.
+//  A Blackman window (about 74dB) needs about 5.5 * fs / transition taps.
+//
+uint16_t Resample_Design(float *coeffs, uint8_t n, float fs, float passband_Hz, float gain)
+{
+    float fs_low = fs / n;
+    float top    = passband_Hz;
+    float sum    = 0.0f;
+
+    if (top > 0.45f * fs_low)
+        top = 0.45f * fs_low;
+    if (top < 0.05f * fs_low)
+        top = 0.05f * fs_low;
+    float tw = fs_low - 2.0f * top;     // transition width
+
+    uint16_t per_phase = (uint16_t) ceilf(5.5f * fs / tw / n);
+    if (per_phase < RESAMPLE_MIN_TAPS_PER_PHASE)
+        per_phase = RESAMPLE_MIN_TAPS_PER_PHASE;
+    if (per_phase > RESAMPLE_MAX_TAPS_PER_PHASE)
+        per_phase = RESAMPLE_MAX_TAPS_PER_PHASE;
+    uint16_t taps = per_phase * n;
+
+    float fc  = 0.5f / n;               // cutoff, cycles per sample at fs
+    float mid = 0.5f * (taps - 1);
+    for (uint16_t k = 0; k < taps; k++)
+    {
+        float x = k - mid;
+        float h = (fabsf(x) < 1.0e-6f) ? 2.0f * fc : sinf(2.0f * PI * fc * x) / (PI * x);
+        h *= 0.42f - 0.5f * cosf(2.0f * PI * k / (taps-1)) + 0.08f * cosf(4.0f * PI * k / (taps-1));
+        coeffs[k] = h;
+        sum += h;
+    }
+    for (uint16_t k = 0; k < taps; k++)
+        coeffs[k] *= gain / sum;
+    return taps;
+}
+
+//---------------------------------------------- Decimator ---------------------------------------------------------
+
+void AudioFilterDecimate_F32::begin(uint8_t n, float passband_Hz, uint16_t block)
+{
+    if (n < 1) n = 1;
+    if (n > RESAMPLE_MAX_FACTOR) n = RESAMPLE_MAX_FACTOR;
+    uint16_t step = Resample_Block(n);
+    block -= block % step;
+    if (block < step) block = step;
+    if (block > AUDIO_BLOCK_SAMPLES) block = AUDIO_BLOCK_SAMPLES;
+    AudioNoInterrupts();
+    factor  = n;
+    out_len = (n > 1) ? block : AUDIO_BLOCK_SAMPLES;
+    if (n > 1)
+    {
+        n_taps = Resample_Design(coeffs, n, sample_rate_Hz, passband_Hz, 1.0f);
+        for (uint8_t c = 0; c < 2; c++)
+            arm_fir_decimate_init_f32(&fir[c], n_taps, n, coeffs, state[c], AUDIO_BLOCK_SAMPLES);
+    }
+    else
+        n_taps = 0;
+    out_count = 0;
+    AudioInterrupts();
+}
+
+void AudioFilterDecimate_F32::update(void)
+{
+    audio_block_f32_t *in[2];
+    uint8_t c;
+
+    in[0] = receiveReadOnly_f32(0);
+    in[1] = receiveReadOnly_f32(1);
+    if (!in[0])     // channel 1 only runs in step with channel 0
+    {
+        if (in[1])
+            release(in[1]);
+        return;
+    }
+    if (factor == 1)
+    {
+        for (c = 0; c < 2 && in[c]; c++)
+        {
+            transmit(in[c], c);
+            release(in[c]);
+        }
+        return;
+    }
+    // Blocks are always full length here, AUDIO_BLOCK_SAMPLES is a multiple of every factor
+    for (c = 0; c < 2 && in[c]; c++)
+    {
+        arm_fir_decimate_f32(&fir[c], in[c]->data, out_buf[c] + out_count, AUDIO_BLOCK_SAMPLES);
+        release(in[c]);
+    }
+    out_count += AUDIO_BLOCK_SAMPLES / factor;
+    if (out_count < out_len)
+        return;
+    out_count = 0;
+
+    for (c = 0; c < 2 && in[c]; c++)
+    {
+        audio_block_f32_t *out = allocate_f32();
+        if (!out)
+            return;
+        memcpy(out->data, out_buf[c], out_len * sizeof(float));
+        out->length = out_len;
+        transmit(out, c);
+        release(out);
+    }
+}
+
+//---------------------------------------------- Interpolator ------------------------------------------------------
+
+void AudioFilterInterpolate_F32::begin(uint8_t n, float passband_Hz)
+{
+    if (n < 1) n = 1;
+    if (n > RESAMPLE_MAX_FACTOR) n = RESAMPLE_MAX_FACTOR;
+    AudioNoInterrupts();
+    factor = n;
+    if (n > 1)
+    {
+        // Gain n makes up for the n-1 zeros between the low rate samples
+        n_taps = Resample_Design(coeffs, n, sample_rate_Hz, passband_Hz, (float) n);
+        for (uint8_t c = 0; c < 2; c++)
+            arm_fir_interpolate_init_f32(&fir[c], n, n_taps, coeffs, state[c], AUDIO_BLOCK_SAMPLES / n);
+    }
+    else
+        n_taps = 0;
+    q_count = 0;
+    q_rd    = 0;
+    running = false;
+    AudioInterrupts();
+}
+
+void AudioFilterInterpolate_F32::update(void)
+{
+    audio_block_f32_t *in[2];
+    uint16_t step = AUDIO_BLOCK_SAMPLES / factor;   // low rate samples per output block
+    uint8_t  c;
+
+    in[0] = receiveReadOnly_f32(0);
+    in[1] = receiveReadOnly_f32(1);
+    if (factor == 1)
+    {
+        for (c = 0; c < 2; c++)
+            if (in[c])
+            {
+                transmit(in[c], c);
+                release(in[c]);
+            }
+        return;
+    }
+    if (in[0])
+    {
+        uint16_t len = in[0]->length - in[0]->length % step;
+        if (q_rd)           // move what is left to the front
+        {
+            q_count -= q_rd;
+            for (c = 0; c < channels; c++)
+                memmove(q[c], q[c] + q_rd, q_count * sizeof(float));
+            q_rd = 0;
+        }
+        if (q_count + len <= 2 * AUDIO_BLOCK_SAMPLES)
+        {
+            channels = in[1] ? 2 : 1;
+            for (c = 0; c < channels; c++)
+                memcpy(q[c] + q_count, in[c]->data, len * sizeof(float));
+            q_count += len;
+            running  = true;
+        }
+        release(in[0]);     // else overrun, drop it
+    }
+    if (in[1])
+        release(in[1]);
+    if (!running || q_count - q_rd < step)
+    {
+        running = false;    // underrun, wait for a full block again
+        return;
+    }
+
+    for (c = 0; c < channels; c++)
+    {
+        audio_block_f32_t *out = allocate_f32();
+        if (out)
+        {
+            arm_fir_interpolate_f32(&fir[c], q[c] + q_rd, out->data, step);
+            out->length = AUDIO_BLOCK_SAMPLES;
+            transmit(out, c);
+            release(out);
+        }
+    }
+    q_rd += step;
+}
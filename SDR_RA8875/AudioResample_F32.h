@@ -0,0 +1,123 @@
+//
+// AudioResample_F32.h
+//
+// Decimate by N and interpolate by N pair for running the demodulated audio stages (notch, NR, bandwidth filter) at a
+// lower sample rate.  Both are polyphase FIR (CMSIS arm_fir_decimate_f32 and arm_fir_interpolate_f32) with a lowpass
+// designed for a passband: anything that would alias (or image) below that edge is removed, the rest of the band down
+// to fs/N is left for the bandwidth filter.  The radio designs them once per sample rate for the widest receive filter,
+// so a bandwidth change leaves them running.
+//
+// By default the decimator sends AUDIO_BLOCK_SAMPLES long blocks, 1 every N updates, so every object fed from it runs
+// 1 update in N.  Those samples wait up to N-1 updates for the block to fill, 8 ms from 48 kHz to 12 kHz.  begin() can
+// ask for shorter blocks instead, down to Resample_Block(N) which is 1 every update, and the objects after it then take
+// blocks of that length (the settings' audio_block_samples).  The interpolator takes blocks of any length that is a
+// whole number of its steps and sends 1 full rate block every update, using AUDIO_BLOCK_SAMPLES/N low rate samples
+// each time.  The audio update runs every object in a fixed order so the next block arrives as the last part is used.
+// If it does not the output stops until the next block.
+//
+// The objects between the 2 should be constructed with AudioSettings_F32 at the decimated rate (getRate()).
+//
+// Input and output 1 are optional.  A second signal (Q with I on channel 0) is filtered with the same coefficients and
+// kept in step with channel 0, so an IQ pair shares 1 object and stays aligned when begin() restarts it.  setSampleRate()
+// changes the full rate for a runtime sample rate change, it takes effect at the next begin().  begin() clears the
+// filter history and the queued samples, the interpolator then sends nothing until the next low rate block comes in.
+//
+#ifndef _AUDIO_RESAMPLE_F32_H_
+#define _AUDIO_RESAMPLE_F32_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include <OpenAudio_ArduinoLibrary.h> // F32 library located on GitHub. https://github.com/chipaudette/OpenAudio_ArduinoLibrary
+
+#define RESAMPLE_MAX_FACTOR         16      // 192KHz down to 12KHz
+#define RESAMPLE_MAX_TAPS_PER_PHASE 32      // Taps per output sample (decimator) or per input sample (interpolator)
+#define RESAMPLE_MIN_TAPS_PER_PHASE 4
+#define RESAMPLE_MIN_BLOCK          16      // shortest decimator output block, the FFT convolution's shortest partition
+#define RESAMPLE_MAX_TAPS           (RESAMPLE_MAX_FACTOR * RESAMPLE_MAX_TAPS_PER_PHASE)
+
+#if AUDIO_BLOCK_SAMPLES % RESAMPLE_MAX_FACTOR
+#error AUDIO_BLOCK_SAMPLES has to be a multiple of RESAMPLE_MAX_FACTOR, the decimator takes whole blocks
+#endif
+
+// Largest power of 2 factor from fs down to no lower than rate_Hz, 1 to RESAMPLE_MAX_FACTOR
+uint8_t Resample_Factor(float fs, float rate_Hz);
+
+// Shortest block a factor n decimator sends:  AUDIO_BLOCK_SAMPLES/n, 1 every update, or RESAMPLE_MIN_BLOCK
+uint16_t Resample_Block(uint8_t n);
+
+// Windowed sinc lowpass for a factor n resampler at fs that keeps passband_Hz free of aliases.  Returns the number of taps,
+// a multiple of n.  DC gain is 'gain'.
+uint16_t Resample_Design(float *coeffs, uint8_t n, float fs, float passband_Hz, float gain);
+
+class AudioFilterDecimate_F32 : public AudioStream_F32
+{
+//GUI: inputs:2, outputs:2  //this line used for automatic generation of GUI node
+//GUI: shortName:Decimate
+  public:
+    AudioFilterDecimate_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+    {
+        sample_rate_Hz = settings.sample_rate_Hz;
+        factor         = 1;
+        n_taps         = 0;
+        out_count      = 0;
+        out_len        = AUDIO_BLOCK_SAMPLES;
+    }
+    // n is 1, 2, 4, 8 or 16.  1 passes the audio through.  block is the output block length, rounded to a multiple of
+    // Resample_Block(n).
+    void     begin(uint8_t n, float passband_Hz, uint16_t block = AUDIO_BLOCK_SAMPLES);
+    void     setSampleRate(float fs)    { sample_rate_Hz = fs; }   // input rate
+    uint8_t  getFactor(void)    { return factor; }
+    float    getRate(void)      { return sample_rate_Hz / factor; }
+    uint16_t getTaps(void)      { return n_taps; }
+    uint16_t getBlock(void)     { return out_len; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+    arm_fir_decimate_instance_f32 fir[2];
+    float       sample_rate_Hz;
+    uint8_t     factor;
+    uint16_t    n_taps;
+    uint16_t    out_count;                          // decimated samples waiting in out_buf, both channels
+    uint16_t    out_len;                            // output block length
+    float       coeffs[RESAMPLE_MAX_TAPS];
+    float       state[2][RESAMPLE_MAX_TAPS + AUDIO_BLOCK_SAMPLES - 1];
+    float       out_buf[2][AUDIO_BLOCK_SAMPLES];
+};
+
+class AudioFilterInterpolate_F32 : public AudioStream_F32
+{
+//GUI: inputs:2, outputs:2  //this line used for automatic generation of GUI node
+//GUI: shortName:Interpolate
+  public:
+    AudioFilterInterpolate_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+    {
+        sample_rate_Hz = settings.sample_rate_Hz;   // the output (full) rate
+        factor         = 1;
+        n_taps         = 0;
+        q_count        = 0;
+        q_rd           = 0;
+        channels       = 1;
+        running        = false;
+    }
+    void     begin(uint8_t n, float passband_Hz);
+    void     setSampleRate(float fs)    { sample_rate_Hz = fs; }   // output rate
+    uint8_t  getFactor(void)    { return factor; }
+    uint16_t getTaps(void)      { return n_taps; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+    arm_fir_interpolate_instance_f32 fir[2];
+    float       sample_rate_Hz;
+    uint8_t     factor;
+    uint16_t    n_taps;
+    uint16_t    q_count;                            // low rate samples in q, both channels
+    uint16_t    q_rd;                               // next to interpolate
+    uint8_t     channels;                           // 2 once a block has come in on input 1
+    bool        running;                            // first block is in, output every update
+    float       coeffs[RESAMPLE_MAX_TAPS];
+    float       state[2][RESAMPLE_MAX_TAPS_PER_PHASE + AUDIO_BLOCK_SAMPLES - 1];
+    float       q[2][2 * AUDIO_BLOCK_SAMPLES];
+};
+#endif  // _AUDIO_RESAMPLE_F32_H_
@@ -5,7 +5,6 @@
 #include "SDR_RA8875.h"
 #include "RadioConfig.h"
 //#include "Bandwidth2.h"
-//#include "Hilbert.h"            // filter coefficients
 
 //extern AudioFilterFIR_F32               RX_Hilbert_Plus_45;
 //extern AudioFilterFIR_F32               RX_Hilbert_Minus_45;
@@ -16,121 +15,94 @@ extern const struct Filter_Settings     filter[];
 extern void                             SetFilter(void);
 extern struct User_Settings             user_settings[];
 extern uint8_t                          user_Profile;
-extern int16_t                          filterCenter;
-extern int16_t                          filterBandwidth;
+extern uint16_t                         filterCenter;
+extern uint16_t                         filterBandwidth;
 extern AudioEffectGain_F32              Amp1_L;  // Some well placed gain stages
 extern AudioEffectGain_F32              Amp1_R;  // Some well placed gain stages
+extern AudioFilterFFTConv_F32           RX_FilterConv;
 
 
 
-////////////////////////////////////////////////////////////////////////////////////
-COLD void selectBandwidth(uint8_t bndx)
+//
+//  Kernel cache for RX_FilterConv.  1 slot per filter[] entry, keyed by the center, width and sample rate it was designed
+//  for.  The CW slots follow the pitch.  Mode is not part of the key, the filter is after the sideband sum so USB and LSB
+//  use the same audio passband.  A slot that is stale while RX_FilterConv is playing it is not rewritten, the new
+//  design goes to a spare and the slot is redone next time.  Changing filters is then a pointer swap in the audio update.
+//
+DMAMEM FFTConv_Kernel filter_kernel[FILTER];
+DMAMEM FFTConv_Kernel filter_kernel_spare[2];
+
+// Center, width and extra audio gain for filter[bndx].  False if bndx is not a filter.
+static bool bw_Params(uint8_t bndx, uint16_t *fc, uint16_t *bw, float *boost_dB)
 {
-    Amp1_L.setGain_dB(AUDIOBOOST);    // Adjustable fixed output boost in dB.
-    Amp1_R.setGain_dB(AUDIOBOOST);
-    // For convolutional filter method, just set a single fixed Hibert filter width. Rest is taken care of after the summer
-    
-    if(bndx==0)
+    *boost_dB = 0.0f;
+    switch (bndx)
     {
-        //bandwidth="Bw 250 Hz";
-        //CW_Filter.end();
-        //CW_Filter.setBandpass(0,250.0f,9.0f);   
-        //CW_Filter.begin();           
-        filterCenter = user_settings[user_Profile].pitch;  // Use pitch since this is a CW filter
-        filterBandwidth = 250;
-        AudioNoInterrupts();
-        Amp1_L.setGain_dB(AUDIOBOOST+8.0f);    // Adjustable fixed output boost in dB.
-        Amp1_R.setGain_dB(AUDIOBOOST+8.0f);
-        AudioInterrupts();
-        SetFilter();               
+        // CW filter widths.  Use pitch for the center since these are CW filters
+        case 0: *fc = user_settings[user_Profile].pitch; *bw = 250;  *boost_dB = 8.0f; break;  // Bw 250 Hz
+        case 1: *fc = user_settings[user_Profile].pitch; *bw = 500;  *boost_dB = 6.0f; break;  // Bw 500 Hz
+        case 2: *fc = user_settings[user_Profile].pitch; *bw = 700;  *boost_dB = 5.0f; break;  // Bw 700 Hz
+        case 3: *fc = user_settings[user_Profile].pitch; *bw = 1000; *boost_dB = 3.0f; break;  // Bw 1.0 kHz
+        // Wider filters for voice and data modes
+        case 4: *fc = 1850/2; *bw = 1800; break;   // Bw 1.8 kHz
+        case 5: *fc = 2400/2; *bw = 2300; break;   // Bw 2.3 kHz
+        case 6: *fc = 2900/2; *bw = 2800; break;   // Bw 2.8 kHz
+        case 7: *fc = 3300/2; *bw = 3200; break;   // Bw 3.2 kHz
+        case 8: *fc = 4100/2; *bw = 4000; break;   // Bw 4.0 kHz
+        default: return false;
     }
+    return true;
+}
 
-    if(bndx==1)
-    {
-        //bandwidth="Bw 500 Hz";
-        //CW_Filter.end();
-        //CW_Filter.setBandpass(0,500.0f,9.0f);
-        //CW_Filter.begin();
-        filterCenter = user_settings[user_Profile].pitch;  // Use pitch since this is a CW filter
-        filterBandwidth = 500;
-        AudioNoInterrupts();
-        Amp1_L.setGain_dB(AUDIOBOOST+6.0f);    // Adjustable fixed output boost in dB.
-        Amp1_R.setGain_dB(AUDIOBOOST+6.0f);
-        AudioInterrupts();
-        SetFilter();
-    }
-    
-    if(bndx==2)
-    {
-        //bandwidth="Bw 700 Hz";
-        //CW_Filter.end();
-        //CW_Filter.setBandpass(0,700.0f,9.0f);
-        //CW_Filter.begin();
-        filterCenter = user_settings[user_Profile].pitch;  // Use pitch since this is a CW filter
-        filterBandwidth = 700;
-        AudioNoInterrupts();
-        Amp1_L.setGain_dB(AUDIOBOOST+5.0f);    // Adjustable fixed output boost in dB.
-        Amp1_R.setGain_dB(AUDIOBOOST+5.0f);
-        AudioInterrupts();
-        SetFilter();
-    }
+// Kernel for a center and width.  Designs it only if the cache does not already hold it.
+COLD FFTConv_Kernel *Filter_Kernel(uint16_t fc, uint16_t bw)
+{
+    FFTConv_Kernel *k = NULL;
 
-    if(bndx==3)
+    for (uint8_t i = 0; i < FILTER; i++)
     {
-        //bandwidth="Bw 1.0 kHz";
-        //CW_Filter.end();
-        //CW_Filter.setBandpass(0,1000.0f,9.0f);
-        //CW_Filter.begin();
-        filterCenter = user_settings[user_Profile].pitch;  // Use pitch since this is a CW filter
-        filterBandwidth=1000;
-        AudioNoInterrupts();
-        Amp1_L.setGain_dB(AUDIOBOOST+3.0f);    // Adjustable fixed output boost in dB.
-        Amp1_R.setGain_dB(AUDIOBOOST+3.0f);
-        AudioInterrupts();
-        SetFilter();
-    }
-    
-    // Above are CW mode filter widths.  Below are wider filters for voice and data modes
-    
-    if(bndx==4)
-    {
-        //bandwidth="Bw 1.8 kHz";  
-        filterCenter = 1850/2;
-        filterBandwidth = 1800;
-        SetFilter();
+        if (filter[i].Width == bw)
+            k = &filter_kernel[i];
     }
+    if (k && RX_FilterConv.matches(k, fc, bw))
+        return k;   // cache hit
+    if (!k || RX_FilterConv.inUse(k))
+        k = &filter_kernel_spare[RX_FilterConv.inUse(&filter_kernel_spare[0]) ? 1 : 0];
+    RX_FilterConv.design(k, fc, 90, FFTCONV_BANDPASS, bw);
+    return k;
+}
 
-    if(bndx==5)
-    {
-        //bandwidth="Bw 2.3kHz";
-        filterCenter = 2400/2;
-        filterBandwidth = 2300;
-        SetFilter();
-    }
+// Design every filter[] kernel up front.  Call once the audio objects are set up, before the first selectBandwidth().
+COLD void Filter_Kernel_Init(void)
+{
+    uint16_t fc, bw;
+    float    boost_dB;
 
-    if(bndx==6)
+    for (uint8_t i = 0; i < FILTER; i++)
     {
-        //bandwidth="Bw 2.8 kHz";
-        filterCenter = 2900/2;
-        filterBandwidth = 2800;
-        SetFilter();
+        filter_kernel[i].fs = 0;    // DMAMEM is not cleared at startup
+        if (bw_Params(i, &fc, &bw, &boost_dB))
+            Filter_Kernel(fc, bw);
     }
-    
-    if(bndx==7)
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+COLD void selectBandwidth(uint8_t bndx)
+{
+    uint16_t fc, bw;
+    float    boost_dB;
+
+    // For convolutional filter method, just set a single fixed Hibert filter width. Rest is taken care of after the summer
+    if (bw_Params(bndx, &fc, &bw, &boost_dB))
     {
-        //bandwidth="Bw 3.2 kHz";
-        filterCenter = 3300/2;
-        filterBandwidth = 3200;
-        SetFilter();           
+        AudioNoInterrupts();
+        Amp1_L.setGain_dB(AUDIOBOOST+boost_dB);    // Adjustable fixed output boost in dB.
+        Amp1_R.setGain_dB(AUDIOBOOST+boost_dB);
+        AudioInterrupts();
+        filterCenter = fc;
+        filterBandwidth = bw;
+        SetFilter();    // kernels are cached, this only swaps the filter
     }
-  
-    if(bndx==8) 
-    {
-        //bandwidth="4.0 kHz";
-        filterCenter = 4100/2;
-        filterBandwidth = 4000;
-        SetFilter();
-    } 
 
     bandmem[curr_band].filter = bndx; // Set new filter into memory
     //DPRINT("Filter Set to ");
@@ -6,5 +6,7 @@
 #include <Arduino.h>
 
 void selectBandwidth(uint8_t bndx);
+void Filter_Kernel_Init(void);
+struct FFTConv_Kernel *Filter_Kernel(uint16_t fc, uint16_t bw);
 
 #endif  // _BANDWIDTH2_H_
@@ -50,6 +50,7 @@ extern          void                set_MF_Service(uint8_t client_name);
 extern          void                unset_MF_Service(uint8_t client_name);
 extern          uint8_t             MF_client; // Flag for current owner of MF knob services
 extern          float               fft_bin_size;       // = sample_rate_Hz/(FFT_SIZE*2) -  Size of FFT bin in Hz
+extern          float               spect_bins_per_pixel;  // > 1 when the spectrum packs the full FFT span into the graph width
 extern          void                touchBeep(bool enable);
 extern          bool                MeterInUse;  // S-meter flag to block updates while the MF knob has control
 extern          Metro               MF_Timeout;
@@ -59,10 +60,13 @@ extern          int32_t 		    ModeOffset;
 extern AudioMixer4_F32              I_Switch;
 extern AudioMixer4_F32              Q_Switch;
 extern AudioLMSDenoiseNotch_F32     LMS_Notch;
+extern AudioEffectAGC_F32           RX_AGC;
 extern          bool                TwoToneTest;
 extern          uint16_t            fft_size;
 extern          int16_t             fft_bins;
 extern          void                Change_FFT_Size(uint16_t new_size, float new_sample_rate_Hz);
+extern          void                Change_FFT_Zoom(uint8_t zoom_factor);
+extern AudioAnalyzeZoomFFT_IQ_F32   myFFT;
 extern          float               zoom_in_sample_rate_Hz;
 extern          float               sample_rate_Hz;
 #ifdef USE_FREQ_SHIFTER
@@ -84,6 +88,9 @@ void pop_win_down(uint8_t win_num);
 void Mute();
 void Menu();
 void Display();
+void setWFPalette(int8_t toggle);
+void setSpan(int8_t toggle);
+void setPeakMarks(int8_t toggle);
 void Band(uint8_t new_band);
 void BandDn();
 void BandUp();
@@ -767,7 +774,7 @@ COLD void ATU(uint8_t state)
 //          1 = step up 1 (zoomed in more)
 //         -1 = step down 1 (zoom out more )
 //          2 = use last zoom level used from user profile
-//   Zoom levels are x1, x2 and x4  Off is same as x1.
+//   Zoom levels are x1, x2, x4, x8 and x16  Off is same as x1.
 //
 COLD void setZoom(int8_t dir)
 {
@@ -800,19 +807,7 @@ COLD void setZoom(int8_t dir)
         user_settings[user_Profile].zoom_level = (uint8_t) _zoom_Level;  // We have our new table index value
     }  
 
-    switch (_zoom_Level)
-    {
-        #ifdef FFT_1024
-            case ZOOMx1: Change_FFT_Size(1024, sample_rate_Hz);  break;  // Zoom farthest in
-        #endif
-        #ifdef FFT_2048
-            case ZOOMx2: Change_FFT_Size(2048, sample_rate_Hz);  break;  // Zoom farthest in
-        #endif
-        #ifdef FFT_4096
-            case ZOOMx4: Change_FFT_Size(4096, sample_rate_Hz);  break;  // Zoom farthest in
-        #endif
-        default:     Change_FFT_Size(FFT_SIZE, sample_rate_Hz);  break;  // Zoom farthest in
-    }
+    Change_FFT_Zoom(zoom[_zoom_Level].zoom_factor);
 
     //DPRINT("Zoom level set to  "); 
     //DPRINTLN(zoom[_zoom_Level].zoom_name);
@@ -1460,36 +1455,76 @@ COLD void Display()
     //DPRINTLN(display_state);
 }
 
+// DISPLAY button long press.  Steps to the next waterfall palette, style 6.
+// 2 = next palette, anything else sets the current user setting such as for startup.
+COLD void setWFPalette(int8_t toggle)
+{
+#ifndef BYPASS_SPECTRUM_MODULE
+    if (toggle == 2)
+    {
+        if (++user_settings[user_Profile].wf_palette >= WF_PALETTE_NUM)
+            user_settings[user_Profile].wf_palette = WF_PALETTE_G0ORX;
+    }
+    Spectrum_Set_Palette(user_settings[user_Profile].wf_palette);
+#endif
+    //DPRINT("Set WF Palette to ");
+    //DPRINTLN(user_settings[user_Profile].wf_palette);
+}
+
+// ZOOM button long press.  Steps through the span modes, crop to the center bins or fit the whole FFT to the graph.
+// 2 = next mode, anything else sets the current user setting such as for startup.
+COLD void setSpan(int8_t toggle)
+{
+#ifndef BYPASS_SPECTRUM_MODULE
+    if (toggle == 2)
+    {
+        if (++user_settings[user_Profile].span_mode >= SPAN_NUM)
+            user_settings[user_Profile].span_mode = SPAN_CROP;
+    }
+    Spectrum_Set_Span(user_settings[user_Profile].span_mode);
+#endif
+    //DPRINT("Set Span mode to ");
+    //DPRINTLN(user_settings[user_Profile].span_mode);
+}
+
+// REFLVL button long press.  Turns the spectrum peak markers on and off.
+// 2 = toggle, anything else sets the current user setting such as for startup.
+COLD void setPeakMarks(int8_t toggle)
+{
+#ifndef BYPASS_SPECTRUM_MODULE
+    if (toggle == 2)
+        user_settings[user_Profile].peak_marks = (user_settings[user_Profile].peak_marks == OFF) ? ON : OFF;
+    Spectrum_Peak_Markers(user_settings[user_Profile].peak_marks);
+#endif
+    //DPRINT("Set Peak markers to ");
+    //DPRINTLN(user_settings[user_Profile].peak_marks);
+}
+
 COLD void TouchTune(int16_t touch_Freq)
 {
     
     if (popup == 1) return;   // skip if menu window is active
 
 #ifndef BYPASS_SPECTRUM_MODULE
-    int32_t pk;
-
-    pk = pan * (fft_size - SCREEN_WIDTH);  // pan offset in fft_bin count
-    touch_Freq -= Sp_Parms_Def[user_settings[user_Profile].sp_preset].spect_width/2 - pk;// adjust coordinate relative to center accounting for pan offset
-    int32_t _newfreq = touch_Freq * fft_bin_size*2;  // convert touch X coordinate to a frequency and jump to it.    
+    // Convert the touch X coordinate to a frequency with the same center column and pan the spectrum drew with
+    int32_t _newfreq = Spectrum_X_Hz(touch_Freq);
     // We have our new target frequency from touch
-    //DPRINT(F("\npan offset (bins from center)     =")); DPRINTLN(pk);
-    //DPRINT(F("touch_Freq (bins from center)     =")); DPRINTLN(touch_Freq);
     //DPRINT(F("Touch target change in Hz         =")); DPRINTLN(_newfreq);
     //DPRINT(F("New target touch VFO (Hz)         =")); DPRINTLN(formatVFO(VFOA+_newfreq));
-    // Suggested frequency from the Peak Frequency function in the spectrum library - may not be the one we want! It is just the strongest.
-    //DPRINT(F("\nFreq_Peak (Hz)                  =")); DPRINTLN(formatVFO(Freq_Peak)); 
-    //DPRINT(F("Target VFOA - VFO_peak (Hz)       =")); DPRINTLN((int32_t) VFOA+_newfreq-Freq_Peak);
     
     DPRINT(F("Touch-Tune frequency is "));
     VFOA += _newfreq;
 
-    // If the Peak happens to be close to the touch target frequency then we can use that to fine tune the new VFO
-    if (abs(VFOA - (uint32_t) Freq_Peak < 1000))
+    // If one of the signal peaks found by the spectrum module is within a few pixels of the touch then snap to it.
+    // The peak frequency is interpolated between bins so it is closer than the touch or bin resolution.
+    int32_t snap = Spectrum_Peak_Near(VFOA, SPECT_PEAK_SNAP_PIX * fft_bin_size*2 * spect_bins_per_pixel);
+    //DPRINT(F("\nSnap peak (Hz)                  =")); DPRINTLN(formatVFO(snap));
+    if (snap)
     {
         if (bandmem[curr_band].mode_A == CW || bandmem[curr_band].mode_A == CW_REV)
-            VFOA = Freq_Peak - ModeOffset;  //user_settings[user_Profile].pitch;
+            VFOA = snap - ModeOffset;  //user_settings[user_Profile].pitch;
         else
-            VFOA = Freq_Peak;  // bin number from spectrum
+            VFOA = snap;
     }
     DPRINTLN(formatVFO(VFOA));
 #endif    
@@ -1515,16 +1550,24 @@ COLD void selectStep(uint8_t fndx)
 
 COLD void selectAgc(uint8_t andx)
 {
-    struct AGC *pAGC = &agc_set[andx];
-	
     if (andx >= AGC_SET_NUM)
       	andx = AGC_OFF; 		// Cycle around
 
 	if (andx <  AGC_OFF)
     	andx = AGC_SET_NUM - 1;		// Cycle around
 		
+    struct AGC *pAGC = &agc_set[andx];
   	bandmem[curr_band].agc_mode = andx;
 
+  #ifdef USE_DIGITAL_AGC
+    // All in the audio graph, no codec I2C traffic
+    RX_AGC.setParams(
+        pAGC->agc_threshold,
+        pAGC->agc_dsp_maxGain,
+        pAGC->agc_dsp_decay,
+        pAGC->agc_hang);
+    RX_AGC.enable(andx != AGC_OFF);
+  #else
     if (andx == AGC_OFF)
     {
         codec1.autoVolumeControl(
@@ -1549,6 +1592,7 @@ COLD void selectAgc(uint8_t andx)
         codec1.audioPostProcessorEnable();
         codec1.autoVolumeEnable();
     }
+  #endif
  	//displayAgc();
 }
 
@@ -18,6 +18,9 @@ void changeBands(int8_t direction);
 void Mute();
 void Menu();
 void Display();
+void setWFPalette(int8_t toggle);
+void setSpan(int8_t toggle);
+void setPeakMarks(int8_t toggle);
 void Band(uint8_t new_band);
 void BandDn();
 void BandUp();
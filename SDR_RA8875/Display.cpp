@@ -427,18 +427,18 @@ COLD void displaySplit()
 {
 	if (popup) return;  // Do not write to the screen when a window is active
 
-	char sp_label[15];
+	char sp_label[20];	// labels[].label, the button label cut to leave room for the state
 
 	if (bandmem[curr_band].split)
 	{
 		tft.setTextColor(GREEN);
-		sprintf(sp_label, "%s %s",  std_btn[SPLIT_BTN].label, ">>>");
+		sprintf(sp_label, "%.15s %s",  std_btn[SPLIT_BTN].label, ">>>");
 		sprintf(labels[SPLIT_LBL].label, "%s",  sp_label);
 	}
 	else
 	{
 		tft.setTextColor(myDARKGREY);
-		sprintf(sp_label, "%s %s", std_btn[SPLIT_BTN].label, "Off");
+		sprintf(sp_label, "%.15s %s", std_btn[SPLIT_BTN].label, "Off");
 		sprintf(labels[SPLIT_LBL].label, "%s",  sp_label);
 	}
 	//DPRINT(F("Split is ")); DPRINTLN(bandmem[curr_band].split);
@@ -483,7 +483,7 @@ COLD void displayMeter(int val, const char *string, uint16_t colorscheme)
 void displayBand_Menu(uint8_t state)
 {
     struct Standard_Button *ptr = std_btn;     // pointer to button object passed by calling function
-	char temp[30];
+	char temp[32];
  	
 	if (state)
     {
@@ -1300,12 +1300,12 @@ COLD int drawRightString(const char *string, int dX, int poY, int font)
 COLD int16_t textWidth(const char *string, int font)
 {
   unsigned int str_width  = 0;
-  char uniCode;
-  char *widthtable;
+  uint8_t uniCode;
+  const unsigned char *widthtable;
 
-  if (font>1 && font<9)
-  //widthtable = (char *)pgm_read_word( &(fontdata[font].widthtbl ) ) - 32; //subtract the 32 outside the loop
-  widthtable = (char *)( &(fontdata[font].widthtbl ) ) - 32; //subtract the 32 outside the loop
+  // Only the fonts in fontdata[] with a width table
+  if (font>1 && font < (int) (sizeof(fontdata)/sizeof(fontdata[0])) && fontdata[font].widthtbl)
+  widthtable = fontdata[font].widthtbl - 32; //subtract the 32 outside the loop
   else return 0;
 
   while (*string)
@@ -1315,7 +1315,7 @@ COLD int16_t textWidth(const char *string, int font)
     if (font == 1) str_width += 6;
     else
 #endif
-    str_width += (int) (widthtable + uniCode); // Normally we need to subract 32 from uniCode
+    str_width += pgm_read_byte(widthtable + uniCode); // Normally we need to subract 32 from uniCode
   }
   return str_width * textsize;
 }
@@ -1453,6 +1453,8 @@ COLD void pop_win_up(uint8_t win_num)
         popup_timer.interval(5000);
         tft.setFont(Arial_14);
         popup = 1;
+        Spectrum_BTE_Wait();    // let any spectrum block move in progress finish before using layer 2 (page 2)
+        Spectrum_Popup(true);   // RA8876 waterfall ring window off so it does not cover the pop up
         #ifdef USE_RA8875
             tft.setActiveWindow(ptr->bx, ptr->bx+ptr->bw, ptr->by, ptr->by+ptr->bh);  
             // Save the current screen to Layer 2
@@ -1493,6 +1495,8 @@ COLD void pop_win_down(uint8_t win_num)
 			tft.canvasImageStartAddress(PAGE1_START_ADDR);
 			setActiveWindow_default();
         #endif
+        Spectrum_Restart();         // layer 2 (page 2) was used to save the screen, have the spectrum frame start over
+        Spectrum_Popup(false);
         popup = 0;   // resume our normal schedule broadcast
         popup_timer.interval(500);      
         //displayRefresh();
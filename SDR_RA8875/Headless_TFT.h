@@ -0,0 +1,492 @@
+//
+// Headless_TFT.h
+//
+// In-memory framebuffer stand in for the RA8875 and RA8876_t3 display libraries.
+// Implements the subset of both APIs this program uses, including 2 layers (RA8875) or pages (RA8876)
+// and the BTE block moves, so the spectrum, display and meter code can run with no display attached.
+// Every call is counted along with the pixels it touched, which gives a repeatable way to compare the
+// cost of the UI drawing paths.  Call saveImage() to write a layer/page out as a binary PPM file.
+//
+// Enable with #define HEADLESS_TFT in RadioConfig.h.  USE_RA8875 still picks which set of calls the
+// rest of the program makes and the screen size.  Block moves finish instantly so readStatus() and
+// statusRead() are never busy.  Touch calls report no touches.
+//
+// RA8876 register writes are kept.  The PIP1 window (registers 0x10-0x3B) is drawn over the shown page
+// by saveImage() as the controller does on the screen.  PIP2 and the other registers do nothing.
+//
+// Intended for host (PC) builds.  saveImage() needs stdio file support.
+//
+#ifndef HEADLESS_TFT_H_
+#define HEADLESS_TFT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+// Names from the RA8875 library used by this program
+enum RA8875writes       { L1=0, L2, CGRAM, PATTERN, CURSOR };
+enum RA8875scrollMode   { SIMULTANEOUS, LAYER1ONLY, LAYER2ONLY, BUFFERED };
+#define RA8875_800x480          0
+#define RA8875_BTEROP_SOURCE    0xC0
+#define RA8875_WHITE            0xFFFF
+#define RA8875_BLACK            0x0000
+#define CENTER                  9998    // setCursor() to the middle of the screen
+#define ARC_ANGLE_MAX           360     // from RA8875UserSettings.h
+#define ARC_ANGLE_OFFSET        -90
+#define ANGLE_OFFSET            -90
+
+// Page addresses from RA8876_t3/RA8876Registers.h.  Used here to find the page index.
+#define HEADLESS_PAGES          3       // RA8875 uses layers 1 and 2, RA8876 uses pages 1-3
+#define HEADLESS_PAGE_SIZE      ((uint32_t) SCREEN_WIDTH * SCREEN_HEIGHT * 2)
+#ifndef PAGE1_START_ADDR
+#define PAGE1_START_ADDR        0
+#define PAGE2_START_ADDR        (HEADLESS_PAGE_SIZE)
+#define PAGE3_START_ADDR        (HEADLESS_PAGE_SIZE*2)
+#endif
+
+// Counts since the last stats_reset()
+struct Headless_Stats {
+    uint32_t commands;          // drawing calls, each BTE move and each text character count as 1
+    uint32_t pixels;            // pixels written by drawing calls and text
+    uint32_t bte_pixels;        // pixels moved by BTE block moves (boxPut, boxGet, BTE_move)
+};
+
+class Headless_TFT
+{
+  public:
+    struct Headless_Stats stats;
+
+    Headless_TFT(uint8_t cs = 0, uint8_t rst = 0)
+    {
+        memset(fb, 0, sizeof(fb));
+        stats_reset();
+        setActiveWindow();
+    }
+
+    void stats_reset(void)  { memset(&stats, 0, sizeof(stats)); }
+
+    // Direct access for compare and checksum use.  page is 0 based.
+    uint16_t getPixel(int16_t x, int16_t y, uint8_t page = 0)
+    {
+        if (page >= HEADLESS_PAGES || x < 0 || y < 0 || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT)
+            return 0;
+        return fb[page][y][x];
+    }
+
+    // As seen on the screen:  the shown page with the PIP1 window over it when it is on
+    uint16_t getScreenPixel(int16_t x, int16_t y)
+    {
+        if ((regs[0x10] & 0x80) && x >= _reg16(0x2A) && x < _reg16(0x2A)+_reg16(0x38) && y >= _reg16(0x2C) && y < _reg16(0x2C)+_reg16(0x3A))
+            return getPixel(x - _reg16(0x2A) + _reg16(0x34), y - _reg16(0x2C) + _reg16(0x36), _page(_reg32(0x2E)));
+        return getPixel(x, y, shown);
+    }
+
+    //
+    //  Write a layer/page as a binary PPM (P6) file.  Returns false if the file cannot be written.
+    //  The shown page is written as on the screen, with the PIP1 window.
+    //
+    bool saveImage(const char *filename, uint8_t page = 0)
+    {
+        FILE *f = fopen(filename, "wb");
+        if (f == NULL || page >= HEADLESS_PAGES)
+        {
+            if (f) fclose(f);
+            return false;
+        }
+        fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+        for (int16_t y = 0; y < SCREEN_HEIGHT; y++)
+        {
+            uint8_t row[SCREEN_WIDTH*3];
+            for (int16_t x = 0; x < SCREEN_WIDTH; x++)
+            {
+                uint16_t c = (page == shown) ? getScreenPixel(x, y) : fb[page][y][x];
+                row[x*3]   = ((c >> 11) & 0x1F) * 255 / 31;
+                row[x*3+1] = ((c >> 5)  & 0x3F) * 255 / 63;
+                row[x*3+2] = (c & 0x1F) * 255 / 31;
+            }
+            fwrite(row, 1, sizeof(row), f);
+        }
+        fclose(f);
+        return true;
+    }
+
+    // ---------------------------------  Setup calls, nothing to do -----------------------------------
+    void begin(uint32_t arg = 0)                { }
+    void setRotation(uint8_t r)                 { }
+    void useLayers(bool on)                     { }
+    void setScrollMode(RA8875scrollMode mode)   { }
+    void setScrollWindow(int16_t XL, int16_t XR, int16_t Yt, int16_t Yb) { }
+    void useCapINT(uint8_t pin)                 { }
+    void setTouchLimit(uint8_t limit)           { }
+    void enableCapISR(bool on)                  { }
+    void touchEnable(bool on)                   { }
+    void displayImageWidth(uint16_t w)          { }
+    void canvasImageWidth(uint16_t w)           { }
+    void displayWindowStartXY(uint16_t x, uint16_t y) { }
+    void graphicMode(bool on)                   { }
+    void setBackGroundColor(uint16_t color)     { }
+    void backlight(bool on)                     { }
+    void displayOn(bool on)                     { }
+    void setTextSize(uint8_t s)                 { }
+    int16_t width(void)                         { return SCREEN_WIDTH; }
+    int16_t height(void)                        { return SCREEN_HEIGHT; }
+    uint16_t Color565(uint8_t r, uint8_t g, uint8_t b) { return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3); }
+
+    // ---------------------------------  Touch, never touched -----------------------------------------
+    uint8_t touched(void)                       { return 0; }
+    void updateTS(void)                         { }
+    uint8_t getTouches(void)                    { return 0; }
+    uint8_t getGesture(void)                    { return 0; }
+    void getTScoordinates(uint16_t coordinates[][2]) { }
+
+    // ---------------------------------  Layers (RA8875) and pages (RA8876) ---------------------------
+    void writeTo(enum RA8875writes d)           { if (d == L1 || d == L2) canvas = d; }
+    void selectScreen(uint32_t addr)            { current = canvas = shown = _page(addr); }
+    void canvasImageStartAddress(uint32_t addr) { canvas = _page(addr); }
+    void displayImageStartAddress(uint32_t addr){ shown = _page(addr); }
+    uint8_t readStatus(void)                    { return 0; }   // BTE never busy
+    uint8_t statusRead(void)                    { return 0; }
+    void check2dBusy(void)                      { }
+
+    // Active window.  RA8875 style takes the edges, RA8876 style the corner then width and height.
+    void setActiveWindow(int16_t XL, int16_t XR, int16_t YT, int16_t YB)
+    {
+        win_xl = XL; win_xr = XR; win_yt = YT; win_yb = YB;
+    }
+    void setActiveWindow(void)                  { setActiveWindow(0, SCREEN_WIDTH-1, 0, SCREEN_HEIGHT-1); }
+    void activeWindowXY(int16_t x, int16_t y)   { int16_t w = win_xr-win_xl, h = win_yb-win_yt; win_xl = x; win_yt = y; win_xr = x+w; win_yb = y+h; }
+    void activeWindowWH(int16_t w, int16_t h)   { win_xr = win_xl+w-1; win_yb = win_yt+h-1; }
+
+    // ---------------------------------  Drawing ------------------------------------------------------
+    void fillScreen(uint16_t color)             { stats.commands++; _fill(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, color); }
+    void clearScreen(uint16_t color = 0)        { fillScreen(color); }
+    void clearActiveScreen(void)                { stats.commands++; _fill(win_xl, win_yt, win_xr-win_xl+1, win_yb-win_yt+1, 0); }
+    void drawPixel(int16_t x, int16_t y, uint16_t color)                { stats.commands++; _pixel(x, y, color); }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)   { stats.commands++; _fill(x, y, w, h, color); }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { stats.commands++; _fill(x, y, w, 1, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { stats.commands++; _fill(x, y, 1, h, color); }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        stats.commands++;
+        _fill(x, y, w, 1, color);
+        _fill(x, y+h-1, w, 1, color);
+        _fill(x, y+1, 1, h-2, color);
+        _fill(x+w-1, y+1, 1, h-2, color);
+    }
+
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+        stats.commands++;
+        int16_t dx = abs(x1-x0), sx = x0 < x1 ? 1 : -1;
+        int16_t dy = -abs(y1-y0), sy = y0 < y1 ? 1 : -1;
+        int16_t err = dx+dy;
+        for (;;)
+        {
+            _pixel(x0, y0, color);
+            if (x0 == x1 && y0 == y1)
+                break;
+            int16_t e2 = 2*err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+    }
+
+    // Rounded corners are drawn square.  Close enough to count the cost.
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)               { fillRect(x, y, w, h, color); }
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t xr, int16_t yr, uint16_t color)  { fillRect(x, y, w, h, color); }
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)               { drawRect(x, y, w, h, color); }
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t xr, int16_t yr, uint16_t color)  { drawRect(x, y, w, h, color); }
+
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+    {
+        stats.commands++;
+        int16_t ymin = (y0 < y1) ? y0 : y1;
+        int16_t ymax = (y0 > y1) ? y0 : y1;
+        if (y2 < ymin) ymin = y2;
+        if (y2 > ymax) ymax = y2;
+        for (int16_t y = ymin; y <= ymax; y++)     // span fill between the edges crossing each row
+        {
+            int16_t xa = 32767, xb = -32768;
+            _edge(x0, y0, x1, y1, y, &xa, &xb);
+            _edge(x1, y1, x2, y2, y, &xa, &xb);
+            _edge(x2, y2, x0, y0, y, &xa, &xb);
+            if (xa <= xb)
+                _fill(xa, y, xb-xa+1, 1, color);
+        }
+    }
+
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *colors)
+    {
+        stats.commands++;
+        for (int16_t j = 0; j < h; j++)
+            for (int16_t i = 0; i < w; i++)
+                _pixel(x+i, y+j, colors[j*w+i]);
+    }
+
+    // ---------------------------------  Block moves --------------------------------------------------
+    //  RA8875.  Layer 0 means the current layer.  In the reverse direction the coordinates are the bottom right corners.
+    void BTE_move(int16_t SourceX, int16_t SourceY, int16_t Width, int16_t Height, int16_t DestX, int16_t DestY,
+                uint8_t SourceLayer = 0, uint8_t DestLayer = 0, bool Transparent = false, uint8_t ROP = RA8875_BTEROP_SOURCE,
+                bool Monochrome = false, bool ReverseDir = false)
+    {
+        uint8_t src = (SourceLayer == 0) ? canvas : SourceLayer-1;
+        uint8_t dst = (DestLayer == 0) ? canvas : DestLayer-1;
+        if (ReverseDir)
+        {
+            SourceX -= Width-1;  SourceY -= Height-1;
+            DestX   -= Width-1;  DestY   -= Height-1;
+        }
+        _move(src, SourceX, SourceY, Width, Height, dst, DestX, DestY);
+    }
+
+    //  RA8876.  boxPut copies from the current page to page vPageAddr, boxGet copies from vPageAddr to the current page.
+    //  The current page is the one selectScreen() picked, as in RA8876_t3, not the canvas.
+    void boxPut(uint32_t vPageAddr, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t dx, uint16_t dy)
+    {
+        _move(current, x0, y0, x1-x0, y1-y0, _page(vPageAddr), dx, dy);
+    }
+    void boxGet(uint32_t vPageAddr, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t dx, uint16_t dy)
+    {
+        _move(_page(vPageAddr), x0, y0, x1-x0, y1-y0, current, dx, dy);
+    }
+
+    //  RA8876 register access, 1 command each
+    void lcdRegDataWrite(uint8_t reg, uint8_t data, bool finalize = true)   { stats.commands++; regs[reg] = data; }
+    uint8_t lcdRegDataRead(uint8_t reg, bool finalize = true)               { stats.commands++; return regs[reg]; }
+
+    // ---------------------------------  Text ---------------------------------------------------------
+    //  Fonts are the ILI9341_t3 packed bitmap format used by the ili9488_t3 Arial fonts.
+    void setCursor(int16_t x, int16_t y)            { cursor_x = x; cursor_y = y; }
+    void setCursor(int16_t x, int16_t y, bool autocenter)     // text is not measured, it starts at the centre
+    {
+        setCursor((x == CENTER) ? SCREEN_WIDTH/2 : x, (y == CENTER) ? SCREEN_HEIGHT/2 : y);
+    }
+    void setTextColor(uint16_t fg)                  { text_fg = fg; text_bg = fg; }
+    void setTextColor(uint16_t fg, uint16_t bg)     { text_fg = fg; text_bg = bg; }
+    template <class F> void setFont(const F &f)
+    {
+        font_index      = f.index;          font_data       = f.data;
+        index1_first    = f.index1_first;   index1_last     = f.index1_last;
+        index2_first    = f.index2_first;   index2_last     = f.index2_last;
+        bits_index      = f.bits_index;     bits_width      = f.bits_width;
+        bits_height     = f.bits_height;    bits_xoffset    = f.bits_xoffset;
+        bits_yoffset    = f.bits_yoffset;   bits_delta      = f.bits_delta;
+        line_space      = f.line_space;     cap_height      = f.cap_height;
+    }
+
+    size_t write(uint8_t c)
+    {
+        if (c == '\n')
+        {
+            cursor_x = 0;
+            cursor_y += line_space;
+        }
+        else if (c != '\r')
+            _drawChar(c);
+        return 1;
+    }
+    size_t print(const char *s)                     { size_t n = 0; while (*s) n += write(*s++); return n; }
+    size_t print(char c)                            { return write(c); }
+    size_t print(long n, int base = 10)             { char b[34]; _itoa(n, b, base); return print(b); }
+    size_t print(unsigned long n, int base = 10)    { char b[34]; _utoa(n, b, base); return print(b); }
+    size_t print(int n, int base = 10)              { return print((long) n, base); }
+    size_t print(unsigned int n, int base = 10)     { return print((unsigned long) n, base); }
+    size_t print(short n, int base = 10)            { return print((long) n, base); }
+    size_t print(unsigned short n, int base = 10)   { return print((unsigned long) n, base); }
+    size_t print(unsigned char n, int base = 10)    { return print((unsigned long) n, base); }
+    size_t print(double d, int digits = 2)          { char b[32]; snprintf(b, sizeof(b), "%.*f", digits, d); return print(b); }
+    template <class T> size_t println(T v)          { size_t n = print(v); return n + write('\n'); }
+    size_t println(void)                            { return write('\n'); }
+    size_t printf(const char *format, ...)
+    {
+        char buf[256];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        return print(buf);
+    }
+
+  private:
+    uint16_t    fb[HEADLESS_PAGES][SCREEN_HEIGHT][SCREEN_WIDTH];
+    uint8_t     regs[256]       = {};   // RA8876 registers
+    uint8_t     canvas          = 0;    // layer/page drawn on
+    uint8_t     shown           = 0;    // layer/page displayed (for reference, saveImage() takes the page)
+    uint8_t     current         = 0;    // RA8876 page of selectScreen(), the boxPut() source and boxGet() destination
+    int16_t     win_xl, win_xr, win_yt, win_yb;
+    int16_t     cursor_x        = 0;
+    int16_t     cursor_y        = 0;
+    uint16_t    text_fg         = 0xFFFF;
+    uint16_t    text_bg         = 0xFFFF;   // same as fg means transparent background
+    const unsigned char *font_index = NULL;
+    const unsigned char *font_data  = NULL;
+    uint8_t     index1_first, index1_last, index2_first, index2_last;
+    uint8_t     bits_index, bits_width, bits_height, bits_xoffset, bits_yoffset, bits_delta;
+    uint8_t     line_space      = 10;
+    uint8_t     cap_height      = 8;
+
+    uint16_t _reg16(uint8_t reg)    { return regs[reg] | (regs[reg+1] << 8); }
+    uint32_t _reg32(uint8_t reg)    { return _reg16(reg) | ((uint32_t) _reg16(reg+2) << 16); }
+
+    uint8_t _page(uint32_t addr)
+    {
+        uint32_t p = addr / HEADLESS_PAGE_SIZE;
+        return (p < HEADLESS_PAGES) ? p : HEADLESS_PAGES-1;
+    }
+
+    // All drawing goes through here and is clipped to the active window
+    inline void _pixel(int16_t x, int16_t y, uint16_t color)
+    {
+        if (x < win_xl || x > win_xr || y < win_yt || y > win_yb || x < 0 || y < 0 || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT)
+            return;
+        fb[canvas][y][x] = color;
+        stats.pixels++;
+    }
+
+    void _fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        for (int16_t j = y; j < y+h; j++)
+            for (int16_t i = x; i < x+w; i++)
+                _pixel(i, j, color);
+    }
+
+    // Block moves are not clipped by the active window, same as the controllers.  Overlapping moves are safe.
+    void _move(uint8_t src, int16_t sx, int16_t sy, int16_t w, int16_t h, uint8_t dst, int16_t dx, int16_t dy)
+    {
+        stats.commands++;
+        if (w <= 0 || h <= 0)
+            return;
+        bool up = (src != dst || dy <= sy);     // copy top down unless moving down within a page
+        for (int16_t n = 0; n < h; n++)
+        {
+            int16_t j = up ? n : h-1-n;
+            if (sy+j < 0 || sy+j >= SCREEN_HEIGHT || dy+j < 0 || dy+j >= SCREEN_HEIGHT)
+                continue;
+            int16_t ox = (sx < 0) ? -sx : 0;        // clip columns off either edge of the source or destination
+            if (dx+ox < 0)
+                ox = -dx;
+            int16_t cw = w - ox;
+            if (sx+ox+cw > SCREEN_WIDTH) cw = SCREEN_WIDTH-sx-ox;
+            if (dx+ox+cw > SCREEN_WIDTH) cw = SCREEN_WIDTH-dx-ox;
+            if (cw <= 0)
+                continue;
+            memmove(&fb[dst][dy+j][dx+ox], &fb[src][sy+j][sx+ox], cw*sizeof(uint16_t));
+            stats.bte_pixels += cw;
+        }
+    }
+
+    void _edge(int16_t xa, int16_t ya, int16_t xb, int16_t yb, int16_t y, int16_t *lo, int16_t *hi)
+    {
+        if ((y < ya && y < yb) || (y > ya && y > yb))
+            return;
+        int16_t x1 = xa, x2 = xb;      // flat edge covers both ends
+        if (ya != yb)
+            x1 = x2 = xa + (int32_t)(xb-xa)*(y-ya)/(yb-ya);
+        if (x1 > x2) { int16_t t = x1; x1 = x2; x2 = t; }
+        if (x1 < *lo) *lo = x1;
+        if (x2 > *hi) *hi = x2;
+    }
+
+    static uint32_t _fetchbits_unsigned(const uint8_t *p, uint32_t index, uint32_t required)
+    {
+        uint32_t val = 0;
+        while (required)
+        {
+            uint8_t b = p[index >> 3];
+            uint32_t avail = 8 - (index & 7);
+            if (avail <= required)
+            {
+                val = (val << avail) | (b & ((1 << avail) - 1));
+                index += avail;
+                required -= avail;
+            }
+            else
+            {
+                b >>= avail - required;
+                val = (val << required) | (b & ((1 << required) - 1));
+                break;
+            }
+        }
+        return val;
+    }
+
+    static int32_t _fetchbits_signed(const uint8_t *p, uint32_t index, uint32_t required)
+    {
+        uint32_t val = _fetchbits_unsigned(p, index, required);
+        if (val & (1 << (required - 1)))
+            return (int32_t) val - (1 << required);
+        return (int32_t) val;
+    }
+
+    void _drawChar(uint8_t c)
+    {
+        stats.commands++;
+        if (font_data == NULL)
+        {
+            cursor_x += 6;
+            return;
+        }
+        uint32_t bitoffset;
+        if (c >= index1_first && c <= index1_last)
+            bitoffset = (c - index1_first) * bits_index;
+        else if (c >= index2_first && c <= index2_last)
+            bitoffset = (c - index2_first + index1_last - index1_first + 1) * bits_index;
+        else
+            return;
+        const uint8_t *data = font_data + _fetchbits_unsigned(font_index, bitoffset, bits_index);
+        if (_fetchbits_unsigned(data, 0, 3) != 0)       // only encoding 0 exists
+            return;
+        bitoffset = 3;
+        uint32_t w = _fetchbits_unsigned(data, bitoffset, bits_width);      bitoffset += bits_width;
+        uint32_t h = _fetchbits_unsigned(data, bitoffset, bits_height);     bitoffset += bits_height;
+        int32_t xoffset = _fetchbits_signed(data, bitoffset, bits_xoffset); bitoffset += bits_xoffset;
+        int32_t yoffset = _fetchbits_signed(data, bitoffset, bits_yoffset); bitoffset += bits_yoffset;
+        uint32_t delta = _fetchbits_unsigned(data, bitoffset, bits_delta);  bitoffset += bits_delta;
+
+        if (text_bg != text_fg)     // opaque text fills the character cell first
+            _fill(cursor_x, cursor_y, delta, line_space, text_bg);
+
+        int16_t ox = cursor_x + xoffset;
+        int16_t oy = cursor_y + cap_height - h - yoffset;
+        uint32_t y = 0;
+        while (y < h)
+        {
+            uint32_t repeat = 1;
+            if (_fetchbits_unsigned(data, bitoffset++, 1))      // row is repeated
+            {
+                repeat = _fetchbits_unsigned(data, bitoffset, 3) + 2;
+                bitoffset += 3;
+            }
+            for (uint32_t r = 0; r < repeat && y < h; r++, y++)
+                for (uint32_t x = 0; x < w; x++)
+                    if (_fetchbits_unsigned(data, bitoffset + x, 1))
+                        _pixel(ox + x, oy + y, text_fg);
+            bitoffset += w;
+        }
+        cursor_x += delta;
+    }
+
+    static void _utoa(unsigned long n, char *buf, int base)
+    {
+        char tmp[34];
+        int i = 0;
+        if (base < 2) base = 10;
+        do { unsigned long d = n % base; tmp[i++] = (d < 10) ? '0'+d : 'A'+d-10; n /= base; } while (n);
+        while (i) *buf++ = tmp[--i];
+        *buf = 0;
+    }
+
+    static void _itoa(long n, char *buf, int base)
+    {
+        if (n < 0 && base == 10)
+        {
+            *buf++ = '-';
+            n = -n;
+        }
+        _utoa((unsigned long) n, buf, base);
+    }
+};
+
+#endif // HEADLESS_TFT_H_
@@ -0,0 +1,102 @@
+//
+//    Arduino.h
+//
+//  Just enough of the Teensy 4 core for the audio library and the radio's audio objects to build on a Linux PC.
+//  Interrupts and the NVIC do nothing, there is only the 1 thread.  millis() and micros() run on the virtual clock
+//  the graph runner moves 1 block per update.  The cycle counter is the host clock in ns, so with F_CPU_ACTUAL at
+//  1GHz cpu_cycles and the CPU usage figures work as they do on the Teensy, in host time.
+//
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define F_CPU_ACTUAL        1000000000UL
+#define MAX_AUDIO_MEMORY    229376          // same pool limit as the IMXRT1062
+
+#define DMAMEM
+#define FASTRUN
+#define FLASHMEM
+#define PROGMEM
+#define F(s)                (s)
+
+#define __disable_irq()
+#define __enable_irq()
+#define NVIC_SET_PRIORITY(irq, pri)
+#define NVIC_ENABLE_IRQ(irq)
+#define NVIC_DISABLE_IRQ(irq)
+#define NVIC_SET_PENDING(irq)               // the runner calls software_isr() itself
+#define IRQ_SOFTWARE        0
+#define attachInterruptVector(irq, fn)
+#define asm(...)                            // the core's DSB barrier
+
+uint32_t host_cycles(void);
+#define ARM_DWT_CYCCNT      host_cycles()
+
+extern uint64_t host_clock_us;              // virtual time, moved by the runner
+inline uint32_t millis(void)                { return (uint32_t) (host_clock_us / 1000); }
+inline uint32_t micros(void)                { return (uint32_t) host_clock_us; }
+inline void     delay(uint32_t ms)          { host_clock_us += (uint64_t) ms * 1000; }
+
+#define DEC 10
+#define HEX 16
+#define HIGH                1
+#define LOW                 0
+#define INPUT               0
+#define OUTPUT              1
+#define INPUT_PULLUP        2
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+inline void     pinMode(uint8_t, uint8_t)       {}
+inline void     digitalWrite(uint8_t, uint8_t)  {}
+inline uint8_t  digitalRead(uint8_t)            { return HIGH; }
+inline long     map(long x, long in_min, long in_max, long out_min, long out_max)
+                                            { return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min; }
+template <class T, class L, class H> inline T constrain(T x, L lo, H hi) { return (x < lo) ? lo : (x > hi) ? hi : x; }
+template <class A, class B> inline A min(A a, B b)  { return (b < a) ? b : a; }
+template <class A, class B> inline A max(A a, B b)  { return (a < b) ? b : a; }
+inline char    *dtostrf(double v, signed char width, unsigned char prec, char *s)
+                                            { sprintf(s, "%*.*f", width, prec, v); return s; }
+
+class Print
+{
+  public:
+    virtual size_t write(uint8_t c) = 0;
+    size_t write(const uint8_t *buf, size_t n) { for (size_t i = 0; i < n; i++) write(buf[i]); return n; }
+    void   print(const char *s)             { while (*s) write((uint8_t) *s++); }
+    void   print(char c)                    { write((uint8_t) c); }
+    void   print(long v, int base = DEC)    { char s[24]; snprintf(s, sizeof(s), (base == HEX) ? "%lX" : "%ld", v); print(s); }
+    void   print(int v, int base = DEC)     { print((long) v, base); }
+    void   print(unsigned long v, int base = DEC) { char s[24]; snprintf(s, sizeof(s), (base == HEX) ? "%lX" : "%lu", v); print(s); }
+    void   print(unsigned int v, int base = DEC)  { print((unsigned long) v, base); }
+    void   print(unsigned char v, int base = DEC) { print((unsigned long) v, base); }
+    void   print(double v, int digits = 2)  { char s[40]; snprintf(s, sizeof(s), "%.*f", digits, v); print(s); }
+    void   println(void)                    { write('\r'); write('\n'); }
+    template <typename T> void println(T v) { print(v); println(); }
+    template <typename T> void println(T v, int fmt) { print(v, fmt); println(); }
+    template <typename... T> void printf(const char *fmt, T... args) { char s[256]; snprintf(s, sizeof(s), fmt, args...); print(s); }
+};
+
+class HostSerial : public Print
+{
+  public:
+    void   begin(uint32_t) {}
+    int    available(void)          { return 0; }
+    int    read(void)               { return -1; }
+    void   mute(bool m)             { muted = m; }
+    virtual size_t write(uint8_t c) { return (muted || c == '\r') ? 1 : fputc(c, stdout) != EOF; }
+    using  Print::write;
+    operator bool()                 { return true; }
+  private:
+    bool   muted = false;
+};
+extern HostSerial Serial;
+
+#endif  // _HOST_ARDUINO_H_
@@ -0,0 +1,16 @@
+//
+//    Audio.h
+//
+//  Host stand-in for the Teensy Audio library header.  Only the scheduler and the 16 bit block pool in
+//  Libraries/cores are built, none of the 16 bit audio objects.
+//
+#ifndef _HOST_AUDIO_H_
+#define _HOST_AUDIO_H_
+
+#include <Arduino.h>
+#include <AudioStream.h>
+
+#define AudioNoInterrupts()
+#define AudioInterrupts()
+
+#endif  // _HOST_AUDIO_H_
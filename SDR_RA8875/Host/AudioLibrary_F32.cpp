@@ -0,0 +1,180 @@
+//
+//    AudioLibrary_F32.cpp
+//
+//  Host versions of a few OpenAudio objects.  See AudioLibrary_F32.h
+//
+#include "AudioLibrary_F32.h"
+
+void AudioMixer4_F32::update(void)
+{
+    audio_block_f32_t *out = NULL;
+
+    for (unsigned int ch = 0; ch < 4; ch++)
+    {
+        audio_block_f32_t *in = receiveReadOnly_f32(ch);
+        if (!in)
+            continue;
+        if (!out)
+        {
+            out = allocate_f32();
+            if (!out)
+            {
+                release(in);
+                return;
+            }
+            arm_scale_f32(in->data, multiplier[ch], out->data, AUDIO_BLOCK_SAMPLES);
+            out->length = in->length;
+            out->fs_Hz  = in->fs_Hz;
+        }
+        else
+        {
+            for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+                out->data[i] += multiplier[ch] * in->data[i];
+        }
+        release(in);
+    }
+    if (out)
+    {
+        transmit(out);
+        release(out);
+    }
+}
+
+void AudioSwitch4_OA_F32::update(void)
+{
+    audio_block_f32_t *in = receiveReadOnly_f32(0);
+
+    if (!in)
+        return;
+    transmit(in, outputChannel);
+    release(in);
+}
+
+void AudioFilterFIR_F32::begin(const float *cp, int n, int block_size)
+{
+    if (n > 513)
+        n = 513;
+    coeffs = cp;
+    n_taps = n;
+    memset(state, 0, sizeof(state));
+}
+
+void AudioFilterFIR_F32::update(void)
+{
+    audio_block_f32_t *in = receiveReadOnly_f32(0);
+    audio_block_f32_t *out;
+
+    if (!in)
+        return;
+    if (!coeffs)
+    {
+        transmit(in);
+        release(in);
+        return;
+    }
+    out = allocate_f32();
+    if (!out)
+    {
+        release(in);
+        return;
+    }
+    memcpy(state + n_taps - 1, in->data, AUDIO_BLOCK_SAMPLES * sizeof(float));
+    release(in);
+    for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+    {
+        float acc = 0.0f;
+        for (int k = 0; k < n_taps; k++)
+            acc += coeffs[k] * state[i + n_taps - 1 - k];
+        out->data[i] = acc;
+    }
+    memmove(state, state + AUDIO_BLOCK_SAMPLES, (n_taps - 1) * sizeof(float));
+    out->length = AUDIO_BLOCK_SAMPLES;
+    transmit(out);
+    release(out);
+}
+
+void AudioSynthWaveformSine_F32::update(void)
+{
+    audio_block_f32_t *out = allocate_f32();
+
+    if (!out)
+        return;
+    for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+    {
+        out->data[i] = amp * sinf(phase);
+        phase += 2.0f * PI * freq / fs;
+        if (phase > 2.0f * PI)
+            phase -= 2.0f * PI;
+    }
+    out->length = AUDIO_BLOCK_SAMPLES;
+    transmit(out);
+    release(out);
+}
+
+void AudioSynthSineCosine_F32::update(void)
+{
+    audio_block_f32_t *s = allocate_f32();
+    audio_block_f32_t *c = allocate_f32();
+
+    if (s && c)
+    {
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+        {
+            s->data[i] = amp * sinf(phase);
+            c->data[i] = amp * cosf(phase);
+            phase += 2.0f * PI * freq / fs;
+            if (phase > 2.0f * PI)
+                phase -= 2.0f * PI;
+        }
+        s->length = c->length = AUDIO_BLOCK_SAMPLES;
+        transmit(s, 0);
+        transmit(c, 1);
+    }
+    if (s) release(s);
+    if (c) release(c);
+}
+
+void AudioPassThrough_F32::update(void)
+{
+    for (unsigned int ch = 0; ch < 2; ch++)
+    {
+        audio_block_f32_t *in = receiveReadOnly_f32(ch);
+        if (!in)
+            continue;
+        transmit(in, ch);
+        release(in);
+    }
+}
+
+void AudioAnalyzePeak_F32::update(void)
+{
+    audio_block_f32_t *in = receiveReadOnly_f32(0);
+
+    if (!in)
+        return;
+    for (int i = 0; i < in->length; i++)
+    {
+        if (in->data[i] < min_sample) min_sample = in->data[i];
+        if (in->data[i] > max_sample) max_sample = in->data[i];
+    }
+    new_output = true;
+    release(in);
+}
+
+float AudioAnalyzePeak_F32::read(void)
+{
+    float m = (-min_sample > max_sample) ? -min_sample : max_sample;
+
+    min_sample = max_sample = 0.0f;
+    new_output = false;
+    return m;
+}
+
+float AudioAnalyzePeak_F32::readPeakToPeak(void)
+{
+    float p = max_sample - min_sample;
+
+    min_sample = max_sample = 0.0f;
+    new_output = false;
+    return p;
+}
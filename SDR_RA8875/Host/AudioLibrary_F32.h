@@ -0,0 +1,129 @@
+//
+//    AudioLibrary_F32.h
+//
+//  Host versions of the OpenAudio mixer, switch and peak objects, with the same names and the methods the radio
+//  calls.  They do what the library ones do so a graph built from them moves the same blocks.
+//
+//  The noise blanker, LMS notch and I2S alignment have no source in this tree.  They are pass-throughs here, which is
+//  what the radio's do turned off, so RX_PatchCords.h can be used as it is.  The FIR and the tone generators are for
+//  the TX chain of TX_PatchCords.h, with the cost of the library ones and no more.
+//
+#ifndef _HOST_AUDIO_LIBRARY_F32_H_
+#define _HOST_AUDIO_LIBRARY_F32_H_
+
+#include <Arduino.h>
+#include <AudioStream_F32.h>
+
+class AudioMixer4_F32 : public AudioStream_F32
+{
+  public:
+    AudioMixer4_F32(void) : AudioStream_F32(4, inputQueueArray) { for (int i = 0; i < 4; i++) multiplier[i] = 1.0f; }
+    AudioMixer4_F32(const AudioSettings_F32 &settings) : AudioMixer4_F32() {}
+    void  gain(unsigned int ch, float g) { if (ch < 4) multiplier[ch] = g; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[4];
+    float multiplier[4];
+};
+
+// 1 input to the 1 of 4 outputs picked by setChannel()
+class AudioSwitch4_OA_F32 : public AudioStream_F32
+{
+  public:
+    AudioSwitch4_OA_F32(void) : AudioStream_F32(1, inputQueueArray), outputChannel(0) {}
+    AudioSwitch4_OA_F32(const AudioSettings_F32 &settings) : AudioSwitch4_OA_F32() {}
+    void  setChannel(unsigned int ch) { if (ch < 4) outputChannel = ch; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[1];
+    uint8_t outputChannel;
+};
+
+class AudioAnalyzePeak_F32 : public AudioStream_F32
+{
+  public:
+    AudioAnalyzePeak_F32(void) : AudioStream_F32(1, inputQueueArray), min_sample(0.0f), max_sample(0.0f), new_output(false) {}
+    AudioAnalyzePeak_F32(const AudioSettings_F32 &settings) : AudioAnalyzePeak_F32() {}
+    bool  available(void)  { return new_output; }
+    float read(void);
+    float readPeakToPeak(void);
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[1];
+    float min_sample, max_sample;
+    bool  new_output;
+};
+
+// Direct form FIR, as the library one does with arm_fir_f32.  coeffs stay the caller's.
+class AudioFilterFIR_F32 : public AudioStream_F32
+{
+  public:
+    AudioFilterFIR_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray), coeffs(NULL), n_taps(0) {}
+    void  begin(const float *cp, int n, int block_size);
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[1];
+    const float *coeffs;
+    int          n_taps;
+    float        state[AUDIO_BLOCK_SAMPLES + 512];   // last n_taps - 1 inputs then the new block
+};
+
+// Sine generators for the test tones, 1 sinf() per sample.  They run at amplitude 0 too, as the library ones do.
+class AudioSynthWaveformSine_F32 : public AudioStream_F32
+{
+  public:
+    AudioSynthWaveformSine_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL),
+        fs(settings.sample_rate_Hz), freq(1000.0f), amp(0.0f), phase(0.0f) {}
+    void  frequency(float f)          { freq = f; }
+    void  amplitude(float a)          { amp = a; }
+    void  setSampleRate_Hz(float f)   { fs = f; }
+    virtual void update(void);
+
+  protected:
+    float fs, freq, amp, phase;
+};
+
+// Sine on output 0, cosine on output 1
+class AudioSynthSineCosine_F32 : public AudioSynthWaveformSine_F32
+{
+  public:
+    AudioSynthSineCosine_F32(const AudioSettings_F32 &settings) : AudioSynthWaveformSine_F32(settings) {}
+    virtual void update(void);
+};
+
+// Each input straight to the output of the same number
+class AudioPassThrough_F32 : public AudioStream_F32
+{
+  public:
+    AudioPassThrough_F32(void) : AudioStream_F32(2, inputQueueArray) {}
+    void  enable(bool on) {}
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+};
+
+class radioNoiseBlanker_F32 : public AudioPassThrough_F32
+{
+  public:
+    radioNoiseBlanker_F32(const AudioSettings_F32 &settings) {}
+    void  useTwoChannel(bool on) {}
+};
+
+class AudioLMSDenoiseNotch_F32 : public AudioPassThrough_F32
+{
+  public:
+    AudioLMSDenoiseNotch_F32(const AudioSettings_F32 &settings) {}
+};
+
+class AudioAlignLR_F32 : public AudioPassThrough_F32
+{
+  public:
+    AudioAlignLR_F32(const AudioSettings_F32 &settings) {}      // the radio's also takes the signal source and pin
+};
+
+#endif  // _HOST_AUDIO_LIBRARY_F32_H_
@@ -0,0 +1,22 @@
+//
+//    AudioSettings_F32.h
+//
+//  Host copy of the OpenAudio settings class, the members the radio uses.
+//
+#ifndef _HOST_AUDIO_SETTINGS_F32_H_
+#define _HOST_AUDIO_SETTINGS_F32_H_
+
+class AudioSettings_F32
+{
+  public:
+    AudioSettings_F32(float fs_Hz, int block_size) : sample_rate_Hz(fs_Hz), audio_block_samples(block_size) {}
+    const float sample_rate_Hz;
+    const int   audio_block_samples;
+
+    float cpu_load_percent(const int n)     { return 100.0f * n * 64.0f * sample_rate_Hz / audio_block_samples / F_CPU_ACTUAL; }
+    float processorUsage(void)              { return cpu_load_percent(AudioStream::cpu_cycles_total); }
+    float processorUsageMax(void)           { return cpu_load_percent(AudioStream::cpu_cycles_total_max); }
+    void  processorUsageMaxReset(void)      { AudioStream::cpu_cycles_total_max = AudioStream::cpu_cycles_total; }
+};
+
+#endif  // _HOST_AUDIO_SETTINGS_F32_H_
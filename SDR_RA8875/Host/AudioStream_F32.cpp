@@ -0,0 +1,130 @@
+//
+//    AudioStream_F32.cpp
+//
+//  Host build of the F32 block pool and connections declared in Libraries/OpenAudio_Library/AudioStream_F32.h.
+//  Same behavior as the OpenAudio library:  192 blocks at most, a block sent to several inputs is shared with a
+//  reference count, and an input that still holds a block drops the new one.
+//
+#include <Arduino.h>
+#include <AudioStream_F32.h>
+
+audio_block_f32_t * AudioStream_F32::f32_memory_pool;
+uint32_t AudioStream_F32::f32_memory_pool_available_mask[6];
+uint8_t  AudioStream_F32::f32_memory_used = 0;
+uint8_t  AudioStream_F32::f32_memory_used_max = 0;
+
+void AudioMemory_F32(const int num)
+{
+    AudioStream_F32::initialize_f32_memory(new audio_block_f32_t[num], num);
+}
+
+void AudioMemory_F32(const int num, const AudioSettings_F32 &settings)
+{
+    AudioStream_F32::initialize_f32_memory(new audio_block_f32_t[num], num, settings);
+}
+
+void AudioStream_F32::initialize_f32_memory(audio_block_f32_t *data, unsigned int num)
+{
+    if (num > 192)
+        num = 192;
+    f32_memory_pool = data;
+    memset(f32_memory_pool_available_mask, 0, sizeof(f32_memory_pool_available_mask));
+    for (unsigned int i = 0; i < num; i++)
+    {
+        f32_memory_pool_available_mask[i >> 5] |= (1u << (i & 0x1F));
+        data[i].memory_pool_index = i;
+    }
+}
+
+void AudioStream_F32::initialize_f32_memory(audio_block_f32_t *data, unsigned int num, const AudioSettings_F32 &settings)
+{
+    initialize_f32_memory(data, num);
+    for (unsigned int i = 0; i < num && i < 192; i++)
+    {
+        data[i].fs_Hz  = settings.sample_rate_Hz;
+        data[i].length = settings.audio_block_samples;
+    }
+}
+
+audio_block_f32_t * AudioStream_F32::allocate_f32(void)
+{
+    for (uint8_t m = 0; m < 6; m++)
+    {
+        uint32_t avail = f32_memory_pool_available_mask[m];
+        if (avail)
+        {
+            uint8_t bit = __builtin_ctz(avail);
+            f32_memory_pool_available_mask[m] = avail & ~(1u << bit);
+            audio_block_f32_t *block = f32_memory_pool + (m << 5) + bit;
+            block->ref_count = 1;
+            if (++f32_memory_used > f32_memory_used_max)
+                f32_memory_used_max = f32_memory_used;
+            return block;
+        }
+    }
+    return NULL;
+}
+
+void AudioStream_F32::release(audio_block_f32_t *block)
+{
+    if (block == NULL)
+        return;
+    if (block->ref_count > 1)
+        block->ref_count--;
+    else
+    {
+        f32_memory_pool_available_mask[block->memory_pool_index >> 5] |= (1u << (block->memory_pool_index & 0x1F));
+        f32_memory_used--;
+    }
+}
+
+void AudioStream_F32::transmit(audio_block_f32_t *block, unsigned char index)
+{
+    for (AudioConnection_F32 *c = destination_list_f32; c != NULL; c = c->next_dest)
+    {
+        if (c->src_index == index && c->dst.inputQueue_f32[c->dest_index] == NULL)
+        {
+            c->dst.inputQueue_f32[c->dest_index] = block;
+            block->ref_count++;
+        }
+    }
+}
+
+audio_block_f32_t * AudioStream_F32::receiveReadOnly_f32(unsigned int index)
+{
+    if (index >= num_inputs_f32)
+        return NULL;
+    audio_block_f32_t *in = inputQueue_f32[index];
+    inputQueue_f32[index] = NULL;
+    return in;
+}
+
+audio_block_f32_t * AudioStream_F32::receiveWritable_f32(unsigned int index)
+{
+    audio_block_f32_t *in = receiveReadOnly_f32(index);
+
+    if (in && in->ref_count > 1)
+    {
+        audio_block_f32_t *p = allocate_f32();
+        if (p)
+        {
+            memcpy(p->data, in->data, sizeof(p->data));
+            p->length = in->length;
+            p->fs_Hz  = in->fs_Hz;
+        }
+        in->ref_count--;
+        in = p;
+    }
+    return in;
+}
+
+void AudioConnection_F32::connect(void)
+{
+    AudioConnection_F32 **p = &src.destination_list_f32;
+
+    while (*p)
+        p = &(*p)->next_dest;
+    *p = this;
+    src.active = true;
+    dst.active = true;
+}
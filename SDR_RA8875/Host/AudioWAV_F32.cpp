@@ -0,0 +1,195 @@
+//
+//    AudioWAV_F32.cpp
+//
+//  WAV file input and output objects for the host graph runner.  See AudioWAV_F32.h
+//
+#include "AudioWAV_F32.h"
+
+static uint32_t _le(const uint8_t *b, uint8_t n)
+{
+    uint32_t v = 0;
+
+    for (uint8_t i = 0; i < n; i++)
+        v |= (uint32_t) b[i] << (8 * i);
+    return v;
+}
+
+static void _put_le(uint8_t *b, uint32_t v, uint8_t n)
+{
+    for (uint8_t i = 0; i < n; i++, v >>= 8)
+        b[i] = (uint8_t) v;
+}
+
+bool AudioInputWAV_F32::open(const char *path)
+{
+    uint8_t  h[40];
+    uint16_t channels = 0;
+
+    close();
+    file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    if (fread(h, 1, 12, file) != 12 || memcmp(h, "RIFF", 4) || memcmp(h + 8, "WAVE", 4))
+    {
+        fprintf(stderr, "%s: not a WAV file\n", path);
+        close();
+        return false;
+    }
+    format = 0;
+    while (fread(h, 1, 8, file) == 8)
+    {
+        uint32_t size = _le(h + 4, 4);
+        if (!memcmp(h, "fmt ", 4))
+        {
+            if (size < 16 || fread(h, 1, (size < 40) ? size : 40, file) < 16)
+                break;
+            format   = _le(h, 2);
+            channels = _le(h + 2, 2);
+            rate     = (float) _le(h + 4, 4);
+            bits     = _le(h + 14, 2);
+            if (format == 0xFFFE && size >= 26)     // WAVE_FORMAT_EXTENSIBLE, the sub format says which
+                format = _le(h + 24, 2);
+            if (size > 40)
+                fseek(file, size - 40, SEEK_CUR);
+        }
+        else if (!memcmp(h, "data", 4))
+        {
+            if (channels != 2 || !((format == 1 && (bits == 16 || bits == 24)) || (format == 3 && bits == 32)))
+            {
+                fprintf(stderr, "%s: need 2 channels of 16 or 24 bit PCM or 32 bit float\n", path);
+                close();
+                return false;
+            }
+            left   = size / (channels * bits / 8);
+            blocks = 0;
+            frames = 0;
+            onset  = -1;
+            return true;
+        }
+        else
+            fseek(file, size + (size & 1), SEEK_CUR);
+    }
+    fprintf(stderr, "%s: no fmt or data chunk\n", path);
+    close();
+    return false;
+}
+
+void AudioInputWAV_F32::close(void)
+{
+    if (file)
+        fclose(file);
+    file = NULL;
+    left = 0;
+}
+
+void AudioInputWAV_F32::update(void)
+{
+    audio_block_f32_t *out_i = allocate_f32();
+    audio_block_f32_t *out_q = allocate_f32();
+    uint8_t            frame[8];
+    uint8_t            bytes = bits / 8;
+
+    if (!out_i || !out_q)
+    {
+        release(out_i);
+        release(out_q);
+        return;
+    }
+    for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+    {
+        float s[2] = {0.0f, 0.0f};
+        if (left && fread(frame, bytes, 2, file) == 2)
+        {
+            left--;
+            for (uint8_t c = 0; c < 2; c++)
+            {
+                uint32_t v = _le(frame + c * bytes, bytes);
+                if (format == 3)
+                    memcpy(&s[c], &v, sizeof(float));
+                else if (bits == 16)
+                    s[c] = (int16_t) v / 32768.0f;
+                else
+                    s[c] = ((int32_t) (v << 8) >> 8) / 8388608.0f;
+            }
+        }
+        else
+            left = 0;
+        if (onset < 0 && fabsf(s[0]) > WAV_ONSET_LEVEL)
+            onset = frames + i;
+        out_i->data[i] = s[0];
+        out_q->data[i] = s[1];
+    }
+    frames += AUDIO_BLOCK_SAMPLES;
+    out_i->length = out_q->length = AUDIO_BLOCK_SAMPLES;
+    blocks++;
+    transmit(out_i, 0);
+    transmit(out_q, 1);
+    release(out_i);
+    release(out_q);
+}
+
+bool AudioOutputWAV_F32::open(const char *path, float rate)
+{
+    uint8_t h[44] = {0};
+
+    close();
+    file = fopen(path, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "%s: cannot create\n", path);
+        return false;
+    }
+    memcpy(h, "RIFF", 4);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    _put_le(h + 16, 16, 4);
+    _put_le(h + 20, 3, 2);                  // float
+    _put_le(h + 22, 2, 2);
+    _put_le(h + 24, (uint32_t) rate, 4);
+    _put_le(h + 28, (uint32_t) rate * 8, 4);
+    _put_le(h + 32, 8, 2);
+    _put_le(h + 34, 32, 2);
+    memcpy(h + 36, "data", 4);
+    fwrite(h, 1, sizeof(h), file);
+    frames = 0;
+    onset  = -1;
+    return true;
+}
+
+void AudioOutputWAV_F32::close(void)
+{
+    uint8_t b[4];
+
+    if (!file)
+        return;
+    fseek(file, 4, SEEK_SET);
+    _put_le(b, 36 + frames * 8, 4);
+    fwrite(b, 1, 4, file);
+    fseek(file, 40, SEEK_SET);
+    _put_le(b, frames * 8, 4);
+    fwrite(b, 1, 4, file);
+    fclose(file);
+    file = NULL;
+}
+
+void AudioOutputWAV_F32::update(void)
+{
+    audio_block_f32_t *in[2] = {receiveReadOnly_f32(0), receiveReadOnly_f32(1)};
+
+    if (file)
+    {
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+            for (uint8_t c = 0; c < 2; c++)
+            {
+                float s = (in[c]) ? in[c]->data[i] : 0.0f;
+                if (c == 0 && onset < 0 && fabsf(s) > WAV_ONSET_LEVEL)
+                    onset = frames + i;
+                fwrite(&s, sizeof(float), 1, file);
+            }
+        frames += AUDIO_BLOCK_SAMPLES;
+    }
+    release(in[0]);
+    release(in[1]);
+}
@@ -0,0 +1,58 @@
+//
+//    AudioWAV_F32.h
+//
+//  Stand-ins for AudioInputI2S_F32 and AudioOutputI2S_F32 on the host.  The input reads a stereo WAV, I on the left
+//  and Q on the right, 16 or 24 bit PCM or 32 bit float, 1 block per update.  Past the end it sends silence and
+//  done() goes true.  The output writes its 2 inputs to a 32 bit float stereo WAV, a missing block as silence.
+//  Both keep the frame the left channel first goes over WAV_ONSET_LEVEL, for measuring the latency in between.
+//
+#ifndef _AUDIO_WAV_F32_H_
+#define _AUDIO_WAV_F32_H_
+
+#include <Arduino.h>
+#include <AudioStream_F32.h>
+
+#define WAV_ONSET_LEVEL     0.1f
+
+class AudioInputWAV_F32 : public AudioStream_F32
+{
+  public:
+    AudioInputWAV_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL), file(NULL), left(0), blocks(0),
+                                                           frames(0), onset(-1) {}
+    bool     open(const char *path);    // false with the reason printed if it is not a stereo WAV this can read
+    void     close(void);
+    float    getRate(void)      { return rate; }
+    bool     done(void)         { return left == 0; }
+    uint32_t getBlocks(void)    { return blocks; }      // blocks sent, the last one padded
+    int32_t  getOnset(void)     { return onset; }       // -1 if it never went over WAV_ONSET_LEVEL
+    virtual void update(void);
+
+  private:
+    FILE    *file;
+    float    rate;
+    uint16_t format;                    // 1 PCM, 3 float
+    uint16_t bits;
+    uint32_t left;                      // frames not read yet
+    uint32_t blocks;
+    uint32_t frames;                    // frames sent
+    int32_t  onset;
+};
+
+class AudioOutputWAV_F32 : public AudioStream_F32
+{
+  public:
+    AudioOutputWAV_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray), file(NULL), frames(0),
+                                                            onset(-1) {}
+    bool     open(const char *path, float rate);
+    void     close(void);               // writes the final lengths in the header
+    int32_t  getOnset(void)     { return onset; }
+    virtual void update(void);
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+    FILE    *file;
+    uint32_t frames;
+    int32_t  onset;
+};
+
+#endif  // _AUDIO_WAV_F32_H_
@@ -0,0 +1,118 @@
+//
+//    DisplayHost.cpp
+//
+//  The globals of SDR_RA8875.ino the display files use, the glyphless fonts and the host clock, for display_runner
+//  and display_test.  See DisplayHost.h.
+//
+#include <time.h>
+#include "DisplayHost.h"
+#include "SDR_Data.h"
+
+HostSerial  Serial;
+uint64_t    host_clock_us = 0;
+InternalTemperatureClass InternalTemperature;
+
+uint32_t host_cycles(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) ((uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+// No glyphs, Headless_TFT moves the cursor 6 pixels a character.  line_space and cap_height are the real fonts'.
+#define HOST_FONT(name, line, cap)  const ILI9341_t3_font_t name = {NULL, NULL, NULL, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, line, cap}
+HOST_FONT(Arial_8,   9,  6);    HOST_FONT(Arial_9,  10,  7);    HOST_FONT(Arial_10, 11,  7);    HOST_FONT(Arial_11, 13,  8);
+HOST_FONT(Arial_12, 14,  9);    HOST_FONT(Arial_13, 15, 10);    HOST_FONT(Arial_14, 16, 10);    HOST_FONT(Arial_16, 18, 12);
+HOST_FONT(Arial_18, 21, 13);    HOST_FONT(Arial_20, 23, 15);    HOST_FONT(Arial_24, 27, 18);    HOST_FONT(Arial_28, 32, 20);
+HOST_FONT(Arial_32, 36, 23);    HOST_FONT(Arial_40, 45, 29);    HOST_FONT(Arial_48, 54, 35);    HOST_FONT(Arial_60, 68, 43);
+HOST_FONT(Arial_72, 81, 52);    HOST_FONT(Arial_96, 108, 69);
+HOST_FONT(Arial_8_Bold,   9,  6);   HOST_FONT(Arial_9_Bold,  10,  7);   HOST_FONT(Arial_10_Bold, 11,  7);
+HOST_FONT(Arial_11_Bold, 13,  8);   HOST_FONT(Arial_12_Bold, 14,  9);   HOST_FONT(Arial_13_Bold, 15, 10);
+HOST_FONT(Arial_14_Bold, 16, 10);   HOST_FONT(Arial_16_Bold, 18, 12);   HOST_FONT(Arial_18_Bold, 21, 13);
+HOST_FONT(Arial_20_Bold, 23, 15);   HOST_FONT(Arial_24_Bold, 27, 18);   HOST_FONT(Arial_28_Bold, 32, 20);
+HOST_FONT(Arial_32_Bold, 36, 23);   HOST_FONT(Arial_40_Bold, 45, 29);   HOST_FONT(Arial_48_Bold, 54, 35);
+HOST_FONT(Arial_60_Bold, 68, 43);   HOST_FONT(Arial_72_Bold, 81, 52);   HOST_FONT(Arial_96_Bold, 108, 69);
+
+//------------------------------------------- Same as SDR_RA8875.ino -------------------------------------------------
+
+#ifdef USE_RA8875
+    RA8875 tft    = RA8875(RA8875_CS,RA8875_RESET); //initialize the display object
+#else
+    RA8876_t3 tft = RA8876_t3(RA8876_CS,RA8876_RESET); //initiate the display object
+#endif
+
+uint8_t     user_Profile            = 0;
+uint8_t     curr_band               = BAND80M;
+uint32_t    VFOA                    = 0;
+uint32_t    VFOB                    = 0;
+int32_t     ModeOffset              = 0;
+uint8_t     popup                   = 0;
+uint8_t     display_state;
+bool        MeterInUse;
+uint8_t     MF_client;
+Metro       popup_timer             = Metro(500);
+Metro       meter                   = Metro(400);
+
+float       sample_rate_Hz          = 48000.0f;
+const int   audio_block_samples     = AUDIO_BLOCK_SAMPLES;
+float       pan                     = 0.0f;
+uint16_t    filterCenter            = 1450;
+uint16_t    filterBandwidth         = 2800;
+uint16_t    fft_size                = FFT_SIZE;
+int16_t     fft_bins                = fft_size;
+float       fft_bin_size            = sample_rate_Hz/(fft_size*2);
+
+AudioSettings_F32           audio_settings(sample_rate_Hz, audio_block_samples);
+AudioInputWAV_F32           Input(audio_settings);
+AudioAnalyzeZoomFFT_IQ_F32  myFFT(audio_settings);
+AudioAnalyzePeak_F32        S_Peak(audio_settings);
+AudioConnection_F32         patchCord_FFT_I(Input, 0, myFFT, 0);
+AudioConnection_F32         patchCord_FFT_Q(Input, 1, myFFT, 1);
+AudioConnection_F32         patchCord_Peak(Input, 0, S_Peak, 0);
+
+//------------------------------------------- Host -------------------------------------------------------------------
+
+// As the display part of setup().  size is the spectrum FFT size
+void display_setup(uint16_t size)
+{
+    AudioMemory_F32(20, audio_settings);
+    myFFT.setSampleRate(sample_rate_Hz);
+    myFFT.setFFTSize(size);
+    fft_size     = myFFT.getFFTSize();
+    fft_bins     = fft_size;
+    fft_bin_size = myFFT.getBinSize()/2;
+
+    tft.begin();
+    #ifndef USE_RA8875
+    tft.displayImageStartAddress(PAGE1_START_ADDR);
+    tft.canvasImageStartAddress(PAGE1_START_ADDR);
+    setActiveWindow_default();
+    #endif
+    tft.fillScreen(BLACK);
+    MF_client  = user_settings[user_Profile].default_MF_client;
+    MeterInUse = false;
+    initSpectrum(user_settings[user_Profile].sp_preset);
+    curr_band  = user_settings[user_Profile].last_band;
+    VFOA       = bandmem[curr_band].vfo_A_last;
+    VFOB       = user_settings[user_Profile].sub_VFO;
+    drawSpectrumFrame(user_settings[user_Profile].sp_preset);
+    displayRefresh();
+}
+
+// 1 pass of the update list, then the clock moves on by 1 block
+void display_block(void)
+{
+    static uint64_t samples = 0;
+
+    software_isr();
+    samples += AUDIO_BLOCK_SAMPLES;
+    host_clock_us = samples * 1000000ULL / (uint64_t) sample_rate_Hz;
+}
+
+// 1 step of spectrum_update(), as loop() calls it
+void display_spectrum(void)
+{
+    spectrum_update(user_settings[user_Profile].sp_preset, 1, VFOA, VFOB, ModeOffset, filterCenter, filterBandwidth, pan,
+                    fft_size, fft_bin_size, fft_bins);
+}
@@ -0,0 +1,38 @@
+//
+//    DisplayHost.h
+//
+//  What display_runner and display_test share:  the globals of SDR_RA8875.ino the display files use, with the WAV
+//  input feeding myFFT and S_Peak, the host clock and the display part of setup().  In DisplayHost.cpp.
+//
+#ifndef _DISPLAY_HOST_H_
+#define _DISPLAY_HOST_H_
+
+#include "SDR_RA8875.h"
+#include "AudioWAV_F32.h"
+
+#ifdef USE_RA8875
+    extern RA8875       tft;
+#else
+    extern RA8876_t3    tft;
+#endif
+extern uint8_t          user_Profile;
+extern uint32_t         VFOA, VFOB;
+extern int32_t          ModeOffset;
+extern Metro            meter;
+extern float            sample_rate_Hz;
+extern float            pan;
+extern uint16_t         filterCenter, filterBandwidth;
+extern uint16_t         fft_size;
+extern int16_t          fft_bins;
+extern float            fft_bin_size;
+extern struct User_Settings user_settings[];
+extern AudioSettings_F32            audio_settings;
+extern AudioInputWAV_F32            Input;
+extern AudioAnalyzeZoomFFT_IQ_F32   myFFT;
+
+void software_isr(void);                // Libraries/cores/AudioStream.cpp, 1 pass of the update list
+void display_setup(uint16_t size);      // as the display part of setup(), size is the spectrum FFT size
+void display_block(void);               // 1 pass of the update list, the clock moves on by 1 block
+void display_spectrum(void);            // 1 step of spectrum_update()
+
+#endif  // _DISPLAY_HOST_H_
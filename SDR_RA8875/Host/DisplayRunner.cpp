@@ -0,0 +1,134 @@
+//
+//    DisplayRunner.cpp
+//
+//  Runs the radio's spectrum, waterfall, frequency display and S meter on a PC with the Headless_TFT framebuffer, from
+//  an IQ WAV file, and writes the screen to a PPM file.
+//
+//  Spectrum_RA887x.cpp, Display.cpp and Smeter.cpp are built as they are with SDR_RA8875.h, RadioConfig.h and
+//  SDR_Data.h (HostDisplay.h turns on HEADLESS_TFT), so the layouts and tables are the radio's.  The WAV feeds myFFT
+//  and S_Peak straight, the rest of the audio graph is not in this build.  The main loop is cut down to the display
+//  calls of loop():  spectrum_update() every pass and Peak() on the meter timer.  Each pass is 1 audio block on the
+//  virtual clock, so spect_wf_rate and the other Metro timers run as they do on the radio.
+//
+//  Usage:  display_runner [options] in.wav out.ppm
+//      -f n                spectrum FFT size, default FFT_SIZE
+//      -w copy|single|ring waterfall scroll, Spectrum_Set_WF_Scroll().  single is RA8875 only, ring RA8876 only
+//      -s crop|max|mean|peak   span mode, Spectrum_Set_Span()
+//      -t s                seconds of in.wav to run, default all of it
+//      -b                  print 1 benchmark line, per spectrum frame:  drawing commands, pixels drawn, pixels moved
+//                          by block moves and host time in spectrum_update()
+//
+//  make display DISPLAY=RA8876 builds display_runner_8876 for the RA8876 screen.
+//
+#include "DisplayHost.h"
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: display_runner [-f fft_size] [-w copy|single|ring] [-s crop|max|mean|peak] [-t seconds] [-b] in.wav out.ppm\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    uint16_t    size = FFT_SIZE;
+    int         scroll = -1;
+    int         span = -1;
+    float       seconds = 0.0f;
+    bool        bench = false;
+    int         a;
+
+    for (a = 1; a < argc && argv[a][0] == '-' && argv[a][1]; a++)
+    {
+        const char *v = (a + 1 < argc) ? argv[a+1] : NULL;
+        if (argv[a][2])
+            return usage();
+        if (argv[a][1] == 'b')
+        {
+            bench = true;
+            continue;
+        }
+        if (!v)
+            return usage();
+        switch (argv[a][1])
+        {
+            case 'f': size = atoi(v); break;
+            case 't': seconds = atof(v); break;
+            case 's':
+                if      (strcmp(v, "crop") == 0)    span = SPAN_CROP;
+                else if (strcmp(v, "max") == 0)     span = SPAN_FIT_MAX;
+                else if (strcmp(v, "mean") == 0)    span = SPAN_FIT_MEAN;
+                else if (strcmp(v, "peak") == 0)    span = SPAN_FIT_PEAK;
+                else return usage();
+                break;
+            case 'w':
+                if      (strcmp(v, "copy") == 0)    scroll = WF_SCROLL_COPY;
+                else if (strcmp(v, "single") == 0)  scroll = WF_SCROLL_SINGLE;
+                else if (strcmp(v, "ring") == 0)    scroll = WF_SCROLL_RING;
+                else return usage();
+                break;
+            default:  return usage();
+        }
+        a++;
+    }
+    if (argc - a != 2)
+        return usage();
+    if (!Input.open(argv[a]))
+        return 1;
+    sample_rate_Hz = Input.getRate();
+    Serial.mute(bench);
+
+    display_setup(size);
+    if (scroll >= 0)
+        Spectrum_Set_WF_Scroll(scroll);
+    if (span >= 0)
+        Spectrum_Set_Span(span);
+    displayFreq();
+
+    uint64_t samples = 0;
+    uint64_t spectrum_ns = 0;
+    uint32_t frames = 0;
+    uint64_t stop = (seconds > 0.0f) ? (uint64_t) (seconds * sample_rate_Hz) : UINT64_MAX;
+
+    tft.stats_reset();
+    while (!Input.done() && samples < stop)
+    {
+        display_block();
+        samples += AUDIO_BLOCK_SAMPLES;
+        // loop() runs many times a block on the radio, spectrum_update() does 1 step a call.  4 a block is enough
+        // for all of the steps of a frame to run well inside spect_wf_rate.
+        for (uint8_t n = 0; n < 4; n++)
+        {
+            uint8_t  last  = sp_state;
+            uint32_t start = host_cycles();
+            display_spectrum();
+            spectrum_ns += host_cycles() - start;
+            if (last == SP_LABELS && sp_state == SP_IDLE)
+                frames++;
+        }
+        if (meter.check() == 1)
+            Peak();
+    }
+    Input.close();
+
+    if (bench)
+    {
+        uint32_t f = frames ? frames : 1;
+        printf("%s scroll %d  frames %4u  per frame: commands %6.1f  pixels %8.1f  moved %8.1f  host %7.1f us\n",
+               #ifdef USE_RA8875
+               "RA8875",
+               #else
+               "RA8876",
+               #endif
+               spect_wf_scroll, (unsigned) frames, (float) tft.stats.commands / f, (float) tft.stats.pixels / f,
+               (float) tft.stats.bte_pixels / f, spectrum_ns / 1000.0f / f);
+    }
+    else
+        printf("%u spectrum frames, noise floor %.1f dB, %u peaks\n", (unsigned) frames, spect_noise_floor,
+               (unsigned) spect_peak_count);
+    if (!tft.saveImage(argv[a+1]))
+    {
+        fprintf(stderr, "%s: cannot create\n", argv[a+1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,710 @@
+//
+//    DisplayTest.cpp
+//
+//  Host checks of the spectrum and waterfall code in Spectrum_RA887x.cpp, built with the same files as display_runner.
+//  Each test prints 1 line, "ok" or "FAIL" and what it measured.  The exit status is the number of failed tests.
+//
+//  Usage:  display_test [-b]
+//      -b                  also print the host timing of the old and new paths where a test has both
+//
+//  make test builds and runs it.
+//
+#include <algorithm>
+#include <vector>
+#include "DisplayHost.h"
+
+// Spectrum_RA887x.cpp internals under test, not in Spectrum_RA887x.h
+int16_t _waterfall_color_update(float sample, int16_t waterfall_low);
+void    _wf_palette_check(struct Spectrum_Parms *pp);
+void    _span_reduce(float *bins, uint16_t nbins, float *out, int16_t npix, uint8_t mode);
+uint8_t _find_FFT_Candidates(const float *pwr, int16_t npix, int16_t dc, float keep, struct Spectrum_Peak *cand);
+void    _noise_floor_update(const float *pwr, int16_t npix, int16_t dc_pix, float hz_per_pix);
+extern uint8_t  wf_palette_sel;
+extern float    nf_hist[];
+extern float    nf_hist_total;
+extern float    span_FFT[];
+extern float    spect_bins_per_pixel;
+extern int16_t  wf_palette_low_ofs;
+extern struct Spectrum_Parms *ptr;
+
+static bool     bench = false;
+static int      failed = 0;
+
+static void result(bool ok, const char *name, const char *fmt, ...)
+{
+    va_list ap;
+
+    printf("%-4s  %-24s ", ok ? "ok" : "FAIL", name);
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+    if (!ok)
+        failed++;
+}
+
+// Largest difference of the 5/6/5 bit fields of 2 RGB565 colors
+static int color_diff(uint16_t a, uint16_t b)
+{
+    int r = abs((a >> 11) - (b >> 11));
+    int g = abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F));
+    int l = abs((a & 0x1F) - (b & 0x1F));
+    return max(r, max(g, l));
+}
+
+// Waterfall style 6.  The palette table with _wf_palette_lookup() is to give the colors _waterfall_color_update() did,
+// within 1 step of the table, for preset 0's floor and scale and a range of pix_min.  The steep parts of the gradient go
+// 255 in 1/9 of the range, so 1 step of 256 is up to 3 of the 6 bit green.  With -b, the per pixel cost of both.
+static void test_palette(void)
+{
+    struct Spectrum_Parms *pp = &Sp_Parms_Def[0];
+    const int16_t  pix_mins[] = { -130, -110, -95, -80 };
+    int            worst = 0;
+    uint32_t       n = 0;
+
+    wf_palette_sel = WF_PALETTE_G0ORX;
+    _wf_palette_check(pp);
+    for (int16_t pix_min : pix_mins)
+    {
+        float lo = (float) (pix_min + wf_palette_low_ofs);
+        float k  = (WF_PALETTE_HIGH > lo) ? WF_PALETTE_SIZE / (WF_PALETTE_HIGH - lo) : 1.0e6f;
+
+        for (float s = -160.0f; s <= 0.0f; s += 0.0625f, n++)
+            worst = max(worst, color_diff(_waterfall_color_update(s, pix_min), _wf_palette_lookup(s, lo, k)));
+    }
+    result(worst <= 3, "palette_colors", "%u samples, largest RGB565 field difference %d (limit 3)", (unsigned) n, worst);
+
+    if (!bench)
+        return;
+
+    // 1 waterfall line of the RA8876 layout at a time, a few thousand times, spread over the range
+    const int   width = 1000;
+    const int   lines = 4000;
+    float       line[width];
+    int16_t     out[width];
+    int16_t     pix_min = -110;
+    float       lo = (float) (pix_min + wf_palette_low_ofs);
+    float       k  = WF_PALETTE_SIZE / (WF_PALETTE_HIGH - lo);
+    uint32_t    sum = 0;
+
+    for (int i = 0; i < width; i++)
+        line[i] = -140.0f + 120.0f * (float) ((i * 37) % width) / width;
+
+    uint32_t start = host_cycles();
+    for (int l = 0; l < lines; l++)
+    {
+        for (int i = 0; i < width; i++)
+            out[i] = _waterfall_color_update(line[i], pix_min);
+        sum += out[l % width];
+    }
+    uint32_t old_ns = host_cycles() - start;
+
+    start = host_cycles();
+    for (int l = 0; l < lines; l++)
+    {
+        _wf_palette_check(pp);      // once a line as spectrum_update() does
+        for (int i = 0; i < width; i++)
+            out[i] = _wf_palette_lookup(line[i], lo, k);
+        sum += out[l % width];
+    }
+    uint32_t new_ns = host_cycles() - start;
+
+    printf("      palette per pixel:  _waterfall_color_update() %.2f ns  _wf_palette_lookup() %.2f ns  (%u)\n",
+           (float) old_ns / (lines * width), (float) new_ns / (lines * width), (unsigned) (sum & 1));
+}
+
+//
+//  Test scenes.  write_scene() writes an IQ WAV at 48 kHz for display_setup():  complex gaussian noise at noise_db
+//  (dBFS, -200 for none) and tones at an offset from the carrier, each with a level and a sweep in Hz a second.
+//  I = cos, Q = sin puts a tone at +hz on the spectrum, which is how myFFT sees the radio's Input.
+//
+struct Scene_Tone {
+    float   hz;
+    float   db;
+    float   sweep;
+};
+
+static bool write_scene(const char *path, float seconds, const Scene_Tone *tones, int ntones, float noise_db)
+{
+    FILE     *f = fopen(path, "wb");
+    uint32_t  frames = (uint32_t) (seconds * 48000.0f);
+    uint32_t  seed = 12345;
+    double    phase[8] = {};
+
+    if (f == NULL || ntones > 8)
+        return false;
+    auto put16 = [f](uint16_t v) { fputc(v & 0xFF, f); fputc(v >> 8, f); };
+    auto put32 = [f](uint32_t v) { fputc(v & 0xFF, f); fputc((v >> 8) & 0xFF, f); fputc((v >> 16) & 0xFF, f); fputc(v >> 24, f); };
+    auto gauss = [&seed](void) {
+        seed = seed * 1664525u + 1013904223u;   float u1 = ((seed >> 8) + 0.5f) / 16777216.0f;
+        seed = seed * 1664525u + 1013904223u;   float u2 = ((seed >> 8) + 0.5f) / 16777216.0f;
+        return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+    };
+    fwrite("RIFF", 1, 4, f);    put32(36 + frames*4);   fwrite("WAVEfmt ", 1, 8, f);
+    put32(16);  put16(1);   put16(2);   put32(48000);   put32(48000*4);     put16(4);   put16(16);
+    fwrite("data", 1, 4, f);    put32(frames*4);
+    float noise = powf(10.0f, noise_db/20.0f) / sqrtf(2.0f);     // per channel, so I+Q is noise_db
+    for (uint32_t n = 0; n < frames; n++)
+    {
+        float i = noise * gauss();
+        float q = noise * gauss();
+        for (int t = 0; t < ntones; t++)
+        {
+            float a = powf(10.0f, tones[t].db/20.0f);
+            i += a * cos(phase[t]);
+            q += a * sin(phase[t]);
+            phase[t] += 6.283185307 * (tones[t].hz + tones[t].sweep * n / 48000.0) / 48000.0;
+        }
+        put16((uint16_t) (int16_t) constrain(lrintf(i * 32767.0f), -32768L, 32767L));
+        put16((uint16_t) (int16_t) constrain(lrintf(q * 32767.0f), -32768L, 32767L));
+    }
+    fclose(f);
+    return true;
+}
+
+// The screen as shown, with the RA8876 PIP window
+static void screen(std::vector<uint16_t> &v)
+{
+    v.resize(SCREEN_WIDTH * SCREEN_HEIGHT);
+    for (int16_t y = 0; y < SCREEN_HEIGHT; y++)
+        for (int16_t x = 0; x < SCREEN_WIDTH; x++)
+            v[y*SCREEN_WIDTH + x] = tft.getScreenPixel(x, y);
+}
+
+// Waterfall scroll, RA8876.  Each line the waterfall on the screen is to move down 1 row, through more lines than the
+// ring has rows so it wraps, with no block moves in the waterfall steps.  The pop up windows and a change of scroll
+// method are not to change the screen.
+static void test_wf_ring(void)
+{
+#ifndef USE_RA8875
+    const Scene_Tone chirp[] = { {-9000.0f, -30.0f, 400.0f}, {4000.0f, -50.0f, 0.0f} };
+    std::vector<uint16_t> before, after;
+
+    if (!write_scene("build/test_chirp.wav", 45.0f, chirp, 2, -90.0f) || !Input.open("build/test_chirp.wav"))
+    {
+        result(false, "wf_ring_scroll", "cannot write build/test_chirp.wav");
+        return;
+    }
+    display_setup(FFT_SIZE);
+    Spectrum_Set_WF_Scroll(WF_SCROLL_RING);
+
+    struct Spectrum_Parms *p = &Sp_Parms_Def[user_settings[user_Profile].sp_preset];
+    int16_t  x0 = p->l_graph_edge+1;
+    int16_t  y0 = p->wf_top_line+1;
+    int16_t  rows = p->wf_bottom_line - p->wf_top_line - 2;
+    int      lines[2] = {}, bad[2] = {}, switched = 0;
+    uint32_t moved[2] = {}, bte = 0;
+
+    for (int pass = 0; pass < 2; pass++)   // ring, then copy
+    {
+        while (!Input.done() && lines[pass] < rows + rows/2)
+        {
+            display_block();
+            for (uint8_t n = 0; n < 4; n++)
+            {
+                uint8_t last = sp_state;
+                if (last == SP_WF_MOVE1)
+                {
+                    screen(before);
+                    bte = tft.stats.bte_pixels;
+                }
+                display_spectrum();
+                if (last != SP_TRACE && sp_state == SP_TRACE)
+                {
+                    screen(after);
+                    moved[pass] += tft.stats.bte_pixels - bte;
+                    lines[pass]++;
+                    // the copy method leaves the last 2 columns, only the ring scrolls all of them
+                    for (int16_t y = 1; y < rows; y++)
+                        for (int16_t x = x0; x < x0 + p->wf_sp_width - 2*pass; x++)
+                            if (after[(y0+y)*SCREEN_WIDTH + x] != before[(y0+y-1)*SCREEN_WIDTH + x])
+                            {
+                                bad[pass]++;
+                                y = rows;
+                                break;
+                            }
+                }
+            }
+        }
+        if (pass == 0)
+        {
+            screen(before);
+            Spectrum_Popup(true);
+            screen(after);
+            switched += (after != before);
+            Spectrum_Popup(false);
+            screen(after);
+            switched += (after != before);
+            Spectrum_Set_WF_Scroll(WF_SCROLL_COPY);
+            screen(after);
+            switched += (after != before);
+        }
+    }
+    screen(before);
+    Spectrum_Set_WF_Scroll(WF_SCROLL_RING);
+    screen(after);
+    switched += (after != before);
+    Input.close();
+
+    result(lines[0] > rows && bad[0] == 0 && moved[0] == 0, "wf_ring_scroll",
+           "%d lines on %d rows, %d not scrolled, %u pixels moved", lines[0], rows, bad[0], (unsigned) moved[0]);
+    result(lines[1] > 0 && bad[1] == 0, "wf_copy_scroll",
+           "%d lines, %d not scrolled, %.0f pixels moved a line", lines[1], bad[1], (float) moved[1] / max(lines[1], 1));
+    result(switched == 0, "wf_ring_switch", "%d of pop up, pop down, ring to copy, copy to ring changed the screen", switched);
+#endif
+}
+
+// The span reducer as it was, mean power with expf() a bin and logf() a pixel
+static void span_reduce_ref(const float *bins, uint16_t nbins, float *out, int16_t npix, uint8_t mode)
+{
+    uint16_t b = 0;
+
+    for (int16_t p = 0; p < npix; p++)
+    {
+        uint16_t b_end = ((uint32_t) (p+1) * nbins) / npix;
+        float    mx  = -200.0f;
+        float    sum = 0.0f;
+        for (uint16_t n = b; n < b_end; n++)
+        {
+            float v = bins[n];
+            if (v > mx)
+                mx = v;
+            if (mode != SPAN_FIT_MAX)
+                sum += expf(v * 0.23025851f);
+        }
+        float v = 4.3429448f * logf(sum / (b_end - b));
+        if (mode == SPAN_FIT_MAX || (mode == SPAN_FIT_PEAK && mx - v > SPAN_PEAK_DB))
+            v = mx;
+        out[p] = v;
+        b = b_end;
+    }
+}
+
+// SPAN_FIT_xxx.  _span_reduce() sums power in dB with its log add table.  It is to be within 0.05 dB of the expf()/logf()
+// sums on noise with carriers, for the FFT sizes and graph widths of both screens, even and uneven groups.
+// With -b, the cost of both per FFT frame.
+static void test_span(void)
+{
+    const uint16_t sizes[][2] = { {4096, 500}, {2048, 700}, {1024, 500}, {4096, 757}, {4096, SCREEN_WIDTH} };
+    static float   bins[4096];
+    static float   out[SPAN_BUF_SIZE], ref[SPAN_BUF_SIZE];
+    float          worst = 0.0f;
+    uint32_t       seed = 1;
+
+    for (int i = 0; i < 4096; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float u = ((seed >> 8) + 0.5f) / 16777216.0f;
+        bins[i] = -120.0f + 10.0f * log10f(-logf(u));        // Rayleigh noise, exponential power
+        if (i % 397 == 0)
+            bins[i] += 60.0f;                               // a carrier now and then
+    }
+    static float   mean[SPAN_BUF_SIZE], peak[SPAN_BUF_SIZE];
+    int            edge = 0;
+
+    for (auto &sz : sizes)
+    {
+        span_reduce_ref(bins, sz[0], mean, sz[1], SPAN_FIT_MEAN);
+        span_reduce_ref(bins, sz[0], peak, sz[1], SPAN_FIT_MAX);
+        for (uint8_t mode = SPAN_FIT_MAX; mode < SPAN_NUM; mode++)
+        {
+            _span_reduce(bins, sz[0], out, sz[1], mode);
+            span_reduce_ref(bins, sz[0], ref, sz[1], mode);
+            for (int p = 0; p < sz[1]; p++)
+            {
+                // SPAN_FIT_PEAK may pick the other side when the peak is SPAN_PEAK_DB above the mean to 0.05 dB
+                if (mode == SPAN_FIT_PEAK && fabsf(peak[p] - mean[p] - SPAN_PEAK_DB) < 0.05f)
+                {
+                    edge++;
+                    continue;
+                }
+                worst = max(worst, fabsf(out[p] - ref[p]));
+            }
+        }
+    }
+    result(worst <= 0.05f, "span_reduce", "largest difference to expf()/logf() %.3f dB (limit 0.05), %d at the peak edge",
+           worst, edge);
+
+    if (!bench)
+        return;
+
+    const int frames = 2000;
+    uint32_t  start = host_cycles();
+    for (int f = 0; f < frames; f++)
+        span_reduce_ref(bins, 4096, ref, 700, SPAN_FIT_PEAK);
+    uint32_t  old_ns = host_cycles() - start;
+    start = host_cycles();
+    for (int f = 0; f < frames; f++)
+        _span_reduce(bins, 4096, out, 700, SPAN_FIT_PEAK);
+    uint32_t  new_ns = host_cycles() - start;
+    printf("      span 4096 bins to 700 pixels:  expf()/logf() %.1f us  log add %.1f us\n",
+           old_ns / 1000.0f / frames, new_ns / 1000.0f / frames);
+}
+
+// All the local maxima the peak search is to look at, the scalar search it had before the block search
+static int peaks_ref(const float *pwr, int16_t npix, int16_t dc, float keep, struct Spectrum_Peak *list)
+{
+    int n = 0;
+
+    for (int16_t i = 2; i < npix-2; i++)
+    {
+        float v = pwr[i];
+        if (!(v >= keep) || v <= pwr[i-1] || v < pwr[i+1] || (i >= dc-1 && i <= dc+1))
+            continue;
+        list[n].bin = i;
+        list[n].dB  = v;
+        n++;
+    }
+    return n;
+}
+
+// Peak search.  _find_FFT_Candidates() skips blocks under the threshold with arm_max_f32().  It is to give what the
+// scalar search gave:  each candidate a local maximum, and each local maximum left out either next to a stronger
+// candidate or weaker than a full list.  Then on a scene with 3 carriers, spectrum_update() is to track just those 3,
+// each within half a pixel of its frequency.  With -b, the cost of both searches.
+static void test_peaks(void)
+{
+    static float          pwr[SCREEN_WIDTH];
+    static Spectrum_Peak  all[SCREEN_WIDTH];
+    struct Spectrum_Peak  cand[SPECT_PEAKS_MAX];
+    const int16_t         npix = SCREEN_WIDTH - 24;
+    uint32_t              seed = 7;
+    int                   bad = 0, frames = 0, found = 0;
+
+    auto fill = [&](int carriers) {
+        for (int i = 0; i < npix; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            float u = ((seed >> 8) + 0.5f) / 16777216.0f;
+            pwr[i] = -120.0f + 10.0f * log10f(-logf(u));
+        }
+        for (int c = 0; c < carriers; c++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            int   x = 3 + (seed >> 8) % (npix - 6);
+            float a = -100.0f + (seed & 0x3F);
+            pwr[x-1] = max(pwr[x-1], a - 6.0f);
+            pwr[x]   = max(pwr[x], a);
+            pwr[x+1] = max(pwr[x+1], a - 9.0f);
+        }
+    };
+    for (frames = 0; frames < 500; frames++)
+    {
+        fill(frames % 24);
+        float keep = -120.0f + SPECT_PEAK_THRESH_DB;
+        int   nc = _find_FFT_Candidates(pwr, npix, npix/2, keep, cand);
+        int   na = peaks_ref(pwr, npix, npix/2, keep, all);
+        for (int k = 0; k < nc; k++)
+        {
+            int j;
+            for (j = 0; j < na && fabsf(all[j].bin - cand[k].bin) >= 0.5f; j++) ;
+            bad += (j == na);
+        }
+        for (int j = 0; j < na; j++)
+        {
+            bool ok = (nc == SPECT_PEAKS_MAX && all[j].dB <= cand[nc-1].dB);
+            for (int k = 0; k < nc && !ok; k++)
+                ok = fabsf(all[j].bin - cand[k].bin) < SPECT_PEAK_MIN_SEP + 0.5f && cand[k].dB >= all[j].dB - 0.5f;
+            bad += !ok;
+        }
+    }
+    result(bad == 0, "peak_search", "%d spectra, %d candidates not as the scalar search", frames, bad);
+
+    if (bench)
+    {
+        fill(6);
+        const int n = 20000;
+        int       sum = 0;
+        uint32_t  start = host_cycles();
+        for (int f = 0; f < n; f++)
+            sum += peaks_ref(pwr, npix, npix/2, -108.0f, all);
+        uint32_t  old_ns = host_cycles() - start;
+        start = host_cycles();
+        for (int f = 0; f < n; f++)
+            sum += _find_FFT_Candidates(pwr, npix, npix/2, -108.0f, cand);
+        uint32_t  new_ns = host_cycles() - start;
+        printf("      peak search %d pixels, 6 carriers:  scalar %.2f us  block %.2f us  (%d)\n", npix,
+               old_ns / 1000.0f / n, new_ns / 1000.0f / n, sum & 1);
+    }
+
+    // 3 carriers on the radio
+    const Scene_Tone tones[] = { {-6000.0f, -40.0f, 0.0f}, {2500.0f, -60.0f, 0.0f}, {9000.0f, -50.0f, 0.0f} };
+    if (!write_scene("build/test_carriers.wav", 3.0f, tones, 3, -90.0f) || !Input.open("build/test_carriers.wav"))
+    {
+        result(false, "peak_track", "cannot write build/test_carriers.wav");
+        return;
+    }
+    display_setup(FFT_SIZE);
+    Spectrum_Peak_Markers(true);
+    while (!Input.done())
+    {
+        display_block();
+        for (uint8_t n = 0; n < 4; n++)
+            display_spectrum();
+    }
+    Input.close();
+    float hz_pix = fft_bin_size * 2 * spect_bins_per_pixel;
+    bad = 0;
+    for (uint8_t p = 0; p < spect_peak_count; p++)
+    {
+        if (spect_peaks[p].hits < SPECT_PEAK_CONFIRM)
+            continue;
+        bool near = false;
+        for (auto &t : tones)
+            near |= fabsf((float) (spect_peaks[p].freq - (int32_t) VFOA) - t.hz) < hz_pix / 2;
+        found += near;
+        bad += !near;
+    }
+    result(found == 3 && bad == 0, "peak_track", "%d of 3 carriers within %.0f Hz, %d others", found, hz_pix / 2, bad);
+}
+
+// Touch tuning on a panned, zoomed spectrum.  Each carrier is touched a few pixels off the column the spectrum draws it
+// in, from SP_CENTER_PIX() as the filter and center line are drawn, and has to snap to its true frequency.
+static void test_touch_tune(void)
+{
+    const Scene_Tone tones[] = { {-6000.0f, -40.0f, 0.0f}, {2500.0f, -60.0f, 0.0f}, {9000.0f, -50.0f, 0.0f} };
+    int found = 0;
+
+    if (!Input.open("build/test_carriers.wav"))
+    {
+        result(false, "touch_tune", "cannot open build/test_carriers.wav");
+        return;
+    }
+    display_setup(FFT_SIZE);
+    myFFT.setZoom(2);
+    fft_bin_size = myFFT.getBinSize()/2;
+    pan = 0.1f;
+    Spectrum_Peak_Markers(true);
+    while (!Input.done())
+    {
+        display_block();
+        for (uint8_t n = 0; n < 4; n++)
+            display_spectrum();
+    }
+    Input.close();
+    float hz_pix = fft_bin_size * 2 * spect_bins_per_pixel;
+    float pan_pix = myFFT.getCenter() / hz_pix;
+    int16_t vfo_x = ptr->l_graph_edge + SP_CENTER_PIX(ptr) - pan_pix;
+    for (auto &t : tones)
+    {
+        int16_t x    = vfo_x + (int16_t) lroundf(t.hz / hz_pix) + 3;
+        int32_t snap = Spectrum_Peak_Near(VFOA + Spectrum_X_Hz(x), SPECT_PEAK_SNAP_PIX * hz_pix);
+        found += snap && fabsf((float) (snap - (int32_t) VFOA) - t.hz) < hz_pix / 2;
+    }
+    myFFT.setZoom(1);
+    fft_bin_size = myFFT.getBinSize()/2;
+    pan = 0.0f;
+    result(pan_pix != 0 && found == 3, "touch_tune", "%d of 3 carriers snapped to within %.0f Hz, pan %.0f pixels",
+           found, hz_pix / 2, pan_pix);
+}
+
+// Play build/test_pan.wav through the spectrum at a zoom and pan.  Returns the confirmed peak nearest hz, NULL if none.
+static const Spectrum_Peak *pan_peak(uint8_t zoom, float pan_set, float hz)
+{
+    const Spectrum_Peak *best = NULL;
+
+    if (!Input.open("build/test_pan.wav"))
+        return NULL;
+    display_setup(FFT_SIZE);
+    myFFT.setZoom(zoom);
+    fft_bin_size = myFFT.getBinSize()/2;
+    pan = pan_set;
+    while (!Input.done())
+    {
+        display_block();
+        for (uint8_t n = 0; n < 4; n++)
+            display_spectrum();
+    }
+    Input.close();
+    for (uint8_t p = 0; p < spect_peak_count; p++)
+    {
+        if (spect_peaks[p].hits >= SPECT_PEAK_CONFIRM && (best == NULL ||
+            fabsf(spect_peaks[p].freq - VFOA - hz) < fabsf(best->freq - VFOA - hz)))
+            best = &spect_peaks[p];
+    }
+    return best;
+}
+
+// Pan at every zoom level.  A tone is to move across the screen by the pan center over the Hz per pixel, 1 pixel either
+// way, and still read its own frequency.  At x1 the mixer moves it past the band edge, those bins are to be blanked.
+static void test_pan(void)
+{
+    const Scene_Tone tone = {500.0f, -50.0f, 0.0f};
+    int  bad = 0;
+    char moved[80] = "", *m = moved;
+
+    if (!write_scene("build/test_pan.wav", 2.0f, &tone, 1, -90.0f))
+    {
+        result(false, "pan_zoom", "cannot write build/test_pan.wav");
+        return;
+    }
+    for (uint8_t zoom = 1; zoom <= ZOOM_FFT_MAX; zoom *= 2)
+    {
+        float pan_set = 0.1f / zoom;
+        const Spectrum_Peak *p0 = pan_peak(zoom, 0.0f, tone.hz);
+        Spectrum_Peak still = p0 ? *p0 : Spectrum_Peak{};
+        const Spectrum_Peak *p1 = pan_peak(zoom, pan_set, tone.hz);
+        float hz_pix = fft_bin_size * 2 * spect_bins_per_pixel;
+        float want   = myFFT.getCenter() / hz_pix;
+        float shift  = p1 ? still.bin - p1->bin : 0.0f;
+        bool  ok     = p0 && p1 && want >= 20.0f && fabsf(shift - want) <= 1.0f &&
+                       fabsf(still.freq - VFOA - tone.hz) < hz_pix/2 && fabsf(p1->freq - VFOA - tone.hz) < hz_pix/2;
+        if (zoom == 1)      // the bins from past +fs/2
+        {
+            int blank = 0;
+            for (uint16_t i = 0; i < fft_size; i++)
+                blank += (myFFT.getData()[i] == ZOOM_FFT_BLANK_DB);
+            ok &= abs(blank - (int) lroundf(myFFT.getCenter() / myFFT.getBinSize())) <= 1;
+        }
+        bad += !ok;
+        m += snprintf(m, moved + sizeof(moved) - m, " x%d %.1f/%.1f", zoom, shift, want);
+    }
+    myFFT.setZoom(1);
+    fft_bin_size = myFFT.getBinSize()/2;
+    pan = 0.0f;
+    result(bad == 0, "pan_zoom", "%d zoom levels wrong, pixels moved/wanted%s", bad, moved);
+}
+
+// Spectra as spectrum_update() captures them, 1 a frame after the span reduce, from a scene through myFFT
+typedef std::vector<std::vector<float>> Spectra;
+
+static bool record_spectra(const char *path, float seconds, const Scene_Tone *tones, int ntones, float noise_db, Spectra &rec)
+{
+    int16_t npix = Sp_Parms_Def[user_settings[user_Profile].sp_preset].wf_sp_width;
+
+    rec.clear();
+    if (!write_scene(path, seconds, tones, ntones, noise_db) || !Input.open(path))
+        return false;
+    display_setup(FFT_SIZE);
+    while (!Input.done())
+    {
+        display_block();
+        for (uint8_t n = 0; n < 4; n++)
+        {
+            uint8_t last = sp_state;
+            display_spectrum();
+            if (last == SP_CAPTURE && sp_state == SP_COLORIZE)
+                rec.push_back(std::vector<float>(span_FFT, span_FFT + npix));
+        }
+    }
+    Input.close();
+    return !rec.empty();
+}
+
+// _noise_floor_update() over recorded spectra from a clear history.  The floor after each spectrum is in floor[], the
+// plain minimum of the pixels, what pix_min was, in pmin[].
+static void replay_floor(const Spectra &rec, std::vector<float> &floor, std::vector<float> &pmin)
+{
+    memset(nf_hist, 0, SPECT_NF_CELLS * sizeof(float));
+    nf_hist_total = 0.0f;
+    floor.clear();
+    pmin.clear();
+    for (auto &v : rec)
+    {
+        int16_t npix = v.size();
+        _noise_floor_update(v.data(), npix, npix/2, fft_bin_size * 2);
+        floor.push_back(spect_noise_floor);
+        pmin.push_back(*std::min_element(v.begin() + 2, v.end() - 2));
+    }
+}
+
+// Largest change from 1 spectrum to the next and the spread of v[from..]
+static void jitter(const std::vector<float> &v, size_t from, float *step, float *spread)
+{
+    float lo = v[from], hi = v[from];
+
+    *step = 0.0f;
+    for (size_t i = from + 1; i < v.size(); i++)
+    {
+        *step = max(*step, fabsf(v[i] - v[i-1]));
+        lo = min(lo, v[i]);
+        hi = max(hi, v[i]);
+    }
+    *spread = hi - lo;
+}
+
+// Noise floor tracker on spectra recorded from the radio's FFT.  Noise at -90 and -70dBFS, with and without carriers
+// and a DC spike, and with a deep null cut into every 4th spectrum.  Once settled the floor is to hold within 1dB from
+// 1 spectrum to the next where the plain minimum jumps, to move 20dB with the noise, not to move with the carriers
+// and to follow a 20dB step in the noise within 12 spectra.  With -b, the host time of 1 update.
+static void test_noise_floor(void)
+{
+    const Scene_Tone tones[] = { {0.0f, -20.0f, 0.0f}, {-8000.0f, -30.0f, 0.0f}, {-3000.0f, -45.0f, 0.0f},
+                                 {5000.0f, -40.0f, 0.0f}, {11000.0f, -35.0f, 150.0f} };
+    const size_t settle = 12;
+    Spectra      quiet, busy, loud;
+    std::vector<float> floor, pmin;
+    float        q_floor, b_floor, l_floor, step, spread, min_step, min_spread;
+
+    if (!record_spectra("build/test_nf_quiet.wav", 6.0f, NULL, 0, -90.0f, quiet) ||
+        !record_spectra("build/test_nf_busy.wav", 6.0f, tones, 5, -90.0f, busy) ||
+        !record_spectra("build/test_nf_loud.wav", 6.0f, tones, 5, -70.0f, loud) || quiet.size() <= settle + 4)
+    {
+        result(false, "noise_floor", "cannot record the test spectra");
+        return;
+    }
+    replay_floor(quiet, floor, pmin);
+    q_floor = floor.back();
+
+    // Deep nulls, 8 pixels 60dB down in every 4th spectrum
+    for (size_t f = 0; f < busy.size(); f += 4)
+        for (int16_t i = 0; i < 8; i++)
+            busy[f][busy[f].size()/4 + i] -= 60.0f;
+    replay_floor(busy, floor, pmin);
+    b_floor = floor.back();
+    jitter(floor, settle, &step, &spread);
+    jitter(pmin, settle, &min_step, &min_spread);
+    result(step < 1.0f && spread < 1.5f, "noise_floor_steady",
+           "%.1f dB step, %.1f dB spread (limit 1, 1.5), plain minimum %.1f dB step, %.1f dB spread",
+           step, spread, min_step, min_spread);
+
+    replay_floor(loud, floor, pmin);
+    l_floor = floor.back();
+    result(fabsf(b_floor - q_floor) < 1.0f && fabsf(l_floor - b_floor - 20.0f) < 1.0f, "noise_floor_level",
+           "%.1f dB noise only, %.1f dB with carriers and nulls, %.1f dB at 20 dB more noise", q_floor, b_floor, l_floor);
+
+    // The noise steps up 20dB after the busy spectra
+    Spectra step_up(busy);
+    step_up.insert(step_up.end(), loud.begin(), loud.end());
+    replay_floor(step_up, floor, pmin);
+    size_t k = busy.size();
+    while (k < floor.size() && fabsf(floor[k] - l_floor) >= 1.0f)
+        k++;
+    result(k - busy.size() <= 12, "noise_floor_follow", "within 1 dB of the new floor %d spectra after a 20 dB step (limit 12)",
+           (int) (k - busy.size()));
+
+    if (bench)
+    {
+        const int n = 20000;
+        uint32_t  start = host_cycles();
+        for (int f = 0; f < n; f++)
+            _noise_floor_update(busy[f % busy.size()].data(), busy[0].size(), busy[0].size()/2, fft_bin_size * 2);
+        printf("      noise floor update %d pixels:  %.2f us\n", (int) busy[0].size(), (host_cycles() - start) / 1000.0f / n);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    for (int a = 1; a < argc; a++)
+    {
+        if (strcmp(argv[a], "-b") == 0)
+            bench = true;
+        else
+        {
+            fprintf(stderr, "usage: display_test [-b]\n");
+            return 2;
+        }
+    }
+    Serial.mute(true);
+
+    test_palette();
+    test_span();
+    test_wf_ring();
+    test_peaks();
+    test_touch_tune();
+    test_pan();
+    test_noise_floor();
+
+    printf("%d failed\n", failed);
+    return failed;
+}
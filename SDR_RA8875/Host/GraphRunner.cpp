@@ -0,0 +1,482 @@
+//
+//    GraphRunner.cpp
+//
+//  Runs the radio's receive audio graph on a PC, from an IQ WAV file to a WAV file, as fast as the PC goes.
+//
+//  The objects and names are the ones in SDR_RA8875.ino, built from the same source files, and the patch cords are
+//  the radio's own from RX_PatchCords.h.  The update list is run by the scheduler in Libraries/cores (software_isr()).
+//  Each pass is 1 block on a virtual clock.  AudioInputWAV_F32 and AudioOutputWAV_F32 take the place of the I2S
+//  objects.  OpenAudio objects with no source in this tree (NoiseBlanker, LMS_Notch, TwinPeak) are the pass-throughs
+//  in AudioLibrary_F32.h, which is what the radio does with them turned off.  The RX path and the TX chain of
+//  TX_PatchCords.h are built, bpf1 and the test tones from the stand-ins there.  The FM path and USB are not.
+//
+//  At the end it prints the real time factor and the per object profile from AudioProfile.cpp, in host time.
+//  The graph runs at the rate of in.wav, set up as Change_Sample_Rate() does (48, 96 or 192 kHz).
+//
+//  Usage:  graph_runner [options] in.wav out.wav
+//          graph_runner [-r Hz] -g test.wav
+//      -s usb|lsb      sideband, default usb
+//      -c Hz -w Hz     bandwidth filter center and width, default 1450 and 2800 (the 2.8 kHz filter)
+//      -a off|s|m|f    AGC-, AGC-S, AGC-M or AGC-F from agc_set[], default m
+//      -f n            spectrum FFT size, default FFT_SIZE
+//      -p file         also write the binary profile to file
+//      -b              print only 1 benchmark line:  block size, in to out latency with the I2S blocks, interrupt and
+//                      scheduler time
+//      -g file         write a test IQ WAV for -b, 1s of silence then a USB tone, and stop
+//      -r Hz           sample rate of the -g file, default 48000
+//      -m dB,deg       I/Q gain and phase error of the -g file, default 0,0
+//      -i on|off       IQ_Correct, default on.  The image rejection before and after it is printed at the end
+//      -t rx|tx        graph state for Audio_Graph_Select(), default rx.  tx switches as TX_RX_Switch() does, the mic
+//                      is channel 0 of in.wav and out.wav is the TX IQ
+//      -u              every group runs, as without USE_GRAPH_PRUNING
+//
+#include <time.h>
+#include "AudioWAV_F32.h"
+#include "AudioFilterHilbertIQ_F32.h"
+#include "AudioFilterFFTConv_F32.h"
+#include "AudioEffectAGC_F32.h"
+#include "AudioResample_F32.h"
+#include "AudioAnalyzeZoomFFT_IQ_F32.h"
+#include "AudioGraph.h"
+#include "AudioProfile.h"
+#include "AudioIQCorrect_F32.h"
+
+HostSerial  Serial;
+uint64_t    host_clock_us = 0;
+
+uint32_t host_cycles(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) ((uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+void software_isr(void);    // Libraries/cores/AudioStream.cpp, 1 pass of the update list
+
+//------------------------------------------- Same as SDR_RA8875.ino -------------------------------------------------
+
+float       sample_rate_Hz      = 48000.0f;
+const int   audio_block_samples = AUDIO_BLOCK_SAMPLES;
+
+AudioSettings_F32  audio_settings(sample_rate_Hz, audio_block_samples);
+#ifdef USE_DEMOD_DECIMATE
+  AudioSettings_F32  hilbert_settings(sample_rate_Hz / Resample_Factor(sample_rate_Hz, HILBERT_RATE_HZ), audio_block_samples);
+  AudioSettings_F32  demod_settings(hilbert_settings.sample_rate_Hz / Resample_Factor(hilbert_settings.sample_rate_Hz, DEMOD_RATE_HZ),
+                                    Resample_Block(Resample_Factor(hilbert_settings.sample_rate_Hz, DEMOD_RATE_HZ)));
+#else
+  AudioSettings_F32  hilbert_settings(sample_rate_Hz, audio_block_samples);
+  AudioSettings_F32  demod_settings(sample_rate_Hz, audio_block_samples);
+#endif
+
+DMAMEM AudioAnalyzeZoomFFT_IQ_F32 myFFT(audio_settings);
+#ifdef W7PUA_I2S_CORRECTION
+AudioAlignLR_F32            TwinPeak(audio_settings);
+#endif
+AudioInputWAV_F32           Input(audio_settings);          // AudioInputI2S_F32 on the radio
+#ifdef USE_IQ_CORRECT
+AudioIQCorrect_F32          IQ_Correct(audio_settings);
+#endif
+AudioMixer4_F32             I_Switch(audio_settings);
+AudioMixer4_F32             Q_Switch(audio_settings);
+AudioSwitch4_OA_F32         RxTx_InputSwitch_L(audio_settings);
+AudioSwitch4_OA_F32         RxTx_InputSwitch_R(audio_settings);
+AudioSwitch4_OA_F32         FFT_OutSwitch_I(audio_settings);
+AudioSwitch4_OA_F32         FFT_OutSwitch_Q(audio_settings);
+AudioMixer4_F32             OutputSwitch_I(audio_settings);
+AudioMixer4_F32             OutputSwitch_Q(audio_settings);
+DMAMEM AudioFilterHilbertIQ_F32 RX_Hilbert(hilbert_settings);
+AudioFilterFFTConv_F32      RX_FilterConv(demod_settings);
+AudioMixer4_F32             RX_Summer(hilbert_settings);
+AudioAnalyzePeak_F32        S_Peak(hilbert_settings);
+AudioOutputWAV_F32          Output(audio_settings);         // AudioOutputI2S_F32 on the radio
+radioNoiseBlanker_F32       NoiseBlanker(hilbert_settings); // pass-through
+AudioLMSDenoiseNotch_F32    LMS_Notch(demod_settings);      // pass-through
+AudioEffectAGC_F32          RX_AGC(demod_settings);
+#ifdef USE_DEMOD_DECIMATE
+  DMAMEM AudioFilterDecimate_F32    RX_Decimate_IQ(audio_settings);
+  DMAMEM AudioFilterDecimate_F32    RX_Decimate(hilbert_settings);
+  DMAMEM AudioFilterInterpolate_F32 RX_Interpolate(audio_settings);
+#endif
+AudioMixer4_F32             FFT_Atten_I(audio_settings);
+AudioMixer4_F32             FFT_Atten_Q(audio_settings);
+AudioMixer4_F32             TX_Source(audio_settings);
+AudioSynthSineCosine_F32    TxTestTone_A(audio_settings);
+AudioSynthWaveformSine_F32  TxTestTone_B(audio_settings);
+DMAMEM AudioFilterHilbertIQ_F32 TX_Hilbert(hilbert_settings);
+DMAMEM AudioFilterFIR_F32   bpf1(hilbert_settings);
+#ifdef USE_DEMOD_DECIMATE
+  DMAMEM AudioFilterDecimate_F32    TX_Decimate(audio_settings);
+  DMAMEM AudioFilterInterpolate_F32 TX_Interpolate(audio_settings);
+#endif
+#define     TX_BPF_TAPS 197
+float       bpf1_coeffs[TX_BPF_TAPS];
+uint16_t    TX_filterCenter = 1800;
+uint16_t    TX_filterBandwidth = 2000;
+
+#include "RX_PatchCords.h"
+#include "TX_PatchCords.h"
+
+#define GRAPH_F32(x)    {&x, #x, true}
+struct Audio_Node audio_nodes[] = {
+    GRAPH_F32(Input), GRAPH_F32(I_Switch), GRAPH_F32(Q_Switch),
+  #ifdef USE_IQ_CORRECT
+    GRAPH_F32(IQ_Correct),
+  #endif
+  #ifdef W7PUA_I2S_CORRECTION
+    GRAPH_F32(TwinPeak),
+  #endif
+    GRAPH_F32(RxTx_InputSwitch_L), GRAPH_F32(RxTx_InputSwitch_R), GRAPH_F32(FFT_OutSwitch_I), GRAPH_F32(FFT_OutSwitch_Q),
+    GRAPH_F32(OutputSwitch_I), GRAPH_F32(OutputSwitch_Q), GRAPH_F32(RX_Hilbert),
+    GRAPH_F32(RX_FilterConv), GRAPH_F32(RX_Summer), GRAPH_F32(S_Peak), GRAPH_F32(Output), GRAPH_F32(NoiseBlanker),
+    GRAPH_F32(LMS_Notch), GRAPH_F32(RX_AGC),
+  #ifdef USE_DEMOD_DECIMATE
+    GRAPH_F32(RX_Decimate_IQ), GRAPH_F32(RX_Decimate), GRAPH_F32(RX_Interpolate),
+    GRAPH_F32(TX_Decimate), GRAPH_F32(TX_Interpolate),
+  #endif
+    GRAPH_F32(FFT_Atten_I), GRAPH_F32(FFT_Atten_Q), GRAPH_F32(myFFT),
+    GRAPH_F32(TX_Source), GRAPH_F32(TxTestTone_A), GRAPH_F32(TxTestTone_B), GRAPH_F32(TX_Hilbert), GRAPH_F32(bpf1)
+};
+uint8_t audio_nodes_count = sizeof(audio_nodes)/sizeof(audio_nodes[0]);
+
+AudioStream_F32 * const graph_RX_nodes[] = {&NoiseBlanker, &RX_Hilbert, &RX_Summer, &S_Peak, &LMS_Notch, &RX_FilterConv, &RX_AGC
+                                          #ifdef USE_DEMOD_DECIMATE
+                                            , &RX_Decimate_IQ, &RX_Decimate, &RX_Interpolate
+                                          #endif
+                                           };
+AudioStream_F32 * const graph_FM_nodes[] = {&TxTestTone_B};     // FM_LO_Mixer and FM_Detector are not built
+AudioStream_F32 * const graph_TX_nodes[] = {&TX_Source, &TxTestTone_A, &TxTestTone_B, &bpf1, &TX_Hilbert
+                                          #ifdef USE_DEMOD_DECIMATE
+                                            , &TX_Decimate, &TX_Interpolate
+                                          #endif
+                                           };
+struct Audio_Group audio_groups[GRAPH_STATES] = {
+    {"RX", graph_RX_nodes, sizeof(graph_RX_nodes)/sizeof(graph_RX_nodes[0])},
+    {"FM", graph_FM_nodes, sizeof(graph_FM_nodes)/sizeof(graph_FM_nodes[0])},
+    {"TX", graph_TX_nodes, sizeof(graph_TX_nodes)/sizeof(graph_TX_nodes[0])}
+};
+
+//------------------------------------------- Runner -----------------------------------------------------------------
+
+// threshold, max gain, decay and hang of the AGC-S, AGC-M and AGC-F rows of agc_set[] in SDR_Data.h
+static const struct { char key; float threshold, max_gain_dB, decay_dBps; uint16_t hang_ms; } agc_rows[] = {
+    {'s',  -5.0f, 50.0f, 20.0f, 1000},
+    {'m', -10.0f, 50.0f, 40.0f,  500},
+    {'f', -16.0f, 50.0f, 80.0f,  200}
+};
+
+static FFTConv_Kernel filter_kernel;
+
+class FilePrint : public Print
+{
+  public:
+    FilePrint(FILE *f) : file(f) {}
+    virtual size_t write(uint8_t c) { return fputc(c, file) != EOF; }
+    using  Print::write;
+  private:
+    FILE *file;
+};
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: graph_runner [-s usb|lsb] [-c Hz] [-w Hz] [-a off|s|m|f] [-f fft_size] [-p profile.bin] [-b] [-i on|off]\n"
+                    "                    [-t rx|tx] [-u] in.wav out.wav\n"
+                    "       graph_runner [-r Hz] [-m dB,deg] -g test.wav\n");
+    return 2;
+}
+
+static void put_le(FILE *f, uint32_t v, uint8_t bytes)
+{
+    for ( ; bytes; bytes--, v >>= 8)
+        fputc(v & 0xFF, f);
+}
+
+// 1s of silence then 2s of a tone at -12dBFS, 1kHz above the carrier, as 16 bit stereo.  The silence gives -b a clean
+// onset to time, the tone comes out of USB at about 0.5 with the AGC off.  Q can be given a gain and phase error, its
+// image then comes out of LSB.
+static int make_test_wav(const char *path, uint32_t fs, float gain_dB, float phase_deg)
+{
+    double   g   = pow(10.0, gain_dB / 20.0);
+    double   phi = phase_deg * M_PI / 180.0;
+    FILE    *f = fopen(path, "wb");
+    uint32_t n  = 3 * fs;
+
+    if (!f)
+    {
+        fprintf(stderr, "%s: cannot create\n", path);
+        return 1;
+    }
+    fwrite("RIFF", 1, 4, f);  put_le(f, 36 + n * 4, 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put_le(f, 16, 4);  put_le(f, 1, 2);  put_le(f, 2, 2);  put_le(f, fs, 4);  put_le(f, fs * 4, 4);
+    put_le(f, 4, 2);  put_le(f, 16, 2);
+    fwrite("data", 1, 4, f);  put_le(f, n * 4, 4);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double a = (i < fs) ? 0.0 : 0.25 * 32767;
+        double w = 2.0 * M_PI * 1000.0 * i / fs;
+        put_le(f, (uint16_t) (int16_t) lrint(a * cos(w)), 2);      // I = cos, Q = -sin is above the carrier
+        put_le(f, (uint16_t) (int16_t) lrint(-a * g * sin(w + phi)), 2);
+    }
+    fclose(f);
+    return 0;
+}
+
+static void print_bench(void)
+{
+    float   isr_us, obj_us, sched_us;
+    float   block_us = AUDIO_BLOCK_SAMPLES * 1.0e6f / sample_rate_Hz;
+    int32_t in = Input.getOnset(), out = Output.getOnset();
+
+    Audio_Profile_Interrupt(&isr_us, &obj_us, &sched_us);
+    printf("block %4d %6.2f ms  latency ", AUDIO_BLOCK_SAMPLES, block_us / 1000.0f);
+    if (in >= 0 && out >= 0)    // the 2 blocks the I2S DMA holds on the radio are not in the host graph, add them
+        printf("%6.2f ms", (out - in + 2 * AUDIO_BLOCK_SAMPLES) * 1000.0f / sample_rate_Hz);
+    else
+        printf("     - ms");
+    printf("  interrupt %7.2f us %5.2f%%  scheduler %5.2f us %7.1f us/s\n", isr_us, 100.0f * isr_us / block_us,
+           sched_us, sched_us * 1.0e6f / block_us);
+}
+
+// As initDSP(), Xmit(0) for RX and selectMode() for SSB
+static void rx_setup(int8_t sideband, uint16_t fft_size)
+{
+    AudioMemory_F32(150, audio_settings);
+    RX_Hilbert.setSideband(sideband);
+    RX_Summer.gain(0, 1.0f);
+    I_Switch.gain(0, 1.0f);
+    Q_Switch.gain(0, 1.0f);
+    I_Switch.gain(1, 0.0f);
+    Q_Switch.gain(1, 0.0f);
+    FFT_Atten_I.gain(0, 1.0f);
+    FFT_Atten_Q.gain(0, 1.0f);
+    RxTx_InputSwitch_L.setChannel(0);
+    RxTx_InputSwitch_R.setChannel(0);
+    OutputSwitch_I.gain(0, 1.0f);
+    OutputSwitch_Q.gain(0, 1.0f);
+    OutputSwitch_I.gain(1, 0.0f);
+    OutputSwitch_Q.gain(1, 0.0f);
+    myFFT.setFFTSize(fft_size);
+    FFT_OutSwitch_I.setChannel(0);
+    FFT_OutSwitch_Q.setChannel(0);
+}
+
+// As TX_RX_Switch() for TX with the mic on and the tones off, USB sideband
+static void tx_setup(void)
+{
+    TX_Source.gain(0, 2.0f);
+    TX_Source.gain(1, 0.0f);
+    TX_Source.gain(2, 0.0f);
+    TX_Source.gain(3, 0.0f);
+    TxTestTone_A.frequency(700.0f);
+    TxTestTone_B.frequency(1900.0f);
+    I_Switch.gain(0, 0.0f);
+    Q_Switch.gain(0, 0.0f);
+    I_Switch.gain(1, 1.0f);
+    Q_Switch.gain(1, 1.0f);
+    FFT_Atten_I.gain(0, 0.000000001f);
+    FFT_Atten_Q.gain(0, 0.000000001f);
+    RxTx_InputSwitch_L.setChannel(1);
+    RxTx_InputSwitch_R.setChannel(1);
+    OutputSwitch_I.gain(0, 0.0f);
+    OutputSwitch_Q.gain(0, 0.0f);
+    OutputSwitch_I.gain(1, 1.0f);
+    OutputSwitch_Q.gain(1, 1.0f);
+    #ifdef USE_IQ_CORRECT
+    IQ_Correct.setAdapt(false);
+    #endif
+}
+
+// As SetTXFilter()
+static void tx_filter(void)
+{
+    float lo = TX_filterCenter - TX_filterBandwidth/2;
+    float hi = TX_filterCenter + TX_filterBandwidth/2;
+
+    TX_Hilbert.design(0, hi + 800.0f);
+    Hilbert_Design(bpf1_coeffs, TX_BPF_TAPS, TX_Hilbert.getRate(), lo, hi, 0);
+    bpf1.begin(bpf1_coeffs, TX_BPF_TAPS, audio_block_samples);
+}
+
+// As SetFilter()
+static void rx_filter(uint16_t fc, uint16_t bw)
+{
+    float top = fminf(ceilf((fc + bw/2 + 800.0f) / 500.0f) * 500.0f, 0.45f * RX_Hilbert.getRate());
+    #ifdef USE_DEMOD_DECIMATE
+        top = fminf(top, IQ_FRONT_PASSBAND_HZ);
+    #endif
+    RX_Hilbert.design(0, top);
+    RX_FilterConv.design(&filter_kernel, fc, 90, FFTCONV_BANDPASS, bw);
+    RX_FilterConv.setKernel(&filter_kernel);
+}
+
+// As Change_Sample_Rate(), less the I2S clock and the tones.  Call before rx_filter().
+static bool rx_rate(float fs)
+{
+    #ifdef USE_DEMOD_DECIMATE
+    uint8_t front = Resample_Factor(fs, HILBERT_RATE_HZ);
+    if (fs / front != hilbert_settings.sample_rate_Hz || fs / Resample_Factor(fs, DEMOD_RATE_HZ) != demod_settings.sample_rate_Hz)
+    #else
+    if (fs != sample_rate_Hz)
+    #endif
+        return false;
+    sample_rate_Hz = fs;
+    myFFT.setSampleRate(fs);
+    #ifdef USE_DEMOD_DECIMATE
+    RX_Decimate_IQ.setSampleRate(fs);
+    RX_Decimate_IQ.begin(front, IQ_FRONT_PASSBAND_HZ);
+    uint8_t n = Resample_Factor(fs, DEMOD_RATE_HZ);
+    RX_Decimate.begin(n / front, DEMOD_PASSBAND_HZ, demod_settings.audio_block_samples);
+    RX_Interpolate.setSampleRate(fs);
+    RX_Interpolate.begin(n, DEMOD_PASSBAND_HZ);
+    TX_Decimate.setSampleRate(fs);
+    TX_Decimate.begin(front, IQ_FRONT_PASSBAND_HZ);
+    TX_Interpolate.setSampleRate(fs);
+    TX_Interpolate.begin(front, IQ_FRONT_PASSBAND_HZ);
+    #endif
+    TxTestTone_A.setSampleRate_Hz(fs);
+    TxTestTone_B.setSampleRate_Hz(fs);
+    #ifdef USE_IQ_CORRECT
+    IQ_Correct.setSampleRate(fs);
+    #endif
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int8_t      sideband = 1;
+    uint16_t    fc = 1450, bw = 2800, fft_size = FFT_SIZE;
+    char        agc = 'm';
+    const char *profile_path = NULL;
+    const char *test_path = NULL;
+    uint32_t    test_rate = 48000;
+    float       test_gain_dB = 0.0f, test_phase_deg = 0.0f;
+    bool        iq_correct = true;
+    bool        bench = false;
+    uint8_t     state = GRAPH_RX;
+    bool        prune = true;
+    int         a;
+
+    for (a = 1; a < argc && argv[a][0] == '-' && argv[a][1]; a++)
+    {
+        const char *v = (a + 1 < argc) ? argv[a+1] : NULL;
+        if (argv[a][2])
+            return usage();
+        if (argv[a][1] == 'b')
+        {
+            bench = true;
+            continue;
+        }
+        if (argv[a][1] == 'u')
+        {
+            prune = false;
+            continue;
+        }
+        if (!v)
+            return usage();
+        switch (argv[a][1])
+        {
+            case 'g': test_path = v; break;
+            case 'r': test_rate = atoi(v); break;
+            case 'm': if (sscanf(v, "%f,%f", &test_gain_dB, &test_phase_deg) != 2) return usage(); break;
+            case 'i': iq_correct = (strcmp(v, "off") != 0); break;
+            case 's': sideband = (strcmp(v, "lsb") == 0) ? -1 : 1; break;
+            case 'c': fc = atoi(v); break;
+            case 'w': bw = atoi(v); break;
+            case 'a': agc = v[0]; break;
+            case 'f': fft_size = atoi(v); break;
+            case 'p': profile_path = v; break;
+            case 't': state = (strcmp(v, "tx") == 0) ? GRAPH_TX : GRAPH_RX; break;
+            default:  return usage();
+        }
+        a++;
+    }
+    if (test_path)
+        return make_test_wav(test_path, test_rate, test_gain_dB, test_phase_deg);
+    if (argc - a != 2)
+        return usage();
+    if (!Input.open(argv[a]))
+        return 1;
+    if (!rx_rate(Input.getRate()))
+    {
+        fprintf(stderr, "%s: %.0f Hz, the graph runs at 1, 2 or 4 times %.0f Hz\n", argv[a], Input.getRate(),
+                hilbert_settings.sample_rate_Hz);
+        return 1;
+    }
+    if (!Output.open(argv[a+1], sample_rate_Hz))
+        return 1;
+    Serial.mute(bench);
+
+    rx_setup(sideband, fft_size);
+    rx_filter(fc, bw);
+    tx_filter();
+    if (state == GRAPH_TX)
+        tx_setup();
+    #ifdef USE_IQ_CORRECT
+    IQ_Correct.enable(iq_correct);
+    #endif
+    RX_AGC.enable(false);
+    for (uint8_t i = 0; i < sizeof(agc_rows)/sizeof(agc_rows[0]); i++)
+        if (agc_rows[i].key == agc)
+        {
+            RX_AGC.setParams(agc_rows[i].threshold, agc_rows[i].max_gain_dB, agc_rows[i].decay_dBps, agc_rows[i].hang_ms);
+            RX_AGC.enable(true);
+        }
+    #ifdef USE_GRAPH_SORT
+    Audio_Graph_Sort();
+    #endif
+    Audio_Graph_Select(state);
+    if (!prune)
+        for (uint8_t g = 0; g < GRAPH_STATES; g++)
+            for (uint8_t i = 0; i < audio_groups[g].count; i++)
+                Audio_Set_Active(audio_groups[g].nodes[i], true);
+    Audio_Graph_Print_Order(&Input, &Output);
+    Audio_Profile_Start();
+
+    uint64_t samples = 0;
+    uint32_t start = host_cycles();
+    uint64_t wall_ns = 0;
+    while (!Input.done())
+    {
+        software_isr();
+        samples += AUDIO_BLOCK_SAMPLES;
+        host_clock_us = samples * 1000000ULL / (uint64_t) sample_rate_Hz;
+        uint32_t now = host_cycles();   // 32 bits of ns wrap in 4.3s, add up as it goes
+        wall_ns += now - start;
+        start = now;
+    }
+    Output.close();
+    Input.close();
+    if (bench)
+        print_bench();
+    else
+    {
+        float audio_s = samples / sample_rate_Hz;
+        float wall_s  = wall_ns / 1.0e9f;
+        printf("\n%u blocks, %.2f s of audio in %.3f s, %.1f x real time\n", (unsigned) Input.getBlocks(), audio_s, wall_s,
+               (wall_s > 0.0f) ? audio_s / wall_s : 0.0f);
+        printf("F32 blocks used at most: %u\n", (unsigned) AudioMemoryUsageMax_F32());
+        printf("Graph state %s, pruning %s\n", audio_groups[state].name, prune ? "on" : "off");
+        #ifdef USE_IQ_CORRECT
+        // As Print_IQ_Correct().  It does not adapt in TX.
+        if (state == GRAPH_RX)
+            printf("IQ correction %s, IRR in %.1f dB out %.1f dB, gain error %.2f dB phase error %.2f deg\n",
+                   IQ_Correct.isEnabled() ? "on" : "off", IQ_Correct.getInputIRR(), IQ_Correct.getOutputIRR(),
+                   20.0f * log10f(IQ_Correct.getGain()), IQ_Correct.getPhase());
+        #endif
+        Audio_Profile_Print();
+    }
+    if (profile_path)
+    {
+        FILE *f = fopen(profile_path, "wb");
+        if (!f)
+        {
+            fprintf(stderr, "%s: cannot create\n", profile_path);
+            return 1;
+        }
+        FilePrint fp(f);
+        Audio_Profile_Write(fp);
+        fclose(f);
+    }
+    return 0;
+}
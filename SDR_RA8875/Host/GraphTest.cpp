@@ -0,0 +1,1058 @@
+//
+//    GraphTest.cpp
+//
+//  Host checks of the radio's audio objects, built from the same files as graph_runner.  Each test sets up its own
+//  small graph:  a TestSource_F32 playing arrays into the object under test and a TestSink_F32 keeping what comes out,
+//  run by software_isr() from Libraries/cores a block at a time as on the radio.  The objects are made in data flow
+//  order, so every block goes through in the pass it was sent, and stopped when the test is done.
+//  Each test prints 1 line, "ok" or "FAIL" and what it measured.  The exit status is the number of failed tests.
+//
+//  Usage:  graph_test
+//
+//  make test builds and runs it.
+//
+#include <stdarg.h>
+#include <initializer_list>
+#include <vector>
+#include <string>
+#include "AudioFilterHilbertIQ_F32.h"
+#include "AudioResample_F32.h"
+#include "AudioFilterFFTConv_F32.h"
+#include "AudioEffectAGC_F32.h"
+#include "AudioIQCorrect_F32.h"
+#include "AudioGraph.h"
+#include "AudioProfile.h"
+#include "Hilbert_Tables.h"
+#include "hilbert121A.h"
+
+HostSerial  Serial;
+uint64_t    host_clock_us = 0;
+
+uint32_t    host_cycle_ns = 0;
+
+// The cycle counter the library times update() with.  Only TestBusy_F32 moves it, so the profile times are exact.
+uint32_t host_cycles(void)
+{
+    return host_cycle_ns;
+}
+
+void software_isr(void);    // Libraries/cores/AudioStream.cpp, 1 pass of the update list
+
+// What AudioGraph.cpp and AudioProfile.cpp take from SDR_RA8875.ino.  The tests add their nodes to audio_nodes[].
+float               sample_rate_Hz = 48000.0f;
+AudioSettings_F32   audio_settings(sample_rate_Hz, AUDIO_BLOCK_SAMPLES);
+struct Audio_Node   audio_nodes[GRAPH_MAX_NODES];
+uint8_t             audio_nodes_count = 0;
+struct Audio_Group  audio_groups[GRAPH_STATES] = { {"RX", NULL, 0}, {"FM", NULL, 0}, {"TX", NULL, 0} };
+
+static int          failed = 0;
+
+static void result(bool ok, const char *name, const char *fmt, ...)
+{
+    va_list ap;
+
+    printf("%-4s  %-24s ", ok ? "ok" : "FAIL", name);
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+    if (!ok)
+        failed++;
+}
+
+//------------------------------------------- Test objects -----------------------------------------------------------
+
+// Sends the next block of 1 or 2 arrays on outputs 0 and 1 every update, nothing once they run out
+class TestSource_F32 : public AudioStream_F32
+{
+  public:
+    TestSource_F32(void) : AudioStream_F32(0, NULL), ch{NULL, NULL}, len(0), pos(0), block(AUDIO_BLOCK_SAMPLES) {}
+    // block is the samples sent each pass, a decimator's short blocks for the objects after it
+    void play(const float *ch0, const float *ch1, uint32_t n, uint16_t blk = AUDIO_BLOCK_SAMPLES)
+    {
+        ch[0] = ch0; ch[1] = ch1; len = n; pos = 0; block = blk;
+    }
+    virtual void update(void)
+    {
+        for (uint8_t c = 0; c < 2 && ch[c] && pos + block <= len; c++)
+        {
+            audio_block_f32_t *out = allocate_f32();
+            if (!out)
+                return;
+            memcpy(out->data, ch[c] + pos, block * sizeof(float));
+            out->length = block;
+            transmit(out, c);
+            release(out);
+        }
+        pos += block;
+    }
+
+  private:
+    const float *ch[2];
+    uint32_t     len;
+    uint32_t     pos;
+    uint16_t     block;
+};
+
+// Keeps every block that comes in on inputs 0 and 1.  A pass with nothing on input 0 is counted as missing.
+class TestSink_F32 : public AudioStream_F32
+{
+  public:
+    TestSink_F32(void) : AudioStream_F32(2, inputQueueArray), missing(0) {}
+    std::vector<float>  out[2];
+    uint32_t            missing;
+    virtual void update(void)
+    {
+        for (uint8_t c = 0; c < 2; c++)
+        {
+            audio_block_f32_t *in = receiveReadOnly_f32(c);
+            if (in)
+            {
+                out[c].insert(out[c].end(), in->data, in->data + in->length);
+                release(in);
+            }
+            else if (c == 0)
+                missing++;
+        }
+    }
+
+  private:
+    audio_block_f32_t *inputQueueArray[2];
+};
+
+// n passes of the update list, the clock moved on 1 block each
+static void run(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        software_isr();
+        host_clock_us += (uint64_t) (AUDIO_BLOCK_SAMPLES * 1.0e6f / sample_rate_Hz);
+    }
+}
+
+// Take a test's objects out of the update passes of the tests after it
+static void stop(std::initializer_list<AudioStream_F32 *> nodes)
+{
+    for (AudioStream_F32 *node : nodes)
+        Audio_Set_Active(node, false);
+}
+
+// Complex gaussian noise at rms 'noise' plus tones at +hz (I = cos, Q = sin) of amplitude 'a', at fs
+static void make_iq(std::vector<float> &i, std::vector<float> &q, uint32_t n, float fs, float noise,
+                    std::initializer_list<float> hz, float a)
+{
+    uint32_t seed = 12345;
+    auto gauss = [&seed](void) {
+        seed = seed * 1664525u + 1013904223u;   float u1 = ((seed >> 8) + 0.5f) / 16777216.0f;
+        seed = seed * 1664525u + 1013904223u;   float u2 = ((seed >> 8) + 0.5f) / 16777216.0f;
+        return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+    };
+
+    i.assign(n, 0.0f);
+    q.assign(n, 0.0f);
+    for (uint32_t k = 0; k < n; k++)
+    {
+        i[k] = noise * gauss();
+        q[k] = noise * gauss();
+        for (float f : hz)
+        {
+            double w = 2.0 * M_PI * f * k / fs;
+            i[k] += a * (float) cos(w);
+            q[k] += a * (float) sin(w);
+        }
+    }
+}
+
+// y[n] = sum h[k] x[n-k] in double, what arm_fir_f32 does with no rounding
+static void fir_ref(const float *h, uint16_t taps, const std::vector<float> &x, std::vector<float> &y)
+{
+    y.assign(x.size(), 0.0f);
+    for (size_t n = 0; n < x.size(); n++)
+    {
+        double acc = 0.0;
+        for (uint16_t k = 0; k < taps && k <= n; k++)
+            acc += (double) h[k] * x[n - k];
+        y[n] = (float) acc;
+    }
+}
+
+// Largest difference of a and b over their common length, as a fraction of the peak of b
+static float max_diff(const std::vector<float> &a, const std::vector<float> &b)
+{
+    size_t n = min(a.size(), b.size());
+    float  d = 0.0f, peak = 1.0e-30f;
+
+    for (size_t k = 0; k < n; k++)
+    {
+        d    = max(d, fabsf(a[k] - b[k]));
+        peak = max(peak, fabsf(b[k]));
+    }
+    return (n) ? d / peak : 1.0f;
+}
+
+// Least squares fit y[from..to) = a cos(wk) + b sin(wk) of the tone at f
+static void tone_coeffs(const std::vector<float> &y, size_t from, size_t to, float f, float fs, double *a, double *b)
+{
+    double cc = 0, ss = 0, cs = 0, yc = 0, ys = 0;
+
+    for (size_t k = from; k < to; k++)
+    {
+        double c = cos(2.0 * M_PI * f * k / fs), s = sin(2.0 * M_PI * f * k / fs);
+        cc += c * c;  ss += s * s;  cs += c * s;  yc += y[k] * c;  ys += y[k] * s;
+    }
+    double det = cc * ss - cs * cs;
+    *a = (yc * ss - ys * cs) / det;
+    *b = (ys * cc - yc * cs) / det;
+}
+
+// Amplitude of the tone at f in y[from..] by least squares, and the rms of what is left
+static void tone_fit(const std::vector<float> &y, size_t from, float f, float fs, float *amp, float *rest)
+{
+    double a, b, r = 0;
+
+    tone_coeffs(y, from, y.size(), f, fs, &a, &b);
+    for (size_t k = from; k < y.size(); k++)
+    {
+        double e = y[k] - a * cos(2.0 * M_PI * f * k / fs) - b * sin(2.0 * M_PI * f * k / fs);
+        r += e * e;
+    }
+    *amp  = (float) sqrt(a * a + b * b);
+    *rest = (float) sqrt(r / (y.size() - from));
+}
+
+// Power of y[from..] from 0 to f_top Hz over the power of a sine of amplitude a, in dB.  Blackman-Harris window (92dB
+// sidelobes) and a DFT of the bins up to f_top.
+static float band_power_dB(const std::vector<float> &y, size_t from, float fs, float f_top, float a)
+{
+    size_t              n = y.size() - from;
+    std::vector<double> x(n);
+    double              w2 = 0, sum = 0;
+
+    for (size_t k = 0; k < n; k++)
+    {
+        double t = 2.0 * M_PI * k / (n - 1);
+        double w = 0.35875 - 0.48829 * cos(t) + 0.14128 * cos(2 * t) - 0.01168 * cos(3 * t);
+        x[k] = w * y[from + k];
+        w2  += w * w;
+    }
+    for (size_t b = 0; b <= (size_t) (f_top * n / fs); b++)
+    {
+        double re = 0, im = 0;
+        for (size_t k = 0; k < n; k++)
+        {
+            re += x[k] * cos(2.0 * M_PI * b * k / n);
+            im -= x[k] * sin(2.0 * M_PI * b * k / n);
+        }
+        sum += re * re + im * im;
+    }
+    return (float) (10.0 * log10(sum / (n * a * a / 4.0 * w2) + 1.0e-30));    // Parseval, 1 side of a sine
+}
+
+//------------------------------------------- Resampler ------------------------------------------------------------
+
+//
+//  The demod audio path as Change_Sample_Rate() sets it up, less what runs in between at DEMOD_RATE_HZ:
+//  RX_Decimate_IQ at fs down to HILBERT_RATE_HZ, RX_Decimate down to DEMOD_RATE_HZ and RX_Interpolate back up to fs.
+//  Plays a sine of amplitude a at f through it, the output is at fs.  RX_Decimate sends blocks of 'block' samples.
+//
+static void resample_chain(float fs, float f, float a, uint32_t blocks, uint16_t block, std::vector<float> &out)
+{
+    uint8_t            front = Resample_Factor(fs, HILBERT_RATE_HZ);
+    uint8_t            n     = Resample_Factor(fs, DEMOD_RATE_HZ);
+    AudioSettings_F32  full(fs, AUDIO_BLOCK_SAMPLES), hilbert(fs / front, AUDIO_BLOCK_SAMPLES);
+    std::vector<float> x(blocks * AUDIO_BLOCK_SAMPLES);
+
+    for (size_t k = 0; k < x.size(); k++)
+        x[k] = a * (float) sin(2.0 * M_PI * f * k / fs);
+
+    TestSource_F32              *src  = new TestSource_F32;
+    AudioFilterDecimate_F32     *dIQ  = new AudioFilterDecimate_F32(full);
+    AudioFilterDecimate_F32     *dec  = new AudioFilterDecimate_F32(hilbert);
+    AudioFilterInterpolate_F32  *intp = new AudioFilterInterpolate_F32(full);
+    TestSink_F32                *sink = new TestSink_F32;
+    new AudioConnection_F32(*src, 0, *dIQ, 0);
+    new AudioConnection_F32(*dIQ, 0, *dec, 0);
+    new AudioConnection_F32(*dec, 0, *intp, 0);
+    new AudioConnection_F32(*intp, 0, *sink, 0);
+
+    dIQ->begin(front, IQ_FRONT_PASSBAND_HZ);
+    dec->begin(n / front, DEMOD_PASSBAND_HZ, block);
+    intp->begin(n, DEMOD_PASSBAND_HZ);
+    src->play(x.data(), NULL, x.size());
+    run(blocks);
+    stop({src, dIQ, dec, intp, sink});
+    out.swap(sink->out[0]);
+}
+
+//
+//  Decimate and interpolate back at 48, 96 and 192 kHz.  Up to DEMOD_PASSBAND_HZ the gain is to be flat and the tone
+//  clean of images.  A tone from the alias edge (DEMOD_RATE_HZ - DEMOD_PASSBAND_HZ) up to fs/2 is to leave nothing
+//  from 0 to DEMOD_PASSBAND_HZ.  The first 16 blocks out are the filters filling and are not measured.
+//  resample_short_blocks is the same with RX_Decimate sending Resample_Block() samples every update, as the radio runs it.
+//
+static void test_resample(void)
+{
+    const float rates[] = { 48000.0f, 96000.0f, 192000.0f };
+    const float a = 0.5f;
+
+    for (uint8_t r = 0; r < 6; r++)
+    {
+        float              fs = rates[r % 3];
+        bool               is_short = r >= 3;
+        uint16_t           block = is_short ? Resample_Block(Resample_Factor(HILBERT_RATE_HZ, DEMOD_RATE_HZ)) : AUDIO_BLOCK_SAMPLES;
+        std::vector<float> y;
+        float              g_lo = 1.0e9f, g_hi = -1.0e9f, rest_worst = -200.0f, alias_worst = -200.0f, alias_f = 0;
+        size_t             from = 16 * AUDIO_BLOCK_SAMPLES;
+
+        for (float f = 100.0f; f <= DEMOD_PASSBAND_HZ; f += 200.0f)
+        {
+            float amp, rest;
+            resample_chain(fs, f, a, 48, block, y);
+            tone_fit(y, from, f, fs, &amp, &rest);
+            g_lo = min(g_lo, 20.0f * log10f(amp / a));
+            g_hi = max(g_hi, 20.0f * log10f(amp / a));
+            rest_worst = max(rest_worst, 20.0f * log10f(rest * sqrtf(2.0f) / a + 1.0e-12f));
+        }
+        for (float f = DEMOD_RATE_HZ - DEMOD_PASSBAND_HZ; f < fs / 2; f += fs / 97.0f)
+        {
+            resample_chain(fs, f, a, 48, block, y);
+            float p = band_power_dB(y, from, fs, DEMOD_PASSBAND_HZ, a);
+            if (p > alias_worst)
+            {
+                alias_worst = p;
+                alias_f = f;
+            }
+        }
+        char name[32];
+        snprintf(name, sizeof(name), is_short ? "resample_short_blocks_%dk" : "resample_round_trip_%dk", (int) (fs / 1000));
+        result(g_hi - g_lo <= 0.1f && rest_worst <= -60.0f && alias_worst <= -60.0f, name,
+               "gain %+.3f to %+.3f dB, images %.0f dB, aliases %.0f dB at %.0f Hz (limits 0.1 dB, -60, -60)",
+               g_lo, g_hi, rest_worst, alias_worst, alias_f);
+    }
+}
+
+//
+//  Bandwidth changes as SetFilter() makes them, in the demod path at 48 kHz:  RX_Decimate, RX_FilterConv and
+//  RX_Interpolate with a 1 kHz tone through them, RX_Decimate sending short blocks as on the radio.  The SSB filters of filter[] are cycled every 16ms with only
+//  setKernel(), the resamplers keep running.  All of them pass 1 kHz at the same gain and delay (same taps, linear
+//  phase), so the output is to stay the 1 tone:  no block missing and no click at a change, the most any sample is
+//  off the fitted tone held to -60 dB.
+//
+static void test_filter_switch(void)
+{
+    const struct { float fc, bw; } filters[] = { {925, 1800}, {1200, 2300}, {1450, 2800}, {1650, 3200}, {2050, 4000} };
+    const uint8_t       n_filters = sizeof(filters) / sizeof(filters[0]);
+    const float         f = 1000.0f, a = 0.5f;
+    const uint32_t      per = 128 / AUDIO_BLOCK_SAMPLES;    // the same times at any block size
+    const uint32_t      blocks = 104 * per, from = 24 * per, every = 6 * per;  // played, before the first change, between
+    uint8_t             n = Resample_Factor(sample_rate_Hz, DEMOD_RATE_HZ);
+    AudioSettings_F32   demod(sample_rate_Hz / n, Resample_Block(n));
+    std::vector<float>  x(blocks * AUDIO_BLOCK_SAMPLES);
+
+    for (size_t k = 0; k < x.size(); k++)
+        x[k] = a * (float) sin(2.0 * M_PI * f * k / sample_rate_Hz);
+
+    TestSource_F32              *src  = new TestSource_F32;
+    AudioFilterDecimate_F32     *dec  = new AudioFilterDecimate_F32(audio_settings);
+    AudioFilterFFTConv_F32      *conv = new AudioFilterFFTConv_F32(demod);
+    AudioFilterInterpolate_F32  *intp = new AudioFilterInterpolate_F32(audio_settings);
+    TestSink_F32                *sink = new TestSink_F32;
+    FFTConv_Kernel              *kernel = new FFTConv_Kernel[n_filters];
+    new AudioConnection_F32(*src, 0, *dec, 0);
+    new AudioConnection_F32(*dec, 0, *conv, 0);
+    new AudioConnection_F32(*conv, 0, *intp, 0);
+    new AudioConnection_F32(*intp, 0, *sink, 0);
+
+    dec->begin(n, DEMOD_PASSBAND_HZ, demod.audio_block_samples);
+    intp->begin(n, DEMOD_PASSBAND_HZ);
+    for (uint8_t i = 0; i < n_filters; i++)
+        conv->design(&kernel[i], filters[i].fc, 90, FFTCONV_BANDPASS, filters[i].bw);
+    conv->setKernel(&kernel[0]);
+    src->play(x.data(), NULL, x.size());
+    run(from);
+    uint32_t missing = sink->missing;   // before the first low rate block is through
+    uint8_t  changes = 0;
+    for (uint32_t b = from; b < blocks; b += every, changes++)
+    {
+        conv->setKernel(&kernel[(changes + 1) % n_filters]);
+        run(min(every, blocks - b));
+    }
+    missing = sink->missing - missing;
+    stop({src, dec, conv, intp, sink});
+
+    // Fit the tone to the last blocks before the first change, then look for the worst sample from there on
+    std::vector<float> &y = sink->out[0];
+    size_t settle = (from - 4 * per) * AUDIO_BLOCK_SAMPLES;
+    double fa, fb;
+    float  worst = 0.0f;
+    tone_coeffs(y, settle, min(y.size(), (size_t) from * AUDIO_BLOCK_SAMPLES), f, sample_rate_Hz, &fa, &fb);
+    for (size_t k = settle; k < y.size(); k++)
+    {
+        double e = y[k] - fa * cos(2.0 * M_PI * f * k / sample_rate_Hz) - fb * sin(2.0 * M_PI * f * k / sample_rate_Hz);
+        worst = max(worst, (float) fabs(e));
+    }
+    float worst_dB = 20.0f * log10f(worst / a + 1.0e-12f);
+    bool  ok = missing == 0 && y.size() >= (blocks - from) * AUDIO_BLOCK_SAMPLES && worst_dB <= -60.0f;
+    result(ok, "filter_switch", "%d changes, %u blocks missing, largest step off the tone %.1f dB (limits 0, -60)",
+           changes, (unsigned) missing, worst_dB);
+}
+
+//------------------------------------------- FFT convolution ------------------------------------------------------
+
+// Taps of a kernel back from its partition spectra, getParts() * getPart() of them
+static void kernel_taps(AudioFilterFFTConv_F32 *conv, const FFTConv_Kernel *k, std::vector<float> &taps)
+{
+    arm_rfft_fast_instance_f32 rfft = {};
+    uint16_t                   part = conv->getPart();
+    std::vector<float>         H(2 * part), h(2 * part);
+
+    arm_rfft_fast_init_f32(&rfft, 2 * part);
+    taps.assign(k->parts * part, 0.0f);
+    for (uint16_t p = 0; p < k->parts; p++)
+    {
+        memcpy(H.data(), k->H + p * 2 * part, 2 * part * sizeof(float));
+        arm_rfft_fast_f32(&rfft, H.data(), h.data(), 1);
+        memcpy(&taps[p * part], h.data(), part * sizeof(float));
+    }
+}
+
+//
+//  AudioFilterFFTConv_F32 against a direct form FIR of the same taps, on noise and tones.  The kernel goes from the
+//  2.8 kHz filter to the 500 Hz CW one at block 'change'.  That block is to be the old filter's output faded into the
+//  new one's, (i + 0.5) / block length of the new at sample i, the blocks after it the new filter's.  The overlap-save
+//  FFTs round differently from the direct form, the limit is 1e-5 of the peak in the fade block and in all of it.
+//  fftconv_direct is at the demod rate in full blocks, fftconv_short in the short blocks RX_Decimate sends and
+//  fftconv_48k at the full rate without USE_DEMOD_DECIMATE, where the filter is longest.
+//
+static void test_fftconv(void)
+{
+    const struct { const char *name; float fs; uint16_t part; } runs[] = {
+        {"fftconv_direct", DEMOD_RATE_HZ, AUDIO_BLOCK_SAMPLES},
+        {"fftconv_short",  DEMOD_RATE_HZ, Resample_Block(Resample_Factor(HILBERT_RATE_HZ, DEMOD_RATE_HZ))},
+        {"fftconv_48k",    48000.0f,      AUDIO_BLOCK_SAMPLES}
+    };
+    const uint32_t     blocks = 40, change = 20;
+
+    for (const auto &r : runs)
+    {
+        AudioSettings_F32  settings(r.fs, r.part);
+        std::vector<float> i, q, taps_a, taps_b, ya, yb, ref;
+
+        TestSource_F32          *src  = new TestSource_F32;
+        AudioFilterFFTConv_F32  *conv = new AudioFilterFFTConv_F32(settings);
+        TestSink_F32            *sink = new TestSink_F32;
+        FFTConv_Kernel          *ka = new FFTConv_Kernel, *kb = new FFTConv_Kernel;
+        new AudioConnection_F32(*src, 0, *conv, 0);
+        new AudioConnection_F32(*conv, 0, *sink, 0);
+
+        conv->design(ka, 1450, 90, FFTCONV_BANDPASS, 2800);
+        conv->design(kb, 700, 90, FFTCONV_BANDPASS, 500);
+        kernel_taps(conv, ka, taps_a);
+        kernel_taps(conv, kb, taps_b);
+        make_iq(i, q, blocks * r.part, r.fs, 0.1f, {650.0f, 1300.0f, 4100.0f}, 0.2f);
+        fir_ref(taps_a.data(), taps_a.size(), i, ya);
+        fir_ref(taps_b.data(), taps_b.size(), i, yb);
+
+        conv->setKernel(ka);
+        src->play(i.data(), NULL, i.size(), r.part);
+        run(change);
+        conv->setKernel(kb);
+        run(blocks - change);
+        stop({src, conv, sink});
+
+        size_t at = change * r.part;
+        ref.assign(ya.begin(), ya.begin() + at);
+        for (uint16_t k = 0; k < r.part; k++)
+        {
+            float g = (k + 0.5f) / r.part;
+            ref.push_back(ya[at + k] + g * (yb[at + k] - ya[at + k]));
+        }
+        ref.insert(ref.end(), yb.begin() + at + r.part, yb.end());
+
+        std::vector<float> fade(sink->out[0].begin() + at, sink->out[0].begin() + at + r.part);
+        std::vector<float> ref_fade(ref.begin() + at, ref.begin() + at + r.part);
+        float d_all  = max_diff(sink->out[0], ref);
+        float d_fade = max_diff(fade, ref_fade);
+        bool  ok = sink->out[0].size() == ref.size() && d_all <= 1.0e-5f && d_fade <= 1.0e-5f;
+        result(ok, r.name, "%d taps in %d partitions of %d, largest difference %.2g of the peak, %.2g in the crossfade "
+               "block (limit 1e-5)", conv->getTaps(), conv->getParts(), r.part, d_all, d_fade);
+    }
+}
+
+//------------------------------------------- AGC ------------------------------------------------------------------
+
+//
+//  RX_AGC at the demod rate with the AGC-M row of agc_set[] (-10 dBFS, 50 dB, 40 dB/s, 500 ms) on a 1 kHz tone:  1 s
+//  at -60 dBFS, 1 s at -6 dBFS, then -60 dBFS again.  With the look-ahead the gain is down before the loud tone comes
+//  out, so no output sample is to go over the threshold, even the first ones of the step.  After the step down the
+//  gain is to hold for the hang time, within a block, then rise at the decay rate, within 2%.
+//  agc_fade then fades a -6 dBFS tone 0.5 dB a block for 30 dB, each block inside AGC_HANG_DB of the one before.  The
+//  gain is still to hold for the hang time, within a block, from where the fade has gone AGC_HANG_DB down, and never
+//  to come up faster than the decay rate.
+//
+static void test_agc_fade(float threshold, float max_gain_dB, float decay_dBps, uint16_t hang_ms)
+{
+    const float        fs = DEMOD_RATE_HZ, block_ms = AUDIO_BLOCK_SAMPLES * 1000.0f / fs, step_dB = 0.5f;
+    const uint32_t     fade = (uint32_t) (1.0f * fs / AUDIO_BLOCK_SAMPLES), blocks = 3 * fade;
+    AudioSettings_F32  demod(fs, AUDIO_BLOCK_SAMPLES);
+    std::vector<float> x(blocks * AUDIO_BLOCK_SAMPLES), gain(blocks);
+
+    for (size_t k = 0; k < x.size(); k++)
+    {
+        uint32_t b = k / AUDIO_BLOCK_SAMPLES;
+        float    dB = -6.0f - step_dB * min(b - min(b, fade), (uint32_t) (30.0f / step_dB));
+        x[k] = powf(10.0f, dB / 20.0f) * (float) sin(2.0 * M_PI * 1000.0 * k / fs);
+    }
+
+    TestSource_F32     *src  = new TestSource_F32;
+    AudioEffectAGC_F32 *agc  = new AudioEffectAGC_F32(demod);
+    TestSink_F32       *sink = new TestSink_F32;
+    new AudioConnection_F32(*src, 0, *agc, 0);
+    new AudioConnection_F32(*agc, 0, *sink, 0);
+
+    agc->setParams(threshold, max_gain_dB, decay_dBps, hang_ms);
+    agc->enable(true);
+    src->play(x.data(), NULL, x.size());
+    for (uint32_t b = 0; b < blocks; b++)
+    {
+        run(1);
+        gain[b] = agc->getGain_dB();
+    }
+    stop({src, agc, sink});
+
+    uint32_t gone = fade + (uint32_t) ceilf(AGC_HANG_DB / step_dB), b = fade;
+    while (b + 1 < blocks && gain[b + 1] <= gain[b] + 0.001f)
+        b++;
+    float hang = ((float) b - gone + 1) * block_ms;
+    float rate = 0.0f;
+    for (b = fade; b + 1 < blocks; b++)
+        rate = max(rate, (gain[b + 1] - gain[b]) * 1000.0f / block_ms);
+
+    bool ok = fabsf(hang - hang_ms) <= block_ms && rate <= 1.02f * decay_dBps;
+    result(ok, "agc_fade", "%.0f dB/s fade, hang %.0f ms, fastest rise %.1f dB/s (limits %d +/- %.0f, %.0f + 2%%)",
+           step_dB * 1000.0f / block_ms, hang, rate, hang_ms, block_ms, decay_dBps);
+}
+
+static void test_agc(void)
+{
+    const float        threshold = -10.0f, max_gain_dB = 50.0f, decay_dBps = 40.0f;
+    const uint16_t     hang_ms = 500;
+    const float        fs = DEMOD_RATE_HZ, block_ms = AUDIO_BLOCK_SAMPLES * 1000.0f / fs;
+    const uint32_t     step_up = (uint32_t) (1.0f * fs / AUDIO_BLOCK_SAMPLES), step_down = 2 * step_up;
+    const uint32_t     blocks = 4 * step_up;
+    AudioSettings_F32  demod(fs, AUDIO_BLOCK_SAMPLES);
+    std::vector<float> x(blocks * AUDIO_BLOCK_SAMPLES), gain(blocks);
+
+    for (size_t k = 0; k < x.size(); k++)
+    {
+        bool loud = k >= step_up * AUDIO_BLOCK_SAMPLES && k < step_down * AUDIO_BLOCK_SAMPLES;
+        x[k] = powf(10.0f, (loud ? -6.0f : -60.0f) / 20.0f) * (float) sin(2.0 * M_PI * 1000.0 * k / fs);
+    }
+
+    TestSource_F32     *src  = new TestSource_F32;
+    AudioEffectAGC_F32 *agc  = new AudioEffectAGC_F32(demod);
+    TestSink_F32       *sink = new TestSink_F32;
+    new AudioConnection_F32(*src, 0, *agc, 0);
+    new AudioConnection_F32(*agc, 0, *sink, 0);
+
+    agc->setParams(threshold, max_gain_dB, decay_dBps, hang_ms);
+    agc->enable(true);
+    src->play(x.data(), NULL, x.size());
+    for (uint32_t b = 0; b < blocks; b++)
+    {
+        run(1);
+        gain[b] = agc->getGain_dB();
+    }
+    stop({src, agc, sink});
+
+    float peak = 0.0f;
+    for (float y : sink->out[0])
+        peak = max(peak, fabsf(y));
+    float over_dB = 20.0f * log10f(peak) - threshold;
+
+    // Hang:  blocks from the last loud one in to the first with the gain going up
+    uint32_t b = step_down;
+    while (b + 1 < blocks && gain[b + 1] <= gain[b] + 0.001f)
+        b++;
+    float hang = (b - step_down + 1) * block_ms;
+
+    // Decay:  slope from 5 dB to 30 dB above the held gain
+    float    held = gain[b];
+    uint32_t b5 = b, b30;
+    while (b5 < blocks && gain[b5] < held + 5.0f)
+        b5++;
+    for (b30 = b5; b30 < blocks && gain[b30] < held + 30.0f; b30++)
+        ;
+    float rate = (b30 < blocks && b30 > b5) ? (gain[b30] - gain[b5]) / ((b30 - b5) * block_ms / 1000.0f) : 0.0f;
+
+    bool ok = over_dB <= 0.001f && fabsf(hang - hang_ms) <= block_ms && fabsf(rate - decay_dBps) <= 0.02f * decay_dBps;
+    result(ok, "agc_step", "peak %+.3f dB of the threshold, hang %.0f ms, decay %.1f dB/s (limits 0, %d +/- %.0f, %.0f +/- 2%%)",
+           over_dB, hang, rate, hang_ms, block_ms, decay_dBps);
+
+    test_agc_fade(threshold, max_gain_dB, decay_dBps, hang_ms);
+}
+
+//------------------------------------------- IQ correction --------------------------------------------------------
+
+//
+//  AudioIQCorrect_F32 on a 1kHz tone above the carrier with a little noise, Q given 1dB of gain and 3 degrees of phase
+//  error as the header has it:  Q = g sin(t + phi).  After 10 time constants getGain() and getPhase() are to read what
+//  was put in, within 0.03dB and 0.2 degrees, together under the 50dB IRR the header gives for the noise in the
+//  estimate.  getInputIRR() is to match the 24dB those errors give, and getOutputIRR() is to be over 50dB.  The image of
+//  the tone left in the output, fitted over the last second, is to be under -50dB too, so the figure is what is there.
+//
+static void test_iq_correct(void)
+{
+    const float        fs = sample_rate_Hz, f = 1000.0f, a = 0.25f;
+    const float        gain_dB = 1.0f, phase_deg = 3.0f, irr_dB = 50.0f;
+    const uint32_t     blocks = (uint32_t) (10.0f * IQ_CORRECT_TAU_S * fs / AUDIO_BLOCK_SAMPLES);
+    const size_t       last = (size_t) (blocks * AUDIO_BLOCK_SAMPLES - fs);     // start of the last second
+    double             g = pow(10.0, gain_dB / 20.0), phi = phase_deg * M_PI / 180.0;
+    std::vector<float> i, q;
+
+    make_iq(i, q, blocks * AUDIO_BLOCK_SAMPLES, fs, 0.01f, {f}, a);
+    for (size_t k = 0; k < i.size(); k++)
+        q[k] = (float) (g * (q[k] * cos(phi) + i[k] * sin(phi)));
+
+    TestSource_F32     *src  = new TestSource_F32;
+    AudioIQCorrect_F32 *iqc  = new AudioIQCorrect_F32(audio_settings);
+    TestSink_F32       *sink = new TestSink_F32;
+    new AudioConnection_F32(*src, 0, *iqc, 0);
+    new AudioConnection_F32(*src, 1, *iqc, 1);
+    new AudioConnection_F32(*iqc, 0, *sink, 0);
+    new AudioConnection_F32(*iqc, 1, *sink, 1);
+
+    src->play(i.data(), q.data(), i.size());
+    run(blocks);
+    stop({src, iqc, sink});
+
+    // z = I + jQ = (aI + j aQ) cos + (bI + j bQ) sin, the tone at +f is half of (aI + bQ) + j(aQ - bI), the image at -f
+    // half of (aI - bQ) + j(aQ + bI)
+    double ai, bi, aq, bq;
+    tone_coeffs(sink->out[0], last, sink->out[0].size(), f, fs, &ai, &bi);
+    tone_coeffs(sink->out[1], last, sink->out[1].size(), f, fs, &aq, &bq);
+    float image_dB = (float) (10.0 * log10(((ai - bq) * (ai - bq) + (aq + bi) * (aq + bi)) /
+                                           ((ai + bq) * (ai + bq) + (aq - bi) * (aq - bi))));
+
+    float in_dB  = (float) (10.0 * log10((1.0 + 2.0 * g * cos(phi) + g * g) / (1.0 - 2.0 * g * cos(phi) + g * g)));
+    float g_err  = 20.0f * log10f(iqc->getGain()) - gain_dB;
+    float ph_err = iqc->getPhase() - phase_deg;
+    float irr    = iqc->getOutputIRR();
+    bool  ok = fabsf(g_err) <= 0.03f && fabsf(ph_err) <= 0.2f && fabsf(iqc->getInputIRR() - in_dB) <= 0.2f &&
+               irr >= irr_dB && image_dB <= -irr_dB;
+    result(ok, "iq_correct", "gain %+.4f dB, phase %+.4f deg off after %u blocks, IRR in %.1f of %.1f, out %.1f dB, "
+           "image %.1f dB (limits 0.03 dB, 0.2 deg, 0.2 dB, %.0f dB)", g_err, ph_err, blocks, iqc->getInputIRR(),
+           in_dB, irr, image_dB, irr_dB);
+}
+
+//------------------------------------------- Update order -----------------------------------------------------------
+
+// Where node is in the update list, -1 if it is not
+static int graph_pos(AudioStream *node)
+{
+    AudioStream *list[GRAPH_MAX_NODES];
+    uint8_t      n = Audio_Graph_List(list, GRAPH_MAX_NODES);
+
+    for (uint8_t i = 0; i < n; i++)
+        if (list[i] == node)
+            return i;
+    return -1;
+}
+
+// Connections, as from and to, that run from a later object in the update list to an earlier one
+static uint8_t graph_late(const std::vector<std::pair<AudioStream *, AudioStream *>> &edges)
+{
+    uint8_t late = 0;
+
+    for (auto &e : edges)
+        if (graph_pos(e.first) >= graph_pos(e.second))
+            late++;
+    return late;
+}
+
+//
+//  Audio_Graph_Sort() on 4 objects made in the reverse of their data flow, so every connection starts out backwards:
+//  source to mixer a, a and the source to mixer b, b to the sink.  Sorted, every source is to come before all its
+//  destinations, and a block played is to reach the sink in the pass it was sent.  Then b is patched back into a, the
+//  sort is to report the 1 cycle and leave only that connection backwards.
+//
+static void test_graph_sort(void)
+{
+    TestSink_F32       *sink = new TestSink_F32;
+    AudioMixer4_F32    *b    = new AudioMixer4_F32(audio_settings);
+    AudioMixer4_F32    *a    = new AudioMixer4_F32(audio_settings);
+    TestSource_F32     *src  = new TestSource_F32;
+    new AudioConnection_F32(*src, 0, *a, 0);
+    new AudioConnection_F32(*a, 0, *b, 0);
+    new AudioConnection_F32(*src, 0, *b, 1);
+    new AudioConnection_F32(*b, 0, *sink, 0);
+    std::vector<std::pair<AudioStream *, AudioStream *>> edges = { {src, a}, {a, b}, {src, b}, {b, sink} };
+
+    audio_nodes[audio_nodes_count++] = { src,  "test_src",  true };
+    audio_nodes[audio_nodes_count++] = { a,    "test_a",    true };
+    audio_nodes[audio_nodes_count++] = { b,    "test_b",    true };
+    audio_nodes[audio_nodes_count++] = { sink, "test_sink", true };
+
+    uint8_t late_before = graph_late(edges);
+    uint8_t cycles = Audio_Graph_Sort();
+    uint8_t late = graph_late(edges);
+
+    std::vector<float> x(4 * AUDIO_BLOCK_SAMPLES, 0.25f);
+    src->play(x.data(), NULL, x.size());
+    run(1);
+    bool same_pass = sink->missing == 0 && sink->out[0].size() == AUDIO_BLOCK_SAMPLES;
+    run(3);
+
+    result(cycles == 0 && late == 0 && late_before == edges.size() && same_pass, "graph_sort",
+           "%u of %u connections backwards before, %u after, %u cycles, sink %s the first pass (limits 0, 0, in)",
+           late_before, (unsigned) edges.size(), late, cycles, same_pass ? "in" : "not in");
+
+    new AudioConnection_F32(*b, 0, *a, 1);
+    edges.push_back({b, a});
+    cycles = Audio_Graph_Sort();
+    late = graph_late(edges);
+    bool back = graph_pos(b) >= graph_pos(a);
+    stop({src, a, b, sink});
+
+    result(cycles == 1 && late == 1 && back, "graph_sort_cycle",
+           "%u cycles reported, %u connections backwards, %s (limits 1, 1, b to a)",
+           cycles, late, back ? "b to a" : "not b to a");
+}
+
+//------------------------------------------- Profiler ---------------------------------------------------------------
+
+// Moves the cycle counter on 'us' in every update, nothing in or out
+class TestBusy_F32 : public AudioStream_F32
+{
+  public:
+    TestBusy_F32(uint32_t us) : AudioStream_F32(0, NULL), ns(us * 1000) {}
+    virtual void update(void) { host_cycle_ns += ns; }
+
+  private:
+    uint32_t ns;
+};
+
+// Audio_Profile_Write() into memory
+class MemoryPrint : public Print
+{
+  public:
+    std::vector<uint8_t> data;
+    size_t write(uint8_t c) { data.push_back(c); return 1; }
+    using  Print::write;
+};
+
+// 1 node of the binary report, times in 0.1us, hist in 1/1000 of blocks
+struct Profile_Row {
+    std::string name;
+    uint16_t    avg, max, ready_avg, ready_max;
+    uint16_t    hist[PROFILE_BINS];
+};
+
+// Read the binary report back.  False if the header or checksum is wrong.
+static bool profile_read(std::vector<Profile_Row> &rows, uint32_t *blocks)
+{
+    MemoryPrint mp;
+    uint8_t     sum = 0;
+    size_t      k = 0;
+
+    Audio_Profile_Write(mp);
+    const std::vector<uint8_t> &d = mp.data;
+    auto get = [&d, &k](uint8_t bytes) {
+        uint32_t v = 0;
+        for (uint8_t i = 0; i < bytes && k < d.size(); i++)
+            v |= (uint32_t) d[k++] << (8 * i);
+        return v;
+    };
+    for (size_t i = 0; i + 1 < d.size(); i++)
+        sum += d[i];
+    if (d.size() < 14 || d[0] != 'A' || d[1] != 'P' || d[2] != PROFILE_VERSION || d.back() != sum)
+        return false;
+    k = 3;
+    uint8_t n = get(1);
+    *blocks = get(4);
+    get(2);                                 // MHz
+    get(2);                                 // block us
+    if (get(1) != PROFILE_BINS)
+        return false;
+    rows.resize(n);
+    for (Profile_Row &r : rows)
+    {
+        uint8_t len = get(1);
+        r.name.assign((const char *) &d[k], len);
+        k += len;
+        r.avg       = get(2);
+        r.max       = get(2);
+        r.ready_avg = get(2);
+        r.ready_max = get(2);
+        for (uint8_t b = 0; b < PROFILE_BINS; b++)
+            r.hist[b] = get(2);
+    }
+    return k + 1 == d.size();
+}
+
+static const Profile_Row *profile_row(const std::vector<Profile_Row> &rows, const char *name)
+{
+    for (const Profile_Row &r : rows)
+        if (r.name == name)
+            return &r;
+    return NULL;
+}
+
+// Row has nothing counted
+static bool profile_empty(const Profile_Row *r)
+{
+    uint32_t n = r->avg + r->max + r->ready_avg + r->ready_max;
+
+    for (uint8_t b = 0; b < PROFILE_BINS; b++)
+        n += r->hist[b];
+    return n == 0;
+}
+
+// What the report gives for ns of cycle counter:  the library keeps 64 cycle units, the report 0.1us at 1000MHz
+static uint16_t profile_tenths(uint32_t ns)
+{
+    return (uint16_t) ((uint64_t) (ns >> 6) * 640 / 1000);
+}
+
+// Row is a node taking 'us' every block:  that average and maximum, and every block in the bin of 'us'
+static bool profile_exact(const Profile_Row *r, uint32_t us)
+{
+    uint8_t bin = 32 - __builtin_clz(us);
+
+    return r->avg == profile_tenths(us * 1000) && r->max == r->avg && r->hist[bin] == 1000;
+}
+
+//
+//  AudioProfile.cpp on 3 busy objects that each move the cycle counter a known time:  200us and 50us running, 100us
+//  stopped.  Nothing else moves it, so every figure is known to the unit.  Read back through the binary report, each
+//  running one is to get its own time and nothing of the others', the ready at times are to add up in update order
+//  with the stopped one left out, and the stopped one is to have nothing.  Then the 200us object is stopped and the
+//  profile started again:  the counts are to start from 0, with no trace of the first run.
+//
+static void test_profile(void)
+{
+    const uint32_t          blocks = 100;
+    TestBusy_F32           *a = new TestBusy_F32(200);
+    TestBusy_F32           *s = new TestBusy_F32(100);
+    TestBusy_F32           *b = new TestBusy_F32(50);
+    std::vector<Profile_Row> rows;
+    uint32_t                n = 0;
+
+    audio_nodes[audio_nodes_count++] = { a, "test_busy_200", true };
+    audio_nodes[audio_nodes_count++] = { s, "test_busy_stopped", true };
+    audio_nodes[audio_nodes_count++] = { b, "test_busy_50", true };
+    Audio_Set_Active(a, true);
+    Audio_Set_Active(b, true);
+
+    Audio_Profile_Start();
+    run(blocks);
+    bool read = profile_read(rows, &n);
+    const Profile_Row *ra = profile_row(rows, "test_busy_200"), *rs = profile_row(rows, "test_busy_stopped");
+    const Profile_Row *rb = profile_row(rows, "test_busy_50"), *rt = profile_row(rows, "(audio interrupt)");
+    bool ok = read && n == blocks && ra && rs && rb && rt;
+    if (ok)
+    {
+        uint16_t both = profile_tenths(200000 - 200000 % 64 + 50000 - 50000 % 64);
+        ok = profile_exact(ra, 200) && profile_exact(rb, 50) && profile_empty(rs) && ra->ready_avg == ra->avg &&
+             rb->ready_avg == both && rt->avg == both;
+        result(ok, "profile_attribution", "%u blocks, avg %.1f and %.1f us, ready %.1f and %.1f us, stopped %s "
+               "(limits %.1f, %.1f, %.1f, %.1f, empty)", n, ra->avg / 10.0f, rb->avg / 10.0f, ra->ready_avg / 10.0f,
+               rb->ready_avg / 10.0f, profile_empty(rs) ? "empty" : "counted", profile_tenths(200000) / 10.0f,
+               profile_tenths(50000) / 10.0f, profile_tenths(200000) / 10.0f, both / 10.0f);
+    }
+    else
+        result(false, "profile_attribution", "report not read back, %u blocks (limit %u)", n, blocks);
+
+    Audio_Set_Active(a, false);
+    Audio_Profile_Start();
+    run(blocks / 2);
+    read = profile_read(rows, &n);
+    ra = profile_row(rows, "test_busy_200");
+    rb = profile_row(rows, "test_busy_50");
+    rt = profile_row(rows, "(audio interrupt)");
+    ok = read && n == blocks / 2 && ra && rb && rt;
+    if (ok)
+    {
+        ok = profile_empty(ra) && profile_exact(rb, 50) && rt->avg == rb->avg;
+        result(ok, "profile_restart", "%u blocks, stopped 200us object %s, avg %.1f us, interrupt %.1f us "
+               "(limits %u, empty, %.1f, %.1f)", n, profile_empty(ra) ? "empty" : "counted", rb->avg / 10.0f,
+               rt->avg / 10.0f, blocks / 2, profile_tenths(50000) / 10.0f, profile_tenths(50000) / 10.0f);
+    }
+    else
+        result(false, "profile_restart", "report not read back, %u blocks (limit %u)", n, blocks / 2);
+    Audio_Profile_Stop();
+    stop({a, s, b});
+}
+
+//------------------------------------------- Hilbert --------------------------------------------------------------
+
+//
+//  AudioFilterHilbertIQ_F32 against the 2 FIR objects and RX_Summer it replaced.  The old pair ran the +45 table over
+//  I and the -45 table over Q, the summer added them for USB and took them apart for LSB.  The fused block is given the
+//  +45 table only.  Every use of the block is checked:  the USB and LSB sums, the 2 separate outputs and 1 input (TX).
+//  The folding adds in a different order, so the limit is float rounding, 1e-6 of the peak.
+//
+static void hilbert_case(const float *plus45, const float *minus45, uint16_t taps, const std::vector<float> &i,
+                         const std::vector<float> &q, float *worst)
+{
+    std::vector<float> p_i, m_q, p_x, m_x, ref;
+
+    fir_ref(plus45, taps, i, p_i);
+    fir_ref(minus45, taps, q, m_q);
+    fir_ref(minus45, taps, i, m_x);     // TX, both filters fed the same audio
+
+    for (int8_t sb : {1, -1, 0, 2})     // 2 is 1 input
+    {
+        TestSource_F32           *src  = new TestSource_F32;
+        AudioFilterHilbertIQ_F32 *hil  = new AudioFilterHilbertIQ_F32(audio_settings);
+        TestSink_F32             *sink = new TestSink_F32;
+        new AudioConnection_F32(*src, 0, *hil, 0);
+        if (sb != 2)
+            new AudioConnection_F32(*src, 1, *hil, 1);
+        new AudioConnection_F32(*hil, 0, *sink, 0);
+        new AudioConnection_F32(*hil, 1, *sink, 1);
+
+        hil->begin(plus45, taps);
+        hil->setSideband((sb == 2) ? 0 : sb);
+        src->play(i.data(), (sb == 2) ? NULL : q.data(), i.size());
+        run(i.size() / AUDIO_BLOCK_SAMPLES);
+        stop({src, hil, sink});
+
+        if (sb == 1 || sb == -1)
+        {
+            ref.resize(i.size());
+            for (size_t k = 0; k < i.size(); k++)
+                ref[k] = p_i[k] + sb * m_q[k];
+            *worst = max(*worst, max_diff(sink->out[0], ref));
+        }
+        else
+        {
+            *worst = max(*worst, max_diff(sink->out[0], p_i));
+            *worst = max(*worst, max_diff(sink->out[1], (sb == 2) ? m_x : m_q));
+        }
+    }
+}
+
+static void test_hilbert_fused(void)
+{
+    const struct { const float *plus45, *minus45; } pairs[] = {
+        {Hilbert_Plus45_40K, Hilbert_Minus45_40K}, {Hilbert_Plus45_32K, Hilbert_Minus45_32K},
+        {Hilbert_Plus45_28K, Hilbert_Minus45_28K}, {Hilbert_Plus45_23K, Hilbert_Minus45_23K},
+        {Hilbert_Plus45_18K, Hilbert_Minus45_18K}, {Hilbert_Plus45_1K,  Hilbert_Minus45_1K},
+        {Hilbert_Plus45_500, Hilbert_Minus45_500}, {Hilbert_Plus45_700, Hilbert_Minus45_700}
+    };
+    std::vector<float> i, q;
+    float              minus121[121];
+    float              worst = 0.0f;
+
+    make_iq(i, q, 40 * AUDIO_BLOCK_SAMPLES, sample_rate_Hz, 0.05f, {700.0f, -1900.0f, 3100.0f}, 0.15f);
+    for (auto &p : pairs)
+        hilbert_case(p.plus45, p.minus45, 151, i, q, &worst);
+    result(worst <= 1.0e-6f, "hilbert_fused_tables", "%d old pairs, largest difference %.2g of the peak (limit 1e-6)",
+           (int) (sizeof(pairs) / sizeof(pairs[0])), worst);
+
+    // The antisymmetric design keeps only its non zero odd taps.  Its -45 filter is the table reversed.
+    for (uint16_t k = 0; k < 121; k++)
+        minus121[k] = hilbert121A[120 - k];
+    worst = 0.0f;
+    hilbert_case(hilbert121A, minus121, 121, i, q, &worst);
+    result(worst <= 1.0e-6f, "hilbert_fused_121A", "largest difference %.2g of the peak (limit 1e-6)", worst);
+}
+
+//
+//  Hilbert_Design() through design() at each codec rate, with the top SetFilter() gives the widest filter, against the
+//  old 4.0KHz table at 48KHz.  1 input, so out 0 is the +45 and out 1 the -45 filter of it.  A tone at a time every
+//  100Hz from 700Hz to 700Hz under the top edge, the flat part of the old tables:  out 0 is to lead out 1 by 90 degrees
+//  within 0.5 and both are to have unity gain within 0.25dB, the old table's own worst case at 700Hz.
+//
+static void hilbert_sweep(float fs, const float *plus45, float top, float f_lo, float f_hi, float *ph_err, float *g_lo,
+                          float *g_hi)
+{
+    const float               a = 0.5f;
+    const uint32_t            settle = HILBERT_IQ_MAX_TAPS / AUDIO_BLOCK_SAMPLES + 1, fit = 16;
+    AudioSettings_F32         settings(fs, AUDIO_BLOCK_SAMPLES);
+    std::vector<float>        x((settle + fit) * AUDIO_BLOCK_SAMPLES);
+    TestSource_F32           *src  = new TestSource_F32;
+    AudioFilterHilbertIQ_F32 *hil  = new AudioFilterHilbertIQ_F32(settings);
+    TestSink_F32             *sink = new TestSink_F32;
+    new AudioConnection_F32(*src, 0, *hil, 0);
+    new AudioConnection_F32(*hil, 0, *sink, 0);
+    new AudioConnection_F32(*hil, 1, *sink, 1);
+
+    if (plus45)
+        hil->begin(plus45, 151);
+    else
+        hil->design(0, top);
+    *ph_err = 0.0f;
+    *g_lo = 1.0e9f;
+    *g_hi = -1.0e9f;
+    for (float f = f_lo; f <= f_hi + 1.0f; f += 100.0f)
+    {
+        for (size_t k = 0; k < x.size(); k++)
+            x[k] = a * (float) sin(2.0 * M_PI * f * k / fs);
+        sink->out[0].clear();
+        sink->out[1].clear();
+        src->play(x.data(), NULL, x.size());
+        run(settle + fit);
+
+        double c[2][2];
+        for (uint8_t ch = 0; ch < 2; ch++)
+        {
+            tone_coeffs(sink->out[ch], settle * AUDIO_BLOCK_SAMPLES, x.size(), f, fs, &c[ch][0], &c[ch][1]);
+            float g = 20.0f * log10f(hypot(c[ch][0], c[ch][1]) / a);
+            *g_lo = min(*g_lo, g);
+            *g_hi = max(*g_hi, g);
+        }
+        // a cos + b sin is the phasor a - jb
+        double lead = (atan2(-c[0][1], c[0][0]) - atan2(-c[1][1], c[1][0])) * 180.0 / M_PI;
+        lead = fmod(lead + 540.0, 360.0) - 180.0;
+        *ph_err = max(*ph_err, (float) fabs(lead - 90.0));
+    }
+    stop({src, hil, sink});
+}
+
+static void test_hilbert_design(void)
+{
+    const float top = IQ_FRONT_PASSBAND_HZ;     // SetFilter() for the 4.0KHz filter
+    const struct { float fs; const float *plus45; float f_hi; const char *name; } cases[] = {
+        {48000.0f,  Hilbert_Plus45_40K, 3300.0f,     "hilbert_old_4K_48k"},
+        {48000.0f,  NULL,               top - 700.0f, "hilbert_design_48k"},
+        {96000.0f,  NULL,               top - 700.0f, "hilbert_design_96k"},
+        {192000.0f, NULL,               top - 700.0f, "hilbert_design_192k"}
+    };
+
+    for (auto &c : cases)
+    {
+        float ph_err, g_lo, g_hi;
+
+        hilbert_sweep(c.fs, c.plus45, top, 700.0f, c.f_hi, &ph_err, &g_lo, &g_hi);
+        result(ph_err <= 0.5f && g_lo >= -0.25f && g_hi <= 0.25f, c.name,
+               "700 to %.0f Hz, 90 %+.3f deg, gain %+.3f to %+.3f dB (limits 0.5 deg, 0.25 dB)",
+               c.f_hi, ph_err, g_lo, g_hi);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "usage: graph_test\n");
+        return 2;
+    }
+    Serial.mute(true);
+    AudioMemory_F32(150, audio_settings);
+
+    // First, while the update list is short.  AudioGraph.cpp and AudioProfile.cpp read only GRAPH_MAX_NODES of it.
+    test_graph_sort();
+    test_profile();
+    test_hilbert_fused();
+    test_hilbert_design();
+    test_resample();
+    test_filter_switch();
+    test_fftconv();
+    test_agc();
+    test_iq_correct();
+
+    printf("%d failed\n", failed);
+    return failed;
+}
@@ -1,822 +1,15 @@
-#ifndef _HILBERT_H_
-#define _HILBERT_H_
-
-/*
-
-FIR filter designed with
-http://t-filter.appspot.com
-
-sampling frequency: 48000 Hz
-
-* 0 Hz - 200 Hz
-  gain = 0
-  desired attenuation = -80 dB
-  actual attenuation = -80.0073352831158 dB
-
-* 400 Hz - 2800 Hz
-  gain = 1
-  desired ripple = 2 dB
-  actual ripple = 1.538351977958361 dB
-
-* 3000 Hz - 24000 Hz
-  gain = 0
-  desired attenuation = -80 dB
-  actual attenuation = -80.0073352831158 dB
-
-*/
-/*
-#define FILTER_TAP_NUM 581
-
-static float fir2[FILTER_TAP_NUM] = {
-  0.00008572202278216231,
-  0.00008873333848388834,
-  0.00012429278866726628,
-  0.0001591930821580411,
-  0.00018819968064642394,
-  0.00020527100796176802,
-  0.00020420185612135547,
-  0.00017944617778700088,
-  0.00012703700322867688,
-  0.000045495930782735694,
-  -0.00006339658111216871,
-  -0.00019409563804344585,
-  -0.00033717487504835505,
-  -0.000479686141685326,
-  -0.0006060326098542568,
-  -0.0006993329580399399,
-  -0.0007431888874815252,
-  -0.0007237028744294475,
-  -0.0006315396510799533,
-  -0.000463784091081939,
-  -0.0002253439959817679,
-  0.00007033418199881955,
-  0.00040141986625744146,
-  0.0007388193511629794,
-  0.0010482597764636908,
-  0.0012932183676319692,
-  0.0014384678252625646,
-  0.0014539021811481214,
-  0.0013182515521529283,
-  0.0010222685138862703,
-  0.0005709593203006898,
-  -0.000015433166393648808,
-  -0.000701994384912355,
-  -0.0014411875696717829,
-  -0.00217648863233103,
-  -0.0028470718596376784,
-  -0.0033934138797834176,
-  -0.0037630103405227318,
-  -0.003915775112732364,
-  -0.0038284900826356743,
-  -0.003497693603384972,
-  -0.002940757744531348,
-  -0.0021948736306096083,
-  -0.0013139522734143233,
-  -0.00036377815188786154,
-  0.000584180086899555,
-  0.0014596874519192285,
-  0.002200599300003758,
-  0.002758935273860843,
-  0.0031055187306392026,
-  0.003232611683236679,
-  0.003154221691360404,
-  0.002904062128062833,
-  0.0025313607858869535,
-  0.0020949605827990836,
-  0.0016564100552206448,
-  0.0012728445607233885,
-  0.0009904761258882695,
-  0.0008394511375777474,
-  0.0008307060909424746,
-  0.0009551874068810349,
-  0.0011855156668107091,
-  0.0014798919206813544,
-  0.0017877581616992228,
-  0.0020565283253158886,
-  0.002238504046577831,
-  0.0022971540890515812,
-  0.002211921069957627,
-  0.0019809937141419785,
-  0.0016216272865773847,
-  0.0011680058489548888,
-  0.0006668969190029198,
-  0.00017164485211247174,
-  -0.00026470087651825087,
-  -0.000596280141716763,
-  -0.0007904138377150592,
-  -0.000831900149988272,
-  -0.0007250650617037929,
-  -0.0004932617200727438,
-  -0.00017588294119523035,
-  0.0001767445415327878,
-  0.0005099496028371527,
-  0.0007719059959676003,
-  0.0009204867349531348,
-  0.0009288805295896037,
-  0.0007892061459759593,
-  0.0005136310637833733,
-  0.00013282691063987167,
-  -0.00030805920074642877,
-  -0.000755419388671193,
-  -0.001154363855093061,
-  -0.0014561347661773596,
-  -0.0016247629061970426,
-  -0.0016420572934059653,
-  -0.0015102347137331662,
-  -0.0012518150417303504,
-  -0.0009067624022555392,
-  -0.0005272125080745231,
-  -0.00017050488021513814,
-  0.00010858710526630229,
-  0.00026537446280897937,
-  0.0002714973104143004,
-  0.00011901338567495831,
-  -0.0001782412986006828,
-  -0.0005862463768702847,
-  -0.0010551759013351877,
-  -0.0015259895562356016,
-  -0.0019383894493312692,
-  -0.0022390578064603282,
-  -0.002389053925650874,
-  -0.0023693623105966143,
-  -0.002183778859080866,
-  -0.0018587172538878998,
-  -0.0014399130310413545,
-  -0.000986405654530969,
-  -0.000562613800572669,
-  -0.0002295349733187548,
-  -0.00003626763309902262,
-  -0.000013044033421252903,
-  -0.00016673694614603298,
-  -0.0004795280244858373,
-  -0.0009109367446628847,
-  -0.0014030282405422423,
-  -0.0018881062507930047,
-  -0.0022978975031792887,
-  -0.0025729674661105696,
-  -0.0026710930171751713,
-  -0.0025734125856196484,
-  -0.0022874494419022904,
-  -0.0018465474672989526,
-  -0.0013057310818774392,
-  -0.000734486466054176,
-  -0.0002073968191584318,
-  0.00020608492515454001,
-  0.00045134826811571037,
-  0.0004964797710932127,
-  0.0003371119642195928,
-  -0.0000024518289885355536,
-  -0.0004720448625299041,
-  -0.0010020876613323676,
-  -0.001512874400615387,
-  -0.0019254293777617303,
-  -0.0021724837825800366,
-  -0.002208067924228658,
-  -0.002014310920130875,
-  -0.0016044923229378573,
-  -0.0010218558659043104,
-  -0.00033420893406702523,
-  0.00037495653421345745,
-  0.0010177155012563901,
-  0.0015138348923906346,
-  0.0018020340386095388,
-  0.0018489198819904716,
-  0.0016541553177132095,
-  0.0012512031782312147,
-  0.000703348824613646,
-  0.00009553925691499412,
-  -0.00047697830830364105,
-  -0.0009216874768295533,
-  -0.001161753782900844,
-  -0.0011470835393128966,
-  -0.000861892374155786,
-  -0.0003276586225619671,
-  0.0003990324973468977,
-  0.0012335468417787705,
-  0.002074304118165617,
-  0.0028165013392266194,
-  0.0033666193000457686,
-  0.003655678926030284,
-  0.00364934243413958,
-  0.0033534152205921294,
-  0.0028139381230825977,
-  0.00211172722940826,
-  0.001351899286176103,
-  0.0006497027607922578,
-  0.00011467605982297195,
-  -0.00016465919247246426,
-  -0.00013364409017003706,
-  0.0002199302708515577,
-  0.0008631453219127773,
-  0.0017216333257997034,
-  0.0026886582679694314,
-  0.0036391013610810046,
-  0.004446945147763357,
-  0.005001965749690097,
-  0.005226217244590067,
-  0.005085111113899724,
-  0.004593585027151745,
-  0.0038150954305210217,
-  0.0028540204286456243,
-  0.0018421146632642093,
-  0.0009208292896379224,
-  0.00022183225689949903,
-  -0.00015160830619914407,
-  -0.00013976456918353734,
-  0.0002640778628568436,
-  0.0010112793453223143,
-  0.0020031479857027267,
-  0.003103346940387279,
-  0.004155872375285053,
-  0.005006251856131773,
-  0.005523098755347976,
-  0.005617039479918757,
-  0.005254313997899117,
-  0.004463010768145714,
-  0.0033308693513987354,
-  0.0019947246036662696,
-  0.0006228238835826321,
-  -0.0006077293636463174,
-  -0.001535404525342436,
-  -0.002037209413438054,
-  -0.002046962267196123,
-  -0.0015661852334542894,
-  -0.0006659255206445724,
-  0.000521100753327975,
-  0.0018170621179737266,
-  0.003022545935485192,
-  0.003943520792004421,
-  0.004418749246913811,
-  0.004343141142848751,
-  0.0036842840619234585,
-  0.0024893415921391944,
-  0.0008810066867891062,
-  -0.0009570199839933773,
-  -0.00280356726717919,
-  -0.004429578038763109,
-  -0.005629693838384371,
-  -0.006251631410508244,
-  -0.006219257112859137,
-  -0.005545851652642779,
-  -0.004335399942294435,
-  -0.00277137979718598,
-  -0.0010941243688771878,
-  0.00043056925042161715,
-  0.0015475228029264098,
-  0.002048117059305819,
-  0.0018011550983611973,
-  0.0007742140401212112,
-  -0.0009578458294053684,
-  -0.003218905636143668,
-  -0.005751864218541319,
-  -0.00825093315522155,
-  -0.010402002556989736,
-  -0.011925879024715964,
-  -0.012618568084463025,
-  -0.01238292522796306,
-  -0.011246987609649702,
-  -0.00936586637238746,
-  -0.007006267321312496,
-  -0.004514890752904236,
-  -0.0022743559344947806,
-  -0.000651990114812951,
-  0.00005179115258132747,
-  -0.00035142078292258003,
-  -0.0019059077245290397,
-  -0.004497706162846874,
-  -0.007861276891327389,
-  -0.01160720436674065,
-  -0.015268297106312223,
-  -0.01835888925401842,
-  -0.020440178552060734,
-  -0.021183205338430138,
-  -0.020420990099073645,
-  -0.018182321564059425,
-  -0.014701616372520362,
-  -0.010402114975466089,
-  -0.005852968042498621,
-  -0.0017041132403154751,
-  0.0013941136691623887,
-  0.0028773682457846244,
-  0.0023491935729413496,
-  -0.00035206655140238556,
-  -0.005110582116697891,
-  -0.011521280076499331,
-  -0.018912314288789506,
-  -0.026401107631533968,
-  -0.032979265646006485,
-  -0.037617994157692965,
-  -0.03938288305700332,
-  -0.03754537006077609,
-  -0.03167801319750119,
-  -0.02172212533609186,
-  -0.008019020337229244,
-  0.008700001719016212,
-  0.027365358020749724,
-  0.04665830759849134,
-  0.06512899528115348,
-  0.08133151943983268,
-  0.0939620150751448,
-  0.1019852242829441,
-  0.10473605071003413,
-  0.1019852242829441,
-  0.0939620150751448,
-  0.08133151943983268,
-  0.06512899528115348,
-  0.04665830759849134,
-  0.027365358020749724,
-  0.008700001719016212,
-  -0.008019020337229244,
-  -0.02172212533609186,
-  -0.03167801319750119,
-  -0.03754537006077609,
-  -0.03938288305700332,
-  -0.037617994157692965,
-  -0.032979265646006485,
-  -0.026401107631533968,
-  -0.018912314288789506,
-  -0.011521280076499331,
-  -0.005110582116697891,
-  -0.00035206655140238556,
-  0.0023491935729413496,
-  0.0028773682457846244,
-  0.0013941136691623887,
-  -0.0017041132403154751,
-  -0.005852968042498621,
-  -0.010402114975466089,
-  -0.014701616372520362,
-  -0.018182321564059425,
-  -0.020420990099073645,
-  -0.021183205338430138,
-  -0.020440178552060734,
-  -0.01835888925401842,
-  -0.015268297106312223,
-  -0.01160720436674065,
-  -0.007861276891327389,
-  -0.004497706162846874,
-  -0.0019059077245290397,
-  -0.00035142078292258003,
-  0.00005179115258132747,
-  -0.000651990114812951,
-  -0.0022743559344947806,
-  -0.004514890752904236,
-  -0.007006267321312496,
-  -0.00936586637238746,
-  -0.011246987609649702,
-  -0.01238292522796306,
-  -0.012618568084463025,
-  -0.011925879024715964,
-  -0.010402002556989736,
-  -0.00825093315522155,
-  -0.005751864218541319,
-  -0.003218905636143668,
-  -0.0009578458294053684,
-  0.0007742140401212112,
-  0.0018011550983611973,
-  0.002048117059305819,
-  0.0015475228029264098,
-  0.00043056925042161715,
-  -0.0010941243688771878,
-  -0.00277137979718598,
-  -0.004335399942294435,
-  -0.005545851652642779,
-  -0.006219257112859137,
-  -0.006251631410508244,
-  -0.005629693838384371,
-  -0.004429578038763109,
-  -0.00280356726717919,
-  -0.0009570199839933773,
-  0.0008810066867891062,
-  0.0024893415921391944,
-  0.0036842840619234585,
-  0.004343141142848751,
-  0.004418749246913811,
-  0.003943520792004421,
-  0.003022545935485192,
-  0.0018170621179737266,
-  0.000521100753327975,
-  -0.0006659255206445724,
-  -0.0015661852334542894,
-  -0.002046962267196123,
-  -0.002037209413438054,
-  -0.001535404525342436,
-  -0.0006077293636463174,
-  0.0006228238835826321,
-  0.0019947246036662696,
-  0.0033308693513987354,
-  0.004463010768145714,
-  0.005254313997899117,
-  0.005617039479918757,
-  0.005523098755347976,
-  0.005006251856131773,
-  0.004155872375285053,
-  0.003103346940387279,
-  0.0020031479857027267,
-  0.0010112793453223143,
-  0.0002640778628568436,
-  -0.00013976456918353734,
-  -0.00015160830619914407,
-  0.00022183225689949903,
-  0.0009208292896379224,
-  0.0018421146632642093,
-  0.0028540204286456243,
-  0.0038150954305210217,
-  0.004593585027151745,
-  0.005085111113899724,
-  0.005226217244590067,
-  0.005001965749690097,
-  0.004446945147763357,
-  0.0036391013610810046,
-  0.0026886582679694314,
-  0.0017216333257997034,
-  0.0008631453219127773,
-  0.0002199302708515577,
-  -0.00013364409017003706,
-  -0.00016465919247246426,
-  0.00011467605982297195,
-  0.0006497027607922578,
-  0.001351899286176103,
-  0.00211172722940826,
-  0.0028139381230825977,
-  0.0033534152205921294,
-  0.00364934243413958,
-  0.003655678926030284,
-  0.0033666193000457686,
-  0.0028165013392266194,
-  0.002074304118165617,
-  0.0012335468417787705,
-  0.0003990324973468977,
-  -0.0003276586225619671,
-  -0.000861892374155786,
-  -0.0011470835393128966,
-  -0.001161753782900844,
-  -0.0009216874768295533,
-  -0.00047697830830364105,
-  0.00009553925691499412,
-  0.000703348824613646,
-  0.0012512031782312147,
-  0.0016541553177132095,
-  0.0018489198819904716,
-  0.0018020340386095388,
-  0.0015138348923906346,
-  0.0010177155012563901,
-  0.00037495653421345745,
-  -0.00033420893406702523,
-  -0.0010218558659043104,
-  -0.0016044923229378573,
-  -0.002014310920130875,
-  -0.002208067924228658,
-  -0.0021724837825800366,
-  -0.0019254293777617303,
-  -0.001512874400615387,
-  -0.0010020876613323676,
-  -0.0004720448625299041,
-  -0.0000024518289885355536,
-  0.0003371119642195928,
-  0.0004964797710932127,
-  0.00045134826811571037,
-  0.00020608492515454001,
-  -0.0002073968191584318,
-  -0.000734486466054176,
-  -0.0013057310818774392,
-  -0.0018465474672989526,
-  -0.0022874494419022904,
-  -0.0025734125856196484,
-  -0.0026710930171751713,
-  -0.0025729674661105696,
-  -0.0022978975031792887,
-  -0.0018881062507930047,
-  -0.0014030282405422423,
-  -0.0009109367446628847,
-  -0.0004795280244858373,
-  -0.00016673694614603298,
-  -0.000013044033421252903,
-  -0.00003626763309902262,
-  -0.0002295349733187548,
-  -0.000562613800572669,
-  -0.000986405654530969,
-  -0.0014399130310413545,
-  -0.0018587172538878998,
-  -0.002183778859080866,
-  -0.0023693623105966143,
-  -0.002389053925650874,
-  -0.0022390578064603282,
-  -0.0019383894493312692,
-  -0.0015259895562356016,
-  -0.0010551759013351877,
-  -0.0005862463768702847,
-  -0.0001782412986006828,
-  0.00011901338567495831,
-  0.0002714973104143004,
-  0.00026537446280897937,
-  0.00010858710526630229,
-  -0.00017050488021513814,
-  -0.0005272125080745231,
-  -0.0009067624022555392,
-  -0.0012518150417303504,
-  -0.0015102347137331662,
-  -0.0016420572934059653,
-  -0.0016247629061970426,
-  -0.0014561347661773596,
-  -0.001154363855093061,
-  -0.000755419388671193,
-  -0.00030805920074642877,
-  0.00013282691063987167,
-  0.0005136310637833733,
-  0.0007892061459759593,
-  0.0009288805295896037,
-  0.0009204867349531348,
-  0.0007719059959676003,
-  0.0005099496028371527,
-  0.0001767445415327878,
-  -0.00017588294119523035,
-  -0.0004932617200727438,
-  -0.0007250650617037929,
-  -0.000831900149988272,
-  -0.0007904138377150592,
-  -0.000596280141716763,
-  -0.00026470087651825087,
-  0.00017164485211247174,
-  0.0006668969190029198,
-  0.0011680058489548888,
-  0.0016216272865773847,
-  0.0019809937141419785,
-  0.002211921069957627,
-  0.0022971540890515812,
-  0.002238504046577831,
-  0.0020565283253158886,
-  0.0017877581616992228,
-  0.0014798919206813544,
-  0.0011855156668107091,
-  0.0009551874068810349,
-  0.0008307060909424746,
-  0.0008394511375777474,
-  0.0009904761258882695,
-  0.0012728445607233885,
-  0.0016564100552206448,
-  0.0020949605827990836,
-  0.0025313607858869535,
-  0.002904062128062833,
-  0.003154221691360404,
-  0.003232611683236679,
-  0.0031055187306392026,
-  0.002758935273860843,
-  0.002200599300003758,
-  0.0014596874519192285,
-  0.000584180086899555,
-  -0.00036377815188786154,
-  -0.0013139522734143233,
-  -0.0021948736306096083,
-  -0.002940757744531348,
-  -0.003497693603384972,
-  -0.0038284900826356743,
-  -0.003915775112732364,
-  -0.0037630103405227318,
-  -0.0033934138797834176,
-  -0.0028470718596376784,
-  -0.00217648863233103,
-  -0.0014411875696717829,
-  -0.000701994384912355,
-  -0.000015433166393648808,
-  0.0005709593203006898,
-  0.0010222685138862703,
-  0.0013182515521529283,
-  0.0014539021811481214,
-  0.0014384678252625646,
-  0.0012932183676319692,
-  0.0010482597764636908,
-  0.0007388193511629794,
-  0.00040141986625744146,
-  0.00007033418199881955,
-  -0.0002253439959817679,
-  -0.000463784091081939,
-  -0.0006315396510799533,
-  -0.0007237028744294475,
-  -0.0007431888874815252,
-  -0.0006993329580399399,
-  -0.0006060326098542568,
-  -0.000479686141685326,
-  -0.00033717487504835505,
-  -0.00019409563804344585,
-  -0.00006339658111216871,
-  0.000045495930782735694,
-  0.00012703700322867688,
-  0.00017944617778700088,
-  0.00020420185612135547,
-  0.00020527100796176802,
-  0.00018819968064642394,
-  0.0001591930821580411,
-  0.00012429278866726628,
-  0.00008873333848388834,
-  0.00008572202278216231
-};
-
-*/
-
-// 0 Hz - 400 Hz   attenuation = -91.3 dB
-// 900 Hz - 3200 Hz  ripple = 3.5 dB
-// 4000 Hz - 22050 Hz  attenuation = -91.3 dB
-float fir1[197] = {
--0.000055559,
--0.000147344,
--0.000316719,
--0.000577924,
--0.000935088,
--0.001370353,
--0.001837088,
--0.002257289,
--0.002525860,
--0.002522810,
--0.002132945,
--0.001271258,
-0.000090777,
-0.001903041,
-0.004025224,
-0.006230427,
-0.008226846,
-0.009696465,
-0.010346183,
-0.009962901,
-0.008462038,
-0.005918743,
-0.002573045,
--0.001195252,
--0.004920393,
--0.008125220,
--0.010403443,
--0.011493537,
--0.011328776,
--0.010051590,
--0.007987374,
--0.005581243,
--0.003309529,
--0.001583953,
--0.000668813,
--0.000629588,
--0.001324889,
--0.002444378,
--0.003584660,
--0.004346205,
--0.004428872,
--0.003703415,
--0.002241472,
--0.000296177,
-0.001762536,
-0.003542562,
-0.004730781,
-0.005175079,
-0.004925521,
-0.004222762,
-0.003434964,
-0.002958006,
-0.003104078,
-0.004008009,
-0.005577512,
-0.007503235,
-0.009329517,
-0.010570511,
-0.010843252,
-0.009982688,
-0.008106107,
-0.005605464,
-0.003063826,
-0.001112060,
-0.000259182,
-0.000739575,
-0.002419507,
-0.004793437,
-0.007079672,
-0.008399780,
-0.008002803,
-0.005480103,
-0.000913890,
--0.005085814,
--0.011476899,
--0.017002965,
--0.020490697,
--0.021160155,
--0.018871458,
--0.014239486,
--0.008573747,
--0.003638765,
--0.001272973,
--0.002941404,
--0.009320169,
--0.020012463,
--0.033474663,
--0.047190380,
--0.058078052,
--0.063064965,
--0.059719323,
--0.046811884,
--0.024685396,
-0.004656693,
-0.037777075,
-0.070318472,
-0.097716384,
-0.115979356,
-0.122388276,
-0.115979356,
-0.097716384,
-0.070318472,
-0.037777075,
-0.004656693,
--0.024685396,
--0.046811884,
--0.059719323,
--0.063064965,
--0.058078052,
--0.047190380,
--0.033474663,
--0.020012463,
--0.009320169,
--0.002941404,
--0.001272973,
--0.003638765,
--0.008573747,
--0.014239486,
--0.018871458,
--0.021160155,
--0.020490697,
--0.017002965,
--0.011476899,
--0.005085814,
-0.000913890,
-0.005480103,
-0.008002803,
-0.008399780,
-0.007079672,
-0.004793437,
-0.002419507,
-0.000739575,
-0.000259182,
-0.001112060,
-0.003063826,
-0.005605464,
-0.008106107,
-0.009982688,
-0.010843252,
-0.010570511,
-0.009329517,
-0.007503235,
-0.005577512,
-0.004008009,
-0.003104078,
-0.002958006,
-0.003434964,
-0.004222762,
-0.004925521,
-0.005175079,
-0.004730781,
-0.003542562,
-0.001762536,
--0.000296177,
--0.002241472,
--0.003703415,
--0.004428872,
--0.004346205,
--0.003584660,
--0.002444378,
--0.001324889,
--0.000629588,
--0.000668813,
--0.001583953,
--0.003309529,
--0.005581243,
--0.007987374,
--0.010051590,
--0.011328776,
--0.011493537,
--0.010403443,
--0.008125220,
--0.004920393,
--0.001195252,
-0.002573045,
-0.005918743,
-0.008462038,
-0.009962901,
-0.010346183,
-0.009696465,
-0.008226846,
-0.006230427,
-0.004025224,
-0.001903041,
-0.000090777,
--0.001271258,
--0.002132945,
--0.002522810,
--0.002525860,
--0.002257289,
--0.001837088,
--0.001370353,
--0.000935088,
--0.000577924,
--0.000316719,
--0.000147344,
--0.000055559};
+//
+//    Hilbert_Tables.h
+//
+//  The fixed +45/-45 degree Hilbert pairs SDR_RA8875 used before AudioFilterHilbertIQ_F32 and Hilbert_Design(), from
+//  the old Hilbert.h as they were (151 taps, 48 kHz).  Only the host tests use them, as the reference the fused block
+//  and the runtime designs are checked against.  The -45 tables are the +45 ones reversed to within rounding.
+//
+#ifndef _HILBERT_TABLES_H_
+#define _HILBERT_TABLES_H_
 
 //Hilbert for 4.0kHz bandwidth
- float32_t Hilbert_Plus45_40K[151] = {
+static const float Hilbert_Plus45_40K[151] = {
 -1.233052391988710E-6,
  2.907075308628130E-6,
  7.995220415172150E-6,
@@ -969,7 +162,7 @@ float fir1[197] = {
 -0.000015839676635412,
 -0.000012353908001798,
  };
- float32_t Hilbert_Minus45_40K[151] = {
+static const float Hilbert_Minus45_40K[151] = {
 -0.000012353908001798,
 -0.000015839676635409,
 -0.000016078358992731,
@@ -1125,8 +318,8 @@ float fir1[197] = {
 
   
   
-  //Hilbert for 3.2kHz bandwidth
- float32_t Hilbert_Plus45_32K[151] = {
+//Hilbert for 3.2kHz bandwidth
+static const float Hilbert_Plus45_32K[151] = {
  0.000132501681837144,
  0.000154968343115635,
  0.000178447729282951,
@@ -1279,7 +472,7 @@ float fir1[197] = {
 -0.000151102552089858,
 -0.000130835501295127
 };
- float32_t Hilbert_Minus45_32K[151] = {
+static const float Hilbert_Minus45_32K[151] = {
 -0.000130835501295130,
 -0.000151102552089859,
 -0.000173103953246280,
@@ -1432,8 +625,8 @@ float fir1[197] = {
  0.000154968343115622,
  0.000132501681837131
 };
- //Hilbert for 2.8kHz bandwidth
- float32_t Hilbert_Plus45_28K[151] = {
+//Hilbert for 2.8kHz bandwidth
+static const float Hilbert_Plus45_28K[151] = {
  0.000122150398116709,
  0.000142280153142477,
  0.000164862606254755,
@@ -1587,7 +780,7 @@ float fir1[197] = {
 -0.000126901663134422
 };
 
-float32_t Hilbert_Minus45_28K[151] = {
+static const float Hilbert_Minus45_28K[151] = {
 -0.000126901663134429,
 -0.000150306513466325,
 -0.000176233559054478,
@@ -1741,8 +934,8 @@ float32_t Hilbert_Minus45_28K[151] = {
  0.000122150398116699
 };
  
- //Hilbert for 2.3kHz bandwidth
-float32_t Hilbert_Plus45_23K[151] = {
+//Hilbert for 2.3kHz bandwidth
+static const float Hilbert_Plus45_23K[151] = {
  0.000118024494551585,
  0.000138786441849980,
  0.000160817042025472,
@@ -1896,7 +1089,7 @@ float32_t Hilbert_Plus45_23K[151] = {
 -0.000132434275417302
 };
 
-float32_t Hilbert_Minus45_23K[151] = {
+static const float Hilbert_Minus45_23K[151] = {
 -0.000132434275417306,
 -0.000153608217638416,
 -0.000176339594312528,
@@ -2050,8 +1243,8 @@ float32_t Hilbert_Minus45_23K[151] = {
  0.000118024494551575
 };
  
- //Hilbert for 1.8kHz bandwidth
-  float32_t Hilbert_Plus45_18K[151] = {
+//Hilbert for 1.8kHz bandwidth
+static const float Hilbert_Plus45_18K[151] = {
  0.000092166605474956,
  0.000107851058359186,
  0.000125434398640303,
@@ -2205,7 +1398,7 @@ float32_t Hilbert_Minus45_23K[151] = {
 -0.000118345954488061
 };
 
-float32_t Hilbert_Minus45_18K[151] = {
+static const float Hilbert_Minus45_18K[151] = {
 -0.000118345954488068,
 -0.000140416783944035,
 -0.000164713402542623,
@@ -2359,7 +1552,7 @@ float32_t Hilbert_Minus45_18K[151] = {
  0.000092166605474950
 };
 
-float32_t Hilbert_Plus45_1K[151] = {
+static const float Hilbert_Plus45_1K[151] = {
  0.000046200325924934,
  0.000053305238890168,
  0.000061352691173050,
@@ -2513,7 +1706,7 @@ float32_t Hilbert_Plus45_1K[151] = {
 -0.000069196908933717
 };
 
-float32_t Hilbert_Minus45_1K[151] = {
+static const float Hilbert_Minus45_1K[151] = {
 -0.000069196908933722,
 -0.000082094053004976,
 -0.000096530157990149,
@@ -2668,7 +1861,7 @@ float32_t Hilbert_Minus45_1K[151] = {
 };
 
 
-float32_t Hilbert_Plus45_500[151] = {
+static const float Hilbert_Plus45_500[151] = {
  0.000102853112358747,
  0.000119317553099289,
  0.000137022623291954,
@@ -2822,7 +2015,7 @@ float32_t Hilbert_Plus45_500[151] = {
 -0.000119916058167414,
 };
 
-float32_t Hilbert_Minus45_500[151] = {
+static const float Hilbert_Minus45_500[151] = {
 -0.000119916058167417,
 -0.000140666276798194,
 -0.000163683124699928,
@@ -2975,7 +2168,7 @@ float32_t Hilbert_Minus45_500[151] = {
  0.000119317553099287,
  0.000102853112358746
 };
-float32_t Hilbert_Plus45_700[151] = {
+static const float Hilbert_Plus45_700[151] = {
  0.000081001844298921,
  0.000094835498674885,
  0.000109416326172862,
@@ -3129,7 +2322,7 @@ float32_t Hilbert_Plus45_700[151] = {
 -0.000102916167772971
 };
 
-float32_t Hilbert_Minus45_700[151] = {
+static const float Hilbert_Minus45_700[151] = {
 -0.000102916167772974,
 -0.000119529867518622,
 -0.000137362092291866,
@@ -3283,4 +2476,4 @@ float32_t Hilbert_Minus45_700[151] = {
  0.000081001844298917
 };
 
-#endif // _HILBERT_H_
\ No newline at end of file
+#endif  // _HILBERT_TABLES_H_
@@ -0,0 +1,22 @@
+//
+//    HostConfig.h
+//
+//  Included ahead of every radio source file in the host build (-include).  It stands in for SDR_RA8875.h, which
+//  pulls in the display, encoder and network libraries:  the guard is set so that header is skipped, and the few
+//  things the audio files use from it are here.  RadioConfig.h is the radio's own, so the USE_xxx switches match.
+//
+#ifndef _HOST_CONFIG_H_
+#define _HOST_CONFIG_H_
+
+#define _SDR_RA8875_H_
+
+#include <Arduino.h>
+#include <OpenAudio_ArduinoLibrary.h>
+#include "RadioConfig.h"
+
+#define DPRINTLN(...)       Serial.println(__VA_ARGS__)
+#define DPRINT(...)         Serial.print(__VA_ARGS__)
+#define HOT                 __attribute__((hot))
+#define COLD                __attribute__((cold))
+
+#endif  // _HOST_CONFIG_H_
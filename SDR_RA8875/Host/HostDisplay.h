@@ -0,0 +1,21 @@
+//
+//    HostDisplay.h
+//
+//  Included ahead of every file of the display build (make display, -include).  The display files are built with
+//  the radio's own SDR_RA8875.h and RadioConfig.h, with Headless_TFT in place of the display library.  The stand-ins
+//  for the other Arduino libraries SDR_RA8875.h includes are in display/.
+//
+//  make display DISPLAY=RA8876 builds the 1024x600 RA8876 screen the same way, as RadioConfig.h does without
+//  USE_RA8875.
+//
+#ifndef _HOST_DISPLAY_H_
+#define _HOST_DISPLAY_H_
+
+#include "RadioConfig.h"
+
+#define HEADLESS_TFT
+#ifdef HOST_RA8876
+    #undef USE_RA8875
+#endif
+
+#endif  // _HOST_DISPLAY_H_
@@ -0,0 +1,14 @@
+//
+//    OpenAudio_ArduinoLibrary.h
+//
+//  Host stand-in for the OpenAudio library header.  The F32 base classes come from Libraries/OpenAudio_Library, the
+//  few library objects the runner's graph needs are in AudioLibrary_F32.h.
+//
+#ifndef _HOST_OPENAUDIO_ARDUINOLIBRARY_H_
+#define _HOST_OPENAUDIO_ARDUINOLIBRARY_H_
+
+#include <Arduino.h>
+#include <AudioStream_F32.h>
+#include "AudioLibrary_F32.h"
+
+#endif  // _HOST_OPENAUDIO_ARDUINOLIBRARY_H_
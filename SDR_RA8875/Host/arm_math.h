@@ -0,0 +1,260 @@
+//
+//    arm_math.h
+//
+//  Plain C++ versions of the CMSIS-DSP functions the radio's audio objects use, with the same structures, buffer
+//  formats and scaling:  FIR coefficients in time reversed order, state buffers of the CMSIS sizes, arm_rfft_fast
+//  packing (DC and Nyquist in the first 2 words) and 1/N on the inverse transforms.  Written for being easy to check
+//  against the CMSIS documentation, not for speed, so host times compare builds with each other and not with the
+//  Teensy.
+//
+#ifndef _HOST_ARM_MATH_H_
+#define _HOST_ARM_MATH_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+typedef float   float32_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+typedef enum {
+    ARM_MATH_SUCCESS        =  0,
+    ARM_MATH_ARGUMENT_ERROR = -1,
+    ARM_MATH_LENGTH_ERROR   = -2
+} arm_status;
+
+#ifndef PI
+#define PI  3.14159265358979f
+#endif
+
+//------------------------------------------- Basic math -------------------------------------------------------------
+
+inline void arm_add_f32(const float32_t *a, const float32_t *b, float32_t *d, uint32_t n)    { for (uint32_t i = 0; i < n; i++) d[i] = a[i] + b[i]; }
+inline void arm_sub_f32(const float32_t *a, const float32_t *b, float32_t *d, uint32_t n)    { for (uint32_t i = 0; i < n; i++) d[i] = a[i] - b[i]; }
+inline void arm_mult_f32(const float32_t *a, const float32_t *b, float32_t *d, uint32_t n)   { for (uint32_t i = 0; i < n; i++) d[i] = a[i] * b[i]; }
+inline void arm_scale_f32(const float32_t *a, float32_t s, float32_t *d, uint32_t n)         { for (uint32_t i = 0; i < n; i++) d[i] = a[i] * s; }
+inline void arm_offset_f32(const float32_t *a, float32_t s, float32_t *d, uint32_t n)        { for (uint32_t i = 0; i < n; i++) d[i] = a[i] + s; }
+inline void arm_copy_f32(const float32_t *a, float32_t *d, uint32_t n)                       { memmove(d, a, n * sizeof(float32_t)); }
+inline void arm_fill_f32(float32_t v, float32_t *d, uint32_t n)                              { for (uint32_t i = 0; i < n; i++) d[i] = v; }
+
+// First of the largest, as CMSIS
+inline void arm_max_f32(const float32_t *s, uint32_t n, float32_t *result, uint32_t *index)
+{
+    uint32_t k = 0;
+    for (uint32_t i = 1; i < n; i++)
+        if (s[i] > s[k])
+            k = i;
+    *result = s[k];
+    *index  = k;
+}
+
+inline void arm_cmplx_mag_squared_f32(const float32_t *s, float32_t *d, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+        d[i] = s[2*i] * s[2*i] + s[2*i+1] * s[2*i+1];
+}
+
+inline void arm_cmplx_mult_cmplx_f32(const float32_t *a, const float32_t *b, float32_t *d, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        float32_t re = a[2*i] * b[2*i]   - a[2*i+1] * b[2*i+1];
+        float32_t im = a[2*i] * b[2*i+1] + a[2*i+1] * b[2*i];
+        d[2*i]   = re;
+        d[2*i+1] = im;
+    }
+}
+
+//------------------------------------------- FIR decimator and interpolator -----------------------------------------
+
+typedef struct {
+    uint8_t          M;
+    uint16_t         numTaps;
+    const float32_t *pCoeffs;
+    float32_t       *pState;            // numTaps + blockSize - 1
+} arm_fir_decimate_instance_f32;
+
+inline arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S, uint16_t numTaps, uint8_t M,
+                                            const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize)
+{
+    if (M == 0 || blockSize % M)
+        return ARM_MATH_LENGTH_ERROR;
+    S->M       = M;
+    S->numTaps = numTaps;
+    S->pCoeffs = pCoeffs;
+    S->pState  = pState;
+    memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+    return ARM_MATH_SUCCESS;
+}
+
+inline void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S, const float32_t *src, float32_t *dst, uint32_t blockSize)
+{
+    uint16_t   N = S->numTaps;
+    float32_t *x = S->pState;           // the last N-1 inputs then this block
+
+    memcpy(x + N - 1, src, blockSize * sizeof(float32_t));
+    for (uint32_t o = 0; o < blockSize / S->M; o++)
+    {
+        const float32_t *w = x + o * S->M + S->M - 1;   // oldest sample under the newest output
+        float32_t acc = 0.0f;
+        for (uint16_t i = 0; i < N; i++)
+            acc += S->pCoeffs[i] * w[i];
+        dst[o] = acc;
+    }
+    memmove(x, x + blockSize, (N - 1) * sizeof(float32_t));
+}
+
+typedef struct {
+    uint8_t          L;
+    uint16_t         phaseLength;
+    const float32_t *pCoeffs;
+    float32_t       *pState;            // phaseLength + blockSize - 1
+} arm_fir_interpolate_instance_f32;
+
+inline arm_status arm_fir_interpolate_init_f32(arm_fir_interpolate_instance_f32 *S, uint8_t L, uint16_t numTaps,
+                                               const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize)
+{
+    if (L == 0 || numTaps % L)
+        return ARM_MATH_LENGTH_ERROR;
+    S->L           = L;
+    S->phaseLength = numTaps / L;
+    S->pCoeffs     = pCoeffs;
+    S->pState      = pState;
+    memset(pState, 0, (S->phaseLength + blockSize - 1) * sizeof(float32_t));
+    return ARM_MATH_SUCCESS;
+}
+
+inline void arm_fir_interpolate_f32(const arm_fir_interpolate_instance_f32 *S, const float32_t *src, float32_t *dst, uint32_t blockSize)
+{
+    uint16_t   P = S->phaseLength;
+    uint8_t    L = S->L;
+    float32_t *x = S->pState;
+
+    memcpy(x + P - 1, src, blockSize * sizeof(float32_t));
+    for (uint32_t n = 0; n < blockSize; n++)
+        for (uint8_t p = 0; p < L; p++)
+        {
+            // Output phase p uses every L'th tap.  Reversed taps:  tap L*k + (L-1-p) goes with the k'th oldest input.
+            float32_t acc = 0.0f;
+            for (uint16_t k = 0; k < P; k++)
+                acc += S->pCoeffs[k * L + (L - 1 - p)] * x[n + k];
+            dst[n * L + p] = acc;
+        }
+    memmove(x, x + blockSize, (P - 1) * sizeof(float32_t));
+}
+
+//------------------------------------------- FFT --------------------------------------------------------------------
+
+typedef struct {
+    uint16_t fftLen;
+} arm_cfft_instance_f32;
+
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len16   = {16};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len32   = {32};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len64   = {64};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len128  = {128};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len256  = {256};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len512  = {512};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024 = {1024};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len2048 = {2048};
+static const arm_cfft_instance_f32 arm_cfft_sR_f32_len4096 = {4096};
+
+// In place radix 2 FFT of n interleaved complex values, n a power of 2.  Inverse is scaled by 1/n.
+inline void _host_fft(float32_t *b, uint32_t n, bool inverse)
+{
+    for (uint32_t i = 1, j = 0; i < n; i++)
+    {
+        uint32_t bit = n >> 1;
+        for ( ; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+        {
+            float32_t t;
+            t = b[2*i];   b[2*i]   = b[2*j];   b[2*j]   = t;
+            t = b[2*i+1]; b[2*i+1] = b[2*j+1]; b[2*j+1] = t;
+        }
+    }
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        double a = ((inverse) ? 2.0 : -2.0) * M_PI / len;
+        for (uint32_t k = 0; k < len / 2; k++)
+        {
+            float32_t wr = (float32_t) cos(a * k), wi = (float32_t) sin(a * k);
+            for (uint32_t i = k; i < n; i += len)
+            {
+                uint32_t  j  = i + len / 2;
+                float32_t vr = b[2*j] * wr - b[2*j+1] * wi;
+                float32_t vi = b[2*j] * wi + b[2*j+1] * wr;
+                b[2*j]   = b[2*i]   - vr;
+                b[2*j+1] = b[2*i+1] - vi;
+                b[2*i]   += vr;
+                b[2*i+1] += vi;
+            }
+        }
+    }
+    if (inverse)
+        arm_scale_f32(b, 1.0f / n, b, 2 * n);
+}
+
+// Output always in normal order, bitReverseFlag 0 is not supported
+inline void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+    (void) bitReverseFlag;
+    _host_fft(p, S->fftLen, ifftFlag);
+}
+
+typedef struct {
+    uint16_t fftLenRFFT;
+} arm_rfft_fast_instance_f32;
+
+inline arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t fftLen)
+{
+    if (fftLen < 32 || (fftLen & (fftLen - 1)))
+        return ARM_MATH_ARGUMENT_ERROR;
+    S->fftLenRFFT = fftLen;
+    return ARM_MATH_SUCCESS;
+}
+
+//  Forward:  n reals in, X[0].re X[n/2].re X[1].re X[1].im ... X[n/2-1].im out.  Inverse:  the same packing in, n
+//  reals out.  Done as an n point complex FFT, which is the easy way to be sure of the packing.
+inline void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag)
+{
+    uint32_t  n = S->fftLenRFFT;
+    float32_t b[2 * 8192];
+
+    if (n > 8192)
+        return;
+    if (!ifftFlag)
+    {
+        for (uint32_t i = 0; i < n; i++)
+        {
+            b[2*i]   = p[i];
+            b[2*i+1] = 0.0f;
+        }
+        _host_fft(b, n, false);
+        pOut[0] = b[0];
+        pOut[1] = b[n];
+        memcpy(pOut + 2, b + 2, (n - 2) * sizeof(float32_t));
+    }
+    else
+    {
+        b[0] = p[0];
+        b[1] = 0.0f;
+        b[n] = p[1];
+        b[n+1] = 0.0f;
+        for (uint32_t k = 1; k < n / 2; k++)
+        {
+            b[2*k]         =  p[2*k];
+            b[2*k+1]       =  p[2*k+1];
+            b[2*(n-k)]     =  p[2*k];
+            b[2*(n-k)+1]   = -p[2*k+1];
+        }
+        _host_fft(b, n, true);
+        for (uint32_t i = 0; i < n; i++)
+            pOut[i] = b[2*i];
+    }
+}
+
+#endif  // _HOST_ARM_MATH_H_
@@ -0,0 +1,19 @@
+//
+//    Encoder.h
+//
+//  Host stand-in, the knobs never turn.
+//
+#ifndef _HOST_ENCODER_H_
+#define _HOST_ENCODER_H_
+
+class Encoder
+{
+  public:
+    Encoder(uint8_t pin1, uint8_t pin2) {}
+    int32_t read(void)          { return position; }
+    void    write(int32_t p)    { position = p; }
+  private:
+    int32_t position = 0;
+};
+
+#endif  // _HOST_ENCODER_H_
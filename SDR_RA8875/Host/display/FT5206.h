@@ -0,0 +1,9 @@
+//
+//    FT5206.h
+//
+//  Host stand-in, nothing on the host build uses it.
+//
+#ifndef _HOST_FT5206_H_
+#define _HOST_FT5206_H_
+
+#endif  // _HOST_FT5206_H_
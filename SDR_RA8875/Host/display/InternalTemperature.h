@@ -0,0 +1,17 @@
+//
+//    InternalTemperature.h
+//
+//  Host stand-in, a steady room temperature.
+//
+#ifndef _HOST_INTERNAL_TEMPERATURE_H_
+#define _HOST_INTERNAL_TEMPERATURE_H_
+
+class InternalTemperatureClass
+{
+  public:
+    float   readTemperatureC(void)  { return 25.0f; }
+    float   readTemperatureF(void)  { return 77.0f; }
+};
+extern InternalTemperatureClass InternalTemperature;
+
+#endif  // _HOST_INTERNAL_TEMPERATURE_H_
@@ -0,0 +1,31 @@
+//
+//    Metro.h
+//
+//  Host stand-in for the Metro timer library, on the virtual millis() clock.
+//
+#ifndef _HOST_METRO_H_
+#define _HOST_METRO_H_
+
+#include <Arduino.h>
+
+class Metro
+{
+  public:
+    Metro(unsigned long interval_millis) : interval_millis(interval_millis) { reset(); }
+    void    interval(unsigned long ms)  { interval_millis = ms; }
+    void    reset(void)                 { previous_millis = millis(); }
+    bool    check(void)
+    {
+        if (millis() - previous_millis >= interval_millis)
+        {
+            previous_millis = millis();
+            return true;
+        }
+        return false;
+    }
+  private:
+    unsigned long interval_millis;
+    unsigned long previous_millis;
+};
+
+#endif  // _HOST_METRO_H_
@@ -0,0 +1,9 @@
+//
+//    SPI.h
+//
+//  Host stand-in, nothing on the host build uses it.
+//
+#ifndef _HOST_SPI_H_
+#define _HOST_SPI_H_
+
+#endif  // _HOST_SPI_H_
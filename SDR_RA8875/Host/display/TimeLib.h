@@ -0,0 +1,23 @@
+//
+//    TimeLib.h
+//
+//  Host stand-in for the Time library, the clock reads the virtual millis() from midnight.
+//
+#ifndef _HOST_TIMELIB_H_
+#define _HOST_TIMELIB_H_
+
+#include <Arduino.h>
+
+inline uint32_t now(void)               { return millis() / 1000; }
+inline int      hour(void)              { return (now() / 3600) % 24; }
+inline int      minute(void)            { return (now() / 60) % 60; }
+inline int      second(void)            { return now() % 60; }
+inline int      day(void)               { return 1; }
+inline int      month(void)             { return 1; }
+inline int      year(void)              { return 2000; }
+inline void     setTime(uint32_t)       {}
+inline void     setSyncProvider(uint32_t (*)(void)) {}
+inline bool     timeStatus(void)        { return true; }
+#define timeSet true
+
+#endif  // _HOST_TIMELIB_H_
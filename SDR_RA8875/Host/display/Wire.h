@@ -0,0 +1,9 @@
+//
+//    Wire.h
+//
+//  Host stand-in, nothing on the host build uses it.
+//
+#ifndef _HOST_WIRE_H_
+#define _HOST_WIRE_H_
+
+#endif  // _HOST_WIRE_H_
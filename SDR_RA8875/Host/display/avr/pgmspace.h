@@ -0,0 +1,12 @@
+//
+//    avr/pgmspace.h
+//
+//  Host stand-in, flash and RAM are the same memory.
+//
+#ifndef _HOST_AVR_PGMSPACE_H_
+#define _HOST_AVR_PGMSPACE_H_
+
+#define pgm_read_byte(addr)     (*(const unsigned char *) (addr))
+#define pgm_read_word(addr)     (*(const unsigned short *) (addr))
+
+#endif  // _HOST_AVR_PGMSPACE_H_
@@ -0,0 +1,33 @@
+//
+//    ili9488_t3_font_Arial.h
+//
+//  Host stand-in.  The font layout of ILI9341_t3 with no glyph data, Headless_TFT steps the cursor 6 pixels a
+//  character when a font has none.  The fonts themselves are in DisplayRunner.cpp.
+//
+#ifndef _HOST_ILI9488_T3_FONT_ARIAL_H_
+#define _HOST_ILI9488_T3_FONT_ARIAL_H_
+
+typedef struct {
+    const unsigned char *index;
+    const unsigned char *unicode;
+    const unsigned char *data;
+    unsigned char version;
+    unsigned char reserved;
+    unsigned char index1_first;
+    unsigned char index1_last;
+    unsigned char index2_first;
+    unsigned char index2_last;
+    unsigned char bits_index;
+    unsigned char bits_width;
+    unsigned char bits_height;
+    unsigned char bits_xoffset;
+    unsigned char bits_yoffset;
+    unsigned char bits_delta;
+    unsigned char line_space;
+    unsigned char cap_height;
+} ILI9341_t3_font_t;
+
+extern const ILI9341_t3_font_t Arial_8, Arial_9, Arial_10, Arial_11, Arial_12, Arial_13, Arial_14, Arial_16, Arial_18,
+                               Arial_20, Arial_24, Arial_28, Arial_32, Arial_40, Arial_48, Arial_60, Arial_72, Arial_96;
+
+#endif  // _HOST_ILI9488_T3_FONT_ARIAL_H_
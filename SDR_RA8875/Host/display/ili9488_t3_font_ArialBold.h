@@ -0,0 +1,15 @@
+//
+//    ili9488_t3_font_ArialBold.h
+//
+//  Host stand-in, see ili9488_t3_font_Arial.h
+//
+#ifndef _HOST_ILI9488_T3_FONT_ARIALBOLD_H_
+#define _HOST_ILI9488_T3_FONT_ARIALBOLD_H_
+
+#include "ili9488_t3_font_Arial.h"
+
+extern const ILI9341_t3_font_t Arial_8_Bold, Arial_9_Bold, Arial_10_Bold, Arial_11_Bold, Arial_12_Bold, Arial_13_Bold,
+                               Arial_14_Bold, Arial_16_Bold, Arial_18_Bold, Arial_20_Bold, Arial_24_Bold, Arial_28_Bold,
+                               Arial_32_Bold, Arial_40_Bold, Arial_48_Bold, Arial_60_Bold, Arial_72_Bold, Arial_96_Bold;
+
+#endif  // _HOST_ILI9488_T3_FONT_ARIALBOLD_H_
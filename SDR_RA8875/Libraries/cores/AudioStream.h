@@ -53,6 +53,9 @@
 //   AudioInputUSB, AudioOutputUSB, AudioPlaySdWav, AudioAnalyzeFFT256,
 //   AudioAnalyzeFFT1024
 
+// KEITHSDR:  32, 64 or 128.  The sketch's own audio objects and the USB audio in this folder follow it.  Every file has
+// to see the same value, so it is set here and not in RadioConfig.h.  32 is about 1/4 of the latency at 128 for
+// more interrupts per second, see the block size notes in RadioConfig.h.
 #ifndef AUDIO_BLOCK_SAMPLES
 #ifdef USB_AUDIO_48KHZ
 #define AUDIO_BLOCK_SAMPLES  128
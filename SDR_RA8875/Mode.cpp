@@ -6,12 +6,16 @@
 //#include "Mode.h"
 
 extern AudioMixer4_F32  	RX_Summer; 
+extern AudioFilterHilbertIQ_F32 RX_Hilbert;
 extern AudioSwitch4_OA_F32  RxTx_InputSwitch_L;
 extern AudioSwitch4_OA_F32  RxTx_InputSwitch_R;
 extern struct Modes_List 	modeList[];
 extern int32_t 				ModeOffset;
 extern struct User_Settings user_settings[];
 extern uint8_t              user_Profile;
+extern float                sample_rate_Hz;
+extern AudioSettings_F32    audio_settings;
+extern bool                 Change_Sample_Rate(float new_sample_rate_Hz);
 
 COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by increment delta.
 {
@@ -21,7 +25,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="CW";
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);  // Turn on non-FM
-		RX_Summer.gain(1, 1.0f);
+		RX_Hilbert.setSideband(1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -35,7 +39,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="CW_REV;
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);
-		RX_Summer.gain(1, -1.0f);
+		RX_Hilbert.setSideband(-1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -49,7 +53,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="USB";          
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);
-		RX_Summer.gain(1, 1.0f);
+		RX_Hilbert.setSideband(1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -63,7 +67,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="LSB";
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);
-		RX_Summer.gain(1, -1.0f);
+		RX_Hilbert.setSideband(-1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -77,7 +81,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="DATA";          
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);
-		RX_Summer.gain(1, 1.0f);
+		RX_Hilbert.setSideband(1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -92,7 +96,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="DATA_REV";          
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);
-		RX_Summer.gain(1, -1.0f);
+		RX_Hilbert.setSideband(-1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -107,7 +111,7 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 		//mode="AM";          
 		AudioNoInterrupts();
 		RX_Summer.gain(0, 1.0f);
-		RX_Summer.gain(1, 1.0f);
+		RX_Hilbert.setSideband(1);
 		RX_Summer.gain(3, 0.0f);  // Turn off FM
 		// Select our sources for the FFT.  mode.h will change this so CW uses the output (for now as an experiment)
         RxTx_InputSwitch_L.setChannel(0); // Select RX path
@@ -120,16 +124,20 @@ COLD void selectMode(uint8_t mndx)   // Change Mode of the current active VFO by
 	{
 		//mode="FM";          
 		AudioNoInterrupts();
-		RX_Summer.gain(0, 0.0f);
-		RX_Summer.gain(1, 0.0f);  // Turn off other modes
+		RX_Summer.gain(0, 0.0f);  // Turn off other modes
 		RX_Summer.gain(3, 1.0f);  // Select FM path
 		RxTx_InputSwitch_L.setChannel(2); // Select FM path
 		RxTx_InputSwitch_R.setChannel(2); // Shut off unused output (in this mode)		
 		AudioInterrupts();
 		ModeOffset = 0; // show shaded filter width on both sides of center
 		NBLevel(-100);	// Turn off NB for FM mode
+		if (sample_rate_Hz != audio_settings.sample_rate_Hz)	// FM_Detector only works at the rate it was built for
+			Change_Sample_Rate(audio_settings.sample_rate_Hz);
 	}
 
+	if (user_settings[user_Profile].xmit == OFF)	// TX_RX_Switch() sets the TX graph
+		Audio_Graph_Select((mndx == FM) ? GRAPH_FM : GRAPH_RX);	// stop the paths this mode does not use
+
 	//DPRINT("Set ModeOffset "); DPRINTLN(ModeOffset);
 	//DPRINT("Set mode to "); DPRINTLN(modeList[mndx].mode_label);  	
   	//displayMode();
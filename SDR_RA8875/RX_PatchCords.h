@@ -0,0 +1,111 @@
+//
+//    RX_PatchCords.h
+//
+//  The receive patch cords:  the IQ input to the spectrum FFT and through demodulation to the output.  SDR_RA8875.ino
+//  and Host/GraphRunner.cpp both include it so the graph the host runs is the radio's.  It defines the connections, so
+//  include it once, at file scope, after the objects it names.  The TX cords are in TX_PatchCords.h,
+//  the FM, beep and USB cords stay in the .ino.
+//
+#ifndef _RX_PATCHCORDS_H_
+#define _RX_PATCHCORDS_H_
+
+// Connections for LineInput and FFT - chooses either the input or the output to display in the spectrum plot
+#if defined(W7PUA_I2S_CORRECTION) && defined(USE_IQ_CORRECT)
+    AudioConnection_F32     patchCord_RX_In_L(Input,0,                           TwinPeak,0); // correct i2s phase imbalance
+    AudioConnection_F32     patchCord_RX_In_R(Input,1,                           TwinPeak,1);
+    AudioConnection_F32     patchCord_RX_IQ_L(TwinPeak,0,                        IQ_Correct,0); // then gain and phase
+    AudioConnection_F32     patchCord_RX_IQ_R(TwinPeak,1,                        IQ_Correct,1);
+    AudioConnection_F32     patchCord_RX_Ph_L(IQ_Correct,0,                      I_Switch,0);  // route raw input audio to the FFT display
+    AudioConnection_F32     patchCord_RX_Ph_R(IQ_Correct,1,                      Q_Switch,0);
+#elif defined(W7PUA_I2S_CORRECTION)
+    AudioConnection_F32     patchCord_RX_In_L(Input,0,                           TwinPeak,0); // correct i2s phase imbalance
+    AudioConnection_F32     patchCord_RX_In_R(Input,1,                           TwinPeak,1);
+    AudioConnection_F32     patchCord_RX_Ph_L(TwinPeak,0,                        I_Switch,0);  // route raw input audio to the FFT display
+    AudioConnection_F32     patchCord_RX_Ph_R(TwinPeak,1,                        Q_Switch,0);
+#elif defined(USE_IQ_CORRECT)
+    AudioConnection_F32     patchCord_RX_IQ_L(Input,0,                           IQ_Correct,0); // correct gain and phase imbalance
+    AudioConnection_F32     patchCord_RX_IQ_R(Input,1,                           IQ_Correct,1);
+    AudioConnection_F32     patchCord_RX_Ph_L(IQ_Correct,0,                      I_Switch,0);  // route raw input audio to the FFT display
+    AudioConnection_F32     patchCord_RX_Ph_R(IQ_Correct,1,                      Q_Switch,0);
+#else
+    AudioConnection_F32     patchCord_RX_Ph_L(Input,0,                           I_Switch,0);  // route raw input audio to the FFT display
+    AudioConnection_F32     patchCord_RX_Ph_R(Input,1,                           Q_Switch,0);
+#endif
+
+// I_Switch has our selected audio source(s), share with the FFT distribution switch FFT_OutSwitch.
+#if defined (USE_FFT_LO_MIXER)
+    //AudioConnection_F32     patchCord_FFT_OUT_L(I_Switch,0,                     FFT_LO_Mixer_I,0);     // Attenuate signals to FFT while in TX mode
+    //AudioConnection_F32     patchCord_FFT_OUT_R(Q_Switch,0,                     FFT_LO_Mixer_I,1);
+    //AudioConnection_F32     patchCord_LO_Mix_L(FFT_LO_Mixer_I,0,              FFT_90deg_Hilbert,0); // Filter I and Q
+    //AudioConnection_F32     patchCord_LO_Mix_R(FFT_LO_Mixer_I,1,              FFT_90deg_Hilbert,1);
+    //AudioConnection_F32     patchCord_LO_Fil_L(FFT_90deg_Hilbert,0,           FFT_Atten_I,0); // Filter I and Q
+    //AudioConnection_F32     patchCord_LO_Fil_R(FFT_90deg_Hilbert,1,           FFT_Atten_Q,0);
+    AudioConnection_F32     patchCord_LO_90Fil_L(TX_FilterConv,0,               FFT_90deg_Hilbert,0); // Filter I and Q
+    AudioConnection_F32     patchCord_LO_90Fil_R(TX_FilterConv,0,               FFT_90deg_Hilbert,1);
+    AudioConnection_F32     patchCord_FFT_OUT_L(FFT_90deg_Hilbert,1,            I_Switch,1);     // Attenuate signals to FFT while in TX mode
+    AudioConnection_F32     patchCord_FFT_OUT_R(FFT_90deg_Hilbert,0,            Q_Switch,1);     // Swap I and Q for correct FFT
+    //AudioConnection_F32     patchCord_LO_Fil_L(FFT_LO_Mixer_I,0,                FFT_Atten_I,0); // Filter I and Q
+    //AudioConnection_F32     patchCord_LO_Fil_R(FFT_LO_Mixer_I,1,                FFT_Atten_Q,0);
+#elif defined(USE_FREQ_SHIFTER)
+    AudioConnection_F32     patchCord_FFT_OUT_L(I_Switch,0,                     FFT_SHIFT_I,0);     // Attenuate signals to FFT while in TX mode
+    AudioConnection_F32     patchCord_FFT_OUT_R(Q_Switch,0,                     FFT_SHIFT_Q,0);
+    AudioConnection_F32     patchCord_FFT_Shift_L(FFT_SHIFT_I,0,                FFT_Atten_I,0); // Filter I and Q
+    AudioConnection_F32     patchCord_FFT_Shift_R(FFT_SHIFT_Q,0,                FFT_Atten_Q,0);
+#else
+    AudioConnection_F32     patchCord_FFT_OUT_L(I_Switch,0,                     FFT_Atten_I,0);     // Attenuate signals to FFT while in TX mode
+    AudioConnection_F32     patchCord_FFT_OUT_R(Q_Switch,0,                     FFT_Atten_Q,0);     // Swap I and Q for correct FFT
+#endif
+
+//AudioConnection_F32     patchCord_LO_Fil_L(I_Switch,0,                      FFT_Atten_I,0); // Filter I and Q
+//AudioConnection_F32     patchCord_LO_Fil_R(Q_Switch,0,                      FFT_Atten_Q,0);
+AudioConnection_F32     patchCord_FFT_ATT_L(FFT_Atten_I,0,                  FFT_OutSwitch_I,0); // Route selected audio source to the selected FFT - should save CPU time
+AudioConnection_F32     patchCord_FFT_ATT_R(FFT_Atten_Q,0,                  FFT_OutSwitch_Q,0);
+
+// One FFT serves all sizes and zoom levels.  FFT_OutSwitch channel 0 feeds it, any other channel turns it off.
+AudioConnection_F32     patchCord_FFT_L(FFT_OutSwitch_I,0,                  myFFT,0);             // Route selected audio source to the FFT
+AudioConnection_F32     patchCord_FFT_R(FFT_OutSwitch_Q,0,                  myFFT,1);
+
+// Send selected IQ source(s) to the audio processing chain for demodulation
+AudioConnection_F32     patchCord_Input_L(I_Switch,0,                       RxTx_InputSwitch_L,0);  // 0 is RX. Output 1 is Tx chain
+AudioConnection_F32     patchCord_Input_R(Q_Switch,0,                       RxTx_InputSwitch_R,0);
+
+// Non-FM path
+#ifdef USE_DEMOD_DECIMATE
+// I and Q go down to the Hilbert rate together in 1 object so they stay in step
+AudioConnection_F32     patchCord10c(RxTx_InputSwitch_L,0,                  RX_Decimate_IQ,0);
+AudioConnection_F32     patchCord10d(RxTx_InputSwitch_R,0,                  RX_Decimate_IQ,1);
+AudioConnection_F32     patchCord10a(RX_Decimate_IQ,0,                      NoiseBlanker,0);
+AudioConnection_F32     patchCord10b(RX_Decimate_IQ,1,                      NoiseBlanker,1);
+#else
+AudioConnection_F32     patchCord10a(RxTx_InputSwitch_L,0,                  NoiseBlanker,0);
+AudioConnection_F32     patchCord10b(RxTx_InputSwitch_R,0,                  NoiseBlanker,1);
+#endif
+// Dual channel hilbert block.  Does the +45/-45 phase shifts and the sideband sum RX_Summer ch 0 and 1 used to do.
+AudioConnection_F32     patchCord11a(NoiseBlanker,0,                        RX_Hilbert,0);
+AudioConnection_F32     patchCord11b(NoiseBlanker,1,                        RX_Hilbert,1);
+AudioConnection_F32     patchCord2c(RX_Hilbert,0,                           RX_Summer,0);  // +45 I +/- -45 Q per RX_Hilbert.setSideband()
+
+// Post mixer processing (now treated as mono audio)
+AudioConnection_F32     patchCord_Summer_Peak(RX_Summer,0,                  S_Peak,0);      // S meter source
+#ifdef USE_DEMOD_DECIMATE
+// Notch, NR, the bandwidth filter and AGC run at the decimated rate
+AudioConnection_F32     patchCord_Summer_Dec(RX_Summer,0,                   RX_Decimate,0);
+AudioConnection_F32     patchCord_Summer_Notch(RX_Decimate,0,               LMS_Notch,0);   // NR and Notch
+AudioConnection_F32     patchCord_Notch(LMS_Notch,0,                        RX_FilterConv,0);  // variable bandwidth filter
+AudioConnection_F32     patchCord_AGC(RX_FilterConv,0,                      RX_AGC,0);
+AudioConnection_F32     patchCord_Interp(RX_AGC,0,                          RX_Interpolate,0);
+AudioConnection_F32     patchCord_RxOut_L(RX_Interpolate,0,                 OutputSwitch_I,0);  // demod and filtering complete
+AudioConnection_F32     patchCord_RxOut_R(RX_Interpolate,0,                 OutputSwitch_Q,0);
+#else
+AudioConnection_F32     patchCord_Summer_Notch(RX_Summer,0,                 LMS_Notch,0);   // NR and Notch
+AudioConnection_F32     patchCord_Notch(LMS_Notch,0,                        RX_FilterConv,0);  // variable bandwidth filter
+AudioConnection_F32     patchCord_AGC(RX_FilterConv,0,                      RX_AGC,0);
+AudioConnection_F32     patchCord_RxOut_L(RX_AGC,0,                         OutputSwitch_I,0);  // demod and filtering complete
+AudioConnection_F32     patchCord_RxOut_R(RX_AGC,0,                         OutputSwitch_Q,0);
+#endif
+
+// Selected source goes to output (selected as headphone or lineout in the code) and boosted if needed
+AudioConnection_F32     patchCord_Output_L(OutputSwitch_I,0,                Output,0);  // output to headphone jack/Line out Left
+AudioConnection_F32     patchCord_Output_R(OutputSwitch_Q,0,                Output,1);  // output to headphone jack/Line out Right
+
+#endif  // _RX_PATCHCORDS_H_
@@ -45,6 +45,10 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
                             //   C:\Program Files (x86)\Arduino\hardware\teensy\avr\libraries\RA8875\_settings\RA8875UserSettings.h
                             //   to enable touch by uncommenting this config item
                             //   #define USE_FT5206_TOUCH//capacitive touch screen
+
+//#define HEADLESS_TFT      // Draw into an in-memory framebuffer (Headless_TFT.h) instead of the RA8875/RA8876 display.
+                            // For host (PC) builds to render and benchmark the spectrum, display and meter drawing code.
+                            // USE_RA8875 still selects the screen size and which display calls are used.
             
 
 //#define OCXO_10MHZ        // Uncomment this line to use a different library that supports External CLKIN for si5351C version PLL boards.
@@ -151,14 +155,54 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
                             // > 1.0f is positive gain.  Too high and you can get clipping.  
                             // See AudioAmplifer doc at https://www.pjrc.com/teensy/gui/index.html?info=AudioAmplifier
 
-// Choose 1024, 2048, or 4096  for AUDIO audio output- usually defined in the main program
-#define FFT_SIZE 4096
-
-// --->>>> Enable one or more FFT pipelines for 2nd window, pan and zoom, if used
-// Recommend all 3 be enabled for 3 zoom levels -  At least one must match FFT_SIZE
-#define FFT_4096 
-#define FFT_2048
-#define FFT_1024
+// --->>>> Spectrum FFT size.  Choose 256, 512, 1024, 2048 or 4096.  One FFT is used for all zoom levels.
+// A mixer moves the pan point to the center and zoom x1 to x16 decimates by 1 to 16 ahead of the FFT,
+// so each zoom step halves the Hz per bin at the same CPU cost.  Size can also be changed at runtime with Change_FFT_Size().
+// Was 4096, but that size was only used when no zoom level matched.  Zoom x1, x2 and x4 ran a 1024, 2048 and 4096
+// point FFT, so the radio started at 1024.  1024 with zoom x1, x2 and x4 gives the same Hz per bin as those did
+// (46.9, 23.4 and 11.7Hz at 48KHz), and x8 and x16 go on from there.  4096 here would make x1 a 9 to 12KHz wide crop of the band.
+#define FFT_SIZE 1024
+
+// --->>>> Demodulated audio sample rate.  The notch/NR and the bandwidth filter run after a decimate by N to no lower
+// than this rate, then the audio is interpolated back up for the codec.  N is 4 at 48KHz, 8 at 96KHz.  Filters up to
+// about 0.45 of this rate pass.  Comment out USE_DEMOD_DECIMATE to run them at the full rate.
+#define USE_DEMOD_DECIMATE
+#define DEMOD_RATE_HZ   12000.0f
+#define DEMOD_PASSBAND_HZ   4100.0f     // kept free of aliases and images, the top of the widest filter[] (4.0KHz)
+
+// --->>>> Codec sample rate.  With USE_DEMOD_DECIMATE the IQ input is first taken down to HILBERT_RATE_HZ (RX_Decimate_IQ,
+// and TX_Decimate/TX_Interpolate around the mic path) so the Hilbert designs, the noise blanker, the S meter
+// and the TX filters run at the rate they were designed for, and the demod stages stay at DEMOD_RATE_HZ.  Only the
+// spectrum FFT sees the whole band.  The rate can then be changed at runtime with Change_Sample_Rate() ('S' on the debug
+// port) to 1, 2 or 4 times HILBERT_RATE_HZ, 48, 96 or 192KHz.  0 to IQ_FRONT_PASSBAND_HZ, a bit above the Hilbert
+// passband, is kept free of aliases.  USB audio and the FM test path are only right at 48KHz.
+#define HILBERT_RATE_HZ         48000.0f
+#define IQ_FRONT_PASSBAND_HZ    5000.0f
+
+// --->>>> AGC in the audio graph (RX_AGC after the bandwidth filter) driven by the agc_set[] table in SDR_Data.h.
+// Comment out to use the SGTL5000 codec auto volume control instead.  That one is set over I2C on every AGC change.
+#define USE_DIGITAL_AGC
+
+// --->>>> Stop the audio objects the current mode does not use (TX chain in RX, RX chain in TX, FM path except in FM).
+// The CPU print (togglePrintMemoryAndCPU()) shows the usage seen in each state.  Comment out to compare.
+#define USE_GRAPH_PRUNING
+
+// --->>>> Put the audio update list in data flow order at startup so each block goes from input to output in the
+// same update.  With DEBUG on, the order and input to output latency are printed before and after.
+#define USE_GRAPH_SORT
+
+// --->>>> Audio block size.  AUDIO_BLOCK_SAMPLES is 128 (2.67ms at 48KHz).  It is set in Libraries/cores/AudioStream.h,
+// not here, because the Teensy core and every audio file have to be built with the same value.  32 or 64 cut the time
+// of every block hop (I2S in and out, USB) for CW and QSK, at the cost of more audio interrupts per second.  The 'P'
+// profile prints the per block scheduler cost, and "make bench" in Host/ compares the latency and overhead of 32, 64
+// and 128.  RX_Decimate sends short blocks every update at any size, and the bandwidth filter adds 5.3ms of its own
+// (127 taps at the 12KHz demod rate).
+
+// --->>>> Adaptive I/Q gain and phase correction (IQ_Correct) between the input and I_Switch/Q_Switch, so the spectrum
+// and the receiver both see the corrected pair.  It learns from the received signals, nothing to calibrate, and holds
+// during TX.  The 'C' report prints the image rejection before and after it, 'I' on the debug port turns it off and on
+// to compare.  Comment out to take it out of the graph.
+#define USE_IQ_CORRECT
 
 //-------------------------W7PUA Auto I2S phase correction-----------------
 //
@@ -215,7 +259,6 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
     // Experimental features - use only one or none!
     //#define USE_FREQ_SHIFTER // Experimental to shift the FFT spectrum up away from DC
     //#define USE_FFT_LO_MIXER    // Experimental to shift the FFT spectrum up away from DC
-    //#define BETATEST  // audio memory external buffer test using FFT4096 
     //#define USE_MIDI  	// Experimental dev work to use Teensy SDR controls to send out MIDI events over USB
     
 #endif  // K7MDL_BUILD
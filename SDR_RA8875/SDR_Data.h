@@ -294,10 +294,10 @@ struct Label labels[LABEL_NUM] = {
 };
 
 struct User_Settings user_settings[USER_SETTINGS_NUM] = {                      
-//Profile name    sp_preset mn  sub_VFO  sv_md uc1 uc2 uc3  lastB   mute  mic_En  micG LInLvl rfg_en rfGain SpkEn afgen afGain LoRX LoTX enet  enout  nben   nblvl  nren  spot  rbeep pitch   notch  xmit fine VFO-AB DefMFknob  enc1   enc1_sw   enc1_swl     enc2     enc2_sw   enc2_swl  enc3     enc3_sw   enc3_swl    enc4    enc4_sw enc4_swl   enc5        enc5_sw   enc5_swl enc6        enc6_sw     enc6_swl    Zoom_lvl panEn panlvl
-    {"ENET ON Config",    0, 0, 28000000, USB, 0,  0,  0, BAND80M,   OFF, MIC_ON,  76.0,  15,   OFF,   100,   ON,   OFF, 100,  16,  16,   ON,  OFF,  OFF,  NBOFF,  OFF,  OFF,  0.02,  600, NTCHOFF, OFF, OFF,   0,    MFTUNE,   MFTUNE, RATE_BTN, FILTER_BTN, RFGAIN_BTN, MODE_BTN, FINE_BTN, PAN_BTN, ZOOM_BTN, VFO_AB_BTN, NB_BTN, NR_BTN, NOTCH_BTN, AFGAIN_BTN, MUTE_BTN, RIT_BTN, REFLVL_BTN, BANDUP_BTN, BANDDN_BTN, ZOOMx1, OFF, 50}, // if no encoder is present assign it to 0 and it will be skipped. 
-    {"User Config #2",    0, 0, 14200000, USB, 0,  0,  0, BAND30M,   OFF, MIC_ON,  50.0,  15,   OFF,   100,   ON,   OFF, 100,  22,  16,  OFF,  OFF,  OFF,  NBOFF,  OFF,  OFF,  0.02,  600, NTCHOFF, OFF, OFF,   0,    MFTUNE,   MFTUNE, RATE_BTN, FILTER_BTN, RFGAIN_BTN, MODE_BTN, FINE_BTN, PAN_BTN, ZOOM_BTN, VFO_AB_BTN, NB_BTN, NR_BTN, NOTCH_BTN, AFGAIN_BTN, MUTE_BTN, RIT_BTN, REFLVL_BTN, BANDUP_BTN, BANDDN_BTN, ZOOMx1, OFF, 50},
-    {"PanAdapter Config", 0, 0, 1420000,  USB, 0,  0,  0, PAN_ADAPT, OFF, MIC_OFF, 76.0,  15,   OFF,   100,   ON,   OFF, 100,  16,  16,  OFF,  OFF,  OFF,  NBOFF,  OFF,  OFF,  0.02,  600, NTCHOFF, OFF, OFF,   0,    MFTUNE,   MFTUNE, RATE_BTN, FILTER_BTN, RFGAIN_BTN, MODE_BTN, FINE_BTN, PAN_BTN, ZOOM_BTN, VFO_AB_BTN, NB_BTN, NR_BTN, NOTCH_BTN, AFGAIN_BTN, MUTE_BTN, RIT_BTN, REFLVL_BTN, BANDUP_BTN, BANDDN_BTN, ZOOMx1, OFF, 50}
+//Profile name    sp_preset mn  sub_VFO  sv_md uc1 uc2 uc3  lastB   mute  mic_En  micG LInLvl rfg_en rfGain SpkEn afgen afGain LoRX LoTX enet  enout  nben   nblvl  nren  spot  rbeep pitch   notch  xmit fine VFO-AB DefMFknob  enc1   enc1_sw   enc1_swl     enc2     enc2_sw   enc2_swl  enc3     enc3_sw   enc3_swl    enc4    enc4_sw enc4_swl   enc5        enc5_sw   enc5_swl enc6        enc6_sw     enc6_swl    Zoom_lvl panEn panlvl  wf_palette span peak
+    {"ENET ON Config",    0, 0, 28000000, USB, 0,  0,  0, BAND80M,   OFF, MIC_ON,  76.0,  15,   OFF,   100,   ON,   OFF, 100,  16,  16,   ON,  OFF,  OFF,  NBOFF,  OFF,  OFF,  0.02,  600, NTCHOFF, OFF, OFF,   0,    MFTUNE,   MFTUNE, RATE_BTN, FILTER_BTN, RFGAIN_BTN, MODE_BTN, FINE_BTN, PAN_BTN, ZOOM_BTN, VFO_AB_BTN, NB_BTN, NR_BTN, NOTCH_BTN, AFGAIN_BTN, MUTE_BTN, RIT_BTN, REFLVL_BTN, BANDUP_BTN, BANDDN_BTN, ZOOMx1, OFF, 50, 0, 0, ON}, // if no encoder is present assign it to 0 and it will be skipped. 
+    {"User Config #2",    0, 0, 14200000, USB, 0,  0,  0, BAND30M,   OFF, MIC_ON,  50.0,  15,   OFF,   100,   ON,   OFF, 100,  22,  16,  OFF,  OFF,  OFF,  NBOFF,  OFF,  OFF,  0.02,  600, NTCHOFF, OFF, OFF,   0,    MFTUNE,   MFTUNE, RATE_BTN, FILTER_BTN, RFGAIN_BTN, MODE_BTN, FINE_BTN, PAN_BTN, ZOOM_BTN, VFO_AB_BTN, NB_BTN, NR_BTN, NOTCH_BTN, AFGAIN_BTN, MUTE_BTN, RIT_BTN, REFLVL_BTN, BANDUP_BTN, BANDDN_BTN, ZOOMx1, OFF, 50, 0, 0, ON},
+    {"PanAdapter Config", 0, 0, 1420000,  USB, 0,  0,  0, PAN_ADAPT, OFF, MIC_OFF, 76.0,  15,   OFF,   100,   ON,   OFF, 100,  16,  16,  OFF,  OFF,  OFF,  NBOFF,  OFF,  OFF,  0.02,  600, NTCHOFF, OFF, OFF,   0,    MFTUNE,   MFTUNE, RATE_BTN, FILTER_BTN, RFGAIN_BTN, MODE_BTN, FINE_BTN, PAN_BTN, ZOOM_BTN, VFO_AB_BTN, NB_BTN, NR_BTN, NOTCH_BTN, AFGAIN_BTN, MUTE_BTN, RIT_BTN, REFLVL_BTN, BANDUP_BTN, BANDDN_BTN, ZOOMx1, OFF, 50, 0, 3, ON}
 };
 
 struct Frequency_Display disp_Freq[FREQ_DISP_NUM] = {
@@ -315,8 +315,8 @@ struct Frequency_Display disp_Freq[FREQ_DISP_NUM] = {
     #endif  // USE_RA8875
 };
 
-// (   name,  maxGain, response, hardLimit, threshold,   attack,  decay);
-// ( "AGC-x", 0-2,     0-3,      0-1,       0 to -96.0,  x.0,     x.0)
+// (   name,  maxGain, response, hardLimit, threshold,   attack,  decay, dsp maxGain, dsp decay, hang);
+// ( "AGC-x", 0-2,     0-3,      0-1,       0 to -96.0,  x.0,     x.0,   dB,          dB/s,      ms)
 // gain 0(0dB), 1(6.0dB), 2(12dB) max gain applied for expanding
 // response 0(0ms), 1(25ms), 2(50ms), 3(100ms) integration time for compressor - larger allows short term peaks to pass through
 // hardlimit 0 = softknee compressor - progressively compresses signals louder than threshold
@@ -324,12 +324,15 @@ struct Frequency_Display disp_Freq[FREQ_DISP_NUM] = {
 // threshold float in range of 0.0 to -96.0dBFS where -18.0dBFS is typical
 // attack float controls rate of decrease in gain when signal is over threshold - in dB/s
 // decay how fast gain is restored once level drops below threshold in dB/s - typically set longer than attack value
+// With USE_DIGITAL_AGC the AGC runs in the audio graph instead of the codec.  It uses threshold as the output level
+// in dBFS and the last 3 fields.  Attack is set by the look-ahead, the other codec fields are not used.
+// dsp maxGain is the most gain applied to weak signals, dsp decay the recovery rate after the hang time in ms.
 PROGMEM struct AGC agc_set[AGC_SET_NUM] = {
     //2,1,0,-5,0.5,0.5 from example file
-    {"AGC- ", 0, 0, 0,  0, 0.0f,  0.0f},  
-    {"AGC-S", 1, 1, 0, -5, 0.2f,  0.1f},
-    {"AGC-M", 1, 0, 0, -10, 0.4f,  0.3f},
-    {"AGC-F", 1, 0, 0, -16, 0.8f,  0.6f}
+    {"AGC- ", 0, 0, 0,  0, 0.0f,  0.0f,  0.0f,  0.0f,    0},  
+    {"AGC-S", 1, 1, 0, -5, 0.2f,  0.1f, 50.0f, 20.0f, 1000},
+    {"AGC-M", 1, 0, 0, -10, 0.4f,  0.3f, 50.0f, 40.0f,  500},
+    {"AGC-F", 1, 0, 0, -16, 0.8f,  0.6f, 50.0f, 80.0f,  200}
 };
 
 // Settings ranges.5 and 20, closer to 3 maybe best
@@ -347,9 +350,11 @@ PROGMEM struct NB nb[NB_SET_NUM] = {
 
 // Zoom Level table
 PROGMEM struct Zoom_Lvl zoom[ZOOM_NUM] = {
-    {":1",   1},  // x1 1024 FFT
-    {":2",   2},  // x2 2048 FFT
-    {":4",   4}   // x4 4096 FFT
+    {":1",   1},  // x1 full span
+    {":2",   2},  // x2 
+    {":4",   4},  // x4
+    {":8",   8},  // x8
+    {":16", 16}   // x16
 };
 
 PROGMEM struct Filter_Settings filter[FILTER] = {
@@ -389,11 +394,11 @@ struct Modes_List modeList[MODES_NUM] = {
 // Just copy and paste from the serial terminal into each record row.
 #define PRESETS 1  // number of parameter records with our preset spectrum window values
 struct Spectrum_Parms Sp_Parms_Def[PRESETS] = { // define default sets of spectrum window parameters, mostly for easy testing but could be used for future custom preset layout options
-        //W        LE  RE CG                                         x   y   w  h  c sp st clr sc mode      scal reflvl wfrate
+        //W        LE  RE CG                                         x   y   w  h  c sp st clr sc mode      scal reflvl wfrate avg tc
     #ifdef USE_RA8875
-        {798,0, 0,  0,798,398,14,8,157,179,179,408,400,110,111,289,289,  0,153,799,256,50,20,6,240,1.0,0.9,1,20, 5, 0}      // Default layout for 4.3" RA8875 800 x480
+        {798,0, 0,  0,798,398,14,8,157,179,179,408,400,110,111,289,289,  0,153,799,256,50,20,6,240,1.0,0.9,1,20, 5, 0, 1,200}      // Default layout for 4.3" RA8875 800 x480
     #else
-        {1020,1,1,  1,1021,510,14,8,143,165,165,528,520,142,213,307,307,  0,139,1022,390,40,20,6,890,1.5,0.9,1,20,10, 80}   // Default layout for 7" RA8876 1024 x 600
+        {1020,1,1,  1,1021,510,14,8,143,165,165,528,520,142,213,307,307,  0,139,1022,390,40,20,6,890,1.5,0.9,1,20,10, 80, 1,200}   // Default layout for 7" RA8876 1024 x 600
     #endif        
 };
 
@@ -425,7 +430,9 @@ struct New_Spectrum_Layout Custom_Layout[1] = {      // Temp storage for generat
     1,        // spectrum_dot_bar_mode 0=bar, 1=Line. Spectrum box
     40,       // spectrum_sp_scale 10 to 80. Spectrum scale factor in dB. This is the height of the scale (if possible by windows sizes). Will plot the spectrum window of values between the floor and the scale value creating a zoom effect.
     -175,     // spectrum_floor 0 to -150. The reference point for plotting values.  Anything signal value > than this (less negative) will be plotted until stronger than the window height*scale factor.
-    70        // spectrum_wf_rate window update rate in ms.  25 is fast enough to see dit and dahs well    
+    70,       // spectrum_wf_rate window update rate in ms.  25 is fast enough to see dit and dahs well    
+    1,        // spectrum_avg_mode 0-5. FFT averaging.  0=block, 1=exponential, 2=peak hold, +3 to average in dB
+    200       // spectrum_avg_tc Averaging time constant in ms
 };
 
 #endif //  _SDR_DATA_RA8876_H_ 
@@ -67,6 +67,14 @@
     //#include <Spectrum_RA887x.h>    // New K7MDL Spectrum and Waterfall library created Jan 2022 (only for builds before May  7, 2022)
                                   // https://github.com/K7MDL2/Spectrum_RA887x_Library
 #endif
+#include "AudioAnalyzeZoomFFT_IQ_F32.h" // Spectrum FFT with mixer and decimator for pan and zoom
+#include "AudioFilterHilbertIQ_F32.h"   // +45/-45 phasing filter pair in 1 object
+#include "AudioResample_F32.h"          // Decimate and interpolate around the demodulated audio stages
+#include "AudioFilterFFTConv_F32.h"     // Bandwidth filter with cached kernels
+#include "AudioEffectAGC_F32.h"         // Receive audio AGC driven by agc_set[]
+#include "AudioGraph.h"                 // Stops the audio objects the mode does not use
+#include "AudioProfile.h"               // Per object CPU time of the audio graph
+#include "AudioIQCorrect_F32.h"         // Adaptive I/Q gain and phase correction
 #include "SDR_Network.h"        // for ethernet UDP remote control and monitoring
 #include "Vfo.h"
 #include "Display.h"
@@ -103,7 +111,9 @@
         #define  RA8875_RESET      9        //any pin or nothing!
         #define  MAXTOUCHLIMIT     3        //1...5  using 3 for 3 finger swipes, otherwise 2 for pinches or just 1 for touch
         #include <SPI.h>                    // included with Arduino
+        #ifndef HEADLESS_TFT
         #include <RA8875.h>                 // internal Teensy library with ft5206 cap touch enabled in user_setting.h
+        #endif
         #include <ili9488_t3_font_Arial.h>      // https://github.com/PaulStoffregen/ILI9341_t3
         #include <ili9488_t3_font_ArialBold.h>  // https://github.com/PaulStoffregen/ILI9341_t3
     #else 
@@ -112,7 +122,9 @@
         #define  SCREEN_HEIGHT     600
         #include <ili9488_t3_font_Arial.h>      // https://github.com/PaulStoffregen/ILI9341_t3
         #include <ili9488_t3_font_ArialBold.h>  // https://github.com/PaulStoffregen/ILI9341_t3
+        #ifndef HEADLESS_TFT
         #include <RA8876_t3.h>           // Github
+        #endif
         #include <FT5206.h>
         #if defined(SMALL_PCB_V1)
             #define  CTP_INT        28  //for John's small V1 motherboard
@@ -126,6 +138,12 @@
         #define  MAXTOUCHLIMIT      3   //1...5  using 3 for 3 finger swipes, otherwise 2 for pinches or just 1 for touch              
     #endif // USE_RA8876_t3
 
+    #ifdef HEADLESS_TFT     // In-memory framebuffer in place of the display library.  See Headless_TFT.h
+        #include "Headless_TFT.h"
+        typedef Headless_TFT RA8875;
+        typedef Headless_TFT RA8876_t3;
+    #endif // HEADLESS_TFT
+
 #endif // BYPASS_SPECTRUM_MODULE
 
 // From RA8876_t3/RA8876Registers.h
@@ -190,10 +208,12 @@ const uint16_t myVERY_DARK_BLUE     = 0x01B0;
 #define PAN_ADAPT    12 // Panadapter IF band
 
 // Zoom level for UI control
-#define ZOOMx1      0       // Zoom out the most (fft1024 @ 48K) (aka OFF)  x1 reference
-#define ZOOMx2      1       // in between (fft2048)  is x2 of 1024
-#define ZOOMx4      2       // Zoom in the most (fft4096 at 96K)   is x4 of 1024
-#define ZOOM_NUM    3       // Number of zoom level choiced for menu system
+#define ZOOMx1      0       // Zoom out the most, full sample rate span (aka OFF)  x1 reference
+#define ZOOMx2      1       // decimate by 2 ahead of the FFT, 1/2 the Hz per bin
+#define ZOOMx4      2       // decimate by 4
+#define ZOOMx8      3       // decimate by 8
+#define ZOOMx16     4       // Zoom in the most, decimate by 16
+#define ZOOM_NUM    5       // Number of zoom level choiced for menu system
 
 // ------------------------  OPERATIONAL PARAMETER STORAGE --------------------------------------
 //
@@ -492,6 +512,9 @@ struct User_Settings {
     uint8_t     zoom_level;         // 0 - 2.  Zoom level memory.  x1, x2, x4 
     uint8_t     pan_state;          // 0 = OFF, 1 = ON
     uint8_t     pan_level;          // 0-100 converts to pan range of -0.50 to 0.50 for the pan memory.  0  is centered.
+    uint8_t     wf_palette;         // 0-2.  Waterfall style 6 palette, WF_PALETTE_xxx in Spectrum_RA887x.h.  Long press DISPLAY to change.
+    uint8_t     span_mode;          // 0-3.  How the FFT bins fit the graph width, SPAN_xxx in Spectrum_RA887x.h.  Long press ZOOM to change.
+    uint8_t     peak_marks;         // 0 = OFF, 1 = ON.  Spectrum peak markers.  Long press REFLVL to change.
 };
 
 struct Frequency_Display {
@@ -520,6 +543,9 @@ struct AGC {
     float       agc_threshold;
     float       agc_attack;
     float       agc_decay;
+    float       agc_dsp_maxGain;  // USE_DIGITAL_AGC only. dB of gain at most, for weak signals
+    float       agc_dsp_decay;    // USE_DIGITAL_AGC only. dB/s the gain comes back up once the hang time is over
+    uint16_t    agc_hang;         // USE_DIGITAL_AGC only. ms the gain holds after a peak
 };
 
 // Noise Blanker Settings
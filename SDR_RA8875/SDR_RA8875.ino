@@ -12,10 +12,9 @@
 #include "RadioConfig.h"        // Majority of declarations here to drive the #ifdefs that follow
 #include "SDR_RA8875.h"
 #include "SDR_Data.h"
-#include "Hilbert.h"            // filter coefficients
-#include "hilbert19A.h"
-#include "hilbert121A.h"
-#include "hilbert251A.h"
+#if defined(__IMXRT1062__)
+#include <utility/imxrt_hw.h>    // set_audioClock() for SetI2SFreq()
+#endif
 
 //#define USB32   // Switch between F32 and I16 versions of USB Audio interface
 // So far I16 method has been working better.  
@@ -115,10 +114,18 @@ COLD void printDigits(int digits);
 HOT  void Check_PTT(void);
 COLD void initDSP(void);
 COLD void SetFilter(void);
+COLD void SetTXFilter(void);
 HOT  void RF_Limiter(float peak_avg);
 COLD void TX_RX_Switch(bool TX,uint8_t mode_sel,bool b_Mic_On,bool b_USBIn_On,bool b_ToneA,bool b_ToneB,float TestTone_Vol);
 COLD void Change_FFT_Size(uint16_t new_size, float new_sample_rate_Hz);
+COLD void Change_FFT_Zoom(uint8_t zoom_factor);
+COLD bool Change_Sample_Rate(float new_sample_rate_Hz);
+COLD bool Sample_Rate_Free(void);
+COLD void SetI2SFreq(float freq);
 COLD void resetCodec(void);
+#ifdef USE_IQ_CORRECT
+COLD void Print_IQ_Correct(void);
+#endif
 COLD void TwinPeaks(void);  // Test auto I2S Alignment 
 HOT void Check_Encoders(void);
 #ifdef USE_RS_HFIQ
@@ -223,41 +230,36 @@ uint16_t    fft_size            = FFT_SIZE;       // This value wil lbe passed t
                                     // Ensure the matching FFT resources are enabled in the lib .h file!                            
 int16_t     fft_bins            = fft_size;     // Number of FFT bins which is FFT_SIZE/2 for real version or FFT_SIZE for iq version
 float       fft_bin_size        = sample_rate_Hz/(fft_size*2);   // Size of FFT bin in HZ.  From sample_rate_Hz/FFT_SIZE for iq
-const int   audio_block_samples = 128;          // do not change this!
+const int   audio_block_samples = AUDIO_BLOCK_SAMPLES;  // set in Libraries/cores/AudioStream.h, see RadioConfig.h
 const int   RxAudioIn = AUDIO_INPUT_LINEIN;
 const int   MicAudioIn = AUDIO_INPUT_MIC;
 uint16_t    filterCenter;
 uint16_t    filterBandwidth;
 uint16_t    TX_filterCenter = 1800;
 uint16_t    TX_filterBandwidth = 2000;
+#define     TX_BPF_TAPS 197                         // bpf1, designed by SetTXFilter()
+DMAMEM float bpf1_coeffs[TX_BPF_TAPS];              // AudioFilterFIR_F32 keeps a pointer to these
 #ifndef BYPASS_SPECTRUM_MODULE
   extern Metro    spectrum_waterfall_update;          // Timer used for controlling the Spectrum module update rate.
   extern struct   Spectrum_Parms Sp_Parms_Def[];
 #endif
 
-#ifdef BETATEST
-    DMAMEM  float32_t  fftOutput[4096];  // Array used for FFT Output to the INO program
-    DMAMEM  float32_t  window[2048];     // Windows reduce sidelobes with FFT's *Half Size*
-    DMAMEM  float32_t  fftBuffer[8192];  // Used by FFT, 4096 real, 4096 imag, interleaved
-    DMAMEM  float32_t  sumsq[4096];      // Required ONLY if power averaging is being done
-#endif
-
 AudioSettings_F32  audio_settings(sample_rate_Hz, audio_block_samples);    
-
-#ifdef FFT_4096
-    #ifndef BETATEST
-        DMAMEM  AudioAnalyzeFFT4096_IQ_F32  myFFT_4096;  // choose which you like, set FFT_SIZE accordingly.
-    #else
-        AudioAnalyzeFFT4096_IQEM_F32 myFFT_4096(fftOutput, window, fftBuffer, sumsq);  // with power averaging array 
-    #endif
-#endif
-#ifdef FFT_2048   
-    DMAMEM AudioAnalyzeFFT2048_IQ_F32  myFFT_2048;
-#endif
-#ifdef FFT_1024
-    DMAMEM AudioAnalyzeFFT1024_IQ_F32  myFFT_1024;
+#ifdef USE_DEMOD_DECIMATE
+  // Settings for the objects between RX_Decimate_IQ and RX_Decimate (and TX_Decimate and TX_Interpolate).  They do not
+  // change with Change_Sample_Rate(), only the factor of the front end does.
+  AudioSettings_F32  hilbert_settings(sample_rate_Hz / Resample_Factor(sample_rate_Hz, HILBERT_RATE_HZ), audio_block_samples);
+  // Settings for the objects between RX_Decimate and RX_Interpolate.  RX_Decimate sends them a short block every update
+  // (Resample_Block()) rather than a full one every 4, so the audio does not wait for a block to fill.
+  AudioSettings_F32  demod_settings(hilbert_settings.sample_rate_Hz / Resample_Factor(hilbert_settings.sample_rate_Hz, DEMOD_RATE_HZ),
+                                    Resample_Block(Resample_Factor(hilbert_settings.sample_rate_Hz, DEMOD_RATE_HZ)));
+#else
+  AudioSettings_F32  hilbert_settings(sample_rate_Hz, audio_block_samples);
+  AudioSettings_F32  demod_settings(sample_rate_Hz, audio_block_samples);
 #endif
 
+DMAMEM AudioAnalyzeZoomFFT_IQ_F32 myFFT(audio_settings);  // Spectrum FFT for all sizes and zoom levels.  Buffers sized for 4096.
+
 #ifdef W7PUA_I2S_CORRECTION
   AudioAlignLR_F32          TwinPeak(SIGNAL_HARDWARE, PIN_FOR_TP, false, audio_settings);
 #endif
@@ -275,6 +277,9 @@ AudioConvert_F32toI16       convertR_Out;
 #endif
 
 AudioInputI2S_F32           Input(audio_settings);  // Input from Line In jack (RX board)
+#ifdef USE_IQ_CORRECT
+AudioIQCorrect_F32          IQ_Correct(audio_settings); // I/Q gain and phase imbalance, adapts in the background
+#endif
 AudioMixer4_F32             I_Switch(audio_settings); // Select between Input from RX board or Mic/TestTone
 AudioMixer4_F32             Q_Switch(audio_settings);
 AudioMixer4_F32             TX_Source(audio_settings);  // Select Mic, ToneA or ToneB or any combo
@@ -284,17 +289,23 @@ AudioSwitch4_OA_F32         FFT_OutSwitch_I(audio_settings); // Select a source
 AudioSwitch4_OA_F32         FFT_OutSwitch_Q(audio_settings);
 AudioMixer4_F32             OutputSwitch_I(audio_settings); // Processed audio from any mode to boost amp then out
 AudioMixer4_F32             OutputSwitch_Q(audio_settings);
-DMAMEM AudioFilterFIR_F32   RX_Hilbert_Plus_45(audio_settings);
-DMAMEM AudioFilterFIR_F32   RX_Hilbert_Minus_45(audio_settings);
-DMAMEM AudioFilterFIR_F32   TX_Hilbert_Plus_45(audio_settings);
-DMAMEM AudioFilterFIR_F32   TX_Hilbert_Minus_45(audio_settings);
-AudioFilterConvolution_F32  RX_FilterConv(audio_settings);  // DMAMEM on this causes it to not be adjustable. Would save 50K local variable space if it worked.
+DMAMEM AudioFilterHilbertIQ_F32 RX_Hilbert(hilbert_settings);  // +45 on I, -45 on Q, summed for the sideband set by the mode
+DMAMEM AudioFilterHilbertIQ_F32 TX_Hilbert(hilbert_settings);  // +45 and -45 of the 1 mic channel
+AudioFilterFFTConv_F32      RX_FilterConv(demod_settings);  // Bandwidth filter.  Its kernels are cached in DMAMEM in Bandwidth2.cpp
 //AudioFilterConvolution_F32  TX_FilterConv(audio_settings);  // DMAMEM on this causes it to not be adjustable. Would save 50K local variable space if it worked.
-AudioMixer4_F32             RX_Summer(audio_settings);
-AudioAnalyzePeak_F32        S_Peak(audio_settings); 
+AudioMixer4_F32             RX_Summer(hilbert_settings);
+AudioAnalyzePeak_F32        S_Peak(hilbert_settings); 
 AudioOutputI2S_F32          Output(audio_settings);
-radioNoiseBlanker_F32       NoiseBlanker(audio_settings);   // DMAMEM on this item breaks stopping RX audio flow.  Would save 10K local variable space
-AudioLMSDenoiseNotch_F32    LMS_Notch(audio_settings);
+radioNoiseBlanker_F32       NoiseBlanker(hilbert_settings);   // DMAMEM on this item breaks stopping RX audio flow.  Would save 10K local variable space
+AudioLMSDenoiseNotch_F32    LMS_Notch(demod_settings);
+AudioEffectAGC_F32          RX_AGC(demod_settings);         // Passes audio through unless USE_DIGITAL_AGC turns it on
+#ifdef USE_DEMOD_DECIMATE
+  DMAMEM AudioFilterDecimate_F32    RX_Decimate_IQ(audio_settings);   // full rate IQ in, Hilbert rate out
+  DMAMEM AudioFilterDecimate_F32    RX_Decimate(hilbert_settings);    // Hilbert rate in
+  DMAMEM AudioFilterInterpolate_F32 RX_Interpolate(audio_settings);   // full rate out
+  DMAMEM AudioFilterDecimate_F32    TX_Decimate(audio_settings);      // mic and test tones to the Hilbert rate
+  DMAMEM AudioFilterInterpolate_F32 TX_Interpolate(audio_settings);   // TX IQ back to the full rate
+#endif
 RadioFMDetector_F32         FM_Detector(audio_settings);
 AudioSynthWaveformSine_F32  Beep_Tone(audio_settings);      // for audible alerts like touch beep confirmations
 AudioSynthSineCosine_F32    TxTestTone_A(audio_settings);   // For TX path test tone
@@ -306,7 +317,7 @@ AudioMixer4_F32             FFT_Atten_Q(audio_settings);         // Some well pl
 RadioIQMixer_F32            FM_LO_Mixer(audio_settings);
 
 DMAMEM AudioFilter90Deg_F32        FFT_90deg_Hilbert(audio_settings);
-DMAMEM AudioFilterFIR_F32          bpf1(audio_settings);
+DMAMEM AudioFilterFIR_F32          bpf1(hilbert_settings);
 
 #ifdef USE_FFT_LO_MIXER
     AudioFilter90Deg_F32    FFT_90deg_Hilbert(audio_settings);
@@ -318,26 +329,13 @@ DMAMEM AudioFilterFIR_F32          bpf1(audio_settings);
     AudioEffectFreqShiftFD_OA_F32 FFT_SHIFT_Q(audio_settings); // the frequency-domain processing block
 #endif
 
-// Connections for LineInput and FFT - chooses either the input or the output to display in the spectrum plot
-// Assuming the mic input is applied to both left and right - need to verify.  Only need the left really
-#if defined(W7PUA_I2S_CORRECTION)
-    AudioConnection_F32     patchCord_RX_In_L(Input,0,                           TwinPeak,0); // correct i2s phase imbalance
-    AudioConnection_F32     patchCord_RX_In_R(Input,1,                           TwinPeak,1);
-    AudioConnection_F32     patchCord_RX_Ph_L(TwinPeak,0,                        I_Switch,0);  // route raw input audio to the FFT display
-    AudioConnection_F32     patchCord_RX_Ph_R(TwinPeak,1,                        Q_Switch,0);
-#else
-    AudioConnection_F32     patchCord_RX_Ph_L(Input,0,                           I_Switch,0);  // route raw input audio to the FFT display
-    AudioConnection_F32     patchCord_RX_Ph_R(Input,1,                           Q_Switch,0);
-#endif
-
-// Test tone sources for single or two tone in place of (or in addition to) real input audio
-// Mic and Test Tones need to be converted to I and Q
-
-// switch to select inputs.  In DATA mode USB in should be default, mic in voice modes
+// The RX cords, input to output.  Host/GraphRunner.cpp builds its graph from the same file.
+#include "RX_PatchCords.h"
 
-// Analog mic input
-AudioConnection_F32     patchCord_Mic_In(Input,0,                               TX_Source,0);   // Mic source
+// Mic, test tones and the TX chain.  Host/GraphRunner.cpp builds its graph from the same file.
+#include "TX_PatchCords.h"
 
+// USB input to TX_Source ch 1
 #ifdef USB32
 AudioConnection_F32     patchcord_Mic_InUL(USB_In,0,                            TX_Source,1);
 #else
@@ -345,88 +343,6 @@ AudioConnection         patchcord_USB_InU(USB_In,0,
 AudioConnection_F32     patchCord_USB_In(convertL_In,0,                         TX_Source,1);
 #endif
 
-AudioConnection_F32     patchCord_Tx_Tone_A(TxTestTone_A,0,                     TX_Source,2);   // Combine mic, tone B and B into L channel
-AudioConnection_F32     patchCord_Tx_Tone_B(TxTestTone_B,0,                     TX_Source,3);
-
-//AudioConnection_F32     patchCord_Audio_Filter(TX_Source,0,                     bpf1,0);  // variable filter for TX    
-//AudioConnection_F32     patchCord_Audio_Filter_L(bpf1,0,                        FFT_90deg_Hilbert,0);  // variable filter for TX    
-//AudioConnection_F32     patchCord_Audio_Filter_R(bpf1,0,                        FFT_90deg_Hilbert,1);  // variable filter for TX
-//AudioConnection_F32     patchCord_Feed_L(FFT_90deg_Hilbert,1,                   I_Switch,1); // Feed into normal chain 
-//AudioConnection_F32     patchCord_Feed_R(FFT_90deg_Hilbert,0,                   Q_Switch,1); 
-
-//AudioConnection_F32     patchCord_Audio_Filter(TX_Source,0,                     TX_FilterConv,0);  // variable filter for TX    
-//AudioConnection_F32     patchCord_Audio_Filter_L(TX_FilterConv,0,               FFT_90deg_Hilbert,0);  // variable filter for TX    
-//AudioConnection_F32     patchCord_Audio_Filter_R(TX_FilterConv,0,               FFT_90deg_Hilbert,1);  // variable filter for TX
-//AudioConnection_F32     patchCord_Feed_L(FFT_90deg_Hilbert,1,                   I_Switch,1); // Feed into normal chain 
-//AudioConnection_F32     patchCord_Feed_R(FFT_90deg_Hilbert,0,                   Q_Switch,1); 
-
-AudioConnection_F32     patchCord_Audio_Filter(TX_Source,0,                     bpf1,0);  // variable filter for TX    
-AudioConnection_F32     patchCord_IQ_Mix_L(bpf1,0,                              TX_Hilbert_Plus_45,0); 
-AudioConnection_F32     patchCord_IQ_Mix_R(bpf1,0,                              TX_Hilbert_Minus_45,0); 
-AudioConnection_F32     patchCord_Feed_L(TX_Hilbert_Minus_45,0,                 I_Switch,1); // Feed into normal chain 
-AudioConnection_F32     patchCord_Feed_R(TX_Hilbert_Plus_45,0,                  Q_Switch,1); 
-
-// I_Switch has our selected audio source(s), share with the FFT distribution switch FFT_OutSwitch.  
-#if defined (USE_FFT_LO_MIXER)
-    //AudioConnection_F32     patchCord_FFT_OUT_L(I_Switch,0,                     FFT_LO_Mixer_I,0);     // Attenuate signals to FFT while in TX mode
-    //AudioConnection_F32     patchCord_FFT_OUT_R(Q_Switch,0,                     FFT_LO_Mixer_I,1);
-    //AudioConnection_F32     patchCord_LO_Mix_L(FFT_LO_Mixer_I,0,              FFT_90deg_Hilbert,0); // Filter I and Q
-    //AudioConnection_F32     patchCord_LO_Mix_R(FFT_LO_Mixer_I,1,              FFT_90deg_Hilbert,1); 
-    //AudioConnection_F32     patchCord_LO_Fil_L(FFT_90deg_Hilbert,0,           FFT_Atten_I,0); // Filter I and Q
-    //AudioConnection_F32     patchCord_LO_Fil_R(FFT_90deg_Hilbert,1,           FFT_Atten_Q,0);
-    AudioConnection_F32     patchCord_LO_90Fil_L(TX_FilterConv,0,               FFT_90deg_Hilbert,0); // Filter I and Q
-    AudioConnection_F32     patchCord_LO_90Fil_R(TX_FilterConv,0,               FFT_90deg_Hilbert,1); 
-    AudioConnection_F32     patchCord_FFT_OUT_L(FFT_90deg_Hilbert,1,            I_Switch,1);     // Attenuate signals to FFT while in TX mode
-    AudioConnection_F32     patchCord_FFT_OUT_R(FFT_90deg_Hilbert,0,            Q_Switch,1);     // Swap I and Q for correct FFT  
-    //AudioConnection_F32     patchCord_LO_Fil_L(FFT_LO_Mixer_I,0,                FFT_Atten_I,0); // Filter I and Q
-    //AudioConnection_F32     patchCord_LO_Fil_R(FFT_LO_Mixer_I,1,                FFT_Atten_Q,0);
-#elif defined(USE_FREQ_SHIFTER)
-    AudioConnection_F32     patchCord_FFT_OUT_L(I_Switch,0,                     FFT_SHIFT_I,0);     // Attenuate signals to FFT while in TX mode
-    AudioConnection_F32     patchCord_FFT_OUT_R(Q_Switch,0,                     FFT_SHIFT_Q,0);
-    AudioConnection_F32     patchCord_FFT_Shift_L(FFT_SHIFT_I,0,                FFT_Atten_I,0); // Filter I and Q
-    AudioConnection_F32     patchCord_FFT_Shift_R(FFT_SHIFT_Q,0,                FFT_Atten_Q,0); 
-#else
-    AudioConnection_F32     patchCord_FFT_OUT_L(I_Switch,0,                     FFT_Atten_I,0);     // Attenuate signals to FFT while in TX mode
-    AudioConnection_F32     patchCord_FFT_OUT_R(Q_Switch,0,                     FFT_Atten_Q,0);     // Swap I and Q for correct FFT 
-#endif
-
-//AudioConnection_F32     patchCord_LO_Fil_L(I_Switch,0,                      FFT_Atten_I,0); // Filter I and Q
-//AudioConnection_F32     patchCord_LO_Fil_R(Q_Switch,0,                      FFT_Atten_Q,0);
-AudioConnection_F32     patchCord_FFT_ATT_L(FFT_Atten_I,0,                  FFT_OutSwitch_I,0); // Route selected audio source to the selected FFT - should save CPU time
-AudioConnection_F32     patchCord_FFT_ATT_R(FFT_Atten_Q,0,                  FFT_OutSwitch_Q,0);
-
-// One or more of these FFT pipelines can be used, most likely for pan and zoom.  Normally just 1 is used.
-#ifdef FFT_4096
-    AudioConnection_F32     patchCord_FFT_L_4096(FFT_OutSwitch_I,0,             myFFT_4096,0);   // Route selected audio source to the FFT
-    AudioConnection_F32     patchCord_FFT_R_4096(FFT_OutSwitch_Q,0,             myFFT_4096,1);
-#endif
-#ifdef FFT_2048
-    AudioConnection_F32     patchCord_FFT_L_2048(FFT_OutSwitch_I,1,             myFFT_2048,0);        // Route selected audio source to the FFT
-    AudioConnection_F32     patchCord_FFT_R_2048(FFT_OutSwitch_Q,1,             myFFT_2048,1);
-#endif
-#ifdef FFT_1024
-    AudioConnection_F32     patchCord_FFT_L_1024(FFT_OutSwitch_I,2,             myFFT_1024,0);        // Route selected audio source to the FFT
-    AudioConnection_F32     patchCord_FFT_R_1024(FFT_OutSwitch_Q,2,             myFFT_1024,1);
-#endif
-
-// Send selected IQ source(s) to the audio processing chain for demodulation
-AudioConnection_F32     patchCord_Input_L(I_Switch,0,                       RxTx_InputSwitch_L,0);  // 0 is RX. Output 1 is Tx chain
-AudioConnection_F32     patchCord_Input_R(Q_Switch,0,                       RxTx_InputSwitch_R,0);
-
-// Non-FM path
-AudioConnection_F32     patchCord10a(RxTx_InputSwitch_L,0,                  NoiseBlanker,0);
-AudioConnection_F32     patchCord10b(RxTx_InputSwitch_R,0,                  NoiseBlanker,1);
-AudioConnection_F32     patchCord11a(NoiseBlanker,0,                        RX_Hilbert_Plus_45,0);
-AudioConnection_F32     patchCord11b(NoiseBlanker,1,                        RX_Hilbert_Minus_45,0);
-// Test dual channel hilbert block 
-//AudioConnection_F32     patchCord_IQ_MIX_L(NoiseBlanker,0,                  RX_Hilbert,0);
-//AudioConnection_F32     patchCord_IQ_MIX_R(NoiseBlanker,1,                  RX_Hilbert,1);                                            
-//AudioConnection_F32     patchCord2c(RX_Hilbert,0,                           RX_Summer,0);  // phase shift +45 deg
-//AudioConnection_F32     patchCord2d(RX_Hilbert,1,                           RX_Summer,1);  // phase shift -45 deg
-AudioConnection_F32     patchCord2c(RX_Hilbert_Plus_45,0,                   RX_Summer,0);  // phase shift +45 deg
-AudioConnection_F32     patchCord2d(RX_Hilbert_Minus_45,0,                  RX_Summer,1);  // phase shift -45 deg
-AudioConnection_F32     patchCord2e(Beep_Tone,0,                            RX_Summer,2);  // For button beep if enabled
-
 // Alternate FM Path use non-IQ signal. Only I.  
 // Using a test tone for testing
 // FM is 10KHz to 20KHz, LO at 15KHz
@@ -435,20 +351,11 @@ AudioConnection_F32     patchCord_FM_Mix_LO(FM_LO_Mixer,0,                  FM_D
 AudioConnection_F32     patchCord_FM_Mix_Det(FM_Detector,0,                 OutputSwitch_I,2);
 AudioConnection_F32     patchCord_FM_Mix_Out(FM_Detector,0,                 OutputSwitch_Q,2);
 
-// Post mixer processing (now treated as mono audio)
-AudioConnection_F32     patchCord_Summer_Peak(RX_Summer,0,                  S_Peak,0);      // S meter source
-AudioConnection_F32     patchCord_Summer_Notch(RX_Summer,0,                 LMS_Notch,0);   // NR and Notch
-AudioConnection_F32     patchCord_Notch(LMS_Notch,0,                        RX_FilterConv,0);  // variable bandwidth filter
-AudioConnection_F32     patchCord_RxOut_L(RX_FilterConv,0,                  OutputSwitch_I,0);  // demod and filtering complete
-AudioConnection_F32     patchCord_RxOut_R(RX_FilterConv,0,                  OutputSwitch_Q,0);  
-
-// In TX the mic source is selected in FFT_Mixer and was phase shifted so just passed
-AudioConnection_F32     patchCord_Mic_Input_L(RxTx_InputSwitch_R,1,         OutputSwitch_I,1);  // phase shift mono source 90 degrees
-AudioConnection_F32     patchCord_Mic_Input_R(RxTx_InputSwitch_L,1,         OutputSwitch_Q,1);  // Using L source twice since mic source is mono
+// Button beep at the codec rate.  It used to go into RX_Summer but that can run at a lower rate.
+AudioConnection_F32     patchCord_Beep_L(Beep_Tone,0,                       OutputSwitch_I,3);
+AudioConnection_F32     patchCord_Beep_R(Beep_Tone,0,                       OutputSwitch_Q,3);
 
-// Selected source goes to output (selected as headphone or lineout in the code) and boosted if needed
-AudioConnection_F32     patchCord_Output_L(OutputSwitch_I,0,                Output,0);  // output to headphone jack/Line out Left
-AudioConnection_F32     patchCord_Output_R(OutputSwitch_Q,0,                Output,1);  // output to headphone jack/Line out Right
+// Processed audio to USB and line out, boosted if needed.  The headphone/line out cords are in RX_PatchCords.h
 AudioConnection_F32     patchCord_Amp1_L(OutputSwitch_I,0,                  Amp1_L,0);  // output audio to USB, line out
 AudioConnection_F32     patchCord_Amp1_R(OutputSwitch_Q,0,                  Amp1_R,0);  // output audio to USB, line out
 
@@ -467,6 +374,62 @@ AudioConnection         patchcord_Out_R16U(convertR_Out,0,                  USB_
 
 #endif
 
+// Objects only some states use.  Audio_Graph_Select() runs the group for the state and stops the rest.
+// Input, output, the spectrum path, the switches and mixers between them and Beep_Tone always run.
+AudioStream_F32 * const graph_RX_nodes[] = {&NoiseBlanker, &RX_Hilbert, &RX_Summer, &S_Peak, &LMS_Notch, &RX_FilterConv, &RX_AGC
+                                          #ifdef USE_DEMOD_DECIMATE
+                                            , &RX_Decimate_IQ, &RX_Decimate, &RX_Interpolate
+                                          #endif
+                                           };
+AudioStream_F32 * const graph_FM_nodes[] = {&TxTestTone_B, &FM_LO_Mixer, &FM_Detector};     // Tone B is the FM test signal
+AudioStream_F32 * const graph_TX_nodes[] = {&TX_Source, &TxTestTone_A, &TxTestTone_B, &bpf1, &TX_Hilbert
+                                          #ifdef USE_DEMOD_DECIMATE
+                                            , &TX_Decimate, &TX_Interpolate
+                                          #endif
+                                           };
+struct Audio_Group audio_groups[GRAPH_STATES] = {
+    {"RX", graph_RX_nodes, sizeof(graph_RX_nodes)/sizeof(graph_RX_nodes[0])},
+    {"FM", graph_FM_nodes, sizeof(graph_FM_nodes)/sizeof(graph_FM_nodes[0])},
+    {"TX", graph_TX_nodes, sizeof(graph_TX_nodes)/sizeof(graph_TX_nodes[0])}
+};
+
+// Every audio object, for Audio_Graph_Sort() and the debug printouts.  F32 objects have their F32 connections followed.
+#define GRAPH_F32(x)    {&x, #x, true}
+#define GRAPH_I16(x)    {&x, #x, false}
+struct Audio_Node audio_nodes[] = {
+  #ifdef W7PUA_I2S_CORRECTION
+    GRAPH_F32(TwinPeak),
+  #endif
+  #ifdef USE_IQ_CORRECT
+    GRAPH_F32(IQ_Correct),
+  #endif
+  #ifdef USB32
+    GRAPH_F32(USB_In), GRAPH_F32(USB_Out),
+  #else
+    GRAPH_I16(USB_In), GRAPH_I16(USB_Out),
+    GRAPH_F32(convertL_In), GRAPH_F32(convertR_In), GRAPH_F32(convertL_Out), GRAPH_F32(convertR_Out),
+  #endif
+    GRAPH_F32(Input), GRAPH_F32(I_Switch), GRAPH_F32(Q_Switch), GRAPH_F32(TX_Source),
+    GRAPH_F32(RxTx_InputSwitch_L), GRAPH_F32(RxTx_InputSwitch_R), GRAPH_F32(FFT_OutSwitch_I), GRAPH_F32(FFT_OutSwitch_Q),
+    GRAPH_F32(OutputSwitch_I), GRAPH_F32(OutputSwitch_Q), GRAPH_F32(RX_Hilbert), GRAPH_F32(TX_Hilbert),
+    GRAPH_F32(RX_FilterConv), GRAPH_F32(RX_Summer), GRAPH_F32(S_Peak), GRAPH_F32(Output),
+    GRAPH_F32(NoiseBlanker), GRAPH_F32(LMS_Notch), GRAPH_F32(RX_AGC),
+  #ifdef USE_DEMOD_DECIMATE
+    GRAPH_F32(RX_Decimate_IQ), GRAPH_F32(RX_Decimate), GRAPH_F32(RX_Interpolate),
+    GRAPH_F32(TX_Decimate), GRAPH_F32(TX_Interpolate),
+  #endif
+    GRAPH_F32(FM_Detector), GRAPH_F32(Beep_Tone), GRAPH_F32(TxTestTone_A), GRAPH_F32(TxTestTone_B),
+    GRAPH_F32(Amp1_L), GRAPH_F32(Amp1_R), GRAPH_F32(FFT_Atten_I), GRAPH_F32(FFT_Atten_Q),
+    GRAPH_F32(FM_LO_Mixer), GRAPH_F32(FFT_90deg_Hilbert), GRAPH_F32(bpf1), GRAPH_F32(myFFT)
+  #ifdef USE_FFT_LO_MIXER
+    , GRAPH_F32(FFT_LO_Mixer_I), GRAPH_F32(FFT_LO_Mixer_Q)
+  #endif
+  #ifdef USE_FREQ_SHIFTER
+    , GRAPH_F32(FFT_SHIFT_I), GRAPH_F32(FFT_SHIFT_Q)
+  #endif
+};
+uint8_t audio_nodes_count = sizeof(audio_nodes)/sizeof(audio_nodes[0]);
+
 AudioControlSGTL5000    codec1;
 //AudioControlWM8960    codec1;   // Does not work yet, hangs
 
@@ -689,6 +652,9 @@ COLD void setup()
                                                               // Therefore always call the generator before drawSpectrum() to create a new set of params you can cut anmd paste.
                                                               // Generator never modifies the globals so never affects the layout itself.
                                                               // Print out our starting frequency for testing
+    setWFPalette(-1);           // waterfall palette from the user profile
+    setSpan(-1);                // span mode from the user profile
+    setPeakMarks(-1);           // peak markers from the user profile
     //sp.drawSpectrumFrame(6);   // for 2nd window
 #endif  
 
@@ -700,6 +666,12 @@ COLD void setup()
     initVfo(); // initialize the si5351 vfo
     delay(10);
     initDSP();
+    Filter_Kernel_Init();   // design the bandwidth filter kernels before the first selectBandwidth()
+    #ifdef USE_GRAPH_SORT
+    Audio_Graph_Print_Order(&Input, &Output);   // as constructed
+    Audio_Graph_Sort();                         // all objects and patch cords exist by now
+    Audio_Graph_Print_Order(&Input, &Output);
+    #endif
     //RFgain(0);
     changeBands(0);     // Sets the VFOs to last used frequencies, sets preselector, active VFO, other last-used settings per band.
                         // Call changeBands() here after volume to get proper startup volume
@@ -736,6 +708,7 @@ HOT void loop()
     #ifndef BYPASS_SPECTRUM_MODULE
         // Update spectrum and waterfall based on timer - do not draw in the screen space while the pop up has the screen focus.
         //if (spectrum_waterfall_update.check() == 1 && !popup) // The update rate is set in drawSpectrumFrame() with spect_wf_rate from table
+        // spectrum_update() runs the spect_wf_rate timer itself and does 1 short step per call so call it every pass
         if (!popup) // The update rate is set in drawSpectrumFrame() with spect_wf_rate from table
         {    
             #ifdef DEBUG  
@@ -771,6 +744,13 @@ HOT void loop()
     }
     time_old = millis();
 
+    #ifndef BYPASS_SPECTRUM_MODULE
+        // spectrum_update() returns with its block moves still running.  The rest of the loop can draw (touch, encoders,
+        // meters, frequency, CAT) and those writes would land in the middle of the move, so they wait for the next pass.
+        if (!popup && Spectrum_BTE_Running())
+            return;
+    #endif
+
     //if (touch.check() == 1)
     //{
         Touch(); // touch points and gestures
@@ -859,7 +839,11 @@ HOT void loop()
         DPRINTLN(ch);
         switch (ch)
         {
+            case 'B':
             case 'C':
+            case 'P':
+            case 'S':
+            case 'I':
             case 'H':   //respondToByte((char)MSG_Serial.read()); 
                         respondToByte((char)ch); 
                         break;
@@ -1044,6 +1028,13 @@ COLD void printCPUandMemory(unsigned long curTime_millis, unsigned long updatePe
         DPRINT(AudioMemoryUsage());
         DPRINT(F("/"));
         DPRINTLN(AudioMemoryUsageMax());
+        Audio_Graph_Print();
+        #ifdef USE_IQ_CORRECT
+        Print_IQ_Correct();
+        #endif
+        #ifndef BYPASS_SPECTRUM_MODULE
+        Spectrum_Print_Timing();
+        #endif
         DPRINTLN(F("*** End of Report ***"));
 
         lastUpdate_millis = curTime_millis; //we will use this value the next time around.
@@ -1079,6 +1070,38 @@ COLD void respondToByte(char c)
         DPRINTLN(F("Toggle printing of memory and CPU usage."));
         togglePrintMemoryAndCPU();
         break;
+    case 'P':
+    case 'p':
+        if (Audio_Profile_Running())
+        {
+            Audio_Profile_Print();
+            Audio_Profile_Stop();
+        }
+        else
+        {
+            DPRINTLN(F("Audio profile started.  P again to print and stop."));
+            Audio_Profile_Start();
+        }
+        break;
+    case 'B':
+    case 'b':
+        Audio_Profile_Write(Serial);    // binary, see AudioProfile.h
+        break;
+    case 'S':
+    case 's':
+        // 1, 2 then 4 times the Hilbert rate and back
+        if (sample_rate_Hz >= 4 * hilbert_settings.sample_rate_Hz)
+            Change_Sample_Rate(hilbert_settings.sample_rate_Hz);
+        else
+            Change_Sample_Rate(2 * sample_rate_Hz);
+        break;
+    #ifdef USE_IQ_CORRECT
+    case 'I':
+    case 'i':
+        IQ_Correct.enable(!IQ_Correct.isEnabled());     // the averages keep going, so it is right as soon as it is back on
+        Print_IQ_Correct();
+        break;
+    #endif
     default:
         DPRINT(F("You typed "));
         DPRINT(s);
@@ -1094,6 +1117,12 @@ COLD void printHelp(void)
     DPRINTLN(F("Help: Available Commands:"));
     DPRINTLN(F("   h: Print this help"));
     DPRINTLN(F("   C: Toggle printing of CPU and Memory usage"));
+    DPRINTLN(F("   P: Start the audio object profile, again to print and stop"));
+    DPRINTLN(F("   B: Send the audio object profile in binary"));
+    DPRINTLN(F("   S: Next sample rate, 48, 96 or 192KHz.  Not in FM or while USB audio is streaming"));
+    #ifdef USE_IQ_CORRECT
+    DPRINTLN(F("   I: Toggle the I/Q gain and phase correction"));
+    #endif
     DPRINTLN(F("   T+10 digits: Time Update. Enter T and 10 digits for seconds since 1/1/1970"));
     //#ifdef USE_RS_HFIQ
       //DPRINTLN(F("   R to display the RS-HFIQ Menu"));
@@ -1430,7 +1459,32 @@ COLD void digitalClockDisplay() {
 
 COLD void SetFilter(void)
 {
-    RX_FilterConv.initFilter((float32_t)filterCenter, 90, 2, filterBandwidth);
+    static float hilbert_top = 0;
+    float top = filterCenter + filterBandwidth/2;
+
+    // The Hilbert pair is flat to about 700Hz under its top edge.  Steps of 500Hz so most filter changes keep the design.
+    float new_top = fminf(ceilf((top + 800.0f) / 500.0f) * 500.0f, 0.45f * RX_Hilbert.getRate());
+    #ifdef USE_DEMOD_DECIMATE
+        new_top = fminf(new_top, IQ_FRONT_PASSBAND_HZ);     // nothing above this is alias free
+    #endif
+    if (new_top != hilbert_top)
+    {
+        RX_Hilbert.design(0, new_top);
+        hilbert_top = new_top;
+    }
+    RX_FilterConv.setKernel(Filter_Kernel(filterCenter, filterBandwidth));  // cached, designs only on a miss
+}
+
+// bpf1 sets the TX passband from TX_filterCenter and TX_filterBandwidth.  TX_Hilbert only has to cover it, so it is a
+// lowpass like the RX one and its phase error near DC falls in the bpf1 stopband.
+COLD void SetTXFilter(void)
+{
+    float lo = TX_filterCenter - TX_filterBandwidth/2;
+    float hi = TX_filterCenter + TX_filterBandwidth/2;
+
+    TX_Hilbert.design(0, hi + 800.0f);
+    Hilbert_Design(bpf1_coeffs, TX_BPF_TAPS, TX_Hilbert.getRate(), lo, hi, 0);
+    bpf1.begin(bpf1_coeffs, TX_BPF_TAPS, audio_block_samples);
 }
 
 COLD void initDSP(void)
@@ -1439,8 +1493,116 @@ COLD void initDSP(void)
     AudioMemory_F32(150, audio_settings);   // 4096IQ FFT needs about 75 or 80 at 96KHz sample rate
     resetCodec();
     delay(50);  // Sometimes a delay avoids a Twin Peaks problem.
+    Change_Sample_Rate(sample_rate_Hz);     // the I2S objects start at this rate, set up the resamplers to match
+}
+
+//  Change the codec sample rate at runtime.  With USE_DEMOD_DECIMATE the Hilbert, noise blanker, S meter and TX filters
+//  run at hilbert_settings and the notch/NR, bandwidth filter and AGC at demod_settings whatever the codec rate, so their
+//  coefficients (the Hilbert designs, the cached filter kernels, LMS, AGC times, the S meter peak) stay as they are.  The rate
+//  has to be a power of 2 times the Hilbert rate that keeps both the same (48, 96 or 192KHz).  What does depend on it is
+//  redone here:  the I2S clock, the front end and demod resampler lowpass filters, the FFT bin size and the tones made at
+//  the codec rate.  Returns false and changes nothing for any other rate.
+//  FM_Detector and the USB audio objects stay at the rate they were built for (audio_settings).  A change away from it is
+//  refused in FM mode and while the USB host streams audio in or out.  selectMode() puts the rate back for FM.
+COLD bool Change_Sample_Rate(float new_sample_rate_Hz)
+{
+    if (new_sample_rate_Hz != audio_settings.sample_rate_Hz && !Sample_Rate_Free())
+    {
+        DPRINT(F("Sample rate stays at ")); DPRINT(sample_rate_Hz, 0); DPRINTLN(F("Hz in FM or with USB audio on"));
+        return false;
+    }
+    #ifdef USE_DEMOD_DECIMATE
+    uint8_t front = Resample_Factor(new_sample_rate_Hz, HILBERT_RATE_HZ);
+    if (new_sample_rate_Hz / front != hilbert_settings.sample_rate_Hz ||
+        new_sample_rate_Hz / Resample_Factor(new_sample_rate_Hz, DEMOD_RATE_HZ) != demod_settings.sample_rate_Hz)
+    #else
+    if (new_sample_rate_Hz != sample_rate_Hz)   // every stage is at the codec rate
+    #endif
+    {
+        DPRINT(F("Sample rate not supported: ")); DPRINTLN(new_sample_rate_Hz);
+        return false;
+    }
+    if (new_sample_rate_Hz != sample_rate_Hz)
+        SetI2SFreq(new_sample_rate_Hz);
+    sample_rate_Hz = new_sample_rate_Hz;
+    zoom_in_sample_rate_Hz = sample_rate_Hz;
+    myFFT.setSampleRate(sample_rate_Hz);
+
+    #ifdef USE_DEMOD_DECIMATE
+    RX_Decimate_IQ.setSampleRate(sample_rate_Hz);
+    RX_Decimate_IQ.begin(front, IQ_FRONT_PASSBAND_HZ);
+    TX_Decimate.setSampleRate(sample_rate_Hz);
+    TX_Decimate.begin(front, IQ_FRONT_PASSBAND_HZ);
+    TX_Interpolate.setSampleRate(sample_rate_Hz);
+    TX_Interpolate.begin(front, IQ_FRONT_PASSBAND_HZ);
+    // The demod resamplers are designed once per rate for the widest filter[] passband.  A filter change does not
+    // touch them, begin() clears their history and queues and would drop a block of audio.
+    // RX_Decimate starts at the Hilbert rate, after RX_Decimate_IQ.  RX_Interpolate goes all the way back up.
+    uint8_t n = Resample_Factor(sample_rate_Hz, DEMOD_RATE_HZ);
+    RX_Decimate.begin(n / front, DEMOD_PASSBAND_HZ, demod_settings.audio_block_samples);
+    RX_Interpolate.setSampleRate(sample_rate_Hz);
+    RX_Interpolate.begin(n, DEMOD_PASSBAND_HZ);
+    #endif
+    Change_FFT_Size(fft_size, sample_rate_Hz);      // fft_bin_size for the new rate
+    SetFilter();                                    // Hilbert top edge and the filter kernel, both cached
+
+    Beep_Tone.setSampleRate_Hz(sample_rate_Hz);
+    TxTestTone_A.setSampleRate_Hz(sample_rate_Hz);
+    TxTestTone_B.setSampleRate_Hz(sample_rate_Hz);
+    FM_LO_Mixer.setSampleRate_Hz(sample_rate_Hz);
+    #ifdef USE_IQ_CORRECT
+    IQ_Correct.setSampleRate(sample_rate_Hz);   // same time constant in seconds, the correction carries over
+    #endif
+    DPRINT(F("Sample rate ")); DPRINT(sample_rate_Hz, 0); DPRINT(F("Hz, bin size ")); DPRINT(fft_bin_size*2, 1); DPRINTLN(F("Hz"));
+    return true;
+}
+
+//  True when nothing that only works at the audio_settings rate is in use:  the radio is not in FM and the USB host is
+//  not streaming audio to or from us.  The USB audio and FM_Detector objects are not redone by Change_Sample_Rate().
+COLD bool Sample_Rate_Free(void)
+{
+    if (bandmem[curr_band].mode_A == FM)
+        return false;
+    #ifdef AUDIO_INTERFACE
+    if (usb_audio_receive_setting || usb_audio_transmit_setting)    // alternate setting 0 is the host not streaming
+        return false;
+    #endif
+    return true;
 }
 
+//  Set the SAI1 (I2S) clock for a new sample rate.  Frank B's method, also in Libraries/Audio/control_wm8960.cpp:
+//  the audio PLL runs at freq * 256 * n1 * n2, between 648 and 1296MHz, and SAI1 divides it back down to MCLK = 256 * freq.
+COLD void SetI2SFreq(float freq)
+{
+    #if defined(__IMXRT1062__)
+    int n1 = 4;     // SAI prescaler 4 => (n1*n2) = multiple of 4
+    int n2 = 1 + (24000000 * 27) / (freq * 256 * n1);
+    double C = ((double)freq * 256 * n1 * n2) / 24000000;
+    int c0 = C;
+    int c2 = 10000;
+    int c1 = C * c2 - (c0 * c2);
+    set_audioClock(c0, c1, c2, true);
+    CCM_CS1CDR = (CCM_CS1CDR & ~(CCM_CS1CDR_SAI1_CLK_PRED_MASK | CCM_CS1CDR_SAI1_CLK_PODF_MASK))
+        | CCM_CS1CDR_SAI1_CLK_PRED(n1-1)    // &0x07
+        | CCM_CS1CDR_SAI1_CLK_PODF(n2-1);   // &0x3f
+    #else
+    DPRINTLN(F("SetI2SFreq() is only for the Teensy 4"));
+    #endif
+}
+
+#ifdef USE_IQ_CORRECT
+//  Image rejection of the RX board as received and after IQ_Correct, and the gain and phase error it is taking out.
+//  With the correction off both read the same.
+COLD void Print_IQ_Correct(void)
+{
+    DPRINT(F("IQ correction ")); DPRINT(IQ_Correct.isEnabled() ? F("on") : F("off"));
+    DPRINT(F(", IRR in ")); DPRINT(IQ_Correct.getInputIRR(), 1);
+    DPRINT(F("dB out ")); DPRINT(IQ_Correct.getOutputIRR(), 1);
+    DPRINT(F("dB, gain error ")); DPRINT(20.0f * log10f(IQ_Correct.getGain()), 2);
+    DPRINT(F("dB phase error ")); DPRINT(IQ_Correct.getPhase(), 2); DPRINTLN(F(" deg"));
+}
+#endif
+
 // initDSP() and startup in RX mode enables our resources.  
 // This function switches input sources between line in and mic in and Test Tones (A and B),
 //   then set levels and retores them on RX.
@@ -1533,6 +1695,11 @@ COLD void TX_RX_Switch(
         OutputSwitch_Q.gain(1, ch_on);      // Turn TX ON   
         OutputSwitch_I.gain(2, ch_off);     // Turn ON for FM   ToDO: automate this based on mode
         OutputSwitch_Q.gain(2, ch_off);     // Turn ON for FM       
+        OutputSwitch_I.gain(3, ch_off);     // No beep on the TX audio
+        OutputSwitch_Q.gain(3, ch_off);
+        #ifdef USE_IQ_CORRECT
+        IQ_Correct.setAdapt(false);         // the input is the mic now, hold the RX correction
+        #endif
 
         Amp1_L.setGain(0.0f);    // Mute output to USB during TX
         Amp1_R.setGain(0.0f);   
@@ -1540,6 +1707,7 @@ COLD void TX_RX_Switch(
         //TX_FilterConv.initFilter((float32_t)TX_filterCenter, 90, 2, TX_filterBandwidth);
 
         AudioInterrupts();
+        Audio_Graph_Select(GRAPH_TX);   // stop the receive chain
 
         RampVolume(ch_on, 0);        // Instant off.  0 to 1.0f for full scale.
         codec1.unmuteLineout();           // Audio out to Line-Out and TX board        
@@ -1604,6 +1772,12 @@ COLD void TX_RX_Switch(
             OutputSwitch_Q.gain(2, ch_on); // Turn ON for FM
         }   
 
+        OutputSwitch_I.gain(3, 0.7f);   // Beep Tone back on
+        OutputSwitch_Q.gain(3, 0.7f);
+        #ifdef USE_IQ_CORRECT
+        IQ_Correct.setAdapt(true);
+        #endif
+
         Amp1_L.setGain_dB(1.0f);    // Adjustable fixed output boost in dB. Turn on USB Out during RX
         Amp1_R.setGain_dB(1.0f);  
 
@@ -1646,33 +1820,30 @@ COLD void TX_RX_Switch(
     }
 }
 
-//  Change FFT data source for zoom effects 
+//  Change the spectrum FFT size (256 to 4096) and/or sample rate.  The same FFT object and buffers are reused.
+//  A new rate goes through Change_Sample_Rate() so the rest of the audio chain changes with it.
 COLD void Change_FFT_Size(uint16_t new_size, float new_sample_rate_Hz)
 {
-    fft_size        = new_size;   //  change global size to use for audio and display
-    sample_rate_Hz  = new_sample_rate_Hz;
-    fft_bin_size    = sample_rate_Hz/(fft_size*2);
+    if (new_sample_rate_Hz != sample_rate_Hz && !Change_Sample_Rate(new_sample_rate_Hz))
+        return;
+    myFFT.setFFTSize(new_size);
+    fft_size        = myFFT.getFFTSize();       //  change global size to use for audio and display
+    fft_bins        = fft_size;
+    fft_bin_size    = myFFT.getBinSize()/2;     // same half bin convention as sample_rate_Hz/(fft_size*2)
 
     AudioNoInterrupts();
-    // Route selected FFT source to one of the possible many FFT processors - should save CPU time for unused FFTs
-    if (fft_size == 4096)
-    {
-        FFT_OutSwitch_I.setChannel(0); //  1 is 4096, 0 is Off
-        FFT_OutSwitch_Q.setChannel(0); //  1 is 4096, 0 is Off
-    }
-    else if (fft_size == 2048)
-    {
-        FFT_OutSwitch_I.setChannel(1); //  1 is 2048, 0 is Off
-        FFT_OutSwitch_Q.setChannel(1); //  1 is 2048, 0 is Off
-    }
-    else if(fft_size == 1024)
-    {
-        FFT_OutSwitch_I.setChannel(2); //  1 is 1024, 0 is Off
-        FFT_OutSwitch_Q.setChannel(2); //  1 is 1024, 0 is Off
-    }
+    FFT_OutSwitch_I.setChannel(0); //  0 feeds the FFT
+    FFT_OutSwitch_Q.setChannel(0);
     AudioInterrupts();
 }
 
+//  Zoom by decimating ahead of the FFT.  The FFT size stays the same, the bin size and span shrink by zoom_factor.
+COLD void Change_FFT_Zoom(uint8_t zoom_factor)
+{
+    myFFT.setZoom(zoom_factor);
+    Change_FFT_Size(fft_size, sample_rate_Hz);
+}
+
 // If peak power exceeds 100% FS, reduce LineIn level, and/or if there is an attenuator, turn it on
 // This is temporary.  It will not change RF or AG Gain levels
 // LineIn level will be restored if RFGain is adjusted manually or during band changes
@@ -1815,12 +1986,8 @@ COLD void resetCodec(void)
     #endif
     
     // Initialize our filters for RX and TX.  Using RX and TX filters since the filters specs are different later
-    RX_Hilbert_Plus_45.begin(Hilbert_Plus45_40K,151);   // Left channel Rx
-    RX_Hilbert_Minus_45.begin(Hilbert_Minus45_40K,151); // Right channel Rx
-    
-    TX_Hilbert_Plus_45.begin(Hilbert_Plus45_28K,151);   // Right channel TX
-    TX_Hilbert_Minus_45.begin(Hilbert_Minus45_28K,151); // Left channel TX
-    bpf1.begin(fir1, 197, 128);
+    // The Hilbert pairs are designed for the rate they run at.  RX_Hilbert follows the RX filter in SetFilter().
+    SetTXFilter();
     
     // Pick one of the three.
     ///FFT_90deg_Hilbert.begin(hilbert19A, 19);
@@ -1840,7 +2007,8 @@ COLD void resetCodec(void)
     // Will be done in mode function also except for Beep Tone (2)
     //RX_Summer.gain(0, 1.0f);  // Left Channel into mixer
 	//RX_Summer.gain(1, 1.0f);  // Right Channel, intoi Miver
-    RX_Summer.gain(2, 0.7f);  // Set Beep Tone ON or Off and Volume
+    OutputSwitch_I.gain(3, 0.7f);  // Set Beep Tone ON or Off and Volume
+    OutputSwitch_Q.gain(3, 0.7f);
     //RX_Summer.gain(3, 0.0f);  // FM Detection Path.  Only turn on for FM Mode
     DPRINTLN(F(" Reset Codec Almost Completed"));
     Xmit(0);  // Finish RX audio chain setup
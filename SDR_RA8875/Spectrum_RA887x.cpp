@@ -15,26 +15,7 @@ uint16_t fft_sz = 0;
 int16_t fft_binc = 0;
 float fft_bin_sz = 0;
 
-#ifdef BETATEST
-    extern float32_t  fftOutput[];  // Array used for FFT Output to the INO program
-    extern float32_t  window[];     // Windows reduce sidelobes with FFT's *Half Size*
-    extern float32_t  fftBuffer[];  // Used by FFT, 4096 real, 4096 imag, interleaved
-    extern float32_t  sumsq[];      // Required ONLY if power averaging is being done
-#endif
-
-#ifdef FFT_4096
-    #ifndef BETATEST
-         extern AudioAnalyzeFFT4096_IQ_F32    myFFT_4096;  // choose which you like, set FFT_SIZE accordingly.
-    #else
-        extern AudioAnalyzeFFT4096_IQEM_F32  myFFT_4096;  // choose which you like, set FFT_SIZE accordingly.
-    #endif
-#endif
-#ifdef FFT_2048    
-    extern AudioAnalyzeFFT2048_IQ_F32  myFFT_2048;
-#endif
-#ifdef FFT_1024
-    extern AudioAnalyzeFFT1024_IQ_F32  myFFT_1024;
-#endif
+extern AudioAnalyzeZoomFFT_IQ_F32  myFFT;     // Spectrum FFT for all sizes and zoom levels
 
 #ifndef USE_RA8875
     int16_t _activeWindowXL = 0;
@@ -67,11 +48,20 @@ uint8_t fft_axis = FFT_AXIS;
 // in your INO setup(), or 0 or 1, and pretty soon it will be what you want, maybe.
 
 int16_t _colorMap(int16_t val, int16_t color_temp);
-//int16_t _find_FFT_Max(uint16_t bin_min, uint16_t bin_max, uint16_t fft_sz);
+void _noise_floor_update(const float *pwr, int16_t npix, int16_t dc_pix, float hz_per_pix);
+void _find_FFT_Peaks(const float *pwr, int16_t npix, float dc_pix, float hz_per_pix, int32_t vfo);
+uint8_t _find_FFT_Candidates(const float *pwr, int16_t npix, int16_t dc, float keep, struct Spectrum_Peak *cand);
+void _sp_draw_peak_markers(struct Spectrum_Parms *ptr, int16_t filt_x, int16_t filt_w);
 char* _formatFreq(uint32_t Freq);
 //static uint16_t Color565(uint8_t r, uint8_t g, uint8_t b);
 //inline uint16_t _Color565(uint8_t r, uint8_t g, uint8_t b);
 int16_t _waterfall_color_update(float sample, int16_t waterfall_low);
+void _waterfall_gradient(float percent, unsigned char *p);
+void _wf_palette_check(struct Spectrum_Parms *pp);
+void _span_reduce(float *bins, uint16_t nbins, float *out, int16_t npix, uint8_t mode);
+void _sp_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void _sp_trace_column(int16_t x, int16_t old_top, int16_t old_bot, int16_t top, int16_t bot, uint16_t bg);
+void _sp_trace_flush(void);
 
 // Function Declarations
 //-------------- COLOR CONVERSION -----------------------------------------------------------
@@ -80,6 +70,17 @@ inline uint16_t Color24To565(int32_t color_) { return ((((color_ >> 16) & 0xFF)
 inline uint16_t htmlTo565(int32_t color_) { return (uint16_t)(((color_ & 0xF80000) >> 8) | ((color_ & 0x00FC00) >> 5) | ((color_ & 0x0000F8) >> 3));}
 inline void 	Color565ToRGB(uint16_t color, uint8_t &r, uint8_t &g, uint8_t &b){r = (((color & 0xF800) >> 11) * 527 + 23) >> 6; g = (((color & 0x07E0) >> 5) * 259 + 33) >> 6; b = ((color & 0x001F) * 527 + 23) >> 6;}
 
+//-------------- PALETTE LOOKUP -------------------------------------------------------------
+extern uint16_t wf_colormap_lut[];
+// _wf_palette_lookup() is in Spectrum_RA887x.h
+// Same result as _colorMap() but uses the table for the common range.  Out of range values are rare and computed.
+inline int16_t _colorMap_lut(int16_t val, int16_t color_temp)
+{
+    if ((uint16_t) val < WF_COLORMAP_SIZE)
+        return wf_colormap_lut[val];
+    return _colorMap(val, color_temp);
+}
+
 int16_t wf_time_line                = 15000;
 int16_t fftFreq_refresh             = 1000;
 Metro   waterfall_timestamp         = Metro(wf_time_line);  // Used to draw a time stamp line across the waterfall window.  Cha
@@ -94,6 +95,62 @@ int16_t fftMaxPower;//          = 0;    // Used to hold the FFT peak power for t
 const int8_t  NAvg                  = 6; //5;
 //static uint32_t time_spectrum;
 
+// Waterfall palette tables.  Built once by _wf_palette_check() when the floor, scale, color temp or palette changes
+// so the per pixel work in spectrum_update() is a quantize step and a table read.
+uint8_t  wf_palette_sel                             = WF_PALETTE_G0ORX;   // Selected palette for waterfall style 6
+uint16_t wf_palette[WF_PALETTE_SIZE+1];                 // Index 0 is the low color, last entry is the over range (high) color
+uint16_t wf_colormap_lut[WF_COLORMAP_SIZE];             // _colorMap() results for val 0 to WF_COLORMAP_SIZE-1 at the current color temp
+int16_t  wf_palette_low_ofs                         = 0;    // Offset added to pix_min to get the waterfall low threshold
+
+// Span (bin to pixel) reduction.  SPAN_CROP shows 1 bin per pixel from the center. The others pack all FFT bins into the graph width.
+uint8_t spect_span_mode                             = SPAN_CROP;
+float   spect_bins_per_pixel                        = 1.0f;     // FFT bins represented by each pixel for the last update.  Used by touch tuning
+float   span_FFT[SPAN_BUF_SIZE];                                // Reduced FFT data, 1 value per pixel.  Sized for waterfall style 0 which reads ahead 1.6x
+float   sp_pan                                      = 0;        // pan (in pixels) and Hz per pixel/2 used for the FFT data being drawn
+float   sp_bin_sz                                   = 0;
+
+// Spectrum trace drawing.  Only the changed part of each column is drawn.  Adjacent columns with the same
+// erase or draw operation are batched into 1 rectangle.
+struct Spectrum_Stats spect_stats                   = {};       // draw calls and estimated SPI bytes for the last spectrum update
+bool    spect_full_redraw                           = true;     // Set to force the spectrum background and trace to be fully redrawn
+
+// spectrum_update() step tracking.  
+uint8_t  sp_state                                   = SP_IDLE;  // Next step spectrum_update() will run
+uint32_t spect_step_max_us[SP_NUM_STEPS]            = {};       // Worst case time in us for each step
+const char *sp_step_name[SP_NUM_STEPS] = {"Idle", "Capture", "Colorize", "WF Move1", "WF Wait1", "WF Move2", "WF Wait2", "Trace", "Blit", "Blit Wait", "Labels"};
+
+// Waterfall scroll method and timing
+#ifdef USE_RA8875
+uint8_t  spect_wf_scroll                            = WF_SCROLL_SINGLE;
+#else
+uint8_t  spect_wf_scroll                            = WF_SCROLL_RING;
+#endif
+uint32_t spect_wf_scroll_us                         = 0;        // last waterfall scroll time in us
+uint32_t spect_wf_scroll_max_us[WF_SCROLL_NUM]      = {};       // worst case waterfall scroll time in us for each method
+uint32_t wf_scroll_work_us                          = 0;        // time in the scroll steps so far for the line in progress
+int16_t  wf_ring_head                               = 0;        // Ring buffer row (from the top of the waterfall) holding the newest line
+bool     wf_pip_on                                  = false;    // RA8876 PIP1 window is showing the waterfall ring
+
+float    spect_noise_floor                          = -120.0f;  // dB, from _noise_floor_update()
+float    nf_hist[SPECT_NF_CELLS]                    = {};       // Noise floor histogram, decaying weight per 1dB cell
+float    nf_hist_total                              = 0.0f;
+
+// Peak detector results.  Tracks with hits < SPECT_PEAK_CONFIRM are not reported or marked yet.
+struct Spectrum_Peak spect_peaks[SPECT_PEAKS_MAX]   = {};
+uint8_t  spect_peak_count                           = 0;
+bool     spect_peak_markers                         = true;     // Draw a marker above each confirmed peak
+int32_t  spect_peak_freq                            = 0;        // Frequency of the strongest confirmed peak, 0 if none
+struct Trace_Run {                                              // A pending batch of identical column operations
+    int16_t  x;             // first column
+    int16_t  w;             // number of columns, 0 = nothing pending
+    int16_t  y0;            // top row
+    int16_t  y1;            // bottom row
+    uint16_t color;
+};
+struct Trace_Run trace_run[4];                                  // erase top, erase bottom, draw top, draw bottom of a column
+bool    trace_label_dirty                           = false;    // A trace change was drawn over the grid label area
+int16_t trace_label_edge                            = 0;        // Right edge of the grid label area
+
 // Place to hold custom data for creating new layouts using the Generator function
 struct Spectrum_Parms Sp_Parms_Custom[1]    = {};      // Temp storage for generating new layouts    
 struct Spectrum_Parms *ptr                  = &Sp_Parms_Def[0];
@@ -152,88 +209,301 @@ void updateActiveWindow(bool full)
 }
 #endif
 
+//
+//  Returns true while the display controller is still doing a block move (BTE).  Does not wait.
+//
+static inline bool _sp_bte_busy(void)
+{
+    #ifdef USE_RA8875
+        return tft.readStatus();
+    #else
+        return (tft.statusRead() & 0x08);   // Same Core task busy bit check2dBusy() waits on
+    #endif
+}
+
+//
+//  Wait for any spectrum block move in progress to finish.  Call before drawing on layer 2 (page 2) or 
+//  saving the screen there (pop up windows) since spectrum_update() leaves block moves running between steps.
+//
+void Spectrum_BTE_Wait(void)
+{
+    while (_sp_bte_busy());
+}
+
+//
+//  Returns true while a block move spectrum_update() started is still running.  The controller status is read only in
+//  the wait steps, the other steps leave no move running.  Anything outside the spectrum that draws should not while
+//  this is true, its writes would land in the middle of the move.
+//
+bool Spectrum_BTE_Running(void)
+{
+    if (sp_state != SP_WF_WAIT1 && sp_state != SP_WF_WAIT2 && sp_state != SP_BLIT_WAIT)
+        return false;
+    return _sp_bte_busy();
+}
+
+//
+//  Abandon the spectrum frame in progress and start over with a full redraw.  Used when the screen 
+//  under the spectrum was changed, like a pop up window removed or a new frame drawn.
+//
+void Spectrum_Restart(void)
+{
+    Spectrum_BTE_Wait();
+    sp_state = SP_IDLE;
+    spect_full_redraw = true;
+}
+
+//
+//  Print the worst case time spent in each spectrum_update() step
+//
+COLD void Spectrum_Print_Timing(void)
+{
+    DPRINTLN(F("Spectrum step max us:"));
+    for (uint8_t n = 0; n < SP_NUM_STEPS; n++)
+    {
+        DPRINT(F("  ")); DPRINT(sp_step_name[n]); DPRINT(F("=")); DPRINTLN(spect_step_max_us[n]);
+    }
+    DPRINT(F("  WF scroll mode=")); DPRINT(spect_wf_scroll);
+    DPRINT(F(" last us=")); DPRINTLN(spect_wf_scroll_us);
+    for (uint8_t n = 0; n < WF_SCROLL_NUM; n++)
+    {
+        DPRINT(F("  WF scroll mode ")); DPRINT(n); DPRINT(F(" max us=")); DPRINTLN(spect_wf_scroll_max_us[n]);
+    }
+}
+
+//
+//  Rows in the waterfall ring buffer.  Same rows the block copy method scrolls.
+//
+static inline int16_t _wf_ring_rows(void)
+{
+    return ptr->wf_bottom_line - ptr->wf_top_line - 2;
+}
+
+//
+//  RA8876 waterfall ring.  The ring is at the top of WF_RING_PAGE, the same columns as the waterfall, and each line
+//  is written twice, at wf_ring_head and wf_ring_head+rows.  Rows wf_ring_head to wf_ring_head+rows-1 are then always
+//  the whole waterfall in order, newest at the top.  The PIP1 window shows them in place of the waterfall on page 1
+//  and moves down the ring with wf_ring_head, so a new line is 2 row writes and 2 register writes, with no block moves.
+//
+//  PIP window x and width have to be multiples of 4 so the window takes in a few columns of the frame each side.
+//  Those columns are copied into the ring once when it is cleared and never written again.
+//
+#ifndef USE_RA8875
+// RA8876 PIP registers, from the datasheet.  16 bit values are low byte first.
+#define RA8876_MPWCTR       0x10    // Main/PIP window control.  Bit 7 PIP1 on, bit 4 0 = the PIP registers below are PIP1's.
+#define RA8876_PIPCDEP      0x11    // PIP color depth.  Bits 3:2 PIP1, 01 = 16 bpp.
+#define RA8876_PWDULX       0x2A    // PIP window on the screen, upper left x then y
+#define RA8876_PISA         0x2E    // PIP image start address, 32 bits
+#define RA8876_PIW          0x32    // PIP image width
+#define RA8876_PWIULX       0x34    // PIP window upper left in the image, x then y
+#define RA8876_PWW          0x38    // PIP window width then height
+
+static void _wf_pip_reg16(uint8_t reg, uint16_t val)
+{
+    tft.lcdRegDataWrite(reg, val & 0xFF);
+    tft.lcdRegDataWrite(reg+1, val >> 8);
+}
+
+static inline int16_t _wf_pip_x(void)   { return (ptr->l_graph_edge+1) & ~3; }
+static inline int16_t _wf_pip_w(void)   { return (ptr->l_graph_edge+1+ptr->wf_sp_width - _wf_pip_x() + 3) & ~3; }
+
+//
+//  Show the ring through PIP1, or turn PIP1 off.  Turning it off first copies what it shows to page 1 so the screen
+//  does not change, for the pop up windows and the copy scroll method that work on page 1.
+//
+static void _wf_pip_show(bool on)
+{
+    if (on)
+    {
+        tft.lcdRegDataWrite(RA8876_MPWCTR, tft.lcdRegDataRead(RA8876_MPWCTR) & ~0x10);     // set up PIP1
+        tft.lcdRegDataWrite(RA8876_PIPCDEP, (tft.lcdRegDataRead(RA8876_PIPCDEP) & ~0x0C) | 0x04);
+        _wf_pip_reg16(RA8876_PWDULX,   _wf_pip_x());
+        _wf_pip_reg16(RA8876_PWDULX+2, ptr->wf_top_line+1);
+        _wf_pip_reg16(RA8876_PISA,     WF_RING_PAGE & 0xFFFF);
+        _wf_pip_reg16(RA8876_PISA+2,   WF_RING_PAGE >> 16);
+        _wf_pip_reg16(RA8876_PIW,      SCREEN_WIDTH);
+        _wf_pip_reg16(RA8876_PWIULX,   _wf_pip_x());
+        _wf_pip_reg16(RA8876_PWIULX+2, wf_ring_head);
+        _wf_pip_reg16(RA8876_PWW,      _wf_pip_w());
+        _wf_pip_reg16(RA8876_PWW+2,    _wf_ring_rows());
+        tft.lcdRegDataWrite(RA8876_MPWCTR, tft.lcdRegDataRead(RA8876_MPWCTR) | 0x80);
+    }
+    else if (wf_pip_on)
+    {
+        tft.boxGet(WF_RING_PAGE, _wf_pip_x(), wf_ring_head, _wf_pip_x()+_wf_pip_w(), wf_ring_head+_wf_ring_rows(), _wf_pip_x(), ptr->wf_top_line+1);
+        tft.check2dBusy();
+        tft.lcdRegDataWrite(RA8876_MPWCTR, tft.lcdRegDataRead(RA8876_MPWCTR) & ~0x80);
+    }
+    wf_pip_on = on;
+}
+#endif  // USE_RA8875
+
+//
+//  Start the waterfall ring over from the waterfall on page 1 and show it, or turn the ring off when another scroll
+//  method is in use.  RA8876 only, nothing to do on the RA8875.  Falls back to the copy method if the 2 copies of the
+//  ring do not fit on the page.
+//
+void _wf_ring_clear(void)
+{
+    #ifndef USE_RA8875
+        int16_t rows = _wf_ring_rows();
+        if (spect_wf_scroll == WF_SCROLL_RING && (rows*2 > SCREEN_HEIGHT || _wf_pip_x()+_wf_pip_w() > SCREEN_WIDTH))
+        {
+            DPRINTLN(F("Waterfall ring does not fit, using the copy scroll"));
+            spect_wf_scroll = WF_SCROLL_COPY;
+        }
+        if (spect_wf_scroll != WF_SCROLL_RING)
+        {
+            _wf_pip_show(false);
+            wf_ring_head = 0;
+            return;
+        }
+        wf_ring_head = 0;
+        tft.boxPut(WF_RING_PAGE, _wf_pip_x(), ptr->wf_top_line+1, _wf_pip_x()+_wf_pip_w(), ptr->wf_top_line+1+rows, _wf_pip_x(), 0);
+        tft.check2dBusy();
+        tft.boxPut(WF_RING_PAGE, _wf_pip_x(), ptr->wf_top_line+1, _wf_pip_x()+_wf_pip_w(), ptr->wf_top_line+1+rows, _wf_pip_x(), rows);
+        tft.check2dBusy();
+        _wf_pip_show(true);
+    #else
+        wf_ring_head = 0;
+    #endif
+}
+
+//
+//  Pop up windows are drawn on page 1.  On the RA8876 the waterfall ring window would show over them, so it is turned
+//  off while a pop up is up.  Call with true from pop_win_up() before the screen is saved, false from pop_win_down().
+//
+void Spectrum_Popup(bool up)
+{
+    #ifndef USE_RA8875
+        if (spect_wf_scroll == WF_SCROLL_RING)
+            _wf_pip_show(!up);
+    #endif
+}
+
+//
+//  Select the waterfall scroll method.  See WF_SCROLL_xxx in the header file.  The measured scroll times are reset
+//  so the methods can be compared with Spectrum_Print_Timing().
+//
+void Spectrum_Set_WF_Scroll(uint8_t mode)
+{
+    #ifdef USE_RA8875
+    if (mode == WF_SCROLL_RING)     // needs a spare page the RA8875 does not have
+        mode = WF_SCROLL_COPY;
+    #else
+    if (mode == WF_SCROLL_SINGLE)   // RA8875 block move only
+        mode = WF_SCROLL_RING;
+    #endif
+    if (mode >= WF_SCROLL_NUM)
+        mode = WF_SCROLL_COPY;
+    Spectrum_Restart();
+    if (mode != spect_wf_scroll)
+    {
+        spect_wf_scroll = mode;
+        _wf_ring_clear();    // the ring starts from the lines the copy method drew, or is copied back for it
+    }
+    spect_wf_scroll_us      = 0;
+}
+
 // -------------------------------------------------------------------------------------
 //
 //      Spectrum Update()
 //
 //      Updates the spectrum/waterfall windows with data from chosen FFT
 //
+//      This is a state machine.  Each call does 1 step of the update and returns so the main loop
+//      can service the encoders, touch, PTT and CAT between steps.  Call it every pass through loop().
+//      The display controller block moves are started in one step and polled in the next, never waited on.
+//          SP_IDLE         Wait for the spect_wf_rate update timer
+//          SP_CAPTURE      Copy (or span reduce) the FFT data when a new FFT is available
+//          SP_COLORIZE     Build the new waterfall line colors and the spectrum pixel values
+//          SP_WF_MOVE1     Start the 1st waterfall scroll block move
+//          SP_WF_WAIT1     Poll for it to finish
+//          SP_WF_MOVE2     Start the 2nd waterfall scroll block move
+//          SP_WF_WAIT2     Poll for it to finish, then write the new waterfall line
+//          SP_TRACE        Draw the spectrum trace, grid and pitch lines on the hidden layer (page)
+//          SP_BLIT         Start the block move of the spectrum window to the visible layer (page)
+//          SP_BLIT_WAIT    Poll for it to finish
+//          SP_LABELS       Update the span frequency labels if needed
+//      The worst case time of each step is kept in spect_step_max_us[].
+//
 // -------------------------------------------------------------------------------------
 //
 int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB, int32_t Offset, uint16_t filterCenter, uint16_t filterBandwidth, float pan, uint16_t fft_sz, float fft_bin_sz, int16_t fft_binc)
 {
-//    s = The PRESET index into Sp_Parms_Def[] structure for windows location and size params  
+//    s = The PRESET index into Sp_Parms_Def[] structure for windows location and size params
 //    Specify the default layout option for spectrum window placement and size.
-//    
+//
 //    This function only uses values from the Sp_Parms_Def[] struct (later Sp_Parms_Custom[]).  To update the structure
-//    records set the global variables the call the Spectrum_Generator() function and copy and paste the output displayed 
+//    records set the global variables the call the Spectrum_Generator() function and copy and paste the output displayed
 //    on the Serial Terminal into the default array init table.
 
-    //if (s >= PRESETS) 
+    //if (s >= PRESETS)
     //    s=PRESETS-1;   // Cycle back to 0
-    // See Spectrum_Parm_Generator() below for details on Global values requires and how the woindows variables are used.    
+    // See Spectrum_Parm_Generator() below for details on Global values requires and how the woindows variables are used.
     //struct Spectrum_Parms *ptr = &Sp_Parms_Def[s];
     *ptr = Sp_Parms_Def[s];
- 
+
     //int16_t blanking = 3; //3;  // used to remove the DC line from the graphs at Fc
-    int16_t pix_o16;
     int16_t pix_n16;
     //static int16_t spect_scale_last     = 0;
     //static int16_t spect_ref_last     = 0;
     //int16_t fft_pk_bin                  = 0;
     static int16_t fftPower_pk_last     = ptr->spect_floor;
     static int16_t pix_min              = ptr->spect_floor;
-    int32_t freq_peak                   = 0;
+    int32_t freq_peak                   = spect_peak_freq;   // strongest peak found by the last capture, 0 if none
     static float old_fft_sz             = 0;        // used to update the spectrum scale frequency labels when the FFT size changes and VFO does not
     int32_t L_EDGE_no_pan               = 0;        // internediate calculation used to pan
     static float old_pan                = 0;        // update screen freq data when pan setting changes
+    static float old_fft_bin_sz         = 0;        // update screen freq data when the span mode changes the Hz per pixel
 
     //for testing alignments
     //tft.drawRect(spectrum_x, spectrum_y, spectrum_width, spectrum_height, myBLUE);  // x start, y start, width, height, array of colors w x h
     //tft.drawRect(ptr->spect_x, ptr->spect_y, ptr->spect_width, ptr->spect_height, myBLUE);  // x start, y start, width, height, array of colors w x h
-     
+
     int16_t         i;
     float           avg = 0.0;
-    int16_t         pixelnew[SCREEN_WIDTH+2];           //  Stores current pixel for spectrum portion only
-    static int16_t  pixelold[SCREEN_WIDTH+2];    //  Stores copy of current pixel so it can be erased in next update
-    //int8_t span_FFT[SCREEN_WIDTH+2];         // Intended to store averaged values representnig a larger FFT set into the smaller screen width set
+    static int16_t  pixelnew[SCREEN_WIDTH+2];    //  Stores current pixel for spectrum portion only.  Kept between steps.
+    static int16_t  pixelold[SCREEN_WIDTH+2];    //  Stores top of the trace drawn in each column so only the change is drawn in next update
+    static int16_t  pixelold_bot[SCREEN_WIDTH+2];   //  Stores bottom of the trace drawn in each column.  Column is empty when top > bottom
+    static int16_t  line_buffer[SCREEN_WIDTH+2]; //  New waterfall line colors.  Kept between steps.
     float           *pout=NULL;
- 
-    // While more than 1 FFT may be enabled, only 1 (fft_size) is chosen for display
-    uint8_t         process_FFT = 0;
-    #ifdef FFT_4096
-        if (fft_sz == 4096 && myFFT_4096.available()) 
-        { 
-            #ifndef BETATEST
-                pout = myFFT_4096.getData();
-            #else
-                pout = fftOutput;
-            #endif
-            process_FFT = 1;
-        }
-    #endif
-    #ifdef FFT_2048
-        if (fft_sz == 2048 && myFFT_2048.available()) 
+    uint32_t        step_start          = micros();
+    uint8_t         step                = sp_state;
+
+    switch (sp_state)
+    {
+      case SP_IDLE:
+        //
+        //  Wait for the update rate timer. The rate is set in drawSpectrumFrame() with spect_wf_rate from the table
+        //
+        if (spectrum_waterfall_update.check() == 1)
+            sp_state = SP_CAPTURE;
+        break;
+
+      case SP_CAPTURE:
+      {
+        uint8_t         process_FFT = 0;
+        if (myFFT.available())
         {
-            pout = myFFT_2048.getData();
+            pout = myFFT.getData();
             process_FFT = 1;
         }
-    #endif
-    #ifdef FFT_1024
-        if (fft_sz == 1024 && myFFT_1024.available()) 
+
+        if (process_FFT != 1)      // Clear stale data
         {
-            pout = myFFT_1024.getData();
-            process_FFT = 1;
+            if (spectrum_clear.check() == 1)      // Spectrum Screen blanking timer
+            {
+               DPRINTLN(F("*** Cleared Screen, no data to Draw! ***"));
+                //tft.fillRect(ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width-2, ptr->sp_height-2, myBLACK);
+                //tft.drawFastVLine(ptr->l_graph_edge+ptr->wf_sp_width/2+1, ptr->sp_top_line+1, ptr->sp_height, myLT_GREY);
+            }
+            break;  // try again next pass
         }
-    #endif
 
-    if (process_FFT == 1)
-    {     
-        //float *pout = myFFT.getData();          // Get pointer to data array of powers, float output[512]; 
+        //float *pout = myFFT.getData();          // Get pointer to data array of powers, float output[512];
         // Only 1 of the FFT outputs can be displayed
-
-        int16_t line_buffer[SCREEN_WIDTH+2];      // Will only use the x bytes defined by wf_sp_width var.  Could be 4096 FFT later which is larger than our width in pixels. 
-        int16_t L_EDGE = 0; 
+        int16_t L_EDGE = 0;
 
         #ifdef ENET
             extern uint8_t enet_write(uint8_t *tx_buffer, const int count);
@@ -249,51 +519,73 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
                 enet_write(tx_buffer, fft_sz);
             }
         #endif
-// ToDO: Check if this is needed anymore
-        // Calculate center. If FFT is larger than graph area width, trim ends evently
-        if (ptr->spect_span == 50)   //span width in KHz.   50 is just used for dev test.
-        {      
-            // pack all bins into the available display width.  
-            //int wd = ptr->wf_sp_width;
-            //int div = ptr->spect_span;
-            //int binsz = round(fft_sz/wd);  // bins that will be compressed into 1 pixel to fit the screen
-            for (i = 0; i < ptr->wf_sp_width; i++)
-            {        
-                if ( i > SCREEN_WIDTH) // do not overrun our buffer size.  Ideally wf_sp_width would never be > SCREENWIDTH but....
-                    i = SCREEN_WIDTH;
-                //span_FFT[i] = (int16_t) sp_FFT.read(binsz*i);
-            }
-            //pout = span_FFT;
-           // DPRINT("Zoom Out =");
-           //DPRINTLN(binsz,DEC);
-        }              
-        else if ( fft_sz > ptr->wf_sp_width-2)  // When FFT data is > available graph area
+        // Calculate center. If FFT is larger than graph area width, either pack all bins into the graph width
+        // or trim ends evently (crop) and use pan to slide the window
+        // Either way the data is copied to span_FFT so the FFT can update while we work on this frame over several steps.
+        spect_bins_per_pixel = 1.0f;
+        // The FFT mixer already moved the pan point to the center bin so the data is not shifted here.
+        // pan becomes the center offset in bins for the filter, pitch line and labels.  New pan takes effect next FFT.
+        float fft_pan = myFFT.getCenter() / (fft_bin_sz * 2);
+        myFFT.setPan(pan);
+        pan = fft_pan;
+        if (spect_span_mode != SPAN_CROP && fft_sz > ptr->wf_sp_width)
         {
-            pan *= (fft_sz - SCREEN_WIDTH);  // pan comes in as is -0.50f to +0.50f ==> calc # of bins to shift
-            L_EDGE_no_pan = (int16_t) ((fft_sz - ptr->wf_sp_width)/2); // left edge calc from reference center
-            L_EDGE = L_EDGE_no_pan + pan;  // shift the spectrum up to the max that the screen size can handle
-            pout = pout+L_EDGE;  // adjust the starting point up a bit to keep things centered.
+            // pack all bins into the available display width.  Several bins are reduced to 1 pixel
+            _span_reduce(pout, fft_sz, span_FFT, ptr->wf_sp_width, spect_span_mode);
+            spect_bins_per_pixel = (float) fft_sz / ptr->wf_sp_width;
+            fft_bin_sz *= spect_bins_per_pixel;  // Hz per pixel now. The filter shading, pitch line and labels below scale with it
+            pan /= spect_bins_per_pixel;         // center offset in pixels
         }
+        else
+        {
+            if ( fft_sz > ptr->wf_sp_width-2)  // When FFT data is > available graph area
+            {
+                L_EDGE_no_pan = (int16_t) ((fft_sz - ptr->wf_sp_width)/2); // left edge calc from reference center
+                L_EDGE = L_EDGE_no_pan;        // already centered on the pan point
+            }
 // ToDo: Figure out if this is needed someday.
-        // else   // When FFT data is < available graph area
-        // {      // If our display area is less then our data width, fill in the outside areas with low values.
-            //L_EDGE = (ptr->wf_sp_width - fft_sz - )/2;
-            //pout = pout+L_EDGE;  // adjust the starting point up a bit to keep things centered.
-            /*
-            for (i=0; i< fft_sz/4; i++)        
-                tempfft[i] = -500;
-            for (i=(fft_sz/4)*3; i< fft_size; i++)        
-                 tempfft[i] = -500;
-            //L_EDGE = FFT_center - GRAPH_center;
-            */
-        // }
+            // else   // When FFT data is < available graph area
+            // {      // If our display area is less then our data width, fill in the outside areas with low values.
+                //L_EDGE = (ptr->wf_sp_width - fft_sz - )/2;
+                //pout = pout+L_EDGE;  // adjust the starting point up a bit to keep things centered.
+                /*
+                for (i=0; i< fft_sz/4; i++)
+                    tempfft[i] = -500;
+                for (i=(fft_sz/4)*3; i< fft_size; i++)
+                     tempfft[i] = -500;
+                //L_EDGE = FFT_center - GRAPH_center;
+                */
+            // }
+            int16_t n = fft_sz - L_EDGE;  // copy starting at the left edge, do not read past the end of the FFT data
+            if (n > SPAN_BUF_SIZE)
+                n = SPAN_BUF_SIZE;
+            memcpy(span_FFT, pout+L_EDGE, n * sizeof(float));
+            for (i = n; i < SPAN_BUF_SIZE; i++)
+                span_FFT[i] = -200.0f;
+        }
+        sp_pan      = pan;
+        sp_bin_sz   = fft_bin_sz;
+        _noise_floor_update(span_FFT, ptr->wf_sp_width, SP_CENTER_PIX(ptr) - pan, fft_bin_sz*2);
+        _find_FFT_Peaks(span_FFT, ptr->wf_sp_width, SP_CENTER_PIX(ptr) - pan, fft_bin_sz*2, VFOA_YES ? VfoA : VfoB);
+        sp_state    = SP_COLORIZE;
+        break;
+      }
+
+      case SP_COLORIZE:
+      {
+        pout = span_FFT;
+
+        // Rebuild the color tables only if the settings they depend on changed, then set up this frame's quantizer
+        _wf_palette_check(ptr);
+        float wf_lo = (float) (pix_min + wf_palette_low_ofs);
+        float wf_k  = (WF_PALETTE_HIGH > wf_lo) ? WF_PALETTE_SIZE / (WF_PALETTE_HIGH - wf_lo) : 1.0e6f;   // table entries per dB
 
         for (i = 0; i < ptr->wf_sp_width; i++)        // Grab all FFT values.  Need to do at one time since averaging is looking at many values in this array
-        { 
+        {
             if (isnanf(*(pout+i)) || isinff (*(pout+i)))    // trap float 'NotaNumber NaN" and Infinity values
             {
                DPRINTLN(F("FFT Invalid Data INF or NaN"));
-                //Serial.println(*(pout+i));                
+                //Serial.println(*(pout+i));
                 pixelnew[i] = -200;   // fill in the missing value with somting harmless
                 //pixelnew[i] = sp_FFT.read(i+1);  // hope the next one is better.
             }
@@ -302,33 +594,33 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
 
             // Several different ways to process the FFT data for display. Gather up a complete FFT sample to do averaging then go on to update the display with the results
             switch (ptr->spect_wf_style)
-            { 
-              case 0: if ( i > 1 )  // prevent reading array out of bounds < 1. 
+            {
+              case 0: if ( i > 1 )  // prevent reading array out of bounds < 1.
                 {
-                    avg = *(pout+(i*16/10))*0.5 + *(pout+(i-1)*16/10)*0.18 + *(pout+(i-2)*16/10)*0.07 + *(pout+(i+1)*16/10)*0.18 + *(pout+(i+2)*16/10)*0.07;                
+                    avg = *(pout+(i*16/10))*0.5 + *(pout+(i-1)*16/10)*0.18 + *(pout+(i-2)*16/10)*0.07 + *(pout+(i+1)*16/10)*0.18 + *(pout+(i+2)*16/10)*0.07;
                     //line_buffer[i] = (LPFcoeff * 8 * sqrt (100+(abs(avg)*wf_scale)) + (1 - LPFcoeff) * line_buffer[i]);
-                    line_buffer[i] = (ptr->spect_LPFcoeff * 8 * sqrtf(fabsf(avg)) + (1 - ptr->spect_LPFcoeff) * line_buffer[i]);                      
-                }      
+                    line_buffer[i] = (ptr->spect_LPFcoeff * 8 * sqrtf(fabsf(avg)) + (1 - ptr->spect_LPFcoeff) * line_buffer[i]);
+                }
                       break;
               case 1: if ( i > 1 )  // prevent reading array out of bounds < 1.
                 {
-                    avg = *(pout+i)*0.5 + *(pout+i-1)*0.18 + *(pout+i-2)*0.07 + *(pout+i+1)*0.18 + *(pout+i+2)*0.07;                
+                    avg = *(pout+i)*0.5 + *(pout+i-1)*0.18 + *(pout+i-2)*0.07 + *(pout+i+1)*0.18 + *(pout+i+2)*0.07;
                     line_buffer[i] = ptr->spect_LPFcoeff * 8 * sqrtf(fabsf(avg)) + (1 - ptr->spect_LPFcoeff);
-                    line_buffer[i] = _colorMap(line_buffer[i], ptr->spect_wf_colortemp);
-                    //Serial.println(line_buffer[i]);    
+                    line_buffer[i] = _colorMap_lut(line_buffer[i], ptr->spect_wf_colortemp);
+                    //Serial.println(line_buffer[i]);
                 }
-                      break;                  
-              case 2: avg = line_buffer[i] = _colorMap(fabsf(*(pout+i)) * 1.9 *  ptr->spect_wf_scale, ptr->spect_wf_colortemp);
                       break;
-              case 3: avg = line_buffer[i] = _colorMap(fabsf(*(pout+i)) * 0.4 *  ptr->spect_wf_scale, ptr->spect_wf_colortemp);
+              case 2: avg = line_buffer[i] = _colorMap_lut(fabsf(*(pout+i)) * 1.9 *  ptr->spect_wf_scale, ptr->spect_wf_colortemp);
                       break;
-              case 4: avg = line_buffer[i] = _colorMap(16000 - fabsf(*(pout+i)), ptr->spect_wf_colortemp) * ptr->spect_wf_scale;
+              case 3: avg = line_buffer[i] = _colorMap_lut(fabsf(*(pout+i)) * 0.4 *  ptr->spect_wf_scale, ptr->spect_wf_colortemp);
                       break;
-              case 6: avg = line_buffer[i] = _waterfall_color_update(*(pout+i), pix_min);//  * ptr->spect_sp_scale;  // test new waterfall colorization method
+              case 4: avg = line_buffer[i] = _colorMap_lut(16000 - fabsf(*(pout+i)), ptr->spect_wf_colortemp) * ptr->spect_wf_scale;
+                      break;
+              case 6: avg = line_buffer[i] = _wf_palette_lookup(*(pout+i), wf_lo, wf_k);   // was _waterfall_color_update(*(pout+i), pix_min)
                       break;
               case 5:
-             default: avg = line_buffer[i] = _colorMap(fabsf(*(pout+i)), ptr->spect_wf_colortemp);                          
-                      break; 
+             default: avg = line_buffer[i] = _colorMap_lut(fabsf(*(pout+i)), ptr->spect_wf_colortemp);
+                      break;
             };
 
             //DPRINTLN(tft.gradient( (uint16_t) pix_n16));
@@ -337,61 +629,103 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
             // Fc Blanking
             if (i >= (ptr->wf_sp_width/2)-blanking  && i <= (ptr->wf_sp_width/2)+blanking+1)
             {
-                line_buffer[i] = myBLACK;    
+                line_buffer[i] = myBLACK;
                 if (i == ((ptr->wf_sp_width)/2) + 1)
                     line_buffer[i] = myLT_GREY;  // draw center Fc line in waterfall
             }
-*/            
+*/
         }   // Done with copying the FFT output array
 
-        for (i = 2; i < (ptr->wf_sp_width-1); i++)
-        {
-            if (i == 2)   // start with 2 because the end values contain special purpose or used for averaging
-            {
-                pix_min = pixelnew[2];  // start off each set with a sample value to compare others with
-            }
-            else
-            {
-                if (pixelnew[i] < pix_min)
-                    pix_min = pixelnew[i];
-            }
-        }
+        // Auto reference for the next trace and waterfall line.  Was the minimum pixel of this update which jumped around
+        // with every deep null.  The tracked floor moves only when most of the bins do.
+        pix_min = (int16_t) floorf(spect_noise_floor) - SPECT_NF_MARGIN;
+        sp_state = SP_WF_MOVE1;
+        break;
+      }
         // ***************************************************************************************************
         //
-        //      UPDATE WATERFALL 
-        //      Takes a snapshot of the current window without the bottom row. Stores it in Layer 2 then brings it back beginning at the 2nd row. 
+        //      UPDATE WATERFALL
+        //      Takes a snapshot of the current window without the bottom row. Stores it in Layer 2 then brings it back beginning at the 2nd row.
         //      Then write new row data into the missing top row to get a scroll effect using display hardware, not the CPU.
         //      Documentation for BTE: BTE_move(int16_t SourceX, int16_t SourceY, int16_t Width, int16_t Height, int16_t DestX, int16_t DestY, uint8_t SourceLayer=0, uint8_t DestLayer=0, bool Transparent = false, uint8_t ROP=RA8875_BTEROP_SOURCE, bool Monochrome=false, bool ReverseDir = false);
+        //      Each block move is started here and polled for completion on the next passes.
+        //      spect_wf_scroll selects this 2 move method, a single in place move (RA8875) or a ring buffer (RA8876).
         //
         // ***************************************************************************************************
+      case SP_WF_MOVE1:
+        wf_scroll_work_us = 0;
         #ifdef USE_RA8875
+            if (spect_wf_scroll == WF_SCROLL_SINGLE)
+            {
+                // Move the block 1 row down on Layer 1 in 1 pass.  The rows overlap so the move has to run bottom up (ReverseDir)
+                // and in that direction the controller takes the bottom right corner of the source and destination.
+                tft.BTE_move(ptr->l_graph_edge+ptr->wf_sp_width, ptr->wf_top_line+ptr->wf_height-4, ptr->wf_sp_width, ptr->wf_height-4, 
+                        ptr->l_graph_edge+ptr->wf_sp_width, ptr->wf_top_line+ptr->wf_height-3, 1, 1, false, RA8875_BTEROP_SOURCE, false, true);
+                sp_state = SP_WF_WAIT2;     // No 2nd move
+                break;
+            }
             tft.BTE_move(ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, ptr->wf_height-4, ptr->l_graph_edge+1, ptr->wf_top_line+2, 1, 2);  // Layer 1 to Layer 2
-            while (tft.readStatus());  // Make sure it is done.  Memory moves can take time.
+        #else   // RA8876
+            if (spect_wf_scroll == WF_SCROLL_RING)
+            {
+                // Write only the new row, into both copies of the ring on the hidden page.  The ring head moves up 1 row
+                // each line and the PIP1 window follows it, so the newest row is at the top of the window.  No block moves.
+                int16_t wf_rows = _wf_ring_rows();
+                if (--wf_ring_head < 0 || wf_ring_head >= wf_rows)
+                    wf_ring_head = wf_rows-1;
+                bool stamp = (waterfall_timestamp.check() == 1);   // a periodic time stamp mark
+                tft.canvasImageStartAddress(WF_RING_PAGE);
+                for (int16_t ring_y = wf_ring_head; ring_y < wf_rows*2; ring_y += wf_rows)
+                {
+                    tft.writeRect(ptr->l_graph_edge+1, ring_y, ptr->wf_sp_width, 1, (uint16_t*) &line_buffer);  // x start, y start, width, height, array of colors w x h
+                    if (stamp)
+                        tft.drawRect(ptr->l_graph_edge+1, ring_y, 20, 1, LIGHTGREY);
+                }
+                tft.canvasImageStartAddress(PAGE1_START_ADDR);
+                _wf_pip_reg16(RA8876_PWIULX+2, wf_ring_head);
+                sp_state = SP_WF_WAIT2;     // No block moves to start or wait for
+                break;
+            }
+            else
+            {
+                tft.canvasImageStartAddress(PAGE2_START_ADDR);
+                tft.boxPut(PAGE2_START_ADDR, ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, ptr->wf_bottom_line-2, ptr->l_graph_edge+1, ptr->wf_top_line+2);
+                tft.canvasImageStartAddress(PAGE1_START_ADDR);   // leave the normal drawing page selected between steps
+            }
+        #endif  // USE_RA8875
+        sp_state = SP_WF_WAIT1;
+        break;
+
+      case SP_WF_WAIT1:
+        if (!_sp_bte_busy())    // Memory moves can take time.
+            sp_state = SP_WF_MOVE2;
+        break;
 
-// 7-8ms to get to here            
+      case SP_WF_MOVE2:
+        #ifdef USE_RA8875
             // Move the block back on Layer 1 but place it 1 row down from the top
             tft.BTE_move(ptr->l_graph_edge+1, ptr->wf_top_line+2, ptr->wf_sp_width, ptr->wf_height-4, ptr->l_graph_edge+1, ptr->wf_top_line+2, 2);  // Move layer 2 up to Layer 1 (1 is assumed).  0 means use current layer.
-            while (tft.readStatus());   // Make sure it is done.  Memory moves can take time.        
-      
-// 15-16ms to get to here    The while() make no delays
-        #else   // RA8876  
-            tft.canvasImageStartAddress(PAGE2_START_ADDR);
-            tft.boxPut(PAGE2_START_ADDR, ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, ptr->wf_bottom_line-2, ptr->l_graph_edge+1, ptr->wf_top_line+2);                    
-            tft.check2dBusy();     
-            
+        #else   // RA8876
             tft.canvasImageStartAddress(PAGE1_START_ADDR);
             tft.boxGet(PAGE2_START_ADDR, ptr->l_graph_edge+1, ptr->wf_top_line+2, ptr->wf_sp_width, ptr->wf_bottom_line-1, ptr->l_graph_edge+1, ptr->wf_top_line+2);
-            tft.check2dBusy();              
         #endif  // USE_RA8875
-        
-        // draw a periodic time stamp line
-        if (waterfall_timestamp.check() == 1)
-            tft.drawRect(ptr->l_graph_edge+1, ptr->wf_top_line+2, 20, 1, LIGHTGREY);  // x start, y start, width, height, colors w x h           
-            //tft.drawFastHLine(ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, myLT_GREY);  // x start, y start, width, height, colors w x h           
-        else  // Draw the new line at the top
-            tft.writeRect(ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, 1, (uint16_t*) &line_buffer);  // x start, y start, width, height, array of colors w x h
+        sp_state = SP_WF_WAIT2;
+        break;
 
-//  16ms to get to here
+      case SP_WF_WAIT2:
+        if (_sp_bte_busy())     // Memory moves can take time.
+            break;
+        if (spect_wf_scroll != WF_SCROLL_RING)   // The ring already has the new line
+        {
+            // draw a periodic time stamp line
+            if (waterfall_timestamp.check() == 1)
+                tft.drawRect(ptr->l_graph_edge+1, ptr->wf_top_line+2, 20, 1, LIGHTGREY);  // x start, y start, width, height, colors w x h
+                //tft.drawFastHLine(ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, myLT_GREY);  // x start, y start, width, height, colors w x h
+            else  // Draw the new line at the top
+                tft.writeRect(ptr->l_graph_edge+1, ptr->wf_top_line+1, ptr->wf_sp_width, 1, (uint16_t*) &line_buffer);  // x start, y start, width, height, array of colors w x h
+        }
+        sp_state = SP_TRACE;
+        break;
 
 //--------------------------------  Spectrum Window ------------------------------------------
 //
@@ -401,22 +735,27 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
 //      Draw our image on canvas 2 which is not visible
 //
 // -------------------------------------------------------------------------------------------
+      case SP_TRACE:
+      {
+        pan         = sp_pan;       // Use the same pan and bin size the FFT data was captured with
+        fft_bin_sz  = sp_bin_sz;
+
         #ifdef USE_RA8875
-            tft.setActiveWindow(ptr->l_graph_edge+1, ptr->r_graph_edge-1, ptr->sp_top_line+2, ptr->sp_bottom_line-2); 
-            tft.writeTo(L2);         //L1, L2, CGRAM, PATTERN, CURSOR     
-        #else            
+            tft.setActiveWindow(ptr->l_graph_edge+1, ptr->r_graph_edge-1, ptr->sp_top_line+2, ptr->sp_bottom_line-2);
+            tft.writeTo(L2);         //L1, L2, CGRAM, PATTERN, CURSOR
+        #else
             // NOTE - setActiveWindow() function in the RA8876_t3 library is marked as protected: Can change it to public:
             // Instead we are using own copies for RA8876
-            // For RA8876 switch to hidden Page 2, draw our line and all label/info text as normal then at end, 
+            // For RA8876 switch to hidden Page 2, draw our line and all label/info text as normal then at end,
             // do a BTE mem copy from page 2 to page 1 for a flicker free, clean screen drawn fast.
             tft.canvasImageStartAddress(PAGE2_START_ADDR);
             // Blank the plot area and we will draw a new line, flicker free!
             setActiveWindow(ptr->l_graph_edge+1, ptr->r_graph_edge-1, ptr->sp_top_line+1, ptr->sp_bottom_line-1);
         #endif
-        
-        // Erase old spectrum window
-        tft.fillRect(ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width, ptr->sp_height-2, BLACK);
-        
+
+        spect_stats.draw_calls = 0;
+        spect_stats.spi_bytes_est  = 0;
+
         // Draw in filter bandwidth "shaded" area
         int8_t filt_side = 0;
         if (Offset == 1 || Offset == 0 || Offset == -1)
@@ -430,235 +769,325 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
         }
 
         // Draw the filter width shaded box.  Translucent would be better.  Correct for pan offset
-        tft.fillRect(ptr->l_graph_edge+ptr->wf_sp_width/2+2+((filterCenter/fft_bin_sz/2)*filt_side)-(filterBandwidth/fft_bin_sz/2/2)-pan, ptr->sp_top_line+1, filterBandwidth/fft_bin_sz/2, ptr->sp_height-2, myVERY_DARK_GREEN);
+        int16_t filt_x = ptr->l_graph_edge+SP_CENTER_PIX(ptr)+((filterCenter/fft_bin_sz/2)*filt_side)-(filterBandwidth/fft_bin_sz/2/2)-pan;
+        int16_t filt_w = filterBandwidth/fft_bin_sz/2;
+
+        // The trace is updated in place on layer 2 (page 2) column by column.  The background only has to be
+        // erased and redrawn when something other than the trace moves: filter, pan, pitch line, grid scale, mode, or
+        // layer 2 was disturbed (new frame drawn, pop up window).
+        static int16_t  old_filt_x      = 0;
+        static int16_t  old_filt_w      = 0;
+        static int32_t  old_Offset      = 0;
+        static float    old_trace_pan   = 0;
+        static int16_t  old_sp_scale    = 0;
+        static int16_t  old_bar_mode    = 0;
+        static int16_t  old_s           = 0;
+        bool            trace_full      = false;
+
+        if (spect_full_redraw || filt_x != old_filt_x || filt_w != old_filt_w || Offset != old_Offset || pan != old_trace_pan
+                || ptr->spect_sp_scale != old_sp_scale || ptr->spect_dot_bar_mode != old_bar_mode || s != old_s)
+        {
+            // Erase old spectrum window
+            _sp_fillRect(ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width, ptr->sp_height-2, BLACK);
+            _sp_fillRect(filt_x, ptr->sp_top_line+1, filt_w, ptr->sp_height-2, myVERY_DARK_GREEN);
+            for (int16_t n = 0; n < SCREEN_WIDTH+2; n++)
+            {
+                pixelold[n]     = 1;    // Mark every column empty so all of the new trace gets drawn
+                pixelold_bot[n] = 0;
+            }
+            old_filt_x          = filt_x;
+            old_filt_w          = filt_w;
+            old_Offset          = Offset;
+            old_trace_pan       = pan;
+            old_sp_scale        = ptr->spect_sp_scale;
+            old_bar_mode        = ptr->spect_dot_bar_mode;
+            old_s               = s;
+            spect_full_redraw   = false;
+            trace_full          = true;
+            spect_stats.full_redraws++;
+        }
+        trace_label_dirty = false;
+        trace_label_edge  = ptr->l_graph_edge+24;   // grid labels are printed left of this
+        int16_t trace_min_y = ptr->sp_top_line+1;   // the peak markers get a strip at the top the trace stays out of
+        if (spect_peak_markers)
+            trace_min_y += SPECT_PEAK_MARK_H;
 
         //---------------------------------------------------------------------------------------------------
         // Now draw the spectrum lines
         // --------------------------------------------------------------------------------------------------
-                
+
         // Average a few values to smooth the line a bit
         // Can likely replace this by trying different FFT.setNAverage values
-        float avg_pix2 = (pixelnew[i]+pixelnew[i+1])/2;     // avg of 2 bins            
+        i = ptr->wf_sp_width-1;     // last column
+        float avg_pix2 = (pixelnew[i]+pixelnew[i+1])/2;     // avg of 2 bins
         float avg_pix5 = (pixelnew[i-2]+pixelnew[i-1]+pixelnew[i]+pixelnew[i+1]+pixelnew[i+2])/5;   //avg of 5 bins
         if (fabsf(pixelnew[i]) > fabsf(avg_pix2) * 1.6f)    // compare to a small average to toss out wild spikes
-            pixelnew[i] = (int16_t) avg_pix5;               // average it out over a wider segment to patch the hole   
+            pixelnew[i] = (int16_t) avg_pix5;               // average it out over a wider segment to patch the hole
 
         //Serial.print("pix min =");DPRINTLN(pix_min);
-   
-// 19 - 20ms to get to here.
 
-        for (i = 2; i < (ptr->wf_sp_width-1); i++) 
-        {       
-// Temp commented out for fixed offset coding - May not be needed anymore       
+        for (i = 2; i < (ptr->wf_sp_width-1); i++)
+        {
+// Temp commented out for fixed offset coding - May not be needed anymore
 //            if (i >= (ptr->wf_sp_width/2)-blanking-1 && i <= (ptr->wf_sp_width/2)+blanking+1)
-//                pixelnew[i] = -200; 
+//                pixelnew[i] = -200;
 
             //#define DBG_SPECTRUM_SCALE
             //#define DBG_SPECTRUM_PIXEL
             //#define DBG_SPECTRUM_WINDOWLIMITS
-            
+
             #ifdef DBG_SPECTRUM_PIXEL
            DPRINT(" raw =");
            DPRINT(pixelnew[i],DEC);
             #endif
-            
-            // limit the upper and lower dB level to between these ranges (set scale) (User Setting)  Can be limited further by window heights   
-            //spectrum_scale_maxdB = 1;    // Scale most zoomed in. This is +10dB above the spectrum floor value.   That value is adjustables and is our refence point set to the bottom line.  
+
+            // limit the upper and lower dB level to between these ranges (set scale) (User Setting)  Can be limited further by window heights
+            //spectrum_scale_maxdB = 1;    // Scale most zoomed in. This is +10dB above the spectrum floor value.   That value is adjustables and is our refence point set to the bottom line.
                                             // Forms the top range of values that line up with the top of our "window" on the FFT data set value range, typiclly -150 to -0dBm possible.
-            //spectrum_scale_mindB = 80;    // Scale most zoomed out. This is +80 dB relative to the spectrum_floor so teh top end of our window.  Typically -150 to -0dBm possible range of signal.             
+            //spectrum_scale_mindB = 80;    // Scale most zoomed out. This is +80 dB relative to the spectrum_floor so teh top end of our window.  Typically -150 to -0dBm possible range of signal.
             // range limit our settings. This number is added to the spectrum floor.  The pixel value will be plotted where ever it lands as along as it is in the window.
 
             #ifdef DBG_SPECTRUM_SCALE
-           DPRINT("   SC_ORG=");DPRINT(ptr->spect_sp_scale);                  
+           DPRINT("   SC_ORG=");DPRINT(ptr->spect_sp_scale);
             #endif
-        
+
             ptr->spect_sp_scale = constrain(ptr->spect_sp_scale, spectrum_scale_maxdB, spectrum_scale_mindB);
 
             #ifdef DBG_SPECTRUM_SCALE
-           DPRINT("   SC_LIM=");DPRINT(ptr->spect_sp_scale);                  
+           DPRINT("   SC_LIM=");DPRINT(ptr->spect_sp_scale);
             #endif
-                
+
             #ifdef DBG_SPECTRUM_SCALE
            DPRINT("   SC_HT=");DPRINT(ptr->spect_sp_scale);
            DPRINT("   HT=");DPRINT(ptr->sp_height-4);
-           DPRINT("   SC_FLR=");DPRINT(ptr->spect_floor);                  
-            #endif       
-            
-            // Invert the sign since the display is also inverted, Increasing value = weaker signal strength, they are now going the same direction.  
+           DPRINT("   SC_FLR=");DPRINT(ptr->spect_floor);
+            #endif
+
+            // Invert the sign since the display is also inverted, Increasing value = weaker signal strength, they are now going the same direction.
             // Small value = bigger signal, closer to 0 on the display coordinates
-            pixelnew[i] = (int16_t) fabsf(pixelnew[i]);   
-            
-            // We are plotting our pixel in the window if it lands between the bottom line and top lines        
+            pixelnew[i] = (int16_t) fabsf(pixelnew[i]);
+
+            // We are plotting our pixel in the window if it lands between the bottom line and top lines
             // set the grass floor to just above the bottom line.  These are the weakest signals. Typically -90 coming out of the FFT right now
             // Offset the pixel position relative to the bottom of the window
-            pixelnew[i] +=  ptr->spect_floor;      
+            pixelnew[i] +=  ptr->spect_floor;
 
             //#if defined (DBG_SPECTRUM_PIXEL) || defined (DBG_SPECTRUM_WINDOWLIMITS)
             //Serial.print("  NF  pix =");DPRINTLN(pixelnew[i],DEC);
             //#endif
 
-            pixelnew[i] = map(pixelnew[i], fabsf(pix_min), fabsf(ptr->spect_sp_scale), ptr->sp_bottom_line, ptr->sp_top_line); 
-            
-            #ifdef DBG_SPECTRUM_WINDOWLIMITS 
+            pixelnew[i] = map(pixelnew[i], fabsf(pix_min), fabsf(ptr->spect_sp_scale), ptr->sp_bottom_line, ptr->sp_top_line);
+
+            #ifdef DBG_SPECTRUM_WINDOWLIMITS
             //DPRINT("  win-ht:");DPRINT(ptr->sp_height-4);
            DPRINT("  top line=");DPRINT(ptr->sp_top_line+2);
             #endif
-            
+
             //#if defined (DBG_SPECTRUM_PIXEL) || defined (DBG_SPECTRUM_WINDOWLIMITS)
             //DPRINT("  MAP pix =");DPRINTLN(pixelnew[i],DEC);
             //#endif
 
-            #ifdef DBG_SPECTRUM_WINDOWLIMITS 
+            #ifdef DBG_SPECTRUM_WINDOWLIMITS
            DPRINT("  bottom line=");DPRINT(ptr->sp_bottom_line-2);
             #endif
 
             //#define DBG_SHOW_OVR
-            
-            if (pixelnew[i] < ptr->sp_top_line+1)        
+
+            if (pixelnew[i] < trace_min_y)
             {
-                #if defined(DBG_SPECTRUM_WINDOWLIMITS) || defined(DBG_SPECTRUM_PIXEL) || defined(DBG_SPECTRUM_SCALE) || defined(DBG_SHOW_OVR) 
+                #if defined(DBG_SPECTRUM_WINDOWLIMITS) || defined(DBG_SPECTRUM_PIXEL) || defined(DBG_SPECTRUM_SCALE) || defined(DBG_SHOW_OVR)
                DPRINT(" !!OVR!! = ");   DPRINTLN(pixelnew[i] - ptr->sp_top_line+2,0);
                 #endif
-                pixelnew[i] = ptr->sp_top_line+1;
+                pixelnew[i] = trace_min_y;
 
             }
 
-            if (pixelnew[i] > ptr->sp_bottom_line-1)        
-            { 
+            if (pixelnew[i] > ptr->sp_bottom_line-1)
+            {
                 #if defined(DBG_SPECTRUM_WINDOWLIMITS) || defined(DBG_SPECTRUM_PIXEL) || defined(DBG_SPECTRUM_SCALE) || defined(DBG_SHOW_OVR)
                DPRINT(" !!UNDER!! = "); DPRINTLN(pixelnew[i] - ptr->sp_top_line+2,0);
                 #endif
                 pixelnew[i] = ptr->sp_bottom_line-1;
-            }          
-            
+            }
+
             pix_n16 = pixelnew[i];  // convert float to uint16_t to match the draw functions type
-            pix_o16 = pixelold[i];
-   
+
 //
 //------------------------ Code below is writing only in the active spectrum window ----------------------
 //                Limit access to the spectrum box to control misbehaved pixel and bar draws
 //
+            int16_t trace_top = 1;   // rows of this column the trace covers this time.  Empty if top > bottom
+            int16_t trace_bot = 0;
 
 // TEMP commented out for fixed offset coding tests
 //            if (i < (ptr->wf_sp_width/2)-5 || i > (ptr->wf_sp_width/2) + 5)   // blank the DC carrier noise at Fc
 //            {
-                if ((i < ptr->wf_sp_width-2) && (pix_n16 > ptr->sp_top_line+2) && (pix_n16 < ptr->sp_bottom_line-2)  ) // will blank out the center spike
-                {   
-                    if (ptr->spect_dot_bar_mode == 0)   // BAR Mode 
+                if ((i < ptr->wf_sp_width-2) && (pix_n16 > trace_min_y+1) && (pix_n16 < ptr->sp_bottom_line-2)  ) // will blank out the center spike
+                {
+                    if (ptr->spect_dot_bar_mode == 0)   // BAR Mode
                     {
-                        if (pix_o16 != pix_n16) 
-                        {                          
-                            if (pix_n16 > ptr->sp_top_line && pix_n16 < ptr->sp_bottom_line-1)
-                            {
-                                //common way: draw bars                                                                        
-                                tft.drawFastVLine(ptr->l_graph_edge+i, pix_n16, ptr->sp_bottom_line-pix_n16, YELLOW); //BLACK);                             
-                                pixelold[i] = pixelnew[i];
-                            }
-                        }
+                        // common way: draw bars from the pixel down to the bottom of the window
+                        trace_top = pix_n16;
+                        trace_bot = ptr->sp_bottom_line-2;
                     }
                     else  // was DOT mode, now LINE mode
-                    {   
-                        // This will be drawn on Canvas 2 if this is a RA8876, layer 2 if a RA8875                               
-                        tft.drawLine(ptr->l_graph_edge+i, pixelnew[i-1], ptr->l_graph_edge+i, pixelnew[i], YELLOW);
-                        pixelold[i] = pixelnew[i]; 
+                    {
+                        // Vertical line from the previous column's pixel to this one
+                        int16_t pix_prev = (i > 2) ? pixelnew[i-1] : pix_n16;
+                        trace_top = (pix_prev < pix_n16) ? pix_prev : pix_n16;
+                        trace_bot = (pix_prev < pix_n16) ? pix_n16  : pix_prev;
                     }
                 }
 //            }
+            // This will be drawn on Canvas 2 if this is a RA8876, layer 2 if a RA8875.  Only the difference from last time is drawn.
+            uint16_t bg = (ptr->l_graph_edge+i >= filt_x && ptr->l_graph_edge+i < filt_x+filt_w) ? myVERY_DARK_GREEN : BLACK;
+            _sp_trace_column(ptr->l_graph_edge+i, pixelold[i], pixelold_bot[i], trace_top, trace_bot, bg);
+            pixelold[i]     = trace_top;
+            pixelold_bot[i] = trace_bot;
         } // end of spectrum pixel plotting
+        _sp_trace_flush();
+        if (spect_peak_markers)
+            _sp_draw_peak_markers(ptr, filt_x, filt_w);
 
-// 36-44ms to get to here
-
-        // Draw Grid Lines  
+        // Draw Grid Lines
         //if (i == (ptr->wf_sp_width/2))  // Just draw once per update cycle
         //{
-        // draw a grid line for XX dB level             
+        // draw a grid line for XX dB level
             tft.setTextColor(LIGHTGREY, BLACK);
             tft.setFont(Arial_10);
-            
+
             int grid_step = ptr->spect_sp_scale;
             for (int16_t j = grid_step; j < ptr->sp_height-10; j+=grid_step)
-            {        
+            {
                 //if (pix_n16 > ptr->sp_top_line+j+2 && pix_n16 < ptr->sp_bottom_line-2)
-                //{    
+                //{
                     // draw bottom most grid line
                     tft.drawFastHLine(ptr->l_graph_edge+24, ptr->sp_bottom_line-j,   ptr->wf_sp_width-24,    LIGHTGREY); // GREEN);
-                    // write the scale value for the grid line
-                    tft.setCursor(ptr->l_graph_edge+5, ptr->sp_bottom_line-j-5);
-                    tft.print(j); 
+                    spect_stats.draw_calls++;
+                    spect_stats.spi_bytes_est += SP_BYTES_PER_CMD;
+                    // write the scale value for the grid line.  Text is slow so only when the trace touched it.
+                    if (trace_full || trace_label_dirty)
+                    {
+                        tft.setCursor(ptr->l_graph_edge+5, ptr->sp_bottom_line-j-5);
+                        tft.print(j);
+                        spect_stats.draw_calls++;
+                        spect_stats.spi_bytes_est += SP_BYTES_PER_CHAR * ((j > 9) ? 2 : 1);
+                    }
                 //}
             }
-            
+
             // redraw the pitch line if in CW modes (Offset not 0).  Offset is in HZ so corect for current fft bin size
             if (Offset < -1 || Offset > 1)  // only draw for CW modes
             {
-                tft.drawFastVLine(ptr->l_graph_edge+ptr->wf_sp_width/2+2+(Offset/fft_bin_sz/2)-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
-                tft.drawFastVLine(ptr->l_graph_edge+ptr->wf_sp_width/2+3+(Offset/fft_bin_sz/2)-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
+                tft.drawFastVLine(ptr->l_graph_edge+SP_CENTER_PIX(ptr)+(Offset/fft_bin_sz/2)-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
+                tft.drawFastVLine(ptr->l_graph_edge+SP_CENTER_PIX(ptr)+1+(Offset/fft_bin_sz/2)-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
+                spect_stats.draw_calls += 2;
+                spect_stats.spi_bytes_est += SP_BYTES_PER_CMD*2;
             }
             else // redraw the center line
-            {   
-                tft.drawFastVLine(ptr->l_graph_edge+ptr->wf_sp_width/2+2-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
-                tft.drawFastVLine(ptr->l_graph_edge+ptr->wf_sp_width/2+3-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
+            {
+                tft.drawFastVLine(ptr->l_graph_edge+SP_CENTER_PIX(ptr)-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
+                tft.drawFastVLine(ptr->l_graph_edge+SP_CENTER_PIX(ptr)+1-pan, ptr->sp_top_line+1, ptr->sp_height, RED);
+                spect_stats.draw_calls += 2;
+                spect_stats.spi_bytes_est += SP_BYTES_PER_CMD*2;
             }
         //}
+
+        // Put the normal drawing layer (page) and window back before returning to the main loop
+        #ifdef USE_RA8875
+            tft.writeTo(L1);         //L1, L2, CGRAM, PATTERN, CURSOR
+            tft.setActiveWindow();
+        #else
+            tft.canvasImageStartAddress(PAGE1_START_ADDR);
+            setActiveWindow_default();
+        #endif
+        sp_state = SP_BLIT;
+        break;
+      }
+
+      case SP_BLIT:
+        #ifdef USE_RA8875
+            // Use BTE_Move to copy our fresh drawn spectrum form layer 2 to Layer 1
+            tft.BTE_move(ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width, ptr->sp_height-2, ptr->l_graph_edge+1, ptr->sp_top_line+1, 2);  // Move layer 2 up to Layer 1 (1 is assumed).  0 means use current layer.
+        #else
+            // BTE block copy it to page 1 spectrum window area. No flicker this way, no artifacts since we clear the window each time.
+            tft.canvasImageStartAddress(PAGE2_START_ADDR);
+            tft.boxGet(PAGE2_START_ADDR, ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width, ptr->sp_bottom_line-1, ptr->l_graph_edge+1, ptr->sp_top_line+1);
+            tft.canvasImageStartAddress(PAGE1_START_ADDR);
+        #endif
+        spect_stats.draw_calls++;
+        spect_stats.spi_bytes_est += SP_BYTES_PER_CMD;
+
+        //#define DBG_SPECTRUM_STATS
+        #ifdef DBG_SPECTRUM_STATS
+        DPRINT(F("Spectrum draw calls=")); DPRINT(spect_stats.draw_calls);
+        DPRINT(F("  SPI bytes (est)=")); DPRINT(spect_stats.spi_bytes_est);
+        DPRINT(F("  Full redraws=")); DPRINTLN(spect_stats.full_redraws);
+        #endif
+        sp_state = SP_BLIT_WAIT;
+        break;
+
+      case SP_BLIT_WAIT:
+        if (!_sp_bte_busy())    // Memory moves can take time.
+            sp_state = SP_LABELS;
+        break;
+
 //--------------------------------------------------------------------------------------------------------------------
 //
 //      Drawing work is done, now update the information text
 //
 //--------------------------------------------------------------------------------------------------------------------
-        // Update graph scale, ref level, power and freq
-        tft.setTextColor(LIGHTGREY, BLACK);
-        tft.setFont(Arial_12);
-
-// 39-54ms to get to here.  45-51 more typical
-
- //       fft_pk_bin = _find_FFT_Max(L_EDGE+2, L_EDGE+ptr->wf_sp_width-2, fft_sz);   // get new frequency and power values for strongest signal 
+      case SP_LABELS:
+      {
+        pan         = sp_pan;
+        fft_bin_sz  = sp_bin_sz;
 
         uint32_t _VFO_;   // Get active VFO frequency
         //if (bandmem[curr_band].VFO_AB_Active == VFO_A)
         if (VFOA_YES)
             _VFO_ = VfoA;
-        else    
+        else
             _VFO_ = VfoB;
- 
+
         // Calculate and print the power of the strongest signal if possible
         // Start by getting the highest power within a period of time
         if (fftMaxPower > fftPower_pk_last)
-        { 
+        {
             fftPower_pk_last = fftMaxPower;
         }
-                            
+
         if (fftFreq_timestamp.check() == 1)
         {
             fftPower_pk_last = -200;  // reset the timer since we have new good data
             //Serial.println("Reset");
         }
-//  The next 4 screen updates take 19-20ms.  Not likely worth it so leaving these commetned out.  
+//  The next 4 screen updates take 19-20ms.  Not likely worth it so leaving these commetned out.
 //   Total spectrum time reduces to 60ms from 80ms
-//time_spectrum = millis();              
-/*        // Calculate and print the frequency of the strongest signal if possible 
-        //DPRINT("Freq=");DPRINTLN(fftFrequency, 3); 
+//time_spectrum = millis();
+/*        // Calculate and print the frequency of the strongest signal if possible
+        //DPRINT("Freq=");DPRINTLN(fftFrequency, 3);
         //tft.fillRect(ptr->l_graph_edge+109,    ptr->sp_txt_row+30, 140, 13, BLACK);
         tft.setCursor(ptr->l_graph_edge+110,  ptr->sp_txt_row+30);
-        tft.print("F: "); 
+        tft.print("F: ");
         tft.setCursor(ptr->l_graph_edge+126,  ptr->sp_txt_row+30);
         float pk_temp = (2 * (fft_bin_sz * (fft_pk_bin + pan)));   // relate the peak bin to the center bin
         freq_peak = _VFO_ + pk_temp;
         tft.print(_formatFreq(freq_peak));
-        
-        // Write the Scale value 
+
+        // Write the Scale value
         tft.setCursor(ptr->l_graph_edge+(ptr->wf_sp_width/2)+50, ptr->sp_txt_row+30);
-        tft.print("S:   "); // actual value is updated elsewhere   
-        //tft.fillRect( ptr->l_graph_edge+(ptr->wf_sp_width/2)+64, ptr->sp_txt_row+30, 32, 13, BLACK);       
+        tft.print("S:   "); // actual value is updated elsewhere
+        //tft.fillRect( ptr->l_graph_edge+(ptr->wf_sp_width/2)+64, ptr->sp_txt_row+30, 32, 13, BLACK);
         tft.setCursor(ptr->l_graph_edge+(ptr->wf_sp_width/2)+64, ptr->sp_txt_row+30);
-        tft.print(ptr->spect_sp_scale);          
+        tft.print(ptr->spect_sp_scale);
         if (spect_scale_last != ptr->spect_sp_scale)
-        {      
+        {
             spect_scale_last = ptr->spect_sp_scale;   // update memory
         }
-        
+
         // Write the Reference Level to top line area
         tft.setCursor(ptr->l_graph_edge+(ptr->wf_sp_width/2)+100, ptr->sp_txt_row+30);
-        tft.print("R:   ");  // actual value is updated elsewhere            
+        tft.print("R:   ");  // actual value is updated elsewhere
         //tft.fillRect( ptr->l_graph_edge+(ptr->wf_sp_width/2)+114, ptr->sp_txt_row+30, 32, 13, BLACK);
         tft.setCursor(ptr->l_graph_edge+(ptr->wf_sp_width/2)+114, ptr->sp_txt_row+30);
         tft.print(ptr-> spect_floor);
@@ -666,82 +1095,80 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
         //if (spect_ref_last != ptr->spect_floor)
         //{
             //spect_ref_last = ptr->spect_floor;   // update memory
-        //}    
-            
-        // Write the dB range of the window 
+        //}
+
+        // Write the dB range of the window
         tft.setTextColor(myLT_GREY, myBLACK);
         tft.setFont(Arial_10);
         tft.setCursor(ptr->r_graph_edge-50, ptr->sp_top_line+8);
         tft.print("H:   ");  // actual value is updated elsewhere
-        tft.setCursor(ptr->r_graph_edge-38, ptr->sp_top_line+8); 
+        tft.setCursor(ptr->r_graph_edge-38, ptr->sp_top_line+8);
         tft.print(ptr->sp_height);
 */
         // Reset spectrum screen blanking timeout
         spectrum_clear.reset();
-    
-//Serial.println(millis()-time_spectrum);
-// 19-21ms from fft_pk_bin to here.
-
-        #ifdef USE_RA8875
-            // Use BTE_Move to copy our fresh drawn spectrum form layer 2 to Layer 1
-            tft.writeTo(L1);         //L1, L2, CGRAM, PATTERN, CURSOR
-            tft.BTE_move(ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width, ptr->sp_height-2, ptr->l_graph_edge+1, ptr->sp_top_line+1, 2);  // Move layer 2 up to Layer 1 (1 is assumed).  0 means use current layer.            
-            while (tft.readStatus());   // Make sure it is done.  Memory moves can take time.
-            tft.setActiveWindow();
-        #else
-            // BTE block copy it to page 1 spectrum window area. No flicker this way, no artifacts since we clear the window each time.            
-            tft.boxGet(PAGE2_START_ADDR, ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width, ptr->sp_bottom_line-1, ptr->l_graph_edge+1, ptr->sp_top_line+1);
-            tft.check2dBusy();            
-            tft.canvasImageStartAddress(PAGE1_START_ADDR);
-            setActiveWindow_default();
-        #endif
-
-
-// 27-28ms from fft_pk_bin to here.
 
-//
-//------------------------ Code above is writing only in the active spectrum window ----------------------
 //
 //-----------------------   This part onward is outside the active spectrum window and al ------------------------------
 //
-        // Update the span labels with current VFO frequencies    
-        tft.setTextColor(LIGHTGREY, BLACK);
-        tft.setFont(Arial_12);
-
+        // Update the span labels with current VFO frequencies
         static uint32_t old_VFO_ = 0;
 
-        if (old_VFO_ != _VFO_ || old_fft_sz != fft_sz || old_pan != pan)
+        if (old_VFO_ != _VFO_ || old_fft_sz != fft_sz || old_pan != pan || old_fft_bin_sz != fft_bin_sz)
         {
+            tft.setTextColor(LIGHTGREY, BLACK);
+            tft.setFont(Arial_12);
             float pan_freq = pan*fft_bin_sz*2;
             tft.fillRect( ptr->l_graph_edge, ptr->sp_txt_row, 110, 13, BLACK);
             tft.setCursor(ptr->l_graph_edge, ptr->sp_txt_row);
             tft.print(_formatFreq((uint32_t) _VFO_ - pan_freq -(ptr->wf_sp_width*fft_bin_sz)));       // Write left side of graph Freq
-            
+
             tft.fillRect( ptr->c_graph-60, ptr->sp_txt_row, 110, 13, BLACK);
             tft.setCursor(ptr->c_graph-60, ptr->sp_txt_row);
-            tft.print(_formatFreq((uint32_t) _VFO_ + pan_freq));   // Write center of graph Freq   
-            
+            tft.print(_formatFreq((uint32_t) _VFO_ + pan_freq));   // Write center of graph Freq
+
             tft.fillRect( ptr->r_graph_edge - 112, ptr->sp_txt_row, 110, 13, BLACK);
             tft.setCursor(ptr->r_graph_edge - 112, ptr->sp_txt_row);
             tft.print(_formatFreq((uint32_t) _VFO_ + pan_freq + (ptr->wf_sp_width*fft_bin_sz)));  // Write right side of graph Freq
-            
+
             // Update our change detector vars
             old_VFO_ = _VFO_;           // save to minimize updates for no reason.
             old_fft_sz = fft_sz;    // used to update the spectrum scale frequency labels when the FFT size changes and VFO does not
             old_pan = pan;          // update when the pan control changes
+            old_fft_bin_sz = fft_bin_sz;    // update when the span mode changes
         }
-    }                
-    else      // Clear stale data
+        sp_state = SP_IDLE;
+        break;
+      }
+
+      default:
+        sp_state = SP_IDLE;
+        break;
+    }
+
+    // Track the worst case time for each step
+    step_start = micros() - step_start;
+
+    // Waterfall scroll time.  Adds up the time inside the scroll steps, the drawing and every busy poll, not the main
+    // loop time between them.  A block move running while loop() does other work is not counted.
+    if (step >= SP_WF_MOVE1 && step <= SP_WF_WAIT2)
     {
-        if (spectrum_clear.check() == 1)      // Spectrum Screen blanking timer
+        wf_scroll_work_us += step_start;
+        if (sp_state == SP_TRACE)   // the new line is on screen
         {
-           DPRINTLN(F("*** Cleared Screen, no data to Draw! ***"));
-            //tft.fillRect(ptr->l_graph_edge+1, ptr->sp_top_line+1, ptr->wf_sp_width-2, ptr->sp_height-2, myBLACK);
-            //tft.drawFastVLine(ptr->l_graph_edge+ptr->wf_sp_width/2+1, ptr->sp_top_line+1, ptr->sp_height, myLT_GREY);
+            spect_wf_scroll_us = wf_scroll_work_us;
+            if (spect_wf_scroll_us > spect_wf_scroll_max_us[spect_wf_scroll])
+                spect_wf_scroll_max_us[spect_wf_scroll] = spect_wf_scroll_us;
         }
     }
-
-// 0ms to get to here from the  end of spectrum BTW block move
+    if (step_start > spect_step_max_us[step])
+    {
+        spect_step_max_us[step] = step_start;
+        //#define DBG_SPECTRUM_TIMING
+        #ifdef DBG_SPECTRUM_TIMING
+        DPRINT(F("Spectrum step ")); DPRINT(step); DPRINT(F(" max us=")); DPRINTLN(step_start);
+        #endif
+    }
 
     return freq_peak;  // freq_peak;  // for use by the main program for more accurate touch tuning
 }
@@ -757,6 +1184,7 @@ int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB,
 //
 FLASHMEM void drawSpectrumFrame(uint8_t s)
 {
+    Spectrum_Restart();         // The spectrum window is being cleared, start the frame and trace over
     // See Spectrum_Parm_Generator() below for details on Global values requires and how the woindows variables are used.
 
     // s = The PRESET index into Sp_Parms_Def[] structure for windows location and size params.  Specify the default layout option for spectrum window placement and size.
@@ -769,40 +1197,10 @@ FLASHMEM void drawSpectrumFrame(uint8_t s)
 
     //Serial.print("fft_axis=");Serial.println(fft_axis);
 
-    // Choose our output type.  Can do dB, RMS or power
-    #ifdef FFT_4096
-        myFFT_4096.setXAxis(fft_axis);    // Set the FFT bin order to our needs
-        myFFT_4096.setOutputType(FFT_DBFS); // FFT_RMS or FFT_POWER or FFT_DBFS
-        // Uncomment one these to try other window functions
-        //  myFFT.windowFunction(NULL);
-        //  myFFT.windowFunction(AudioWindowBartlett4096);
-        //  myFFT.windowFunction(AudioWindowFlattop4096);
-        myFFT_4096.windowFunction(AudioWindowHanning4096);
-        // myFFT_4096.windowFunction(AudioWindowBlackmanHarris4096);
-        myFFT_4096.setNAverage(NAvg); // experiment with this value.  Too much causes a large time penalty
-    #endif
-    #ifdef FFT_2048
-        myFFT_2048.setXAxis(fft_axis);    // Set the FFT bin order to our needs
-        myFFT_2048.setOutputType(FFT_DBFS); // FFT_RMS or FFT_POWER or FFT_DBFS
-        // Uncomment one these to try other window functions
-        //  myFFT.windowFunction(NULL);
-        //  myFFT.windowFunction(AudioWindowBartlett2048);
-        //  myFFT.windowFunction(AudioWindowFlattop2048);
-        myFFT_2048.windowFunction(AudioWindowHanning2048);
-        //  myFFT_4096.windowFunction(AudioWindowBlackmanHarris2048);
-        myFFT_2048.setNAverage(NAvg); // experiment with this value.  Too much causes a large time penalty
-    #endif
-    #ifdef FFT_1024
-        myFFT_1024.setXAxis(fft_axis);    // Set the FFT bin order to our needs
-        myFFT_1024.setOutputType(FFT_DBFS); // FFT_RMS or FFT_POWER or FFT_DBFS
-        // Uncomment one these to try other window functions
-        //  myFFT.windowFunction(NULL);
-        //  myFFT.windowFunction(AudioWindowBartlett1024);
-        //  myFFT.windowFunction(AudioWindowFlattop1024);
-        myFFT_1024.windowFunction(AudioWindowHanning1024);
-        //  myFFT_4096.windowFunction(AudioWindowBlackmanHarris1024);
-        myFFT_1024.setNAverage(NAvg); // experiment with this value.  Too much causes a large time penalty
-    #endif
+    // Output is always dB (FFT_DBFS) with a Hanning window
+    myFFT.setXAxis(fft_axis);     // Set the FFT bin order to our needs
+    myFFT.setNAverage(NAvg);      // experiment with this value.  Too much causes a large time penalty
+    myFFT.setAverage(Sp_Parms_Def[s].spect_avg_mode, Sp_Parms_Def[s].spect_avg_tc);  // time averaging per bin, from the preset
 
     tft.fillRect(ptr->spect_x, ptr->spect_y, ptr->spect_width, ptr->spect_height, BLACK);  // x start, y start, width, height, array of colors w x h
     //tft.drawRect(ptr->spect_x, ptr->spect_y, ptr->spect_width, ptr->spect_height, myBLUE);  // x start, y start, width, height, array of colors w x h
@@ -820,6 +1218,7 @@ FLASHMEM void drawSpectrumFrame(uint8_t s)
     //The scroll region is over the same area
     tft.drawRect(ptr->l_graph_edge,    ptr->wf_top_line,    ptr->wf_sp_width+2,   ptr->wf_height,    LIGHTGREY);  // x start, y start, width, height, array of colors w x h
     tft.fillRect(ptr->l_graph_edge+1,  ptr->wf_top_line+1,  ptr->wf_sp_width,     ptr->wf_height-2,  BLACK);
+    _wf_ring_clear();
     // Set the scroll region for the watefall.  We only need to write 1 new top line and block shift the rest down 1.
     //tft.setScrollWindow(l_graph_edge, r_graph_edge, wf_top_line+1, wf_bottom_line-1);  //Specifies scrolling activity area   XL, XR, Ytop, Ybottom
   
@@ -830,7 +1229,7 @@ FLASHMEM void drawSpectrumFrame(uint8_t s)
     // Draw Tick marks and Span Labels
     tft.drawLine(ptr->l_graph_edge+1,                        ptr->sp_tick_row,      ptr->l_graph_edge+1,                        ptr->sp_tick_row-ptr->tick_height, LIGHTGREY);
     tft.drawLine(ptr->l_graph_edge+(ptr->wf_sp_width/4),     ptr->sp_tick_row,      ptr->l_graph_edge+(ptr->wf_sp_width/4),     ptr->sp_tick_row-ptr->tick_height, LIGHTGREY);
-    tft.drawLine(ptr->l_graph_edge+1+(ptr->wf_sp_width/2)+1, ptr->sp_tick_row,      ptr->l_graph_edge+1+(ptr->wf_sp_width/2)+1, ptr->sp_tick_row-ptr->tick_height, LIGHTGREY);
+    tft.drawLine(ptr->l_graph_edge+SP_CENTER_PIX(ptr), ptr->sp_tick_row,      ptr->l_graph_edge+SP_CENTER_PIX(ptr), ptr->sp_tick_row-ptr->tick_height, LIGHTGREY);
     tft.drawLine(ptr->l_graph_edge+((ptr->wf_sp_width/4)*3), ptr->sp_tick_row,      ptr->l_graph_edge+((ptr->wf_sp_width/4)*3), ptr->sp_tick_row-ptr->tick_height, LIGHTGREY);
     tft.drawLine(ptr->l_graph_edge+ptr->wf_sp_width-1,       ptr->sp_tick_row,      ptr->l_graph_edge+ptr->wf_sp_width-1,       ptr->sp_tick_row-ptr->tick_height, LIGHTGREY);
     
@@ -840,7 +1239,7 @@ FLASHMEM void drawSpectrumFrame(uint8_t s)
     // Draw the ticks on the bottom of Waterfall window also
     tft.drawLine(ptr->l_graph_edge+1,                         ptr->wf_bottom_line,   ptr->l_graph_edge+1,                        ptr->wf_tick_row, LIGHTGREY);
     tft.drawLine(ptr->l_graph_edge+(ptr->wf_sp_width/4),      ptr->wf_bottom_line,   ptr->l_graph_edge+(ptr->wf_sp_width/4),     ptr->wf_tick_row, LIGHTGREY);
-    tft.drawLine(ptr->l_graph_edge+1+(ptr->wf_sp_width/2)+1,  ptr->wf_bottom_line,   ptr->l_graph_edge+1+(ptr->wf_sp_width/2)+1, ptr->wf_tick_row, LIGHTGREY);
+    tft.drawLine(ptr->l_graph_edge+SP_CENTER_PIX(ptr),  ptr->wf_bottom_line,   ptr->l_graph_edge+SP_CENTER_PIX(ptr), ptr->wf_tick_row, LIGHTGREY);
     tft.drawLine(ptr->l_graph_edge+(ptr->wf_sp_width/4)*3,    ptr->wf_bottom_line,   ptr->l_graph_edge+(ptr->wf_sp_width/4)*3,   ptr->wf_tick_row, LIGHTGREY);
     tft.drawLine(ptr->l_graph_edge+ptr->wf_sp_width-1,        ptr->wf_bottom_line,   ptr->l_graph_edge+ptr->wf_sp_width-1,       ptr->wf_tick_row, LIGHTGREY);    
 }
@@ -973,6 +1372,8 @@ void Spectrum_Parm_Generator(int16_t parm_set, int16_t preset, uint16_t fft_binc
     ptr->spect_sp_scale      = c_ptr->spectrum_sp_scale;
     ptr->spect_floor         = c_ptr->spectrum_floor;
     ptr->spect_wf_rate       = c_ptr->spectrum_wf_rate;
+    ptr->spect_avg_mode      = c_ptr->spectrum_avg_mode;
+    ptr->spect_avg_tc        = c_ptr->spectrum_avg_tc;
   
 // print out results to the serial terminal for manual copy into the default table.  This is 1 set of data only, for each run.  
 // Change the globals and run again for a new set
@@ -1011,7 +1412,9 @@ void Spectrum_Parm_Generator(int16_t parm_set, int16_t preset, uint16_t fft_binc
    DPRINT(ptr->spect_dot_bar_mode); DPRINT(",");
    DPRINT(ptr->spect_sp_scale); DPRINT(",");
    DPRINT(ptr->spect_floor); DPRINT(",");
-   DPRINT(ptr->spect_wf_rate); DPRINT("}");
+   DPRINT(ptr->spect_wf_rate); DPRINT(",");
+   DPRINT(ptr->spect_avg_mode); DPRINT(",");
+   DPRINT(ptr->spect_avg_tc); DPRINT("}");
 
    DPRINTLN(F("\nEnd of Spectrum Parameter Generator List"));
    DPRINT(F("Current Preset="));
@@ -1024,108 +1427,465 @@ void Spectrum_Parm_Generator(int16_t parm_set, int16_t preset, uint16_t fft_binc
    DPRINTLN(c_ptr->spectrum_wf_colortemp);
 }
 //
-//--------------------------------------------------  find_FFT_Max(min, max) ------------------------------------------------------------------------
-//
-// Return the estimated frequency and max power level, based on powers in FFT bins. -------------------------------------
-// Adapted from OpenAudio_ArduinoLibrary example FFTFrequencyMeter.ino by Bob Larkin, 2021
-  // Following from DerekR
-  // https://forum.pjrc.com/threads/36358-A-New-Accurate-FFT-Interpolator-for-Frequency-Estimation
-  // " 1) A record of length 1024 samples is windowed with a Hanning window
-  //   2) The magnitude spectrum is computed from the FFT, and the two (adjacent)
-  //      largest amplitude lines are found.  Let the largest be line L, and the
-  //      other be either L+1, of L-1.
-  //   3) Compute the ratio R of the amplitude of the two largest lines.
-  //   4) If the amplitude of L+1 is greater than L-1 then
-  //              f = (L + (2-R)/(1+R))*f_sample/1024
-  //        otherwise
-  //              f = (L - (2-R)/(1+R))*f_sample/1024  "
-  //
-int16_t _find_FFT_Max(uint16_t bin_min, uint16_t bin_max, uint16_t fft_sz)    // args for min and max bins to look at based on display width.
+//--------------------------------------------------  Spectrum trace drawing ------------------------------------------------------------------------
+//
+//   Each column of the trace covers rows top to bottom (a bar to the window bottom, or a line segment from the previous column).
+//   Compare with what was drawn there last time and only erase rows no longer covered and draw rows newly covered.
+//   Each of the 4 possible operations in a column is added to its own run.  When the next column has the exact same 
+//   operation the run gets 1 wider, otherwise it is drawn as 1 line or rectangle.
+//
+void _sp_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
-    float specMax = -200.0f;
-    uint16_t iiMax = 0;
-    int16_t f_peak = 0.0f;
-    uint16_t bin_center = (bin_max-bin_min)/2 + bin_min;
-//Serial.println("FFT_MAX CALL");
-    //sp_FFT.setOutputType(FFT_POWER);   // change to power, return it to FFT_DBFS at end
-
-    // Get pointer to data array of powers, float output[xxx];
-    // setAxis(fft_axis)  // Called in drawSpectrumFrame() to set the bin order to lowest frequency at 0 bin and highest at bin 1023
-    float *pPwr=NULL;
-    
-    // only 1 of these (fft_sz derived from global fft_size) is chosen to be used to display
-    #ifdef FFT_4096
-        #ifndef BETATEST
-            if (fft_sz == 4096) pPwr = myFFT_4096.getData();
-        #else
-            pPwr = fftOutput;
-        #endif
-    #endif
-    #ifdef FFT_2048
-        if (fft_sz == 2048) pPwr = myFFT_2048.getData();
-    #endif
-    #ifdef FFT_1024
-        if (fft_sz == 1024) pPwr = myFFT_1024.getData();   
-    #endif
-    // Find biggest bin
-    for(int ii=bin_min; ii<bin_max; ii++)  
-    {        
-        if (ii == bin_center -1)        
-            ii += 3;   // advance ii to skip the center few bins around our center frequency.
-
-//Serial.print("ii=");DPRINT(ii);DPRINT("  binval=");DPRINTLN(*(pPwr + ii));  
-        if (*(pPwr + ii) > specMax && *(pPwr + ii) < -1.0)   // filter out periodic blocks of 0 values 
-        { // Find highest peak of range
-          specMax = *(pPwr + ii);
-          iiMax = ii;         
+    tft.fillRect(x, y, w, h, color);
+    spect_stats.draw_calls++;
+    spect_stats.spi_bytes_est += SP_BYTES_PER_CMD;
+}
+
+void _sp_run_flush(struct Trace_Run *r)
+{
+    if (r->w == 0)
+        return;
+    if (r->w == 1)
+    {
+        tft.drawFastVLine(r->x, r->y0, r->y1 - r->y0 + 1, r->color);
+        spect_stats.draw_calls++;
+        spect_stats.spi_bytes_est += SP_BYTES_PER_CMD;
+    }
+    else
+        _sp_fillRect(r->x, r->y0, r->w, r->y1 - r->y0 + 1, r->color);
+    r->w = 0;
+}
+
+// Add rows y0 to y1 of column x to a run.  An empty segment (y0 > y1) ends the run.
+void _sp_run_add(struct Trace_Run *r, int16_t x, int16_t y0, int16_t y1, uint16_t color)
+{
+    if (y0 > y1)
+    {
+        _sp_run_flush(r);
+        return;
+    }
+    if (x < trace_label_edge)
+        trace_label_dirty = true;
+    if (r->w && r->x + r->w == x && r->y0 == y0 && r->y1 == y1 && r->color == color)
+    {
+        r->w++;
+        return;
+    }
+    _sp_run_flush(r);
+    r->x     = x;
+    r->w     = 1;
+    r->y0    = y0;
+    r->y1    = y1;
+    r->color = color;
+}
+
+// old_top/old_bot is what was drawn in column x last time, top/bot is the new trace.  Either can be empty (top > bottom).
+// bg is the background color of the column, black or the filter shading.
+void _sp_trace_column(int16_t x, int16_t old_top, int16_t old_bot, int16_t top, int16_t bot, uint16_t bg)
+{
+    if (old_top > old_bot)  // nothing there before, draw it all
+    {
+        _sp_run_add(&trace_run[0], x, 1, 0, bg);
+        _sp_run_add(&trace_run[1], x, 1, 0, bg);
+        _sp_run_add(&trace_run[2], x, top, bot, YELLOW);
+        _sp_run_add(&trace_run[3], x, 1, 0, YELLOW);
+    }
+    else if (top > bot)     // nothing to draw now, erase it all
+    {
+        _sp_run_add(&trace_run[0], x, old_top, old_bot, bg);
+        _sp_run_add(&trace_run[1], x, 1, 0, bg);
+        _sp_run_add(&trace_run[2], x, 1, 0, YELLOW);
+        _sp_run_add(&trace_run[3], x, 1, 0, YELLOW);
+    }
+    else
+    {
+        _sp_run_add(&trace_run[0], x, old_top, min(old_bot, top-1), bg);       // erase above the new trace
+        _sp_run_add(&trace_run[1], x, max(old_top, bot+1), old_bot, bg);       // erase below the new trace
+        _sp_run_add(&trace_run[2], x, top, min(bot, old_top-1), YELLOW);       // extend upward
+        _sp_run_add(&trace_run[3], x, max(top, old_bot+1), bot, YELLOW);       // extend downward
+    }
+}
+
+// Draw whatever runs are still pending at the end of the trace
+void _sp_trace_flush(void)
+{
+    for (int16_t n = 0; n < 4; n++)
+        _sp_run_flush(&trace_run[n]);
+}
+
+//
+//--------------------------------------------------  Span reduction ------------------------------------------------------------------------
+//
+//   Select how FFT bins are mapped to the graph width.  See SPAN_xxx in the header file.
+//
+void Spectrum_Set_Span(uint8_t mode)
+{
+    if (mode >= SPAN_NUM)
+        mode = SPAN_CROP;
+    spect_span_mode = mode;
+}
+
+//   Power sums are done in dB with a log add table so there is no expf() per bin or logf() per pixel.
+//   span_log_add[n] is 10*log10(1 + 10^(-d/10)) for d = n/SPAN_LOG_ADD_STEPS dB.  Past the end of the table it is < 0.003 dB.
+//
+#define SPAN_LOG_ADD_STEPS  8       // table entries per dB
+#define SPAN_LOG_ADD_SIZE   (32*SPAN_LOG_ADD_STEPS)
+static float span_log_add[SPAN_LOG_ADD_SIZE];
+
+COLD static void _span_log_add_init(void)
+{
+    for (int16_t n = 0; n < SPAN_LOG_ADD_SIZE; n++)
+        span_log_add[n] = 10.0f * log10f(1.0f + powf(10.0f, -(float) n / SPAN_LOG_ADD_STEPS / 10.0f));
+}
+
+// 10*log10(10^(a/10) + 10^(b/10)), a and b in dB.  Good to about 0.03 dB.
+inline float _span_log_add(float a, float b)
+{
+    float d = a - b;
+    if (d < 0.0f)
+    {
+        d = -d;
+        a = b;
+    }
+    int32_t n = (int32_t) (d * SPAN_LOG_ADD_STEPS + 0.5f);
+    return (n < SPAN_LOG_ADD_SIZE) ? a + span_log_add[n] : a;
+}
+
+//   Reduce nbins of FFT dB values down to npix values, 1 per pixel, in a single pass over the bins.  
+//   When nbins is not a multiple of npix, pixels get either floor or ceiling of nbins/npix bins so no bin is skipped or used twice.
+//      SPAN_FIT_MAX  - strongest bin in each group.  Keeps narrow carriers but lifts the noise floor a few dB.
+//      SPAN_FIT_MEAN - average power of the group (summed with _span_log_add(), less 10*log10(bins)).  True noise floor.
+//      SPAN_FIT_PEAK - mean power unless the strongest bin stands SPAN_PEAK_DB above the mean, then the peak is used.
+//   Bad data (NaN, Inf) is replaced with -200.  Values past npix are filled with -200 for the waterfall styles that read ahead.
+//
+HOT void _span_reduce(float *bins, uint16_t nbins, float *out, int16_t npix, uint8_t mode)
+{
+    static bool init = false;
+    uint16_t b = 0;
+    uint16_t b_end;
+    float    v, mx, sum;
+    float    div_lo, div_hi;    // 10*log10() of the 2 group sizes
+
+    if (npix > SCREEN_WIDTH) 
+        npix = SCREEN_WIDTH;    // do not overrun our buffer size
+    if (!init)
+    {
+        _span_log_add_init();
+        init = true;
+    }
+    div_lo = 10.0f * log10f((float) (nbins / npix));
+    div_hi = 10.0f * log10f((float) (nbins / npix + 1));
+
+    for (int16_t p = 0; p < npix; p++)
+    {
+        b_end = ((uint32_t) (p+1) * nbins) / npix;
+        mx  = -200.0f;
+        sum = -200.0f;
+        for (uint16_t n = b; n < b_end; n++)
+        {
+            v = *(bins+n);
+            if (isnanf(v) || isinff(v))
+                v = -200.0f;
+            if (v > mx) 
+                mx = v;
+            if (mode != SPAN_FIT_MAX)
+                sum = (n == b) ? v : _span_log_add(sum, v);
         }
+        if (mode == SPAN_FIT_MAX)
+            *(out+p) = mx;
+        else
+        {
+            v = sum - ((b_end - b == nbins / npix) ? div_lo : div_hi);   // 10*log10(mean power)
+            if (mode == SPAN_FIT_PEAK && mx - v > SPAN_PEAK_DB)
+                v = mx;
+            *(out+p) = v;
+        }
+        b = b_end;
+    }
+    for (int16_t p = npix; p < SPAN_BUF_SIZE; p++)
+        *(out+p) = -200.0f;
+}
+
+//
+//--------------------------------------------------  noise_floor_update() ------------------------------------------------------------------
+//
+//  Add this update's displayed bins to the decaying histogram and take the SPECT_NF_PCT percentile as spect_noise_floor.
+//  The bins next to the hardware center are skipped, that is the DC spike or the hole left by the IQ correction.
+//  O(bins + cells) with no sort.  A new zoom or span (Hz per pixel) clears the history since the level per bin changes with
+//  the bin size.  A pan keeps it, the bin size is the same and the decay follows any change in the floor.
+//
+HOT void _noise_floor_update(const float *pwr, int16_t npix, int16_t dc_pix, float hz_per_pix)
+{
+    static float last_hz = 0.0f;
+    int16_t i;
+    int16_t n = 0;
+
+    if (npix > SCREEN_WIDTH)
+        npix = SCREEN_WIDTH;
+    if (hz_per_pix != last_hz)
+    {
+        memset(nf_hist, 0, sizeof(nf_hist));
+        nf_hist_total = 0.0f;
+        last_hz = hz_per_pix;
     }
-//Serial.print("iiMax=");DPRINT(iiMax);DPRINT(" specMax=");DPRINTLN(specMax);   
-    if (specMax != 0.0)
+    for (i = 0; i < SPECT_NF_CELLS; i++)
+        nf_hist[i] *= SPECT_NF_DECAY;
+    nf_hist_total *= SPECT_NF_DECAY;
+
+    for (i = 2; i < npix-2; i++)
     {
-        float vm =  *(pPwr + iiMax - 1);
-        float vc =  *(pPwr + iiMax);
-        float vp =  *(pPwr + iiMax + 1);
-        float R=0;
+        float v = pwr[i] - SPECT_NF_LO;
+        if (!(v > 0.0f) || (i >= dc_pix-1 && i <= dc_pix+1))   // fill values, NaN and DC
+            continue;
+        int16_t c = (v < SPECT_NF_CELLS) ? (int16_t) v : SPECT_NF_CELLS-1;
+        nf_hist[c] += 1.0f;
+        n++;
+    }
+    nf_hist_total += n;
+    if (nf_hist_total < 1.0f)
+        return;     // nothing valid yet, keep the last value
 
-        if(vp > vm)  
+    float target = nf_hist_total * (SPECT_NF_PCT / 100.0f);
+    float cum    = 0.0f;
+    for (i = 0; i < SPECT_NF_CELLS-1; i++)
+    {
+        if (cum + nf_hist[i] >= target)
+            break;
+        cum += nf_hist[i];
+    }
+    // Spread the weight evenly across the cell to get the fraction of a dB
+    float frac = (nf_hist[i] > 0.0f) ? (target - cum) / nf_hist[i] : 0.0f;
+    spect_noise_floor = SPECT_NF_LO + i + frac;
+}
+
+//
+//--------------------------------------------------  find_FFT_Peaks() ------------------------------------------------------------------------
+//
+//  Find the strongest peaks in the displayed bins (1 value per pixel) in a single pass, then match them to the last update's peaks.
+//      - A peak is a local maximum at least SPECT_PEAK_THRESH_DB above the tracked noise floor.
+//        Bins around the hardware center (dc_pix) are skipped, that is the DC spike.
+//      - The position and level are interpolated with a parabola through the peak bin and its 2 neighbors in dB.
+//        On log power that is the same as fitting a Gaussian, close to the main lobe of the Hanning window.  Good to about 0.1 bin.
+//      - Of 2 peaks closer than SPECT_PEAK_MIN_SEP only the stronger is kept, and only the SPECT_PEAKS_MAX strongest overall.
+//      - A peak within SPECT_PEAK_TRACK of a last update peak continues that track.  New tracks need SPECT_PEAK_HYST_DB more level
+//        and SPECT_PEAK_CONFIRM updates before they are reported.  Lost tracks are held SPECT_PEAK_HOLD updates.
+//  Results are in spect_peaks[], strongest first.  fftMaxPower and spect_peak_freq get the strongest confirmed peak.
+//
+static void _peak_insert(struct Spectrum_Peak *list, uint8_t *n, const struct Spectrum_Peak *pk)
+{
+    int8_t j;
+
+    for (j = 0; j < *n; j++)    // a stronger peak close by wins
+    {
+        if (fabsf(list[j].bin - pk->bin) < SPECT_PEAK_MIN_SEP && list[j].dB >= pk->dB)
+            return;
+    }
+    for (j = *n-1; j >= 0; j--) // remove the weaker ones close by
+    {
+        if (fabsf(list[j].bin - pk->bin) < SPECT_PEAK_MIN_SEP)
         {
-         // set global fftMaxPower = Power of the strongest signal if possible
-           R = vc/vp;
+            for (int8_t k = j; k < *n-1; k++)
+                list[k] = list[k+1];
+            (*n)--;
         }
-        else  
-        {          
-            R = vc/vm;
+    }
+    if (*n == SPECT_PEAKS_MAX)
+    {
+        if (list[*n-1].dB >= pk->dB)
+            return;     // list is full of stronger peaks
+        (*n)--;
+    }
+    for (j = *n; j > 0 && list[j-1].dB < pk->dB; j--)   // insert in order, strongest first
+        list[j] = list[j-1];
+    list[j] = *pk;
+    (*n)++;
+}
+
+//  The strongest local maxima at or above keep, not next to the DC pixel dc, into cand[].  Returns how many.
+//  Most of the spectrum is below keep so it is searched SPECT_PEAK_BLOCK pixels at a time with arm_max_f32() and only
+//  the blocks that reach keep are looked at pixel by pixel.  NaN compares false so is never a peak.
+//
+HOT uint8_t _find_FFT_Candidates(const float *pwr, int16_t npix, int16_t dc, float keep, struct Spectrum_Peak *cand)
+{
+    struct Spectrum_Peak pk;
+    uint8_t  nc = 0;
+    float    mx;
+    uint32_t mi;
+
+    for (int16_t b = 2; b < npix-2; b += SPECT_PEAK_BLOCK)
+    {
+        int16_t b_end = (b + SPECT_PEAK_BLOCK < npix-2) ? b + SPECT_PEAK_BLOCK : npix-2;
+        arm_max_f32(pwr+b, b_end-b, &mx, &mi);
+        if (!(mx >= keep))
+            continue;
+        for (int16_t i = b; i < b_end; i++)
+        {
+            float v = pwr[i];
+            if (!(v >= keep) || v <= pwr[i-1] || v < pwr[i+1] || (i >= dc-1 && i <= dc+1))    // !(v >= keep) also traps NaN
+                continue;
+            float a   = pwr[i-1];
+            float c   = pwr[i+1];
+            float d   = a - 2.0f * v + c;
+            float ofs = (d < 0.0f) ? 0.5f * (a - c) / d : 0.0f;   // -0.5 to +0.5 bin
+            pk.bin  = i + ofs;
+            pk.dB   = v - 0.25f * (a - c) * ofs;
+            pk.freq = 0;
+            pk.hits = 0;
+            pk.miss = 0;
+            _peak_insert(cand, &nc, &pk);
         }
-        // return a frequency value adjusted to be relative to the center bin
-        fftMaxPower = iiMax + (2-R)/(1+R);
-        f_peak = fftMaxPower - bin_center;   //adjust for center  
-        //fftMaxPower = myFFT.read(fftMaxPower)-20; // set global fftMaxPower = Power of the strongest signal if possible
-                                                            // -20 is a cal factor experimentally determined
-        #ifdef FFT_4096
-            if (fft_sz == 4096) fftMaxPower = myFFT_4096.read(fftMaxPower)-20; 
-        #endif
-        #ifdef FFT_2048
-            if (fft_sz == 2048) fftMaxPower = myFFT_2048.read(fftMaxPower)-20; 
-        #endif
-        #ifdef FFT_1024 
-            if (fft_sz == 1024) fftMaxPower = myFFT_1024.read(fftMaxPower)-20;    
-        #endif
     }
-//DPRINT("iiMax=");DPRINT(iiMax);DPRINT(" fftMaxPower=");DPRINT(fftMaxPower);DPRINT(" fpeak=");DPRINTLN(f_peak);
-    return f_peak;    // return -200 unless there is a good value to send out
+    return nc;
+}
+
+HOT void _find_FFT_Peaks(const float *pwr, int16_t npix, float dc_pix, float hz_per_pix, int32_t vfo)
+{
+    static float    last_dc     = 0.0f;
+    static float    last_hz     = 0.0f;
+    struct Spectrum_Peak cand[SPECT_PEAKS_MAX];
+    struct Spectrum_Peak next[SPECT_PEAKS_MAX];
+    struct Spectrum_Peak pk;
+    bool     used[SPECT_PEAKS_MAX]  = {};
+    uint8_t  nc         = 0;
+    uint8_t  nn         = 0;
+    float    keep       = spect_noise_floor + SPECT_PEAK_THRESH_DB;
+    int16_t  dc         = (int16_t) (dc_pix + 0.5f);
+    int16_t  i, k;
+
+    if (npix > SCREEN_WIDTH)
+        npix = SCREEN_WIDTH;
+    if (npix < 8)
+        return;
+    if (dc_pix != last_dc || hz_per_pix != last_hz)   // pan, zoom or span changed, the old positions mean nothing
+    {
+        spect_peak_count = 0;
+        last_dc = dc_pix;
+        last_hz = hz_per_pix;
+    }
+
+    // The 1 pass over the bins collects the strongest local maxima
+    nc = _find_FFT_Candidates(pwr, npix, dc, keep, cand);
+
+    // Continue the existing tracks
+    for (i = 0; i < spect_peak_count; i++)
+    {
+        struct Spectrum_Peak *old = &spect_peaks[i];
+        int8_t  best    = -1;
+        float   best_d  = SPECT_PEAK_TRACK;
+        for (k = 0; k < nc; k++)
+        {
+            float d = fabsf(cand[k].bin - old->bin);
+            if (!used[k] && d <= best_d)
+            {
+                best   = k;
+                best_d = d;
+            }
+        }
+        if (best >= 0)
+        {
+            used[best] = true;
+            pk      = cand[best];
+            pk.hits = (old->hits < 255) ? old->hits+1 : 255;
+            pk.miss = 0;
+        }
+        else if (old->miss < SPECT_PEAK_HOLD)
+        {
+            pk = *old;
+            pk.miss++;
+        }
+        else
+            continue;   // lost
+        _peak_insert(next, &nn, &pk);
+    }
+    // Start new tracks
+    for (k = 0; k < nc; k++)
+    {
+        if (!used[k] && cand[k].dB >= keep + SPECT_PEAK_HYST_DB)
+        {
+            pk      = cand[k];
+            pk.hits = 1;
+            _peak_insert(next, &nn, &pk);
+        }
+    }
+
+    spect_peak_freq = 0;
+    for (i = 0; i < nn; i++)
+    {
+        next[i].freq = vfo + (int32_t) ((next[i].bin - dc_pix) * hz_per_pix);
+        spect_peaks[i] = next[i];
+        if (spect_peak_freq == 0 && next[i].hits >= SPECT_PEAK_CONFIRM)
+        {
+            spect_peak_freq = next[i].freq;
+            fftMaxPower     = (int16_t) next[i].dB;
+        }
+    }
+    spect_peak_count = nn;
+}
+
+//  Draw a small marker over each confirmed peak in the strip at the top of the spectrum window.  The strip is cleared each time.
+//  Called while drawing to layer 2 (page 2) so it is copied to the screen with the trace.
+void _sp_draw_peak_markers(struct Spectrum_Parms *ptr, int16_t filt_x, int16_t filt_w)
+{
+    int16_t y = ptr->sp_top_line+1;
+
+    _sp_fillRect(ptr->l_graph_edge+1, y, ptr->wf_sp_width, SPECT_PEAK_MARK_H, BLACK);
+    _sp_fillRect(filt_x, y, filt_w, SPECT_PEAK_MARK_H, myVERY_DARK_GREEN);
+    for (uint8_t p = 0; p < spect_peak_count; p++)
+    {
+        if (spect_peaks[p].hits < SPECT_PEAK_CONFIRM || spect_peaks[p].miss)
+            continue;
+        int16_t x = ptr->l_graph_edge + (int16_t) (spect_peaks[p].bin + 0.5f);
+        if (x-3 <= ptr->l_graph_edge || x+3 >= ptr->r_graph_edge)
+            continue;
+        tft.fillTriangle(x-3, y, x+3, y, x, y+SPECT_PEAK_MARK_H-2, (p == 0) ? ORANGE : CYAN);   // strongest is orange
+        spect_stats.draw_calls++;
+        spect_stats.spi_bytes_est += SP_BYTES_PER_CMD;
+    }
+}
+
+//  Turn the peak markers on or off.  The trace gives up the top SPECT_PEAK_MARK_H rows while they are on.
+void Spectrum_Peak_Markers(bool on)
+{
+    spect_peak_markers = on;
+    spect_full_redraw  = true;
+}
+
+//  Return the frequency of the confirmed peak nearest to freq, if it is within range_Hz.  Otherwise 0.
+int32_t Spectrum_Peak_Near(int32_t freq, int32_t range_Hz)
+{
+    int32_t best    = 0;
+    int32_t best_d  = abs(range_Hz) + 1;
+
+    for (uint8_t p = 0; p < spect_peak_count; p++)
+    {
+        if (spect_peaks[p].hits < SPECT_PEAK_CONFIRM)
+            continue;
+        int32_t d = abs(spect_peaks[p].freq - freq);
+        if (d < best_d)
+        {
+            best   = spect_peaks[p].freq;
+            best_d = d;
+        }
+    }
+    return best;
+}
+
+//  Return the offset in Hz from the tuned frequency to screen column x, for the frame being drawn.  Used by touch tuning.
+int32_t Spectrum_X_Hz(int16_t x)
+{
+    return (int32_t) ((x - (ptr->l_graph_edge + SP_CENTER_PIX(ptr) - sp_pan)) * sp_bin_sz*2);
 }
 
 // Duplicate of the function in Display.h but included here to make the spectrum module self contained. Minor changes included
 //char* Spectrum_RA887x::_formatFreq(uint32_t Freq)
 char* _formatFreq(uint32_t Freq)
 {
-	static char Freq_str[15];
+	static char Freq_str[16];
 	
 	uint16_t MHz = (Freq/1000000 % 1000000);
 	uint16_t Hz  = (Freq % 1000);
 	uint16_t KHz = ((Freq % 1000000) - Hz)/1000;
-	sprintf(Freq_str, "%5d.%03d.%03d", MHz, KHz, Hz);
+	snprintf(Freq_str, sizeof(Freq_str), "%5d.%03d.%03d", MHz, KHz, Hz);
 	//Serial.print("Freq: ");Serial.println(Freq_str);
 	return Freq_str;
 }
@@ -1155,6 +1915,79 @@ int16_t _colorMap(int16_t val, int16_t color_temp)
     return _Color565(red * 256, green * 256, blue * 256);
 }
 
+//
+//____________________________________________________Waterfall Palettes _____________________________________
+//
+// Select the palette used by waterfall style 6.  The table is rebuilt on the next spectrum update.
+void Spectrum_Set_Palette(uint8_t palette)
+{
+    if (palette >= WF_PALETTE_NUM)
+        palette = WF_PALETTE_G0ORX;
+    wf_palette_sel = palette;
+}
+
+// Fill wf_palette[] from the selected palette.  Entry n covers n/WF_PALETTE_SIZE of the range between the 
+// waterfall low and high thresholds.  The extra entry at the end is the over range color.
+COLD void _wf_palette_build(uint8_t palette)
+{
+    unsigned char rgb[3];
+    float temp;
+
+    for (int16_t n = 0; n <= WF_PALETTE_SIZE; n++)
+    {
+        temp = (float) n / WF_PALETTE_SIZE;   // 0.0 to 1.0, last entry is 1.0 (over range)
+        switch (palette)
+        {
+            case WF_PALETTE_COLORMAP:   // Temperature ramp from _colorMap() spread across the range. Blue->Green->Red
+                    if (temp < 0.5) 
+                        wf_palette[n] = _Color565(0, temp * 2 * 255, 2 * (0.5 - temp) * 255);
+                    else 
+                        wf_palette[n] = _Color565(temp * 255, (1.0 - temp) * 255, 0);
+                    break;
+            case WF_PALETTE_GRAYSCALE:
+                    wf_palette[n] = _Color565(temp * 255, temp * 255, temp * 255);
+                    break;
+            case WF_PALETTE_G0ORX:
+            default:
+                    _waterfall_gradient(temp, rgb);
+                    wf_palette[n] = _Color565(rgb[0], rgb[1], rgb[2]);
+                    break;
+        }
+    }
+}
+
+// Called once per spectrum update.  Only rebuilds the tables when a setting they depend on has changed.
+// The color temp is the current layout's (pp).  The floor and scale are preset 0's, as _waterfall_color_update() reads them.
+void _wf_palette_check(struct Spectrum_Parms *pp)
+{
+    struct Spectrum_Parms *Gptr = Sp_Parms_Def;
+    static int16_t last_floor       = -32768;
+    static int16_t last_sp_scale    = -32768;
+    static int16_t last_colortemp   = -32768;
+    static uint8_t last_palette     = 255;
+
+    if (Gptr->spect_floor != last_floor || Gptr->spect_sp_scale != last_sp_scale)
+    {
+        // Same adjustment _waterfall_color_update() makes to pix_min to lower the color temp a bit.
+        wf_palette_low_ofs = (Gptr->spect_floor/2) + (Gptr->spect_sp_scale/-30) + 8;
+        last_floor    = Gptr->spect_floor;
+        last_sp_scale = Gptr->spect_sp_scale;
+    }
+
+    if (pp->spect_wf_colortemp != last_colortemp)
+    {
+        for (int16_t n = 0; n < WF_COLORMAP_SIZE; n++)
+            wf_colormap_lut[n] = _colorMap(n, pp->spect_wf_colortemp);
+        last_colortemp = pp->spect_wf_colortemp;
+    }
+
+    if (wf_palette_sel != last_palette)
+    {
+        _wf_palette_build(wf_palette_sel);
+        last_palette = wf_palette_sel;
+    }
+}
+
 /*
 // Pass 8-bit (each) R,G,B, get back 16-bit packed color
 static uint16_t Color565(uint8_t r, uint8_t g, uint8_t b) {
@@ -1218,20 +2051,6 @@ int16_t _waterfall_color_update(float sample, int16_t waterfall_low)
     struct Spectrum_Parms *Gptr = Sp_Parms_Def;
     //int average=0;
     unsigned char rgb[3];
-    unsigned char *p;
-
-    static int colorLowR=0; // black
-    static int colorLowG=0;
-    static int colorLowB=0;
-
-    //static int colorMidR=255; // red
-    //static int colorMidG=0;
-    //static int colorMidB=0;
-
-    static int colorHighR=255; // yellow
-    static int colorHighG=255;
-    static int colorHighB=0;
-    //int pan = 0;
 
     // introduce scale factor here possibly - might do something with average later also
     // but the pix_min seems to work well enough
@@ -1243,7 +2062,7 @@ int16_t _waterfall_color_update(float sample, int16_t waterfall_low)
 
     //waterfall_low += (Gptr->spect_sp_scale/-30);  // slight adjustment to lower the color temp a bit.
     waterfall_low += (Gptr->spect_floor/2) + (Gptr->spect_sp_scale/-30) + 8;  // slight adjustment to lower the color temp a bit.
-    int16_t waterfall_high = -40;
+    int16_t waterfall_high = WF_PALETTE_HIGH;
 
     //Serial.print("FFT = " );Serial.println(sample);
     //Serial.print("WtrF Low = " );Serial.println(waterfall_low);
@@ -1251,19 +2070,54 @@ int16_t _waterfall_color_update(float sample, int16_t waterfall_low)
     //average+=sample;        
     //Serial.println(average);
     
-    p = rgb;
-    if(sample<(float)waterfall_low) {
+    if(sample<(float)waterfall_low) 
+        _waterfall_gradient(0.0f, rgb);
+    else if(sample>(float)waterfall_high) 
+        _waterfall_gradient(1.0f, rgb);  // 1.0 and above is the high color
+    else 
+    {
+        float range=(float)waterfall_high-(float)waterfall_low;
+        float offset=sample-(float)waterfall_low;
+        _waterfall_gradient(offset/range, rgb);
+    }
+
+    //if(rx->waterfall_automatic) {
+    //  waterfall_low=average/display_width;
+    //  waterfall_high=waterfall_low+50;
+    //}
+    
+    int16_t pval = _Color565(rgb[0], rgb[1], rgb[2]);
+    //DPRINT("Final color = ");DPRINTLN(pval,HEX);
+    return pval;
+}
+
+// The gradient part of the above.  percent is 0.0 to 1.0 of the range between waterfall low and high.  
+// Values below 0 give the low color, 1.0 and above gives the high color.
+// Split out so the palette table builder can use it without the per pixel threshold math.
+void _waterfall_gradient(float percent, unsigned char *p)
+{
+    static int colorLowR=0; // black
+    static int colorLowG=0;
+    static int colorLowB=0;
+
+    //static int colorMidR=255; // red
+    //static int colorMidG=0;
+    //static int colorMidB=0;
+
+    static int colorHighR=255; // yellow
+    static int colorHighG=255;
+    static int colorHighB=0;
+    //int pan = 0;
+
+    if(percent<0.0f) {
         *p++=colorLowR;
         *p++=colorLowG;
         *p++=colorLowB;
-    } else if(sample>(float)waterfall_high) {
+    } else if(percent>=1.0f) {
         *p++=colorHighR;
         *p++=colorHighG;
         *p++=colorHighB;
     } else {
-        float range=(float)waterfall_high-(float)waterfall_low;
-        float offset=sample-(float)waterfall_low;
-        float percent=offset/range;
         if(percent<(2.0f/9.0f)) {
             float local_percent = percent / (2.0f/9.0f);
             *p++ = (int)((1.0f-local_percent)*colorLowR);
@@ -1301,13 +2155,4 @@ int16_t _waterfall_color_update(float sample, int16_t waterfall_low)
                 *p++ = 255;
         }
     }
-
-    //if(rx->waterfall_automatic) {
-    //  waterfall_low=average/display_width;
-    //  waterfall_high=waterfall_low+50;
-    //}
-    
-    int16_t pval = _Color565(rgb[0], rgb[1], rgb[2]);
-    //DPRINT("Final color = ");DPRINTLN(pval,HEX);
-    return pval;
 }
@@ -89,21 +89,122 @@ struct Spectrum_Parms {
                                 // The diff between this and box bottom results in scaling (zoom). If peaks occur outside the box bounds then they are not drawn.
     int16_t spect_floor;        // Slides the data up and down relative to the specrum bottom box line. The noise floor may be above or below and if outside the box is simply not drawn.
     int16_t spect_wf_rate;      // Used by external timer to control refresh rate for this layout. drawSpectrumFRame() will read this and set the timer
+    int16_t spect_avg_mode;     // FFT averaging over time, ZOOM_AVG_xxx.  0=block mean of power, 1=exponential, 2=peak hold.  +3 averages the dB values.
+    int16_t spect_avg_tc;       // Averaging time constant in ms.  0 in block mode averages NAvg FFTs.
 };
 
 // The main program should define at least 1 layout record based on this structure.
 // Here is a working example usually placed in your main program header files.
 /*
 struct Spectrum_Parms Sp_Parms_Def[PRESETS] = { // define default sets of spectrum window parameters, mostly for easy testing but could be used for future custom preset layout options
-  //W LE  RE  CG x   y   w  h  c sp st clr sc mode scal reflvl wfrate
+  //W LE  RE  CG x   y   w  h  c sp st clr sc mode scal reflvl wfrate avg tc
   #ifdef USE_RA8875
-    {798,0, 0,  0,798,398,14,8,157,179,179,408,400,110,111,289,289,  0,153,799,256,50,20,6,240,1.0,0.9,1,20, 8, 70},
+    {798,0, 0,  0,798,398,14,8,157,179,179,408,400,110,111,289,289,  0,153,799,256,50,20,6,240,1.0,0.9,1,20, 8, 70, 1,200},
   #else
-    {1020,1,1,  1,1021,510,14,8,143,165,165,528,520,142,213,307,307,  0,139,1022,390,40,20,6,890,1.5,0.9,1,20,10, 80},
+    {1020,1,1,  1,1021,510,14,8,143,165,165,528,520,142,213,307,307,  0,139,1022,390,40,20,6,890,1.5,0.9,1,20,10, 80, 1,200},
   #endif
 };
 */
 
+// Waterfall palettes for style 6.  The selected palette is expanded into a RGB565 table when the floor, 
+// scale, color temp or palette changes, then each waterfall pixel is a single table lookup.
+#define WF_PALETTE_G0ORX        0       // Black->Blue->Cyan->Green->Yellow->Red->Magenta gradient from PiHPSDR (default)
+#define WF_PALETTE_COLORMAP     1       // Blue->Green->Red temperature ramp like _colorMap()
+#define WF_PALETTE_GRAYSCALE    2       // Black->White
+#define WF_PALETTE_NUM          3       // Number of palettes
+#define WF_PALETTE_SIZE         256     // Palette table entries across the low to high range (+1 over range entry)
+#define WF_PALETTE_HIGH         -40     // Waterfall high threshold in dB.  Signals above this get the over range color.
+#define WF_COLORMAP_SIZE        1024    // _colorMap() values cached for styles 1-5.  Larger values are computed.
+
+// Span modes.  How FFT bins are mapped to the pixels in the graph width when the FFT is larger than the graph.
+#define SPAN_CROP               0       // 1 bin per pixel from the center of the FFT. Pan slides the window. (default)
+#define SPAN_FIT_MAX            1       // Full FFT span packed into the graph width. Max of each group of bins.
+#define SPAN_FIT_MEAN           2       // Full FFT span packed into the graph width. Mean power of each group of bins.
+#define SPAN_FIT_PEAK           3       // Full FFT span packed into the graph width. Mean power, but peaks standing above the mean are kept.
+#define SPAN_NUM                4       // Number of span modes
+#define SPAN_PEAK_DB            6.0f    // SPAN_FIT_PEAK uses the peak when it is more than this many dB above the group mean
+#define SPAN_BUF_SIZE           (SCREEN_WIDTH*16/10+4)  // Reduced data buffer.  Waterfall style 0 reads ahead 1.6x the pixel index
+
+// Per update spectrum drawing counters.  The display libraries do not report SPI bytes, so spi_bytes_est adds a fixed
+// guess per command or character.  It follows the draw calls, it is not a measure of the bus traffic.
+#define SP_BYTES_PER_CMD        48      // Guess for the register writes of 1 line, rectangle or BTE command
+#define SP_BYTES_PER_CHAR       400     // Guess for 1 font character drawn as pixels
+struct Spectrum_Stats {
+    uint32_t draw_calls;        // Display drawing commands issued for the spectrum window in the last update
+    uint32_t spi_bytes_est;     // SPI bytes for them from the SP_BYTES_PER_ guesses, not counted
+    uint32_t full_redraws;      // Number of times the whole spectrum window was erased and redrawn since startup
+};
+extern struct Spectrum_Stats spect_stats;
+extern bool spect_full_redraw;
+
+// spectrum_update() steps.  Each call does 1 step so the main loop is never held up for a whole frame.
+#define SP_IDLE                 0       // Waiting for the update rate timer
+#define SP_CAPTURE              1       // Copy or span reduce the new FFT data
+#define SP_COLORIZE             2       // Build the waterfall line colors and spectrum pixel values
+#define SP_WF_MOVE1             3       // Start waterfall scroll block move to layer 2 (page 2)
+#define SP_WF_WAIT1             4       // Poll block move done
+#define SP_WF_MOVE2             5       // Start waterfall scroll block move back 1 row lower
+#define SP_WF_WAIT2             6       // Poll block move done, write the new waterfall line
+#define SP_TRACE                7       // Draw the spectrum trace on layer 2 (page 2)
+#define SP_BLIT                 8       // Start block move of the spectrum window to the visible layer (page)
+#define SP_BLIT_WAIT            9       // Poll block move done
+#define SP_LABELS               10      // Update span frequency labels
+#define SP_NUM_STEPS            11
+
+// Graph column holding the FFT center bin, the pan point.  The tuned frequency is drawn at this column less the pan
+// offset.  The peak search, filter shading, center and pitch lines, ticks and touch tuning all use it.
+#define SP_CENTER_PIX(p)        ((p)->wf_sp_width/2)
+extern uint8_t  sp_state;
+extern uint32_t spect_step_max_us[SP_NUM_STEPS];  // Worst case time in us spent in each step since startup
+
+// Waterfall scroll methods
+#define WF_SCROLL_COPY          0       // Block copy the whole waterfall to layer 2 (page 2) and back 1 row lower each line
+#define WF_SCROLL_RING          1       // RA8876 only. Waterfall is a ring buffer on a hidden page shown through the PIP1 window.
+                                        //   Only the new row is written (twice) and the window start moves, no block moves. (RA8876 default)
+#define WF_SCROLL_SINGLE        2       // RA8875 only. 1 block move on layer 1 in the negative (bottom up) direction shifts the waterfall
+                                        //   down 1 row in place, then the new row is written. Layer 2 is not used. (RA8875 default)
+#define WF_SCROLL_NUM           3
+#define WF_RING_PAGE            PAGE3_START_ADDR    // RA8876 hidden page holding the waterfall ring buffer.  Page 2 is used by the spectrum and pop ups.
+extern uint8_t  spect_wf_scroll;
+extern uint32_t spect_wf_scroll_us;         // Time in us spent in the waterfall scroll steps for the last line, work and busy polls
+extern uint32_t spect_wf_scroll_max_us[WF_SCROLL_NUM];  // and worst case for each scroll method since startup
+
+// Noise floor tracker.  Each update adds the displayed bins to a histogram of 1dB cells that forgets the older updates
+// at SPECT_NF_DECAY per update.  The floor is the SPECT_NF_PCT percentile of it, found by walking the cells, so no sort
+// and a deep null, the DC hole or a few strong signals do not move it.  It is the auto reference for the bottom of the
+// spectrum and the low end of the waterfall colors.  spect_floor is still added on top as the user trim.  The tracker
+// does not write spect_floor or bandmem[].sp_ref_lvl, those stay the user's per band setting and move the trace relative
+// to the tracked floor.
+#define SPECT_NF_LO             -200    // dB at the bottom of cell 0.  Bins at or below this are fill values and skipped.
+#define SPECT_NF_CELLS          200     // 1dB cells, covers -200 to 0dB
+#define SPECT_NF_PCT            10      // Percentile of the bins taken as the floor
+#define SPECT_NF_DECAY          0.75f   // Weight kept per update. About 4 updates to follow a change
+#define SPECT_NF_MARGIN         3       // dB the spectrum bottom is set below the floor so most of the grass is drawn
+extern float    spect_noise_floor;      // dB
+
+// Peak detector.  1 pass over the displayed bins each update finds the strongest local maxima, interpolated on the dB values
+// (a parabola on log power is a Gaussian fit), kept SPECT_PEAK_MIN_SEP pixels apart and tracked from frame to frame.
+#define SPECT_PEAKS_MAX         8       // Most peaks tracked
+#define SPECT_PEAK_THRESH_DB    12.0f   // A tracked peak is kept while this many dB above the noise floor
+#define SPECT_PEAK_HYST_DB      3.0f    // A new peak must be this much more above the floor to start being tracked
+#define SPECT_PEAK_MIN_SEP      6       // Pixels.  The weaker of 2 closer peaks is dropped
+#define SPECT_PEAK_TRACK        3       // Pixels.  A peak within this distance of last update's peak is the same carrier
+#define SPECT_PEAK_CONFIRM      2       // Updates a new peak must be seen before it is reported
+#define SPECT_PEAK_HOLD         3       // Updates a tracked peak is held after it is last seen
+#define SPECT_PEAK_MARK_H       7       // Height of the marker strip reserved at the top of the spectrum window
+#define SPECT_PEAK_SNAP_PIX     10      // Touch tune snaps to a peak within this many pixels
+#define SPECT_PEAK_BLOCK        16      // Pixels.  The search skips blocks this wide whose max is under the threshold
+struct Spectrum_Peak {
+    float   bin;                // Interpolated pixel position from the left edge of the graph
+    float   dB;                 // Interpolated peak level
+    int32_t freq;               // Frequency in Hz
+    uint8_t hits;               // Updates seen, stops at 255
+    uint8_t miss;               // Updates missed in a row
+};
+extern struct Spectrum_Peak spect_peaks[SPECT_PEAKS_MAX];   // Strongest first
+extern uint8_t  spect_peak_count;
+extern bool     spect_peak_markers;
+
 struct New_Spectrum_Layout {      // Temp storage for generating new layouts    
       int16_t spectrum_x;             // 0 to width of display - window width. Must fit within the button frame edges left and right
                                           // ->Pay attention to the fact that position X starts with 0 so 100 pixels wide makes the right side value of x=99.
@@ -125,14 +226,38 @@ struct New_Spectrum_Layout {      // Temp storage for generating new layouts
       int16_t spectrum_sp_scale;      // 10 to 80. Spectrum scale factor in dB. This is the height of the scale (if possible by windows sizes). Will plot the spectrum window of values between the floor and the scale value creating a zoom effect.
       int16_t spectrum_floor;         // 0 to -150. The reference point for plotting values.  Anything signal value > than this (less negative) will be plotted until stronger than the window height*scale factor.
       int16_t spectrum_wf_rate;       // window update rate in ms.  25 is fast enough to see dit and dahs well    
+      int16_t spectrum_avg_mode;      // 0-5. FFT averaging, ZOOM_AVG_xxx.  0=block, 1=exponential, 2=peak hold, +3 in dB.
+      int16_t spectrum_avg_tc;        // Averaging time constant in ms.  Longer digs weak signals out of the noise but follows fading slower.
 };
 
 int32_t spectrum_update(int16_t s, int16_t VFOA_YES, int32_t VfoA, int32_t VfoB, int32_t Offset, uint16_t filterCenter, uint16_t filterBandwidth, float pan, uint16_t zoom_fft_size, float fft_bin_sz, int16_t fft_binc);
 void Spectrum_Parm_Generator(int16_t parm_set, int16_t preset, uint16_t fft_binc);
 void drawSpectrumFrame(uint8_t s);
 void initSpectrum(int16_t preset);
+void Spectrum_Set_Palette(uint8_t palette);
+void Spectrum_Set_Span(uint8_t mode);
+void Spectrum_Set_WF_Scroll(uint8_t mode);
+void Spectrum_Popup(bool up);
+void Spectrum_BTE_Wait(void);
+bool Spectrum_BTE_Running(void);
+void Spectrum_Restart(void);
+void Spectrum_Print_Timing(void);
+void Spectrum_Peak_Markers(bool on);
+int32_t Spectrum_Peak_Near(int32_t freq, int32_t range_Hz);
+int32_t Spectrum_X_Hz(int16_t x);
 void setActiveWindow(int16_t XL,int16_t XR ,int16_t YT ,int16_t YB);
 void setActiveWindow_default(void);
 void updateActiveWindow(bool full);
 
+extern uint16_t wf_palette[];
+// Quantize a FFT bin value (dB) into the waterfall palette.  lo is the low threshold, k is table entries per dB.
+// Below lo gives entry 0, above the high threshold gives the over range entry.  Also traps NaN to the low color.
+inline int16_t _wf_palette_lookup(float sample, float lo, float k)
+{
+    float f = (sample - lo) * k;
+    if (!(f > 0.0f))            return wf_palette[0];
+    if (f >= WF_PALETTE_SIZE)   return wf_palette[WF_PALETTE_SIZE];
+    return wf_palette[(int32_t) f];
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+//
+//    TX_PatchCords.h
+//
+//  The transmit patch cords:  mic and test tones through the TX filter and Hilbert into I_Switch/Q_Switch ch 1, and
+//  the TX monitor to OutputSwitch ch 1.  SDR_RA8875.ino and Host/GraphRunner.cpp both include it, as RX_PatchCords.h.
+//  Include it once, at file scope, after the objects it names.  The USB input cords stay in the .ino.
+//
+#ifndef _TX_PATCHCORDS_H_
+#define _TX_PATCHCORDS_H_
+
+// Test tone sources for single or two tone in place of (or in addition to) real input audio
+// Mic and Test Tones need to be converted to I and Q
+
+// switch to select inputs.  In DATA mode USB in should be default, mic in voice modes
+
+// Analog mic input
+AudioConnection_F32     patchCord_Mic_In(Input,0,                               TX_Source,0);   // Mic source
+
+AudioConnection_F32     patchCord_Tx_Tone_A(TxTestTone_A,0,                     TX_Source,2);   // Combine mic, tone B and B into L channel
+AudioConnection_F32     patchCord_Tx_Tone_B(TxTestTone_B,0,                     TX_Source,3);
+
+//AudioConnection_F32     patchCord_Audio_Filter(TX_Source,0,                     bpf1,0);  // variable filter for TX
+//AudioConnection_F32     patchCord_Audio_Filter_L(bpf1,0,                        FFT_90deg_Hilbert,0);  // variable filter for TX
+//AudioConnection_F32     patchCord_Audio_Filter_R(bpf1,0,                        FFT_90deg_Hilbert,1);  // variable filter for TX
+//AudioConnection_F32     patchCord_Feed_L(FFT_90deg_Hilbert,1,                   I_Switch,1); // Feed into normal chain
+//AudioConnection_F32     patchCord_Feed_R(FFT_90deg_Hilbert,0,                   Q_Switch,1);
+
+//AudioConnection_F32     patchCord_Audio_Filter(TX_Source,0,                     TX_FilterConv,0);  // variable filter for TX
+//AudioConnection_F32     patchCord_Audio_Filter_L(TX_FilterConv,0,               FFT_90deg_Hilbert,0);  // variable filter for TX
+//AudioConnection_F32     patchCord_Audio_Filter_R(TX_FilterConv,0,               FFT_90deg_Hilbert,1);  // variable filter for TX
+//AudioConnection_F32     patchCord_Feed_L(FFT_90deg_Hilbert,1,                   I_Switch,1); // Feed into normal chain
+//AudioConnection_F32     patchCord_Feed_R(FFT_90deg_Hilbert,0,                   Q_Switch,1);
+
+#ifdef USE_DEMOD_DECIMATE
+// The TX filters run at the Hilbert rate whatever the codec rate
+AudioConnection_F32     patchCord_TX_Dec(TX_Source,0,                           TX_Decimate,0);
+AudioConnection_F32     patchCord_Audio_Filter(TX_Decimate,0,                   bpf1,0);  // variable filter for TX
+AudioConnection_F32     patchCord_IQ_Mix_L(bpf1,0,                              TX_Hilbert,0);  // input 1 left open, both filters share the 1 input
+AudioConnection_F32     patchCord_TX_Interp_L(TX_Hilbert,1,                     TX_Interpolate,0); // -45
+AudioConnection_F32     patchCord_TX_Interp_R(TX_Hilbert,0,                     TX_Interpolate,1); // +45
+AudioConnection_F32     patchCord_Feed_L(TX_Interpolate,0,                      I_Switch,1); // Feed into normal chain
+AudioConnection_F32     patchCord_Feed_R(TX_Interpolate,1,                      Q_Switch,1);
+#else
+AudioConnection_F32     patchCord_Audio_Filter(TX_Source,0,                     bpf1,0);  // variable filter for TX
+AudioConnection_F32     patchCord_IQ_Mix_L(bpf1,0,                              TX_Hilbert,0);  // input 1 left open, both filters share the 1 input
+AudioConnection_F32     patchCord_Feed_L(TX_Hilbert,1,                          I_Switch,1); // -45, Feed into normal chain
+AudioConnection_F32     patchCord_Feed_R(TX_Hilbert,0,                          Q_Switch,1); // +45
+#endif
+
+// In TX the mic source is selected in FFT_Mixer and was phase shifted so just passed
+AudioConnection_F32     patchCord_Mic_Input_L(RxTx_InputSwitch_R,1,         OutputSwitch_I,1);  // phase shift mono source 90 degrees
+AudioConnection_F32     patchCord_Mic_Input_R(RxTx_InputSwitch_L,1,         OutputSwitch_Q,1);  // Using L source twice since mic source is mono
+
+#endif  // _TX_PATCHCORDS_H_
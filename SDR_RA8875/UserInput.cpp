@@ -485,6 +485,10 @@ COLD uint8_t Gesture_Handler(uint8_t gesture)
                 zoom = 2;
             if (user_settings[user_Profile].zoom_level == 2)
                 zoom = 4;
+            if (user_settings[user_Profile].zoom_level == 3)
+                zoom = 8;
+            if (user_settings[user_Profile].zoom_level == 4)
+                zoom = 16;
             
             //DPRINTLN(F("Drag RIGHT")); 
             switch (MF_client) {
@@ -709,6 +713,9 @@ COLD void Button_Handler(int16_t x, uint16_t y)
                     case PAN_BTN:       setPAN(3);      break;  // set pan to center
                     //case AFGAIN_BTN:    setAFgain(1);   break;
                     case RFGAIN_BTN:    setRFgain(3);   break;  // same as 2 but toggle PAN ON state
+                    case DISPLAY_BTN:   setWFPalette(2); break; // next waterfall palette
+                    case ZOOM_BTN:      setSpan(2);     break;  // next span mode, crop or fit
+                    case REFLVL_BTN:    setPeakMarks(2); break; // peak markers on/off
                     default:DPRINT(F("Found a LONG PRESS button with SHOW ON but has no function to call.  Index = "));
                       DPRINTLN(i); break;
                 }